@@ -10,6 +10,7 @@
 
 // ------------------------------------------------------------------
 #include "Game/Units/Unit.hpp"
+#include "Game/Framework/RenderLayers.hpp"
 
 // ------------------------------------------------------------------
 Ability::Ability(const AbilityDefinition* abilityDefinition_)
@@ -20,21 +21,15 @@ Ability::Ability(const AbilityDefinition* abilityDefinition_)
 // ------------------------------------------------------------------
 Ability::~Ability()
 {
-	for (Term*& term : m_abilitySequence)
-	{
-		delete term;
-		term = nullptr;
-	}
-	m_abilitySequence.clear();
 }
 
 // ------------------------------------------------------------------
 void Ability::Update(float deltaSeconds_)
 {
-	for(Term* term : m_abilitySequence)
+	const AbilitySequence& sequence = m_abilityDefinition->m_abilitySequence;
+	for(int termIndex = 0; termIndex < m_termCount; ++termIndex)
 	{
-		term->SetAbilityCurrentlySequencing(this);
-		term->Run(deltaSeconds_);
+		Term::Run(sequence[termIndex], m_termStates[termIndex], *this, deltaSeconds_);
 	}
 	
 	if(SequenceFinishedAllTerms())
@@ -58,16 +53,10 @@ void Ability::Render()
 		return;
 	}
 
-	std::vector<Vertex_PCU> abilityVerts;
-	
 	AABB2 abilityBox = AABB2(m_castLocation, m_dimensions / 2.0f);
 
 	m_currentSpriteDefinition.GetUVs(m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
-	AddVertsForAABB2D(abilityVerts, abilityBox, Rgba::WHITE, m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
-
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_spriteTexture));
-	g_theRenderer->DrawVertexArray((int)abilityVerts.size(), &abilityVerts[0]);
+	g_theRenderer->GetSpriteBatch().AddQuad(GameSpriteKey(RENDER_LAYER_ABILITIES, m_spriteTexture), abilityBox, Rgba::WHITE, m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
 }
 
 // ------------------------------------------------------------------
@@ -186,33 +175,33 @@ void Ability::DoHealing(float percentDamage_, int damageModifier_)
 }
 
 // ------------------------------------------------------------------
-void Ability::ApplyStatus(std::string statusName_)
+void Ability::ApplyStatus(StringID statusID_)
 {
-	m_target->ApplyStatus(statusName_, m_caster);
+	m_target->ApplyStatus(statusID_, m_caster);
 }
 
 // ------------------------------------------------------------------
-void Ability::ApplyDebuff(std::string debuffName_)
+void Ability::ApplyDebuff(StringID debuffID_)
 {
-	m_target->ApplyDebuff(debuffName_, m_caster);
+	m_target->ApplyDebuff(debuffID_, m_caster);
 }
 
 // ------------------------------------------------------------------
-void Ability::ApplyBuff(std::string buffName_)
+void Ability::ApplyBuff(StringID buffID_)
 {
-	const AbilityDefinition* buffDef = AbilityDefinition::s_abilityDefinitions[buffName_];
+	const AbilityDefinition* buffDef = AbilityDefinition::GetAbilityDefinition(buffID_);
 
 	switch (buffDef->m_targetChoice)
 	{
 		case TargetChoice::SELF:
 		{
-			m_caster->ApplyBuff(buffName_, m_caster);
+			m_caster->ApplyBuff(buffID_, m_caster);
 			break;
 		}
 
 		case TargetChoice::RANDOM:
 		{
-			m_target->ApplyBuff(buffName_, m_caster);
+			m_target->ApplyBuff(buffID_, m_caster);
 			break;
 		}
 
@@ -284,7 +273,7 @@ void Ability::SetSpriteDimensions(Vec2 dimensions_)
 }
 
 // ------------------------------------------------------------------
-void Ability::SetSpriteTexture(std::string texture_)
+void Ability::SetSpriteTexture(TextureHandle texture_)
 {
 	m_spriteTexture = texture_;
 }
@@ -298,46 +287,48 @@ void Ability::SetRenderAbility(bool renderAbility_)
 // ------------------------------------------------------------------
 void Ability::AddOffsetStartTimeToSequence(float offsetTime_)
 {
-	for(Term* term : m_abilitySequence)
-	{
-		term->AddToAtTime(offsetTime_);
-	}
+	m_sequenceStartOffset += offsetTime_;
+}
+
+// ------------------------------------------------------------------
+float Ability::GetSequenceStartOffset() const
+{
+	return m_sequenceStartOffset;
 }
 
 // ------------------------------------------------------------------
 void Ability::ResetTermStateOnAllTermsInSequence()
 {
-	for(Term* term : m_abilitySequence)
+	for(int termIndex = 0; termIndex < m_termCount; ++termIndex)
 	{
-		term->SetStateToStart();
+		m_termStates[termIndex].m_termState = TermState::START;
 	}
 }
 
 // ------------------------------------------------------------------
 bool Ability::SequenceFinishedAllTerms()
 {
-	bool allFinished = true;
-	for(Term* term : m_abilitySequence)
+	for(int termIndex = 0; termIndex < m_termCount; ++termIndex)
 	{
-		if(!term->IsFinished())
+		if(m_termStates[termIndex].m_termState != TermState::FINISHED)
 		{
-			allFinished = false;
+			return false;
 		}
 	}
 
-	return allFinished;
+	return true;
 }
 
 // ------------------------------------------------------------------
-std::string Ability::GetAbilityStatusEffectIcon()
+TextureHandle Ability::GetAbilityStatusEffectIcon() const
 {
-	return m_abilityDefinition->m_statusIcon;
+	return m_abilityDefinition->m_statusIconHandle;
 }
 
 // ------------------------------------------------------------------
-std::string Ability::GetAbilityBuffEffectIcon()
+TextureHandle Ability::GetAbilityBuffEffectIcon() const
 {
-	return m_abilityDefinition->m_buffIcon;
+	return m_abilityDefinition->m_buffIconHandle;
 }
 
 // ------------------------------------------------------------------
@@ -353,9 +344,10 @@ void Ability::Create(const AbilityDefinition* abilityDefinition_)
 
 	m_lifetimeTotalTime = m_abilityDefinition->m_sequenceLifetime;
 
-	for(Term* term : m_abilityDefinition->m_abilitySequence)
+	const AbilitySequence& sequence = m_abilityDefinition->m_abilitySequence;
+	m_termCount = (int)sequence.size();
+	for(int termIndex = 0; termIndex < m_termCount; ++termIndex)
 	{
-		Term* clone = term->Clone();
-		m_abilitySequence.push_back(clone);
+		Term::InitInstanceState(sequence[termIndex], m_termStates[termIndex]);
 	}
 }
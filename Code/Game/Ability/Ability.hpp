@@ -3,6 +3,7 @@
 // -----------------------------------------------------------------------
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Renderer/SpriteDefinition.hpp"
+#include "Engine/Memory/BlockAllocator.hpp"
 
 // -----------------------------------------------------------------------
 #include "Game/Ability/AbilityDefinition.hpp"
@@ -15,6 +16,9 @@ class Ability
 
 public:
 
+	// Statuses, buffs and debuffs are made and deleted all through a battle;
+	BLOCK_ALLOCATED_CLASS()
+
 	Ability() = delete;
 	explicit Ability(const AbilityDefinition* abilityDefinition_);
 	~Ability();
@@ -28,9 +32,9 @@ public:
 	void ApplyPercentDamage(float percentDamage_, int damageModifier_);
 	void DoDamage(float percentDamage_, int damageModifier_);
 	void DoHealing(float percentDamage_, int damageModifier_);
-	void ApplyStatus(std::string statusName_);
-	void ApplyDebuff(std::string debuffName_);
-	void ApplyBuff(std::string buffName_);
+	void ApplyStatus(StringID statusID_);
+	void ApplyDebuff(StringID debuffID_);
+	void ApplyBuff(StringID buffID_);
 
 	// Helpers;
 	const AbilityDefinition* GetAbilityDefinition();
@@ -45,13 +49,14 @@ public:
 	Vec2 GetCasterOriginalLocation();
 	void SetCurrentSpriteDefinition(SpriteDefinition currentSpriteDefinition_);
 	void SetSpriteDimensions(Vec2 dimensions_);
-	void SetSpriteTexture(std::string texture_);
+	void SetSpriteTexture(TextureHandle texture_);
 	void SetRenderAbility(bool renderAbility_);
 	void AddOffsetStartTimeToSequence(float offsetTime_);
+	float GetSequenceStartOffset() const;
 	void ResetTermStateOnAllTermsInSequence();
 	bool SequenceFinishedAllTerms();
-	std::string GetAbilityStatusEffectIcon();
-	std::string GetAbilityBuffEffectIcon();
+	TextureHandle GetAbilityStatusEffectIcon() const;
+	TextureHandle GetAbilityBuffEffectIcon() const;
 	Unit* GetTarget();
 
 public:
@@ -63,7 +68,7 @@ public:
 
 	Vec2 m_castLocation = Vec2(0.0f, 0.0f);
 	Vec2 m_dimensions = Vec2(0.0f, 0.0f);
-	std::string m_spriteTexture = "";
+	TextureHandle m_spriteTexture;
 	bool m_renderAbility = false;
 
 private:
@@ -79,7 +84,10 @@ private:
 	// Ability Definition;
 	const AbilityDefinition* m_abilityDefinition = nullptr;
 
-	AbilitySequence m_abilitySequence;
+	// The definition owns the compiled sequence, we only keep a state per term;
+	TermInstanceState m_termStates[AbilityDefinition::MAX_TERMS_PER_SEQUENCE];
+	int m_termCount = 0;
+	float m_sequenceStartOffset = 0.0f;
 
 	// Sprite Information;
 	SpriteDefinition m_currentSpriteDefinition;
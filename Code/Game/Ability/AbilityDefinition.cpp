@@ -1,16 +1,18 @@
 #include "Game/Ability/AbilityDefinition.hpp"
 
+#include "Engine/Renderer/RenderContext.hpp"
 
 #include "Game/Framework/Interface.hpp"
 
 
 // ------------------------------------------------------------------
-std::map<std::string, AbilityDefinition*> AbilityDefinition::s_abilityDefinitions;
+std::unordered_map<StringID, AbilityDefinition*> AbilityDefinition::s_abilityDefinitions;
 
 // ------------------------------------------------------------------
 AbilityDefinition::AbilityDefinition(XmlElement* abilityElement_)
 {
 	m_name = ParseXmlAttribute(*abilityElement_, "name", "");
+	m_nameID = InternString(m_name);
 	m_abilityClass = StringToAbilityClass(ParseXmlAttribute(*abilityElement_, "class", ""));
 	m_baseDamage = ParseXmlAttribute(*abilityElement_, "base_damage", 0);
 	m_unlockLevel = ParseXmlAttribute(*abilityElement_, "unlock_level", 0);
@@ -18,6 +20,8 @@ AbilityDefinition::AbilityDefinition(XmlElement* abilityElement_)
 	m_targetAlliance = StringToTargetAlliance(ParseXmlAttribute(*abilityElement_, "target_alliance", ""));
 	m_statusIcon = ParseXmlAttribute(*abilityElement_, "status_icon", "");
 	m_buffIcon = ParseXmlAttribute(*abilityElement_, "buff_icon", "");
+	m_statusIconHandle = g_theRenderer->AcquireTextureView(m_statusIcon);
+	m_buffIconHandle = g_theRenderer->AcquireTextureView(m_buffIcon);
 	m_activationPeriod = StringToActivationPeriod(ParseXmlAttribute(*abilityElement_, "activation_period", ""));
 	
 	CheckForAndLoadSequence(abilityElement_);
@@ -26,14 +30,14 @@ AbilityDefinition::AbilityDefinition(XmlElement* abilityElement_)
 // ------------------------------------------------------------------
 AbilityDefinition::~AbilityDefinition()
 {
-	for(Term*& term : m_abilitySequence)
+	for(TermInstruction& instruction : m_abilitySequence)
 	{
-		delete term;
-		term = nullptr;
+		delete instruction.m_spriteAnimationDefinition;
+		instruction.m_spriteAnimationDefinition = nullptr;
 	}
 	m_abilitySequence.clear();
 
-	std::map<std::string, AbilityDefinition*>::iterator ability_iter;
+	std::unordered_map<StringID, AbilityDefinition*>::iterator ability_iter;
 	for (ability_iter = s_abilityDefinitions.begin(); ability_iter != s_abilityDefinitions.end(); ++ability_iter)
 	{
 		delete ability_iter->second;
@@ -46,7 +50,7 @@ AbilityDefinition::~AbilityDefinition()
 void AbilityDefinition::LoadAbilitiesFromXML(const char* filename_)
 {
 	tinyxml2::XMLDocument entityXMLDoc;
-	entityXMLDoc.LoadFile(filename_);
+	LoadXmlDocument(entityXMLDoc, filename_);
 
 	if (entityXMLDoc.ErrorID() != tinyxml2::XML_SUCCESS)
 	{
@@ -64,13 +68,34 @@ void AbilityDefinition::LoadAbilitiesFromXML(const char* filename_)
 		while (abilityElement)
 		{
 			AbilityDefinition* abilityDefinition = new AbilityDefinition(abilityElement);
-			s_abilityDefinitions[abilityDefinition->m_name] = abilityDefinition;
+			s_abilityDefinitions[abilityDefinition->m_nameID] = abilityDefinition;
 
 			abilityElement = abilityElement->NextSiblingElement();
 		}
 	}
 }
 
+// ------------------------------------------------------------------
+AbilityDefinition* AbilityDefinition::GetAbilityDefinition(StringID abilityID_)
+{
+	AbilityDefinition* abilityDefinition = FindAbilityDefinition(abilityID_);
+	GUARANTEE_OR_DIE(abilityDefinition != nullptr, Stringf("Ability definition \"%s\" is not loaded.", GetInternedString(abilityID_).c_str()));
+
+	return abilityDefinition;
+}
+
+// ------------------------------------------------------------------
+AbilityDefinition* AbilityDefinition::FindAbilityDefinition(StringID abilityID_)
+{
+	std::unordered_map<StringID, AbilityDefinition*>::iterator found = s_abilityDefinitions.find(abilityID_);
+	if (found == s_abilityDefinitions.end())
+	{
+		return nullptr;
+	}
+
+	return found->second;
+}
+
 // ------------------------------------------------------------------
 AbilityClass AbilityDefinition::StringToAbilityClass(std::string abilityClass_)
 {
@@ -132,9 +157,9 @@ float AbilityDefinition::GetLifetimeOfAbilitySequence()
 		return lifetime;
 	}
 	
-	for(Term* term : m_abilitySequence)
+	for(const TermInstruction& instruction : m_abilitySequence)
 	{
-		float sequenceLifetime = term->GetAtTime() + term->GetDuration();
+		float sequenceLifetime = instruction.m_atTime + instruction.m_duration;
 		if(sequenceLifetime > lifetime)
 		{
 			lifetime = sequenceLifetime;
@@ -164,24 +189,94 @@ void AbilityDefinition::CheckForAndLoadSequence(XmlElement* abilityElement_)
 	m_sequenceLifetime = GetLifetimeOfAbilitySequence();
 }
 
+// ------------------------------------------------------------------
+const std::string& AbilityDefinition::GetTermString(int stringIndex_) const
+{
+	return m_termStrings[stringIndex_];
+}
+
 // ------------------------------------------------------------------
 void AbilityDefinition::ParseTermInSequence(XmlElement* termElement_)
 {
-	TermType type = Term::StringToTermType(ParseXmlAttribute(*termElement_, "type", ""));
+	GUARANTEE_OR_DIE((int)m_abilitySequence.size() < MAX_TERMS_PER_SEQUENCE, Stringf("Ability %s has more terms than MAX_TERMS_PER_SEQUENCE!", m_name.c_str()));
 
-	Term* term = nullptr;
-	switch (type)
+	TermInstruction instruction;
+	instruction.m_termType = Term::StringToTermType(ParseXmlAttribute(*termElement_, "type", ""));
+	instruction.m_atTime = ParseXmlAttribute(*termElement_, "atTime", 0.0f);
+	instruction.m_duration = ParseXmlAttribute(*termElement_, "duration", 0.0f);
+
+	switch (instruction.m_termType)
 	{
-	case TermType::ANIM:			{ term = new AnimTerm(termElement_); break; }
-	case TermType::MOVEMENT:		{ term = new MovementTerm(termElement_); break; }
-	case TermType::EFFECT:			{ term = new EffectTerm(termElement_); break; }
-	case TermType::AUDIO:			{ term = new AudioTerm(termElement_); break; }
-	case TermType::DAMAGE:			{ term = new DamageTerm(termElement_); break; }
-	case TermType::DEBUFF:			{ term = new DebuffTerm(termElement_); break; }
-	case TermType::BUFF:			{ term = new BuffTerm(termElement_); break; }
-	case TermType::STATUS:			{ term = new StatusTerm(termElement_); break; }
-	case TermType::ATTACKCHANGE:	{ term = new AttackChange(termElement_); break; }
-	case TermType::DISSPELL:		{ term = new Disspell(termElement_); break; }
+		case TermType::ANIM:
+		{
+			std::string animationName = ParseXmlAttribute(*termElement_, "animname", "");
+			GUARANTEE_OR_DIE(animationName != "", "Setting Animation in an anim term to nothing. This is not a valid animation!");
+			instruction.m_stringID = InternString(animationName);
+			break;
+		}
+
+		case TermType::MOVEMENT:
+		{
+			instruction.m_movementType = Term::StringToMovementType(ParseXmlAttribute(*termElement_, "movement_type", ""));
+			break;
+		}
+
+		case TermType::EFFECT:
+		{
+			instruction.m_textureHandle = g_theRenderer->AcquireTextureView(ParseXmlAttribute(*termElement_, "texture", ""));
+			Vec2 dimensions = ParseXmlAttribute(*termElement_, "dimensions", Vec2(0.0f, 0.0f));
+			instruction.m_dimensionX = dimensions.x;
+			instruction.m_dimensionY = dimensions.y;
+
+			XmlElement* animationElement = termElement_->FirstChildElement("animation");
+			if (animationElement)
+			{
+				SpriteSheet* spriteSheet = g_Interface->match().m_abilitySpriteSheets[ParseXmlAttribute(*animationElement, "ability_name", "")];
+				SpriteAnimationPlaybackType playback = SpriteAnimationDefinition::StringToSpriteAnimationPlaybackType(ParseXmlAttribute(*animationElement, "playback", "loop"));
+				instruction.m_spriteAnimationDefinition = new SpriteAnimationDefinition
+				(
+					*spriteSheet,
+					ParseXmlAttribute(*animationElement, "start", 0),
+					ParseXmlAttribute(*animationElement, "end", 0),
+					ParseXmlAttribute(*animationElement, "duration", 0.0f),
+					playback
+				);
+			}
+			break;
+		}
+
+		case TermType::AUDIO:
+		{
+			instruction.m_stringIndex = AddTermString(ParseXmlAttribute(*termElement_, "audio", ""));
+			break;
+		}
+
+		case TermType::DAMAGE:
+		{
+			instruction.m_value = ParseXmlAttribute(*termElement_, "damage_percent", 0.0f);
+			instruction.m_amount = ParseXmlAttribute(*termElement_, "damage_modifier", 1);
+			break;
+		}
+
+		case TermType::DEBUFF:
+		case TermType::BUFF:
+		case TermType::STATUS:
+		{
+			instruction.m_stringID = InternString(ParseXmlAttribute(*termElement_, "name", ""));
+			instruction.m_value = ParseXmlAttribute(*termElement_, "chance", 0.0f);
+			break;
+		}
+
+		case TermType::ATTACKCHANGE:
+		{
+			instruction.m_amount = ParseXmlAttribute(*termElement_, "amount", 0);
+			break;
+		}
+
+		case TermType::DISSPELL:
+		{
+			break;
+		}
 
 		default:
 		{
@@ -190,8 +285,20 @@ void AbilityDefinition::ParseTermInSequence(XmlElement* termElement_)
 		}
 	}
 
-	if(term)
+	m_abilitySequence.push_back(instruction);
+}
+
+// ------------------------------------------------------------------
+int AbilityDefinition::AddTermString(const std::string& string_)
+{
+	for (int i = 0; i < (int)m_termStrings.size(); ++i)
 	{
-		m_abilitySequence.push_back(term);
+		if (m_termStrings[i] == string_)
+		{
+			return i;
+		}
 	}
+
+	m_termStrings.push_back(string_);
+	return (int)m_termStrings.size() - 1;
 }
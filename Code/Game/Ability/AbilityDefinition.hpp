@@ -1,13 +1,14 @@
 #pragma once
 
 #include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/StringID.hpp"
 #include "Game/Ability/Term.hpp"
 
 #include <map>
+#include <unordered_map>
 
-class Term;
-
-typedef std::vector<Term*> AbilitySequence;
+// Compiled once per definition, Abilities only keep a TermInstanceState per instruction;
+typedef std::vector<TermInstruction> AbilitySequence;
 
 enum class AbilityClass
 {
@@ -63,22 +64,32 @@ public:
 	explicit AbilityDefinition(XmlElement* abilityElement_);
 	~AbilityDefinition();
 
+	// Abilities hold their term states inline, so sequences are capped;
+	static constexpr int MAX_TERMS_PER_SEQUENCE = 16;
+
 	static void LoadAbilitiesFromXML(const char* filename_);
 	static AbilityClass StringToAbilityClass(std::string abilityClass_);
 	static TargetChoice StringToTargetChoice(std::string targetChoice_);
 	static TargetAlliance StringToTargetAlliance(std::string targetAlliance_);
 	static ActivationPeriod StringToActivationPeriod(std::string activationPeriod_);
+
+	// Get dies on an unknown ID, Find returns nullptr;
+	static AbilityDefinition* GetAbilityDefinition(StringID abilityID_);
+	static AbilityDefinition* FindAbilityDefinition(StringID abilityID_);
 	
 	float GetLifetimeOfAbilitySequence();
+	const std::string& GetTermString(int stringIndex_) const;
 
 	// Parsing XML;
 	void CheckForAndLoadSequence(XmlElement* abilityElement_);
 	void ParseTermInSequence(XmlElement* termElement_);
+	int AddTermString(const std::string& string_);
 
 public:
 
 	// Ability Information;
 	std::string m_name = "";
+	StringID m_nameID = INVALID_STRING_ID;
 	AbilityClass m_abilityClass = AbilityClass::INVALID;
 	int m_baseDamage = 0;
 	int m_unlockLevel = 0;
@@ -87,13 +98,16 @@ public:
 	float m_sequenceLifetime = 0.0f;
 	std::string m_statusIcon = "";
 	std::string m_buffIcon = "";
+	TextureHandle m_statusIconHandle;
+	TextureHandle m_buffIconHandle;
 	ActivationPeriod m_activationPeriod = ActivationPeriod::INVALID;
 
 	// Sequence;
 	AbilitySequence m_abilitySequence;
+	std::vector<std::string> m_termStrings;
 
-	// Static Map to hold Ability Definitions;
-	static std::map<std::string, AbilityDefinition*> s_abilityDefinitions;
+	// Static Map to hold Ability Definitions, keyed by the interned name;
+	static std::unordered_map<StringID, AbilityDefinition*> s_abilityDefinitions;
 
 	
 };
\ No newline at end of file
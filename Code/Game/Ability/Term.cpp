@@ -2,7 +2,6 @@
 
 // -----------------------------------------------------------------------
 #include "Engine/Core/RandomNumberGenerator.hpp"
-#include "Engine/Core/DevConsole.hpp"
 
 // -----------------------------------------------------------------------
 #include "Game/Units/Unit.hpp"
@@ -44,29 +43,40 @@ TermMovementType Term::StringToMovementType(const std::string& type_)
 }
 
 // -----------------------------------------------------------------------
-// Base;
+// Interpreter;
 // -----------------------------------------------------------------------
-void Term::Run(float deltaSeconds_)
+void Term::InitInstanceState(const TermInstruction& instruction_, TermInstanceState& state_)
 {
-	switch(m_termState)
+	state_ = TermInstanceState();
+
+	if(instruction_.m_termType == TermType::DAMAGE)
+	{
+		state_.m_damageModifier = instruction_.m_amount;
+	}
+}
+
+// -----------------------------------------------------------------------
+void Term::Run(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_, float deltaSeconds_)
+{
+	switch(state_.m_termState)
 	{
 		case TermState::SETUP_COMPLETE:
 		case TermState::START:
 		{
-			m_runningTimer = 0.0f;
-			Start(deltaSeconds_);
+			state_.m_runningTimer = 0.0f;
+			Start(instruction_, state_, ability_, deltaSeconds_);
 			break;
 		}
 
 		case TermState::DO:
 		{
-			Tick(deltaSeconds_);
+			Tick(instruction_, state_, ability_, deltaSeconds_);
 			break;
 		}
 
 		case TermState::END:
 		{
-			End();
+			End(instruction_, state_, ability_);
 			break;
 		}
 
@@ -82,266 +92,215 @@ void Term::Run(float deltaSeconds_)
 			break;
 		}
 	}
-
-	m_abilityCurrentlySequencing = nullptr;
-	return;
-}
-
-// -----------------------------------------------------------------------
-void Term::SetSetupComplete()
-{
-	m_termState = TermState::SETUP_COMPLETE;
-}
-
-// -----------------------------------------------------------------------
-void Term::SetStateToStart()
-{
-	m_termState = TermState::START;
-}
-
-// -----------------------------------------------------------------------
-float Term::GetAtTime()
-{
-	return m_atTime;
-}
-
-// -----------------------------------------------------------------------
-float Term::GetDuration()
-{
-	return m_duration;
-}
-
-// -----------------------------------------------------------------------
-void Term::SetAtTime(float atTime_)
-{
-	m_atTime = atTime_;
-}
-
-// -----------------------------------------------------------------------
-void Term::AddToAtTime(float additionalTime_)
-{
-	m_atTime += additionalTime_;
 }
 
 // -----------------------------------------------------------------------
-void Term::SetDuration(float duration_)
+void Term::Start(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_, float deltaSeconds_)
 {
-	m_duration = duration_;
-}
-
-// -----------------------------------------------------------------------
-void Term::SetAbilityCurrentlySequencing(Ability* ability_)
-{
-	m_abilityCurrentlySequencing = ability_;
-}
-
-// -----------------------------------------------------------------------
-bool Term::IsFinished()
-{
-	return m_termState == TermState::FINISHED;
-}
-
-// -----------------------------------------------------------------------
-// Anim;
-// -----------------------------------------------------------------------
-AnimTerm::AnimTerm(XmlElement* termElement_)
-{
-	SetAnimationState(ParseXmlAttribute(*termElement_, "animname", ""));
-	SetAtTime(ParseXmlAttribute(*termElement_, "atTime", 0.0f));
-	SetDuration(ParseXmlAttribute(*termElement_, "duration", 0.0f));
-
-	SetSetupComplete();
-}
-
-// -----------------------------------------------------------------------
-void AnimTerm::Start(float deltaSeconds_)
-{
-	m_termState = TermState::START;
+	state_.m_termState = TermState::START;
 
 	// Stay in the START state until it is time to DO this term;
-	if(m_abilityCurrentlySequencing->m_lifetimeTimer >= m_atTime)
+	if(ability_.m_lifetimeTimer < instruction_.m_atTime + ability_.GetSequenceStartOffset())
 	{
-		Tick(deltaSeconds_);
+		return;
 	}
-}
-
-// -----------------------------------------------------------------------
-void AnimTerm::Tick(float deltaSeconds_)
-{
-	m_termState = TermState::DO;
 
-	// This term will DO what needs to be done for the length of its duration;
-	// Everything in this DO will run each frame;
+	switch(instruction_.m_termType)
+	{
+		case TermType::MOVEMENT:
+		{
+			StartMovement(instruction_, state_, ability_);
+			break;
+		}
 
-	m_abilityCurrentlySequencing->GetCaster()->m_currentAnimationName = m_animationName;
-	m_abilityCurrentlySequencing->GetCaster()->m_animationTimer = 0.0f;
-	m_runningTimer += deltaSeconds_;
+		case TermType::EFFECT:
+		{
+			ability_.SetSpriteDimensions(Vec2(instruction_.m_dimensionX, instruction_.m_dimensionY));
+			ability_.SetSpriteTexture(instruction_.m_textureHandle);
+			ability_.SetRenderAbility(true);
+			state_.m_animationTimer = 0.0f;
+			break;
+		}
 
-	// When the term has run for its duration, it will END;
-	if (m_runningTimer >= m_duration)
-	{
-		End();
+		default:
+		{
+			// Nothing to set up for the rest of the terms;
+			break;
+		}
 	}
+
+	Tick(instruction_, state_, ability_, deltaSeconds_);
 }
 
 // -----------------------------------------------------------------------
-void AnimTerm::End()
+void Term::Tick(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_, float deltaSeconds_)
 {
-	m_termState = TermState::END;
+	state_.m_termState = TermState::DO;
 
-	// There is nothing to end for this term in its current iteration;
-
-	m_termState = TermState::FINISHED;
-}
+	// This term will DO what needs to be done for the length of its duration;
+	// Everything in this DO will run each frame;
+	const AbilityDefinition* abilityDefinition = ability_.GetAbilityDefinition();
 
-// -----------------------------------------------------------------------
-Term* AnimTerm::Clone()
-{
-	return new AnimTerm(*this);
-}
+	switch(instruction_.m_termType)
+	{
+		case TermType::ANIM:
+		{
+			ability_.GetCaster()->m_currentAnimationID = instruction_.m_stringID;
+			ability_.GetCaster()->m_animationTimer = 0.0f;
+			break;
+		}
 
-// -----------------------------------------------------------------------
-void AnimTerm::SetAnimationState(const std::string& animationName_)
-{
-	m_animationName = animationName_;
+		case TermType::MOVEMENT:
+		{
+			TickMovement(instruction_, state_, ability_);
+			break;
+		}
 
-	GUARANTEE_OR_DIE(m_animationName != "", "Setting Animation in an AnimTerm to nothing. This is not a valid animation!");
-}
+		case TermType::EFFECT:
+		{
+			state_.m_animationTimer += deltaSeconds_;
+			ability_.SetCurrentSpriteDefinition(instruction_.m_spriteAnimationDefinition->GetSpriteDefinitionAtTime(state_.m_animationTimer));
+			break;
+		}
 
-// -----------------------------------------------------------------------
-// Movement;
-// -----------------------------------------------------------------------
-MovementTerm::MovementTerm(XmlElement* termElement_)
-{
-	SetMovementType(Term::StringToMovementType(ParseXmlAttribute(*termElement_, "movement_type", "")));
-	SetAtTime(ParseXmlAttribute(*termElement_, "atTime", 0.0f));
-	SetDuration(ParseXmlAttribute(*termElement_, "duration", 0.0f));
+		case TermType::AUDIO:
+		{
+			ChannelGroupID sfxGroup = g_theAudioSystem->CreateOrGetChannelGroup("SFX");
+			SoundID audio = g_theAudioSystem->CreateOrGetSound(abilityDefinition->GetTermString(instruction_.m_stringIndex));
+			g_theAudioSystem->PlaySound(audio, sfxGroup, false);
+			break;
+		}
 
-	SetSetupComplete();
-}
+		case TermType::DAMAGE:
+		{
+			ability_.ApplyPercentDamage(instruction_.m_value, state_.m_damageModifier);
+			break;
+		}
 
-// -----------------------------------------------------------------------
-void MovementTerm::Start(float deltaSeconds_)
-{
-	m_termState = TermState::START;
+		case TermType::DEBUFF:
+		{
+			if(Roll(instruction_.m_value))
+			{
+				ability_.ApplyDebuff(instruction_.m_stringID);
+			}
+			break;
+		}
 
-	// Stay in the START state until it is time to DO this term;
-	if (m_abilityCurrentlySequencing->m_lifetimeTimer >= m_atTime)
-	{
-		SetOriginalPosition();
-		SetCurrentPosition();
-		SetTargetPosition();
+		case TermType::BUFF:
+		{
+			if(Roll(instruction_.m_value))
+			{
+				ability_.ApplyBuff(instruction_.m_stringID);
+			}
+			break;
+		}
 
-		Tick(deltaSeconds_);
-	}
-}
+		case TermType::STATUS:
+		{
+			if(Roll(instruction_.m_value))
+			{
+				ability_.ApplyStatus(instruction_.m_stringID);
+			}
+			break;
+		}
 
-// -----------------------------------------------------------------------
-void MovementTerm::Tick(float deltaSeconds_)
-{
-	m_termState = TermState::DO;
+		case TermType::ATTACKCHANGE:
+		{
+			ability_.GetCaster()->AttackChange(instruction_.m_amount);
+			break;
+		}
 
-	// This term will DO what needs to be done for the length of its duration;
-	// Everything in this DO will run each frame;
+		case TermType::DISSPELL:
+		{
+			TickDisspell(ability_);
+			break;
+		}
 
-	float percentAlongPath = 0.0f;
-	if(m_duration > 0.0f)
-	{
-		percentAlongPath = m_runningTimer / m_duration;
+		default:
+		{
+			ERROR_AND_DIE("Unknown Term Type in the Ability Sequence!");
+			break;
+		}
 	}
 
-	m_currentPosition = Lerp2D(m_currentPosition, m_targetPosition, percentAlongPath);
-	m_abilityCurrentlySequencing->GetCaster()->SetLocation(m_currentPosition);
-
-	m_runningTimer += deltaSeconds_;
+	state_.m_runningTimer += deltaSeconds_;
 
 	// When the term has run for its duration, it will END;
-	if (m_runningTimer >= m_duration)
+	if(state_.m_runningTimer >= instruction_.m_duration)
 	{
-		End();
+		End(instruction_, state_, ability_);
 	}
 }
 
 // -----------------------------------------------------------------------
-void MovementTerm::End()
+void Term::End(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_)
 {
-	m_termState = TermState::END;
+	state_.m_termState = TermState::END;
 
-	// There is nothing to end for this term in its current iteration;
-
-	m_termState = TermState::FINISHED;
-}
+	switch(instruction_.m_termType)
+	{
+		case TermType::EFFECT:
+		{
+			ability_.SetRenderAbility(false);
+			break;
+		}
 
-// -----------------------------------------------------------------------
-Term* MovementTerm::Clone()
-{
-	return new MovementTerm(*this);
-}
+		case TermType::DAMAGE:
+		{
+			// Apply damage modifier, this will be 1 for most cases;
+			if(state_.m_damageModifier > 1)
+			{
+				state_.m_damageModifier++;
+			}
+			break;
+		}
 
-// -----------------------------------------------------------------------
-void MovementTerm::SetMovementType(TermMovementType movementType_)
-{
-	m_movementType = movementType_;
-}
+		default:
+		{
+			// There is nothing to end for the rest of the terms;
+			break;
+		}
+	}
 
-// -----------------------------------------------------------------------
-void MovementTerm::SetOriginalPosition()
-{
-	m_originalPosition = m_abilityCurrentlySequencing->GetCasterOriginalLocation();
+	state_.m_termState = TermState::FINISHED;
 }
 
 // -----------------------------------------------------------------------
-void MovementTerm::SetCurrentPosition()
+void Term::StartMovement(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_)
 {
-	m_currentPosition = m_abilityCurrentlySequencing->GetCaster()->GetLocation();
-}
+	Vec2 currentLocation = ability_.GetCaster()->GetLocation();
+	state_.m_currentPosition = currentLocation;
 
-// -----------------------------------------------------------------------
-void MovementTerm::SetTargetPosition()
-{
-	switch(m_movementType)
+	switch(instruction_.m_movementType)
 	{
 		case TermMovementType::TARGET_X:
 		{
-			Vec2 enemyLocation = m_abilityCurrentlySequencing->m_castLocation;
-			Vec2 currentLocation = m_abilityCurrentlySequencing->GetCaster()->GetLocation();
-
-			m_targetPosition = Vec2(enemyLocation.x, currentLocation.y);
-
+			state_.m_targetPosition = Vec2(ability_.m_castLocation.x, currentLocation.y);
 			break;
 		}
 
 		case TermMovementType::TARGET_Y:
 		{
-			Vec2 enemyLocation = m_abilityCurrentlySequencing->m_castLocation;
-			Vec2 currentLocation = m_abilityCurrentlySequencing->GetCaster()->GetLocation();
-
-			m_targetPosition = Vec2(currentLocation.x, enemyLocation.y);
-
+			state_.m_targetPosition = Vec2(currentLocation.x, ability_.m_castLocation.y);
 			break;
 		}
 
 		case TermMovementType::ENEMY_POS:
 		{
-			m_targetPosition = m_abilityCurrentlySequencing->m_castLocation;
-
+			state_.m_targetPosition = ability_.m_castLocation;
 			break;
 		}
 
 		case TermMovementType::ORIGINAL_POS:
 		{
-			m_targetPosition = m_originalPosition;
-
+			state_.m_targetPosition = ability_.GetCasterOriginalLocation();
 			break;
 		}
 
 		case TermMovementType::OFFSCREEN_TOP:
 		{
-			Vec2 currentLocation = m_abilityCurrentlySequencing->GetCaster()->GetLocation();
 			float offscreenTop = (Map::HEIGHT + (Map::HEIGHT * 0.1f));
-
-			m_targetPosition = Vec2(currentLocation.x, offscreenTop);
-
+			state_.m_targetPosition = Vec2(currentLocation.x, offscreenTop);
 			break;
 		}
 
@@ -354,609 +313,31 @@ void MovementTerm::SetTargetPosition()
 }
 
 // -----------------------------------------------------------------------
-// Effect;
-// -----------------------------------------------------------------------
-EffectTerm::EffectTerm(XmlElement* termElement_)
-{
-	SetTexture(ParseXmlAttribute(*termElement_, "texture", ""));
-	SetDimensions(ParseXmlAttribute(*termElement_, "dimensions", Vec2(0.0f, 0.0f)));
-	SetAtTime(ParseXmlAttribute(*termElement_, "atTime", 0.0f));
-	SetDuration(ParseXmlAttribute(*termElement_, "duration", 0.0f));
-
-	XmlElement* animationElement = termElement_->FirstChildElement("animation");
-	if (animationElement)
-	{
-		SetSpriteAnimationDefinition
-		(
-			g_Interface->match().m_abilitySpriteSheets[ParseXmlAttribute(*animationElement, "ability_name", "")],
-			ParseXmlAttribute(*animationElement, "start", 0),
-			ParseXmlAttribute(*animationElement, "end", 0),
-			ParseXmlAttribute(*animationElement, "duration", 0.0f),
-			ParseXmlAttribute(*animationElement, "playback", "loop")
-		);
-	}
-
-	SetSetupComplete();
-}
-
-// -----------------------------------------------------------------------
-void EffectTerm::Start(float deltaSeconds_)
-{
-	m_termState = TermState::START;
-
-	// Stay in the START state until it is time to DO this term;
-	if (m_abilityCurrentlySequencing->m_lifetimeTimer >= m_atTime)
-	{
-		m_abilityCurrentlySequencing->SetSpriteDimensions(m_dimensions);
-		m_abilityCurrentlySequencing->SetSpriteTexture(m_texture);
-		m_abilityCurrentlySequencing->SetRenderAbility(true);
-		m_animationTimer = 0.0f;
-
-		Tick(deltaSeconds_);
-	}
-}
-
-// -----------------------------------------------------------------------
-void EffectTerm::Tick(float deltaSeconds_)
+void Term::TickMovement(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_)
 {
-	m_termState = TermState::DO;
-
-	// This term will DO what needs to be done for the length of its duration;
-	// Everything in this DO will run each frame;
-
-	m_runningTimer += deltaSeconds_;
-	m_animationTimer += deltaSeconds_;
-	m_abilityCurrentlySequencing->SetCurrentSpriteDefinition(m_spriteAnimationDefinition->GetSpriteDefinitionAtTime(m_animationTimer));
-
-	// When the term has run for its duration, it will END;
-	if (m_runningTimer >= m_duration)
+	float percentAlongPath = 0.0f;
+	if(instruction_.m_duration > 0.0f)
 	{
-		End();
+		percentAlongPath = state_.m_runningTimer / instruction_.m_duration;
 	}
-}
-
-// -----------------------------------------------------------------------
-void EffectTerm::End()
-{
-	m_termState = TermState::END;
-
-	m_abilityCurrentlySequencing->SetRenderAbility(false);
-
-	m_termState = TermState::FINISHED;
-}
-
-// -----------------------------------------------------------------------
-Term* EffectTerm::Clone()
-{
-	return new EffectTerm(*this);
-}
-
-// -----------------------------------------------------------------------
-void EffectTerm::SetTexture(std::string texture_)
-{
-	m_texture = texture_;
-}
-
-// -----------------------------------------------------------------------
-void EffectTerm::SetDimensions(Vec2 dimensions_)
-{
-	m_dimensions = dimensions_;
-}
-
-// -----------------------------------------------------------------------
-void EffectTerm::SetSpriteAnimationDefinition(SpriteSheet* spriteSheet_, int startIndex_, int endIndex_, float duration_, std::string playback_)
-{
-	SpriteAnimationPlaybackType playback = SpriteAnimationDefinition::StringToSpriteAnimationPlaybackType(playback_);
-	m_spriteAnimationDefinition = new SpriteAnimationDefinition(*spriteSheet_, startIndex_, endIndex_, duration_, playback);
-}
-
-// -----------------------------------------------------------------------
-// Audio;
-// -----------------------------------------------------------------------
-AudioTerm::AudioTerm(XmlElement* termElement_)
-{
-	SetAudio(ParseXmlAttribute(*termElement_, "audio", ""));
-	SetAtTime(ParseXmlAttribute(*termElement_, "atTime", 0.0f));
-	SetDuration(ParseXmlAttribute(*termElement_, "duration", 0.0f));
-
-	SetSetupComplete();
-}
-
-// -----------------------------------------------------------------------
-void AudioTerm::Start(float deltaSeconds_)
-{
-	m_termState = TermState::START;
 
-	// Stay in the START state until it is time to DO this term;
-	if (m_abilityCurrentlySequencing->m_lifetimeTimer >= m_atTime)
-	{
-		Tick(deltaSeconds_);
-	}
+	state_.m_currentPosition = Lerp2D(state_.m_currentPosition, state_.m_targetPosition, percentAlongPath);
+	ability_.GetCaster()->SetLocation(state_.m_currentPosition);
 }
 
 // -----------------------------------------------------------------------
-void AudioTerm::Tick(float deltaSeconds_)
+void Term::TickDisspell(Ability& ability_)
 {
-	m_termState = TermState::DO;
-
-	// This term will DO what needs to be done for the length of its duration;
-	// Everything in this DO will run each frame;
-
-	m_runningTimer += deltaSeconds_;
-	ChannelGroupID sfxGroup = g_theAudioSystem->CreateOrGetChannelGroup("SFX");
-	SoundID audio = g_theAudioSystem->CreateOrGetSound(m_audio);
-	g_theAudioSystem->PlaySound(audio, sfxGroup, false);
-
-	// When the term has run for its duration, it will END;
-	if (m_runningTimer >= m_duration)
+	for (Ability* status : ability_.GetTarget()->m_activeStatusEffects)
 	{
-		End();
+		status->m_abilityHasBeenDisspelled = true;
 	}
-}
-
-// -----------------------------------------------------------------------
-void AudioTerm::End()
-{
-	m_termState = TermState::END;
-
-	// There is nothing to end for this term in its current iteration;
-
-	m_termState = TermState::FINISHED;
-}
-
-// -----------------------------------------------------------------------
-Term* AudioTerm::Clone()
-{
-	return new AudioTerm(*this);
-}
-
-// -----------------------------------------------------------------------
-void AudioTerm::SetAudio(std::string audio_)
-{
-	m_audio = audio_;
-}
-
-// -----------------------------------------------------------------------
-// Damage;
-// -----------------------------------------------------------------------
-DamageTerm::DamageTerm(XmlElement* termElement_)
-{
-	SetDamagePercent(ParseXmlAttribute(*termElement_, "damage_percent", 0.0f));
-	SetAtTime(ParseXmlAttribute(*termElement_, "atTime", 0.0f));
-	SetDuration(ParseXmlAttribute(*termElement_, "duration", 0.0f));
-	SetDamageModifier(ParseXmlAttribute(*termElement_, "damage_modifier", 1));
-	
-	SetSetupComplete();
-}
-
-// -----------------------------------------------------------------------
-void DamageTerm::Start(float deltaSeconds_)
-{
-	m_termState = TermState::START;
-
-	// Stay in the START state until it is time to DO this term;
-	if (m_abilityCurrentlySequencing->m_lifetimeTimer >= m_atTime)
-	{
-		Tick(deltaSeconds_);
-	}
-}
-
-// -----------------------------------------------------------------------
-void DamageTerm::Tick(float deltaSeconds_)
-{
-	m_termState = TermState::DO;
-
-	// This term will DO what needs to be done for the length of its duration;
-	// Everything in this DO will run each frame;
-
-	m_runningTimer += deltaSeconds_;
-	m_abilityCurrentlySequencing->ApplyPercentDamage(m_damagePercent, m_damageModifier);
-
-	// When the term has run for its duration, it will END;
-	if (m_runningTimer >= m_duration)
-	{
-		End();
-	}
-}
-
-// -----------------------------------------------------------------------
-void DamageTerm::End()
-{
-	m_termState = TermState::END;
-
-	// Apply damage modifier, this will be 1 for most cases;
-	if(m_damageModifier > 1)
-	{
-		m_damageModifier++;
-	}
-
-	// There is nothing to end for this term in its current iteration;
-
-	m_termState = TermState::FINISHED;
-}
-
-// -----------------------------------------------------------------------
-Term* DamageTerm::Clone()
-{
-	return new DamageTerm(*this);
-}
-
-// -----------------------------------------------------------------------
-void DamageTerm::SetDamagePercent(float damagePercent_)
-{
-	m_damagePercent = damagePercent_;
-}
-
-// -----------------------------------------------------------------------
-void DamageTerm::SetDamageModifier(int damageModifier_)
-{
-	m_damageModifier = damageModifier_;
-}
-
-// -----------------------------------------------------------------------
-// Debuff;
-// -----------------------------------------------------------------------
-DebuffTerm::DebuffTerm(XmlElement* termElement_)
-{
-	SetDebuffAbilityName(ParseXmlAttribute(*termElement_, "name", ""));
-	SetPercentChance(ParseXmlAttribute(*termElement_, "chance", 0.0f));
-	SetAtTime(ParseXmlAttribute(*termElement_, "atTime", 0.0f));
-	SetDuration(ParseXmlAttribute(*termElement_, "duration", 0.0f));
-
-	SetSetupComplete();
-}
-
-// -----------------------------------------------------------------------
-void DebuffTerm::Start(float deltaSeconds_)
-{
-	m_termState = TermState::START;
-
-	// Stay in the START state until it is time to DO this term;
-	if (m_abilityCurrentlySequencing->m_lifetimeTimer >= m_atTime)
-	{
-		Tick(deltaSeconds_);
-	}
-}
-
-// -----------------------------------------------------------------------
-void DebuffTerm::Tick(float deltaSeconds_)
-{
-	m_termState = TermState::DO;
-
-	// This term will DO what needs to be done for the length of its duration;
-	// Everything in this DO will run each frame;
-
-	m_runningTimer += deltaSeconds_;
-	if(RollForDebuff())
-	{
-		m_abilityCurrentlySequencing->ApplyDebuff(m_debuffAbilityName);
-	}
-
-	// When the term has run for its duration, it will END;
-	if (m_runningTimer >= m_duration)
-	{
-		End();
-	}
-}
-
-// -----------------------------------------------------------------------
-void DebuffTerm::End()
-{
-	m_termState = TermState::END;
-
-	// There is nothing to end for this term in its current iteration;
-
-	m_termState = TermState::FINISHED;
-}
-
-// -----------------------------------------------------------------------
-Term* DebuffTerm::Clone()
-{
-	return new DebuffTerm(*this);
-}
-
-// -----------------------------------------------------------------------
-void DebuffTerm::SetDebuffAbilityName(std::string debuffAbilityName_)
-{
-	m_debuffAbilityName = debuffAbilityName_;
-}
-
-// -----------------------------------------------------------------------
-void DebuffTerm::SetPercentChance(float percentChance_)
-{
-	m_percentChance_ = percentChance_;
-}
-
-// -----------------------------------------------------------------------
-bool DebuffTerm::RollForDebuff()
-{
-	return g_theRandomNumberGenerator->GetRandomFloatZeroToOne() <= m_percentChance_;
-}
-
-// -----------------------------------------------------------------------
-// Buff;
-// -----------------------------------------------------------------------
-BuffTerm::BuffTerm(XmlElement* termElement_)
-{
-	SetBuffAbilityName(ParseXmlAttribute(*termElement_, "name", ""));
-	SetPercentChance(ParseXmlAttribute(*termElement_, "chance", 0.0f));
-	SetAtTime(ParseXmlAttribute(*termElement_, "atTime", 0.0f));
-	SetDuration(ParseXmlAttribute(*termElement_, "duration", 0.0f));
-
-	SetSetupComplete();
-}
-
-// -----------------------------------------------------------------------
-void BuffTerm::Start(float deltaSeconds_)
-{
-	m_termState = TermState::START;
-
-	// Stay in the START state until it is time to DO this term;
-	if (m_abilityCurrentlySequencing->m_lifetimeTimer >= m_atTime)
-	{
-		Tick(deltaSeconds_);
-	}
-}
-
-// -----------------------------------------------------------------------
-void BuffTerm::Tick(float deltaSeconds_)
-{
-	m_termState = TermState::DO;
-
-	// This term will DO what needs to be done for the length of its duration;
-	// Everything in this DO will run each frame;
-
-	m_runningTimer += deltaSeconds_;
-	if (RollForBuff())
-	{
-		m_abilityCurrentlySequencing->ApplyBuff(m_buffAbilityName);
-	}
-
-	// When the term has run for its duration, it will END;
-	if (m_runningTimer >= m_duration)
-	{
-		End();
-	}
-}
-
-// -----------------------------------------------------------------------
-void BuffTerm::End()
-{
-	m_termState = TermState::END;
-
-	// There is nothing to end for this term in its current iteration;
-
-	m_termState = TermState::FINISHED;
-}
-
-// -----------------------------------------------------------------------
-Term* BuffTerm::Clone()
-{
-	return new BuffTerm(*this);
-}
-
-// -----------------------------------------------------------------------
-void BuffTerm::SetBuffAbilityName(std::string buffAbilityName_)
-{
-	m_buffAbilityName = buffAbilityName_;
-}
-
-// -----------------------------------------------------------------------
-void BuffTerm::SetPercentChance(float percentChance_)
-{
-	m_percentChance_ = percentChance_;
-}
-
-// -----------------------------------------------------------------------
-bool BuffTerm::RollForBuff()
-{
-	return g_theRandomNumberGenerator->GetRandomFloatZeroToOne() <= m_percentChance_;
-}
-
-// -----------------------------------------------------------------------
-// Status;
-// -----------------------------------------------------------------------
-StatusTerm::StatusTerm(XmlElement* termElement_)
-{
-	SetStatusAbilityName(ParseXmlAttribute(*termElement_, "name", ""));
-	SetPercentChance(ParseXmlAttribute(*termElement_, "chance", 0.0f));
-	SetAtTime(ParseXmlAttribute(*termElement_, "atTime", 0.0f));
-	SetDuration(ParseXmlAttribute(*termElement_, "duration", 0.0f));
-
-	SetSetupComplete();
-}
-
-// -----------------------------------------------------------------------
-void StatusTerm::Start(float deltaSeconds_)
-{
-	m_termState = TermState::START;
-
-	// Stay in the START state until it is time to DO this term;
-	if (m_abilityCurrentlySequencing->m_lifetimeTimer >= m_atTime)
-	{
-		Tick(deltaSeconds_);
-	}
-}
-
-// -----------------------------------------------------------------------
-void StatusTerm::Tick(float deltaSeconds_)
-{
-	m_termState = TermState::DO;
-
-	// This term will DO what needs to be done for the length of its duration;
-	// Everything in this DO will run each frame;
-
-	m_runningTimer += deltaSeconds_;
-	if (RollForStatus())
-	{
-		m_abilityCurrentlySequencing->ApplyStatus(m_statusAbilityName);
-	}
-
-	// When the term has run for its duration, it will END;
-	if (m_runningTimer >= m_duration)
-	{
-		End();
-	}
-}
-
-// -----------------------------------------------------------------------
-void StatusTerm::End()
-{
-	m_termState = TermState::END;
-
-	// There is nothing to end for this term in its current iteration;
-
-	m_termState = TermState::FINISHED;
-}
-
-// -----------------------------------------------------------------------
-Term* StatusTerm::Clone()
-{
-	return new StatusTerm(*this);
-}
-
-// -----------------------------------------------------------------------
-void StatusTerm::SetStatusAbilityName(std::string statusAbilityName_)
-{
-	m_statusAbilityName = statusAbilityName_;
-}
-
-// -----------------------------------------------------------------------
-void StatusTerm::SetPercentChance(float percentChance_)
-{
-	m_percentChance_ = percentChance_;
-}
-
-// -----------------------------------------------------------------------
-bool StatusTerm::RollForStatus()
-{
-	return g_theRandomNumberGenerator->GetRandomFloatZeroToOne() <= m_percentChance_;
-}
-
-// -----------------------------------------------------------------------
-// AttackChange;
-// -----------------------------------------------------------------------
-AttackChange::AttackChange(XmlElement* termElement_)
-{
-	SetAmountChange(ParseXmlAttribute(*termElement_, "amount", 0));
-	SetAtTime(ParseXmlAttribute(*termElement_, "atTime", 0.0f));
-	SetDuration(ParseXmlAttribute(*termElement_, "duration", 0.0f));
-
-	SetSetupComplete();
-}
-
-// -----------------------------------------------------------------------
-void AttackChange::Start(float deltaSeconds_)
-{
-	m_termState = TermState::START;
-
-	// Stay in the START state until it is time to DO this term;
-	if (m_abilityCurrentlySequencing->m_lifetimeTimer >= m_atTime)
-	{
-		Tick(deltaSeconds_);
-	}
-}
-
-// -----------------------------------------------------------------------
-void AttackChange::Tick(float deltaSeconds_)
-{
-	m_termState = TermState::DO;
-
-	// This term will DO what needs to be done for the length of its duration;
-	// Everything in this DO will run each frame;
-
-	m_runningTimer += deltaSeconds_;
-	m_abilityCurrentlySequencing->GetCaster()->AttackChange(m_amountChange_);
-
-	// When the term has run for its duration, it will END;
-	if (m_runningTimer >= m_duration)
-	{
-		End();
-	}
-}
-
-// -----------------------------------------------------------------------
-void AttackChange::End()
-{
-	m_termState = TermState::END;
-
-	// There is nothing to end for this term in its current iteration;
-
-	m_termState = TermState::FINISHED;
-}
-
-// -----------------------------------------------------------------------
-Term* AttackChange::Clone()
-{
-	return new AttackChange(*this);
-}
-
-// -----------------------------------------------------------------------
-void AttackChange::SetAmountChange(int amountChange_)
-{
-	m_amountChange_ = amountChange_;
-}
-
-// -----------------------------------------------------------------------
-Disspell::Disspell(XmlElement* termElement_)
-{
-	SetAtTime(ParseXmlAttribute(*termElement_, "atTime", 0.0f));
-	SetDuration(ParseXmlAttribute(*termElement_, "duration", 0.0f));
-
-	SetSetupComplete();
-}
-
-// -----------------------------------------------------------------------
-void Disspell::Start(float deltaSeconds_)
-{
-	m_termState = TermState::START;
-
-	// Stay in the START state until it is time to DO this term;
-	if (m_abilityCurrentlySequencing->m_lifetimeTimer >= m_atTime)
-	{
-		Tick(deltaSeconds_);
-	}
-}
-
-// -----------------------------------------------------------------------
-void Disspell::Tick(float deltaSeconds_)
-{
-	m_termState = TermState::DO;
-
-	// This term will DO what needs to be done for the length of its duration;
-	// Everything in this DO will run each frame;
-
-	m_runningTimer += deltaSeconds_;
-
-	for (Ability* status : m_abilityCurrentlySequencing->GetTarget()->m_activeStatusEffects)
-	{
-		std::string unitType = UnitDefinition::UnitTypeToString(m_abilityCurrentlySequencing->GetCaster()->m_unitDefinition->m_type);
-		std::string printString = Stringf("%s has had %s removed.", unitType.c_str(), status->GetAbilityDefinition()->m_name.c_str());
-		g_theDevConsole->Print(printString);
-		status->m_abilityHasBeenDisspelled = true;
-	}
-
-	m_abilityCurrentlySequencing->m_abilityHasBeenDisspelled = true;
-
-	// When the term has run for its duration, it will END;
-	if (m_runningTimer >= m_duration)
-	{
-		End();
-	}
-}
-
-// -----------------------------------------------------------------------
-void Disspell::End()
-{
-	m_termState = TermState::END;
-
-	// There is nothing to end for this term in its current iteration;
 
-	m_termState = TermState::FINISHED;
+	ability_.m_abilityHasBeenDisspelled = true;
 }
 
 // -----------------------------------------------------------------------
-Term* Disspell::Clone()
+bool Term::Roll(float percentChance_)
 {
-	return new Disspell(*this);
+	return g_theRandomNumberGenerator->GetRandomFloatZeroToOne() <= percentChance_;
 }
@@ -1,10 +1,16 @@
 #pragma once
 
+#include "Engine/Core/StringID.hpp"
+#include "Engine/Math/Vec2.hpp"
 #include "Engine/Renderer/SpriteAnimationDefinition.hpp"
+#include "Engine/Renderer/ResourceRegistry.hpp"
 
 #include "Game/Units/UnitDefinition.hpp"
 
+#include <string>
+
 class Ability;
+class AbilityDefinition;
 class SpriteAnimationDefinition;
 
 enum class TermState
@@ -53,318 +59,72 @@ enum class TermMovementType
 
 
 // -----------------------------------------------------------------------
-// Base Class, Pure Virtual;
+// Instruction;
+// One term of an AbilityDefinition sequence, compiled once when the XML is loaded;
+// Plain data only, every Ability casting the definition reads the same array;
 // -----------------------------------------------------------------------
-class Term
+struct TermInstruction
 {
-
-public:
-
-	virtual ~Term() {}
-
-	void Run(float deltaSeconds_);
-	virtual void Start(float deltaSeconds_) = 0;
-	virtual void Tick(float deltaSeconds_) = 0;
-	virtual void End() = 0;
-
-	virtual Term* Clone() = 0;
-
-	void SetSetupComplete();
-	void SetStateToStart();
-
-	// Helpers;
-	float GetAtTime();
-	float GetDuration();
-	void SetAtTime(float atTime_);
-	void AddToAtTime(float additionalTime_);
-	void SetDuration(float duration_);
-	void SetAbilityCurrentlySequencing(Ability* ability_);
-	bool IsFinished();
-
-	static TermType StringToTermType(const std::string& type_);
-	static TermMovementType StringToMovementType(const std::string& type_);
-
-protected:
-
-	Ability* m_abilityCurrentlySequencing = nullptr;
-
-	TermState m_termState = TermState::INVALID;
-
-	float m_runningTimer = 0.0f;
+	TermType m_termType = TermType::INVALID;
 	float m_atTime = 0.0f;
 	float m_duration = 0.0f;
-};
-
-// -----------------------------------------------------------------------
-// Anim;
-// -----------------------------------------------------------------------
-class AnimTerm : public Term
-{
-
-public:
-
-	AnimTerm() = delete;
-	explicit AnimTerm(XmlElement* termElement_);
-
-	virtual void Start(float deltaSeconds_) override;
-	virtual void Tick(float deltaSeconds_) override;
-	virtual void End() override;
-
-	virtual Term* Clone() override;
-
-	void SetAnimationState(const std::string& animationName_);
-
-
-private:
-
-	std::string m_animationName = "";
-	// AnimationState m_animationState = INVALID;
-
-};
-
-// -----------------------------------------------------------------------
-// Movement;
-// -----------------------------------------------------------------------
-class MovementTerm : public Term
-{
-
-public:
-
-	MovementTerm() = delete;
-	explicit MovementTerm(XmlElement* termElement_);
-
-	virtual void Start(float deltaSeconds_) override;
-	virtual void Tick(float deltaSeconds_) override;
-	virtual void End() override;
-
-	virtual Term* Clone() override;
-
-	void SetMovementType(TermMovementType movementType_);
-	void SetOriginalPosition();
-	void SetCurrentPosition();
-	void SetTargetPosition();
-
-
-private:
 
+	// What these mean depends on m_termType;
+	StringID m_stringID = INVALID_STRING_ID;						// Anim name, or Debuff/Buff/Status ability name;
+	int m_stringIndex = -1;											// Audio file;
+	TextureHandle m_textureHandle;									// Effect texture;
+	float m_value = 0.0f;											// Damage percent, or Debuff/Buff/Status chance;
+	int m_amount = 0;												// Damage modifier, or AttackChange amount;
 	TermMovementType m_movementType = TermMovementType::INVALID;
-	
-
-	// Literal values of the movement types;
-	Vec2 m_currentPosition = Vec2(0.0f, 0.0f);
-	Vec2 m_originalPosition = Vec2(0.0f, 0.0f);
-	Vec2 m_targetPosition = Vec2(0.0f, 0.0f);
-
-};
-
-// -----------------------------------------------------------------------
-// Effect;
-// -----------------------------------------------------------------------
-class EffectTerm : public Term
-{
-
-public:
-
-	EffectTerm() = delete;
-	explicit EffectTerm(XmlElement* termElement_);
-
-	virtual void Start(float deltaSeconds_) override;
-	virtual void Tick(float deltaSeconds_) override;
-	virtual void End() override;
-
-	virtual Term* Clone() override;
-
-	void SetTexture(std::string texture_);
-	void SetDimensions(Vec2 dimensions_);
-	void SetSpriteAnimationDefinition(SpriteSheet* spriteSheet_, int startIndex_, int endIndex_, float duration_, std::string playback_);
-
-private:
-
-	std::string m_texture = "";
-	Vec2 m_dimensions = Vec2(0.0f, 0.0f);
-	SpriteAnimationDefinition* m_spriteAnimationDefinition = nullptr;
-	float m_animationTimer = 0.0f;
-};
-
-// -----------------------------------------------------------------------
-// Audio;
-// -----------------------------------------------------------------------
-class AudioTerm : public Term
-{
-
-public:
-
-	AudioTerm() = delete;
-	explicit AudioTerm(XmlElement* termElement_);
-
-	virtual void Start(float deltaSeconds_) override;
-	virtual void Tick(float deltaSeconds_) override;
-	virtual void End() override;
-
-	virtual Term* Clone() override;
-
-	void SetAudio(std::string audio_);
-	
-private:
-
-	std::string m_audio = "";
-	
+	float m_dimensionX = 0.0f;
+	float m_dimensionY = 0.0f;
+	SpriteAnimationDefinition* m_spriteAnimationDefinition = nullptr;	// Owned by the AbilityDefinition;
 };
 
 // -----------------------------------------------------------------------
-// Damage;
+// Instance State;
+// What one Ability needs to remember about one term while it runs;
 // -----------------------------------------------------------------------
-class DamageTerm : public Term
+struct TermInstanceState
 {
+	TermState m_termState = TermState::SETUP_COMPLETE;
+	float m_runningTimer = 0.0f;
 
-public:
-
-	DamageTerm() = delete;
-	explicit DamageTerm(XmlElement* termElement_);
-
-	virtual void Start(float deltaSeconds_) override;
-	virtual void Tick(float deltaSeconds_) override;
-	virtual void End() override;
-
-	virtual Term* Clone() override;
-
-	void SetDamagePercent(float damagePercent_);
-	void SetDamageModifier(int damageModifier_);
-
-private:
-
-	float m_damagePercent = 0.0f;
+	// Damage; modifiers above 1 grow each time the sequence is run;
 	int m_damageModifier = 1;
-};
-
-// -----------------------------------------------------------------------
-// Debuff;
-// -----------------------------------------------------------------------
-class DebuffTerm : public Term
-{
-
-public:
-
-	DebuffTerm() = delete;
-	explicit DebuffTerm(XmlElement* termElement_);
-
-	virtual void Start(float deltaSeconds_) override;
-	virtual void Tick(float deltaSeconds_) override;
-	virtual void End() override;
-
-	virtual Term* Clone() override;
-
-	void SetDebuffAbilityName(std::string debuffAbilityName_);
-	void SetPercentChance(float percentChance_);
-	bool RollForDebuff();
-
-private:
-
-	std::string m_debuffAbilityName = "";
-	float m_percentChance_ = 0.0f;
-
-};
-
-// -----------------------------------------------------------------------
-// Buff;
-// -----------------------------------------------------------------------
-class BuffTerm : public Term
-{
-
-public:
-
-	BuffTerm() = delete;
-	explicit BuffTerm(XmlElement* termElement_);
-
-	virtual void Start(float deltaSeconds_) override;
-	virtual void Tick(float deltaSeconds_) override;
-	virtual void End() override;
-
-	virtual Term* Clone() override;
-
-	void SetBuffAbilityName(std::string buffAbilityName_);
-	void SetPercentChance(float percentChance_);
-	bool RollForBuff();
-
-private:
 
-	std::string m_buffAbilityName = "";
-	float m_percentChance_ = 0.0f;
-
-};
-
-// -----------------------------------------------------------------------
-// Status;
-// -----------------------------------------------------------------------
-class StatusTerm : public Term
-{
-
-public:
-
-	StatusTerm() = delete;
-	explicit StatusTerm(XmlElement* termElement_);
-
-	virtual void Start(float deltaSeconds_) override;
-	virtual void Tick(float deltaSeconds_) override;
-	virtual void End() override;
-
-	virtual Term* Clone() override;
-
-	void SetStatusAbilityName(std::string statusAbilityName_);
-	void SetPercentChance(float percentChance_);
-	bool RollForStatus();
-
-private:
-
-	std::string m_statusAbilityName = "";
-	float m_percentChance_ = 0.0f;
-
-};
-
-// -----------------------------------------------------------------------
-// AttackChange;
-// -----------------------------------------------------------------------
-class AttackChange : public Term
-{
-
-public:
-
-	AttackChange() = delete;
-	explicit AttackChange(XmlElement* termElement_);
-
-	virtual void Start(float deltaSeconds_) override;
-	virtual void Tick(float deltaSeconds_) override;
-	virtual void End() override;
-
-	virtual Term* Clone() override;
-
-	void SetAmountChange(int amountChange_);
-
-private:
-
-	int m_amountChange_ = 0;
+	// Effect;
+	float m_animationTimer = 0.0f;
 
+	// Movement;
+	Vec2 m_currentPosition = Vec2(0.0f, 0.0f);
+	Vec2 m_targetPosition = Vec2(0.0f, 0.0f);
 };
 
 // -----------------------------------------------------------------------
-// Disspell;
+// Interpreter;
+// Steps a TermInstruction against its TermInstanceState for the Ability running it;
 // -----------------------------------------------------------------------
-class Disspell : public Term
+class Term
 {
 
 public:
 
-	Disspell() = delete;
-	explicit Disspell(XmlElement* termElement_);
-
-	virtual void Start(float deltaSeconds_) override;
-	virtual void Tick(float deltaSeconds_) override;
-	virtual void End() override;
-
-	virtual Term* Clone() override;
+	static void InitInstanceState(const TermInstruction& instruction_, TermInstanceState& state_);
+	static void Run(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_, float deltaSeconds_);
 
+	static TermType StringToTermType(const std::string& type_);
+	static TermMovementType StringToMovementType(const std::string& type_);
 
 private:
 
+	static void Start(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_, float deltaSeconds_);
+	static void Tick(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_, float deltaSeconds_);
+	static void End(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_);
 
+	// Per type work, called from Start and Tick;
+	static void StartMovement(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_);
+	static void TickMovement(const TermInstruction& instruction_, TermInstanceState& state_, Ability& ability_);
+	static void TickDisspell(Ability& ability_);
+	static bool Roll(float percentChance_);
 };
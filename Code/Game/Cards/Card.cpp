@@ -11,6 +11,7 @@
 // ------------------------------------------------------------------
 #include "Game/Framework/App.hpp"
 #include "Game/Framework/Interface.hpp"
+#include "Game/Framework/RenderLayers.hpp"
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Gameplay/Map.hpp"
 #include "Game/Cards/Cards.hpp"
@@ -77,7 +78,6 @@ void Card::PurchaseUpdate(float deltaSeconds_)
 // ------------------------------------------------------------------
 void Card::PurchaseRender()
 {
-	std::vector<Vertex_PCU> cardVerts;
 	Vec2 dimensions;
 	Vec2 centerSlot;
 	switch (m_cardArea)
@@ -109,29 +109,28 @@ void Card::PurchaseRender()
 	}
 
 	
+	// The card being dragged draws over the rest;
+	bool isFloating = (m_cardArea == CardArea::FLOATING);
+	RenderLayer cardLayer = isFloating ? RENDER_LAYER_FLOATING_CARD : RENDER_LAYER_CARDS;
+	RenderLayer iconLayer = isFloating ? RENDER_LAYER_FLOATING_CARD_ICONS : RENDER_LAYER_CARD_ICONS;
+	SpriteBatch& spriteBatch = g_theRenderer->GetSpriteBatch();
+
 	AABB2 box = AABB2(centerSlot, dimensions / 2);
-	AddVertsForAABB2D(cardVerts, box, Rgba::WHITE);
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_cardDefinition->m_cardTexture));
-	g_theRenderer->DrawVertexArray((int)cardVerts.size(), &cardVerts[0]);
+	spriteBatch.AddQuad(GameSpriteKey(cardLayer, m_cardDefinition->m_cardTextureHandle), box, Rgba::WHITE);
 
-	std::vector<Vertex_PCU> jobVerts;
 	float height = box.maxs.y - box.mins.y;
 	float width = box.maxs.x - box.mins.x;
 	Vec2 start = Vec2(box.mins.x + (width * 0.15f), box.mins.y + (height * 0.70f));
 	Vec2 end = Vec2(box.maxs.x - (width * 0.15f), box.maxs.y - (height * 0.15f));
 	AABB2 box2 = AABB2::MakeFromMinsMaxs(start, end);
 	m_currentSpriteDefinition.GetUVs(m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
-	AddVertsForAABB2D(jobVerts, box2, Rgba::WHITE, m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_cardDefinition->m_jobTexture));
-	g_theRenderer->DrawVertexArray((int)jobVerts.size(), &jobVerts[0]);
+	spriteBatch.AddQuad(GameSpriteKey(iconLayer, m_cardDefinition->m_jobTextureHandle), box2, Rgba::WHITE, m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
 
 	if(g_Interface->client().IsMarketplaceLocked() && m_cardArea == CardArea::MARKET)
 	{
-		std::vector<Vertex_PCU> lockVerts;
 		AABB2 box3 = AABB2(box2.center, 2.0f);
-		AddVertsForAABB2D(lockVerts, box3, Rgba::WHITE);
-		g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Lock.png"));
-		g_theRenderer->DrawVertexArray((int)lockVerts.size(), &lockVerts[0]);
+		// Market cards never float, so the floating icon layer is free to put the lock over the job icon;
+		static const TextureHandle s_lockTexture = g_theRenderer->AcquireTextureView("Data/Sprites/Lock.png");
+		spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_FLOATING_CARD_ICONS, s_lockTexture), box3, Rgba::WHITE);
 	}
 }
@@ -37,6 +37,7 @@ public:
 	int m_playerID = -1;
 	int m_slotID = -1;
 	unsigned int m_cardID = 0;
+	int m_zoneIndex = -1;						// Spot in its CardZones bucket, -1 when not tracked;
 
 	CardArea m_cardArea = CardArea::INVALID;
 
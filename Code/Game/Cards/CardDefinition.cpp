@@ -2,6 +2,7 @@
 
 // ------------------------------------------------------------------
 #include "Engine/Core/RandomNumberGenerator.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
 
 // ------------------------------------------------------------------
 std::map<CardType, CardDefinition*> CardDefinition::s_cardDefinitions;
@@ -18,6 +19,9 @@ CardDefinition::CardDefinition(XmlElement* cardElement_)
 	m_speed =			ParseXmlAttribute(*cardElement_, "speed", 0);
 	m_cardTexture =		ParseXmlAttribute(*cardElement_, "cardTexture", "");
 	m_jobTexture =		ParseXmlAttribute(*cardElement_, "jobTexture", "");
+
+	m_cardTextureHandle =	g_theRenderer->AcquireTextureView(m_cardTexture);
+	m_jobTextureHandle =	g_theRenderer->AcquireTextureView(m_jobTexture);
 }
 
 // ------------------------------------------------------------------
@@ -36,7 +40,7 @@ CardDefinition::~CardDefinition()
 void CardDefinition::LoadCardsFromXML(const char* filename_)
 {
 	tinyxml2::XMLDocument cardXMLDoc;
-	cardXMLDoc.LoadFile(filename_);
+	LoadXmlDocument(cardXMLDoc, filename_);
 
 	if (cardXMLDoc.ErrorID() != tinyxml2::XML_SUCCESS)
 	{
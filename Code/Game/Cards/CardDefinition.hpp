@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Renderer/ResourceRegistry.hpp"
 
 #include <map>
 #include <vector>
@@ -77,6 +78,8 @@ public:
 	int m_speed = 0;
 	std::string m_cardTexture = "";
 	std::string m_jobTexture = "";
+	TextureHandle m_cardTextureHandle;
+	TextureHandle m_jobTextureHandle;
 
 	// Static Map to hold Card Definitions;
 	static std::map<CardType, CardDefinition*> s_cardDefinitions;
@@ -0,0 +1,106 @@
+#include "Game/Cards/CardZones.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/RandomNumberGenerator.hpp"
+
+// ----------------------------------------------------------------------------
+void CardZones::Add(Card* card_)
+{
+	GUARANTEE_OR_DIE(card_->m_zoneIndex == -1, "Tried to add a card to the card zones twice.");
+
+	Cards& zone = GetOrCreateZone(card_->m_playerID, card_->m_cardArea);
+	card_->m_zoneIndex = (int)zone.size();
+	zone.push_back(card_);
+}
+
+// ----------------------------------------------------------------------------
+void CardZones::Remove(Card* card_)
+{
+	GUARANTEE_OR_DIE(card_->m_zoneIndex != -1, "Tried to remove a card that is not in the card zones.");
+
+	// Swap the last card of the zone into our spot;
+	Cards& zone = GetOrCreateZone(card_->m_playerID, card_->m_cardArea);
+	Card* lastCard = zone.back();
+	zone[card_->m_zoneIndex] = lastCard;
+	lastCard->m_zoneIndex = card_->m_zoneIndex;
+	zone.pop_back();
+
+	card_->m_zoneIndex = -1;
+}
+
+// ----------------------------------------------------------------------------
+void CardZones::Move(Card* card_, CardArea cardArea_, int playerID_)
+{
+	Remove(card_);
+
+	card_->m_cardArea = cardArea_;
+	card_->m_playerID = playerID_;
+
+	Add(card_);
+}
+
+// ----------------------------------------------------------------------------
+void CardZones::Clear()
+{
+	for (Cards& zone : m_zones)
+	{
+		for (Card* card : zone)
+		{
+			card->m_zoneIndex = -1;
+		}
+		zone.clear();
+	}
+}
+
+// ----------------------------------------------------------------------------
+const Cards& CardZones::GetCards(int playerID_, CardArea cardArea_) const
+{
+	static const Cards s_emptyZone;
+
+	int zoneIndex = GetZoneIndex(playerID_, cardArea_);
+	if (zoneIndex >= (int)m_zones.size())
+	{
+		return s_emptyZone;
+	}
+
+	return m_zones[zoneIndex];
+}
+
+// ----------------------------------------------------------------------------
+int CardZones::GetCardCount(int playerID_, CardArea cardArea_) const
+{
+	return (int)GetCards(playerID_, cardArea_).size();
+}
+
+// ----------------------------------------------------------------------------
+Card* CardZones::GetRandomCard(int playerID_, CardArea cardArea_) const
+{
+	const Cards& zone = GetCards(playerID_, cardArea_);
+	if (zone.empty())
+	{
+		return nullptr;
+	}
+
+	return zone[g_theRandomNumberGenerator->GetRandomIntInRange(0, (int)zone.size() - 1)];
+}
+
+// ----------------------------------------------------------------------------
+int CardZones::GetZoneIndex(int playerID_, CardArea cardArea_) const
+{
+	GUARANTEE_OR_DIE(playerID_ >= UNOWNED_PLAYER_ID, "Card zones were asked for a negative player ID.");
+	GUARANTEE_OR_DIE(cardArea_ > CardArea::INVALID && cardArea_ < CardArea::CARDAREA_COUNT, "Card zones were asked for an invalid card area.");
+
+	return ((playerID_ - UNOWNED_PLAYER_ID) * (int)CardArea::CARDAREA_COUNT) + (int)cardArea_;
+}
+
+// ----------------------------------------------------------------------------
+Cards& CardZones::GetOrCreateZone(int playerID_, CardArea cardArea_)
+{
+	int zoneIndex = GetZoneIndex(playerID_, cardArea_);
+	if (zoneIndex >= (int)m_zones.size())
+	{
+		m_zones.resize(zoneIndex + 1);
+	}
+
+	return m_zones[zoneIndex];
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Game/Cards/Cards.hpp"
+
+#include <deque>
+
+
+// ----------------------------------------------------------------------------
+// Keeps the shared cards bucketed by owner and CardArea, so finding the deck, a market or a hand
+// doesn't mean filtering every card in the game; Each card remembers its spot in its bucket (m_zoneIndex)
+// so moving it between zones is a swap-remove and a push_back;
+// Cards tracked here must change m_playerID and m_cardArea through Move, or the buckets go stale;
+// ----------------------------------------------------------------------------
+class CardZones
+{
+
+public:
+
+	static constexpr int UNOWNED_PLAYER_ID = -1;
+
+	CardZones() = default;
+	~CardZones() = default;
+
+	void Add(Card* card_);
+	void Remove(Card* card_);
+	void Move(Card* card_, CardArea cardArea_, int playerID_);
+	void Clear();
+
+	// An empty Cards is returned for zones that have never held a card;
+	const Cards& GetCards(int playerID_, CardArea cardArea_) const;
+	int GetCardCount(int playerID_, CardArea cardArea_) const;
+	Card* GetRandomCard(int playerID_, CardArea cardArea_) const;
+
+private:
+
+	int GetZoneIndex(int playerID_, CardArea cardArea_) const;
+	Cards& GetOrCreateZone(int playerID_, CardArea cardArea_);
+
+private:
+
+	// Zones are laid out per player (unowned first), CARDAREA_COUNT zones each;
+	// A deque so growing it never moves a zone someone is holding on to;
+	std::deque<Cards> m_zones;
+};
@@ -14,7 +14,7 @@ public:
 	explicit Cards(const std::vector<Card*>& cards_);
 
 	// Easy accessor;
-	std::vector<Card*> operator()()						{ return m_cards; }
+	const std::vector<Card*>& operator()() const		{ return m_cards; }
 
 	// Common functions found in std::vector implementations;
 	std::vector<Card*>::iterator begin()				{ return m_cards.begin(); }
@@ -22,6 +22,7 @@ public:
 	std::vector<Card*>::const_iterator begin() const	{ return m_cards.begin(); }
 	std::vector<Card*>::const_iterator end() const		{ return m_cards.end(); }
 	Card*& operator[](std::size_t i)					{ return m_cards[i]; }
+	Card* operator[](std::size_t i) const				{ return m_cards[i]; }
 	Card* front()										{ return m_cards.front(); }
 	Card* back()										{ return m_cards.back(); }
 	std::size_t size() const							{ return m_cards.size(); }
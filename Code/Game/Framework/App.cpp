@@ -2,6 +2,7 @@
 #define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
 #include <winsock2.h>
 #include <windows.h>			// #include this (massive, platform-specific) header in very few places
+#include <string.h>
 
 // Commons ----------------------------------------------------------------------------------------
 #include "Game/Framework/GameCommon.hpp"
@@ -12,8 +13,15 @@
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/RandomNumberGenerator.hpp"
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/PackArchive.hpp"
 #include "Engine/Core/Time.hpp"
 #include "Engine/Input/InputSystem.hpp"
+#include "Engine/Job/Jobs.hpp"
+#include "Engine/Job/AssetLoader.hpp"
+#include "Engine/Profile/Profile.hpp"
+#include "Engine/Log/Log.hpp"
+#include "Engine/Memory/Memory.hpp"
+#include "Engine/Memory/ArenaAllocator.hpp"
 
 
 // Game Includes ----------------------------------------------------------------------------------
@@ -29,6 +37,9 @@
 // Global Singletons ------------------------------------------------------------------------------
 App* g_theApp = nullptr;
 
+// Main thread time per frame for texture and mesh uploads, the decoding happens on the workers;
+constexpr uint ASSET_UPLOAD_BUDGET_MS = 4;
+
 // Constructor ------------------------------------------------------------------------------------
 App::App()
 {
@@ -41,9 +52,33 @@ App::~App()
 
 }
 
+// ------------------------------------------------------------------------------------------------
+static bool HasCommandLineSwitch(const char* commandLine_, const char* switch_)
+{
+	size_t switchLength = strlen(switch_);
+	for (const char* found = strstr(commandLine_, switch_); found != nullptr; found = strstr(found + 1, switch_))
+	{
+		bool startsWord = (found == commandLine_) || (found[-1] == ' ');
+		bool endsWord = (found[switchLength] == '\0') || (found[switchLength] == ' ');
+		if (startsWord && endsWord)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 // Init -------------------------------------------------------------------------------------------
-void App::Init()
+void App::Init( const char* commandLine_ )
 {
+	m_isDedicatedServer = HasCommandLineSwitch(commandLine_, "-server");
+	bool isBinaryLog = m_isDedicatedServer || HasCommandLineSwitch(commandLine_, "-binarylog");
+
+	// Mounted first so every load after this can come from it; without a Data.pack it stays closed and files load loose;
+	g_thePackArchive			= new PackArchive();
+	g_thePackArchive->Open(DATA_PACK_PATH);
+
 	// Create Systems;
 	g_theInputSystem			= new InputSystem();
 	g_theGameInput				= new GameInput();
@@ -51,11 +86,27 @@ void App::Init()
 	g_theDevConsole				= new DevConsole();
 	g_theRandomNumberGenerator	= new RandomNumberGenerator((unsigned int)time(0));
 	g_theEventSystem			= new EventSystem();
+	g_theJobSystem				= new JobSystem();
+	g_theAssetLoader			= new AssetLoader();
 	m_theGame					= new Game();
 	g_Interface					= new Interface(m_theGame);
 
 	g_theRakNetInterface		= new RakNetInterface();
 
+	// Scopes are cheap enough to stay on in every build, the Trees are only built when someone asks;
+	ProfilerSystemInit();
+	// The server logs every match, binary keeps the log thread from formatting them;
+	if (isBinaryLog)
+	{
+		LogSystemInit(LOG_BINARY_FILE_PATH, LOG_DEFAULT_MEMORY_MB, LOG_FILE_BINARY);
+	}
+	else
+	{
+		LogSystemInit(LOG_FILE_PATH);
+	}
+	MemTrackSystemInit();
+	ArenaSystemInit();
+
 	// Init Systems;
 	g_theRenderer->Init();
 	g_Interface->Init();
@@ -72,10 +123,16 @@ void App::Startup()
 	g_theAudioSystem->Startup();
 	g_theDevConsole->Startup();
 	g_theEventSystem->Startup();
+	g_theJobSystem->Startup();
 	g_Interface->Startup();
 	m_theGame->Startup();
 	g_theRakNetInterface->Startup();
 
+	if (m_isDedicatedServer)
+	{
+		g_theEventSystem->FireEvent("create_server");
+	}
+
 	m_devConsoleFont = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
 
 	m_intialStartupDone = true;
@@ -84,15 +141,27 @@ void App::Startup()
 // -----------------------------------------------------------------------
 void App::RunFrame()
 {
+	ProfilerUpdate();
+	ProfileBeginFrame("Frame");
+
 	BeginFrame();
 	Update();
 	Render();
 	EndFrame();
+
+	ProfileEndFrame();
 }
 
 // -----------------------------------------------------------------------
 void App::Shutdown()
 {
+	// Waits on the loads in flight, which needs the JobSystem running;
+	DELETE_POINTER(g_theAssetLoader);
+
+	// Everything that records scopes is joined first, the Job workers and the log thread;
+	g_theJobSystem->Shutdown();
+	LogSystemShutdown();
+	ProfilerSystemDeinit();
 	g_theEventSystem->Shutdown();
 	g_theDevConsole->Shutdown();
 	g_theAudioSystem->Shutdown();
@@ -102,6 +171,7 @@ void App::Shutdown()
 
 	DELETE_POINTER(m_theGame);
 	DELETE_POINTER(g_Interface);
+	DELETE_POINTER(g_theJobSystem);
 	DELETE_POINTER(g_theEventSystem);
 	DELETE_POINTER(g_theDevConsole);
 	DELETE_POINTER(g_theRandomNumberGenerator);
@@ -110,6 +180,7 @@ void App::Shutdown()
 	DELETE_POINTER(g_theGameInput);
 	DELETE_POINTER(g_theInputSystem);
 	DELETE_POINTER(g_theRakNetInterface);
+	DELETE_POINTER(g_thePackArchive);
 }
 
 // -----------------------------------------------------------------------
@@ -125,18 +196,28 @@ void App::CalculateDeltaSeconds()
 // -----------------------------------------------------------------------
 void App::BeginFrame()
 {
+	PROFILE_FUNCTION();
+
 	g_theWindowContext->BeginFrame();
 	g_theAudioSystem->BeginFrame();
 	g_theInputSystem->BeginFrame();
 	g_theDevConsole->BeginFrame();
 	g_theRenderer->BeginFrame();
 
+	// Finished Jobs report back on the main thread;
+	while(g_theJobSystem->ProcessFinishCallbacksForJobCategory(JOBCATEGORY_GENERIC));
+
+	// Starts queued asset loads and uploads the ones that are decoded;
+	g_theAssetLoader->Update(ASSET_UPLOAD_BUDGET_MS);
+
 	m_theGame->BeginFrame();
 }
 
 // -----------------------------------------------------------------------
 void App::Update()
 {
+	PROFILE_FUNCTION();
+
 	CalculateDeltaSeconds();
 
 	if (m_isFirstFrame)
@@ -161,6 +242,8 @@ void App::Update()
 // -----------------------------------------------------------------------
 void App::Render()
 {
+	PROFILE_FUNCTION();
+
 	m_theGame->Render();
 
 	if (m_isFirstFrame)
@@ -174,6 +257,8 @@ void App::Render()
 // -----------------------------------------------------------------------
 void App::EndFrame()
 {
+	PROFILE_FUNCTION();
+
 	m_theGame->EndFrame();
 	g_theGameInput->EndFrame();
 	g_theInputSystem->EndFrame();
@@ -15,7 +15,7 @@ public:
 	~App();
 	
 	// Game Flow
-	void Init();
+	void Init( const char* commandLine_ = "" );
 	void Startup();
 	void RunFrame();
 	void BeginFrame();
@@ -43,6 +43,9 @@ public:
 	bool m_intialStartupDone	= false;
 
 	bool m_isQuitting			= false;
+
+	// -server creates the server on Startup and logs in binary, -binarylog logs in binary without it;
+	bool m_isDedicatedServer	= false;
 	
 	double m_timeLastFrameBegan = 0.0f;
 	double m_timeNow			= 0.0f;
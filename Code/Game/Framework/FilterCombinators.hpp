@@ -0,0 +1,82 @@
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+
+// ----------------------------------------------------------------------------
+// Compile-time filter combinators for the templated Query functions;
+// Any filter struct (IsUnitNotDead, CardInHand, IsAIPlayer...) can be combined, the whole tree is one type
+// so it is evaluated inline with no std::function or std::vector behind it;
+// e.g. query().CountCards(FilterAnd(CardBelongsToPlayerID(playerID), CardInHand()));
+// ----------------------------------------------------------------------------
+template <typename ...FILTERS>
+struct AndFilter
+{
+	explicit AndFilter(FILTERS... filters_) : m_filters(std::move(filters_)...) {}
+
+	template <typename T>
+	bool operator()(const T* object_) const
+	{
+		return std::apply([object_](const FILTERS&... filters_) { return (filters_(object_) && ...); }, m_filters);
+	}
+
+private:
+
+	std::tuple<FILTERS...> m_filters;
+};
+
+// ----------------------------------------------------------------------------
+template <typename ...FILTERS>
+struct OrFilter
+{
+	explicit OrFilter(FILTERS... filters_) : m_filters(std::move(filters_)...) {}
+
+	template <typename T>
+	bool operator()(const T* object_) const
+	{
+		return std::apply([object_](const FILTERS&... filters_) { return (filters_(object_) || ...); }, m_filters);
+	}
+
+private:
+
+	std::tuple<FILTERS...> m_filters;
+};
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+struct NotFilter
+{
+	explicit NotFilter(FILTER filter_) : m_filter(std::move(filter_)) {}
+
+	template <typename T>
+	bool operator()(const T* object_) const
+	{
+		return !m_filter(object_);
+	}
+
+private:
+
+	FILTER m_filter;
+};
+
+// ----------------------------------------------------------------------------
+template <typename ...FILTERS>
+AndFilter<FILTERS...> FilterAnd(FILTERS... filters_)
+{
+	return AndFilter<FILTERS...>(std::move(filters_)...);
+}
+
+// ----------------------------------------------------------------------------
+template <typename ...FILTERS>
+OrFilter<FILTERS...> FilterOr(FILTERS... filters_)
+{
+	return OrFilter<FILTERS...>(std::move(filters_)...);
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+NotFilter<FILTER> FilterNot(FILTER filter_)
+{
+	return NotFilter<FILTER>(std::move(filter_));
+}
@@ -11,6 +11,11 @@ constexpr float ASPECTED_WORLD_HEIGHT = ASPECT * WORLD_HEIGHT;
 constexpr float WORLD_CENTER_X = WORLD_WIDTH / 2.f;
 constexpr float WORLD_CENTER_Y = WORLD_HEIGHT / 2.f;
 
+// Data
+constexpr const char* DATA_PACK_PATH = "Data.pack";		// Mounted over the loose Data folder when present;
+constexpr const char* LOG_FILE_PATH = "Data/Log/logfile.txt";
+constexpr const char* LOG_BINARY_FILE_PATH = "Data/Log/logfile.binary";		// log_decode turns it into text;
+
 // Camera
 constexpr float CAMERA_SHAKE_REDUCTION_PER_SECOND = 1.0f;
 constexpr float CAMERA_SHAKE_MAX = 2.0f;
@@ -10,6 +10,10 @@
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Job/Jobs.hpp"
+#include "Engine/Job/AssetLoader.hpp"
+#include "Engine/Memory/Memory.hpp"
+#include "Engine/Log/Log.hpp"
 
 // ----------------------------------------------------------------------------
 #include "Game/Framework/App.hpp"
@@ -21,15 +25,25 @@
 #include "Game/Gameplay/PlayerFilters.hpp"
 #include "Game/Cards/CardDefinition.hpp"
 #include "Game/Ability/Ability.hpp"
+#include "Game/Gameplay/BattleSimulationJob.hpp"
 
 // Third Party Includes ----------------------------------------------------------------------------
 #include "ThirdParty/RakNet/RakNetInterface.hpp"
 
 #include <ctime>
+#include <thread>
 
 // ----------------------------------------------------------------------------
 Interface* g_Interface = nullptr;
 
+// Only CreateUnit, CreateEnemyUnit and CreateCard are tagged: pool chunks and what the constructors allocate count against these, see mem_tags;
+// What a Unit or Card allocates later, abilities added in battle and such, counts against whatever tag is active then;
+static const uint s_memTagUnits = MemTagRegister("Units");
+static const uint s_memTagCards = MemTagRegister("Cards");
+
+// Set in handles into m_enemyUnitPool, so GetUnit knows which pool to look in;
+static constexpr uint32_t ENEMY_UNIT_HANDLE_BIT = 0x80000000;
+
 // ----------------------------------------------------------------------------
 // Action;
 // ----------------------------------------------------------------------------
@@ -103,66 +117,40 @@ void Match::Render()
 }
 
 // ----------------------------------------------------------------------------
-void Match::CreateSpriteSheets()
+// The sheet is usable right away, its texture is set once the AssetLoader has it uploaded;
+static SpriteSheet* CreateStreamedSpriteSheet(const std::string& texturePath_, const IntVec2& spriteGridLayout_)
 {
-	TextureView* spriteTexture = nullptr;
+	SpriteSheet* spriteSheet = new SpriteSheet(nullptr, spriteGridLayout_);
+	g_theAssetLoader->RequestSpriteSheetTexture(spriteSheet, texturePath_, ASSET_PRIORITY_GAMEPLAY);
+	return spriteSheet;
+}
 
+// ----------------------------------------------------------------------------
+void Match::CreateSpriteSheets()
+{
 	// Let the match store the job icons for the cards;
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/JobIcons.png");
-	m_jobIcons = new SpriteSheet(spriteTexture, IntVec2((int)JobType::JOB_COUNT, 1));
+	m_jobIcons = CreateStreamedSpriteSheet("Data/Sprites/JobIcons.png", IntVec2((int)JobType::JOB_COUNT, 1));
 
 	// Let the match store each unit's sprite sheet;
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Knight.png");
-	m_unitSpriteSheets["Knight"] = new SpriteSheet(spriteTexture, IntVec2(3, 4));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Archer.png");
-	m_unitSpriteSheets["Archer"] = new SpriteSheet(spriteTexture, IntVec2(3, 4));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Warrior.png");
-	m_unitSpriteSheets["Warrior"] = new SpriteSheet(spriteTexture, IntVec2(3, 4));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Paladin.png");
-	m_unitSpriteSheets["Paladin"] = new SpriteSheet(spriteTexture, IntVec2(3, 4));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Dragoon.png");
-	m_unitSpriteSheets["Dragoon"] = new SpriteSheet(spriteTexture, IntVec2(3, 4));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Blackmage.png");
-	m_unitSpriteSheets["Blackmage"] = new SpriteSheet(spriteTexture, IntVec2(3, 4));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Whitemage.png");
-	m_unitSpriteSheets["Whitemage"] = new SpriteSheet(spriteTexture, IntVec2(3, 4));
+	m_unitSpriteSheets["Knight"] = CreateStreamedSpriteSheet("Data/Sprites/Knight.png", IntVec2(3, 4));
+	m_unitSpriteSheets["Archer"] = CreateStreamedSpriteSheet("Data/Sprites/Archer.png", IntVec2(3, 4));
+	m_unitSpriteSheets["Warrior"] = CreateStreamedSpriteSheet("Data/Sprites/Warrior.png", IntVec2(3, 4));
+	m_unitSpriteSheets["Paladin"] = CreateStreamedSpriteSheet("Data/Sprites/Paladin.png", IntVec2(3, 4));
+	m_unitSpriteSheets["Dragoon"] = CreateStreamedSpriteSheet("Data/Sprites/Dragoon.png", IntVec2(3, 4));
+	m_unitSpriteSheets["Blackmage"] = CreateStreamedSpriteSheet("Data/Sprites/Blackmage.png", IntVec2(3, 4));
+	m_unitSpriteSheets["Whitemage"] = CreateStreamedSpriteSheet("Data/Sprites/Whitemage.png", IntVec2(3, 4));
 
 	// Let the match store each ability's sprite sheet;
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Abilities/Fire.png");
-	m_abilitySpriteSheets["Fire"] = new SpriteSheet(spriteTexture, IntVec2(2, 1));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Abilities/Cure.png");
-	m_abilitySpriteSheets["Cure"] = new SpriteSheet(spriteTexture, IntVec2(2, 1));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Abilities/Burn.png");
-	m_abilitySpriteSheets["Burn"] = new SpriteSheet(spriteTexture, IntVec2(3, 2));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Abilities/Shimmer.png");
-	m_abilitySpriteSheets["Shimmer"] = new SpriteSheet(spriteTexture, IntVec2(3, 3));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Effects/PhysicalHit.png");
-	m_abilitySpriteSheets["PhysicalHit"] = new SpriteSheet(spriteTexture, IntVec2(4, 1));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/BuffEffects/EnrageBuff.png");
-	m_abilitySpriteSheets["EnrageBuff"] = new SpriteSheet(spriteTexture, IntVec2(2, 1));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/BuffEffects/Enrage.png");
-	m_abilitySpriteSheets["Enrage"] = new SpriteSheet(spriteTexture, IntVec2(1, 1));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Abilities/Bleed.png");
-	m_abilitySpriteSheets["Bleed"] = new SpriteSheet(spriteTexture, IntVec2(3, 2));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/BuffEffects/Shield.png");
-	m_abilitySpriteSheets["Shield"] = new SpriteSheet(spriteTexture, IntVec2(3, 2));
-
-	spriteTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/BuffEffects/ShieldProc.png");
-	m_abilitySpriteSheets["ShieldProc"] = new SpriteSheet(spriteTexture, IntVec2(3, 2));
+	m_abilitySpriteSheets["Fire"] = CreateStreamedSpriteSheet("Data/Sprites/Abilities/Fire.png", IntVec2(2, 1));
+	m_abilitySpriteSheets["Cure"] = CreateStreamedSpriteSheet("Data/Sprites/Abilities/Cure.png", IntVec2(2, 1));
+	m_abilitySpriteSheets["Burn"] = CreateStreamedSpriteSheet("Data/Sprites/Abilities/Burn.png", IntVec2(3, 2));
+	m_abilitySpriteSheets["Shimmer"] = CreateStreamedSpriteSheet("Data/Sprites/Abilities/Shimmer.png", IntVec2(3, 3));
+	m_abilitySpriteSheets["PhysicalHit"] = CreateStreamedSpriteSheet("Data/Sprites/Effects/PhysicalHit.png", IntVec2(4, 1));
+	m_abilitySpriteSheets["EnrageBuff"] = CreateStreamedSpriteSheet("Data/Sprites/BuffEffects/EnrageBuff.png", IntVec2(2, 1));
+	m_abilitySpriteSheets["Enrage"] = CreateStreamedSpriteSheet("Data/Sprites/BuffEffects/Enrage.png", IntVec2(1, 1));
+	m_abilitySpriteSheets["Bleed"] = CreateStreamedSpriteSheet("Data/Sprites/Abilities/Bleed.png", IntVec2(3, 2));
+	m_abilitySpriteSheets["Shield"] = CreateStreamedSpriteSheet("Data/Sprites/BuffEffects/Shield.png", IntVec2(3, 2));
+	m_abilitySpriteSheets["ShieldProc"] = CreateStreamedSpriteSheet("Data/Sprites/BuffEffects/ShieldProc.png", IntVec2(3, 2));
 }
 
 // ----------------------------------------------------------------------------
@@ -229,85 +217,92 @@ void Match::CreateCommunalDeck()
 	CardType cardType = CardType::BLACKMAGE;
 	for(int i = 0; i < blackmageCount; ++i)
 	{
-		card = new Card(cardType);
+		card = g_Interface->CreateCard(cardType);
 		card->m_playerID = -1;
 		card->m_slotID = -1;
 		card->m_cardID = g_Interface->GetCardIDAndIncrementCounter();
 		card->m_currentSpriteDefinition = m_jobIcons->GetSpriteDefinition((int)cardType);
 		card->m_cardArea = CardArea::DECK;
 		m_cards.push_back(card);
+		g_Interface->cardZones().Add(card);
 	}
 
 	cardType = CardType::ARCHER;
 	for (int i = 0; i < archerCount; ++i)
 	{
-		card = new Card(cardType);
+		card = g_Interface->CreateCard(cardType);
 		card->m_playerID = -1;
 		card->m_slotID = -1;
 		card->m_cardID = g_Interface->GetCardIDAndIncrementCounter();
 		card->m_currentSpriteDefinition = m_jobIcons->GetSpriteDefinition((int)cardType);
 		card->m_cardArea = CardArea::DECK;
 		m_cards.push_back(card);
+		g_Interface->cardZones().Add(card);
 	}
 
 	cardType = CardType::DRAGOON;
 	for (int i = 0; i < dragoonCount; ++i)
 	{
-		card = new Card(cardType);
+		card = g_Interface->CreateCard(cardType);
 		card->m_playerID = -1;
 		card->m_slotID = -1;
 		card->m_cardID = g_Interface->GetCardIDAndIncrementCounter();
 		card->m_currentSpriteDefinition = m_jobIcons->GetSpriteDefinition((int)cardType);
 		card->m_cardArea = CardArea::DECK;
 		m_cards.push_back(card);
+		g_Interface->cardZones().Add(card);
 	}
 
 	cardType = CardType::PALADIN;
 	for (int i = 0; i < paladinCount; ++i)
 	{
-		card = new Card(cardType);
+		card = g_Interface->CreateCard(cardType);
 		card->m_playerID = -1;
 		card->m_slotID = -1;
 		card->m_cardID = g_Interface->GetCardIDAndIncrementCounter();
 		card->m_currentSpriteDefinition = m_jobIcons->GetSpriteDefinition((int)cardType);
 		card->m_cardArea = CardArea::DECK;
 		m_cards.push_back(card);
+		g_Interface->cardZones().Add(card);
 	}
 
 	cardType = CardType::WHITEMAGE;
 	for (int i = 0; i < whitemageCount; ++i)
 	{
-		card = new Card(cardType);
+		card = g_Interface->CreateCard(cardType);
 		card->m_playerID = -1;
 		card->m_slotID = -1;
 		card->m_cardID = g_Interface->GetCardIDAndIncrementCounter();
 		card->m_currentSpriteDefinition = m_jobIcons->GetSpriteDefinition((int)cardType);
 		card->m_cardArea = CardArea::DECK;
 		m_cards.push_back(card);
+		g_Interface->cardZones().Add(card);
 	}
 
 	cardType = CardType::WARRIOR;
 	for (int i = 0; i < warriorCount; ++i)
 	{
-		card = new Card(cardType);
+		card = g_Interface->CreateCard(cardType);
 		card->m_playerID = -1;
 		card->m_slotID = -1;
 		card->m_cardID = g_Interface->GetCardIDAndIncrementCounter();
 		card->m_currentSpriteDefinition = m_jobIcons->GetSpriteDefinition((int)cardType);
 		card->m_cardArea = CardArea::DECK;
 		m_cards.push_back(card);
+		g_Interface->cardZones().Add(card);
 	}
 
 	cardType = CardType::KNIGHT;
 	for (int i = 0; i < knightCount; ++i)
 	{
-		card = new Card(cardType);
+		card = g_Interface->CreateCard(cardType);
 		card->m_playerID = -1;
 		card->m_slotID = -1;
 		card->m_cardID = g_Interface->GetCardIDAndIncrementCounter();
 		card->m_currentSpriteDefinition = m_jobIcons->GetSpriteDefinition((int)cardType);
 		card->m_cardArea = CardArea::DECK;
 		m_cards.push_back(card);
+		g_Interface->cardZones().Add(card);
 	}
 }
 
@@ -326,10 +321,12 @@ PurchaseMap*& Match::GetPurchaseMap()
 // ----------------------------------------------------------------------------
 // Query;
 // ----------------------------------------------------------------------------
-Query::Query(Units& units_, Cards& cards_, Players& players_)
+Query::Query(Units& units_, Cards& cards_, Players& players_, const ObjectPool<Unit>& unitPool_, const ObjectPool<Card>& cardPool_)
 	: m_units(units_)
 	, m_cards(cards_)
 	, m_players(players_)
+	, m_unitPool(unitPool_)
+	, m_cardPool(cardPool_)
 {
 }
 
@@ -338,13 +335,13 @@ int Query::GetUnitCount(const UnitFilter& filter_) const
 {
 	int count = 0;
 
-	for (Unit*& unit : m_units)
+	m_unitPool.ForEach([&](const Unit* unit_)
 	{
-		if (filter_(unit))
+		if (filter_(unit_))
 		{
 			count++;
 		}
-	}
+	});
 
 	return count;
 }
@@ -354,13 +351,13 @@ int Query::GetCardCount(int playerID_, const CardFilter& filter_) const
 {
 	int count = 0;
 
-	for (Card*& card : m_cards)
+	m_cardPool.ForEach([&](const Card* card_)
 	{
-		if (filter_(card) && card->m_playerID == playerID_)
+		if (filter_(card_) && card_->m_playerID == playerID_)
 		{
 			count++;
 		}
-	}
+	});
 
 	return count;
 }
@@ -370,13 +367,13 @@ int Query::GetCardCount(const CardFilter& filter_) const
 {
 	int count = 0;
 
-	for (Card* card : m_cards)
+	m_cardPool.ForEach([&](const Card* card_)
 	{
-		if (filter_(card))
+		if (filter_(card_))
 		{
 			count++;
 		}
-	}
+	});
 
 	return count;
 }
@@ -386,13 +383,13 @@ Units Query::GetUnits(const UnitFilter& filter_) const
 {
 	Units units;
 
-	for (Unit* unit : m_units)
+	m_unitPool.ForEach([&](Unit* unit_)
 	{
-		if (filter_(unit))
+		if (filter_(unit_))
 		{
-			units.push_back(unit);
+			units.push_back(unit_);
 		}
-	}
+	});
 
 	return units;
 }
@@ -508,13 +505,13 @@ Cards Query::GetCards(const CardFilter& filter_) const
 {
 	Cards cards;
 
-	for(Card*& card : m_cards)
+	m_cardPool.ForEach([&](Card* card_)
 	{
-		if (filter_(card))
+		if (filter_(card_))
 		{
-			cards.push_back(card);
+			cards.push_back(card_);
 		}
-	}
+	});
 
 	return cards;
 }
@@ -538,12 +535,10 @@ Cards Query::GetCards(Cards& cardsToFilter_, const CardFilter& filter_) const
 // ----------------------------------------------------------------------------
 Card* Query::GetCard(const CardFilter& filter_)
 {
-	for (int i = 0; i < (int)m_cards.size(); ++i)
+	Card* card = m_cardPool.FindIf(filter_);
+	if (card != nullptr)
 	{
-		if (filter_(m_cards[i]))
-		{
-			return m_cards[i];
-		}
+		return card;
 	}
 
 	ERROR_AND_DIE("Looked for a player with a bad filter.");
@@ -645,6 +640,19 @@ Server::~Server()
 	
 }
 
+// ----------------------------------------------------------------------------
+void Server::WaitForBattleSimulations()
+{
+	// Once the JobSystem has shut down every Job has run, and their callbacks are never made;
+	while (m_battleSimulationsRunning > 0 && g_theJobSystem != nullptr && g_theJobSystem->IsRunning())
+	{
+		if (!g_theJobSystem->ProcessFinishCallbacksForJobCategory(JOBCATEGORY_GENERIC))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
 // ----------------------------------------------------------------------------
 void Server::Update(float deltaSeconds_)
 {
@@ -673,8 +681,8 @@ void Server::Update(float deltaSeconds_)
 					g_theRakNetInterface->SendSwitchPhaseMessageToClients();
 				}
 
-				Players aiPlayers = g_Interface->query().GetPlayers(IsAIPlayer());
-				for(Player*& player : aiPlayers)
+				g_Interface->query().FilterPlayers(m_aiPlayersToUpdate, IsAIPlayer());
+				for(Player*& player : m_aiPlayersToUpdate)
 				{
 					player->Update(deltaSeconds_);
 				}
@@ -684,19 +692,16 @@ void Server::Update(float deltaSeconds_)
 
 			case Phase::BATTLE:
 			{
-				Players aiPlayers = g_Interface->query().GetPlayers(IsAIPlayer());
-				for (Player*& player : aiPlayers)
+				g_Interface->query().FilterPlayers(m_aiPlayersToUpdate, IsAIPlayer());
+				for (Player*& player : m_aiPlayersToUpdate)
 				{
 					player->Update(deltaSeconds_);
 				}
 
+				// Clients are only playing back their battle, the Server already resolved every match on the JobSystem;
 				bool allClientsBattlePhaseComplete = g_theRakNetInterface->CheckAllClientsBattlePhaseComplete();
-				if(allClientsBattlePhaseComplete)
+				if(allClientsBattlePhaseComplete && m_allMatchesReportedBack)
 				{
-
-					// If everyone has reported they are done with Battle Phase, verify we have all MatchReports;
-					GUARANTEE_OR_DIE(m_matchReports.size() == (m_matchCount * 2), "The count of Match Reports does not match the count of matches assigned.");
-
 					VerifyAndProcessEachMatchReport();
 					bool itsOver = CheckForWinnerAndLoser();
 					/*
@@ -1103,6 +1108,10 @@ void Server::SendYouLostTheGameMessageToPlayerID(int playerID_)
 // ----------------------------------------------------------------------------
 void Server::SwitchPhases()
 {
+	// Nothing may hold on to the last phase's arena, the reports were already processed;
+	PhaseVector<MatchReport>().swap(m_matchReports);
+	ArenaReset(ARENA_PHASE);
+
 	// Done when switching any phase;
 	m_allClientsSaidDoneWithPurchasePhase = false;
 	m_allClientsSaidDoneWithBattlePhase = false;
@@ -1124,7 +1133,6 @@ void Server::SwitchPhases()
 	else if (m_currentPhase == Phase::PURCHASE)
 	{
 		m_currentPhase = Phase::BATTLE;
-		m_matchReports.clear();
 		SendAllClientsPhaseInformationForBattlePhase();
 	}
 	else if (m_currentPhase == Phase::BATTLE)
@@ -1253,7 +1261,15 @@ void Server::SendAllClientsPhaseInformationForBattlePhase()
 
 		SendPlayerTheirSeedForRandomNumberGenrator(player1->GetPlayerID(), seed);
 		SendPlayerTheirSeedForRandomNumberGenrator(player2->GetPlayerID(), seed);
+
+		// The Server is authoritative on the outcome, resolve the match off the main thread;
+		player1GoesFirst
+			? StartBattleSimulationForMatch(i, player1, player1Units, player2, player2Units, seed)
+			: StartBattleSimulationForMatch(i, player2, player2Units, player1, player1Units, seed);
 	}
+
+	// Nothing to wait on if no matches were made;
+	m_allMatchesReportedBack = (m_battleSimulationsRunning == 0);
 }
 
 // ----------------------------------------------------------------------------
@@ -1302,78 +1318,64 @@ int Server::GetMaxMarketplaceCards()
 // ----------------------------------------------------------------------------
 void Server::RollAndSendMarketplaceCardsForClient(Player*& player_)
 {
-	// If we are rolling, more than likely we will need a fresh market;
-	int amountRequested = m_maxMarketplaceCards;
-
-	// Get the cards, if any, that are currently in the marketplace;
-	Cards rolledCardsForMarketPlace;
-	Cards currentMarketplaceCards = g_Interface->query().GetCards(CardMultiFilter(CardMultiFilter::Selector::AND,
-		{
-			CardBelongsToPlayerID(player_->GetPlayerID()),
-			CardInMarketplace()
-		}));
+	int playerID = player_->GetPlayerID();
+	CardZones& cardZones = g_Interface->cardZones();
 
 	// If the player has locked their marketplace, then they will only need to fill the empty spaces;
-	if(g_theRakNetInterface->m_clientList[player_->GetPlayerID()].m_marketplaceLocked)
+	if(g_theRakNetInterface->m_clientList[playerID].m_marketplaceLocked)
 	{
-		amountRequested = m_maxMarketplaceCards - (int)currentMarketplaceCards.size();
-
-		// Put our current cards into the rolledCardsForMarketPlace list that we will return;
-		for(Card* oldCard : currentMarketplaceCards)
+		for(Card* oldCard : cardZones.GetCards(playerID, CardArea::MARKET))
 		{
 			oldCard->m_slotID = -1;
-			rolledCardsForMarketPlace.push_back(oldCard);
 		}
 	}
-
-	// If the market is not locked, then the player will have those market cards put back in the deck;
-	if(!g_theRakNetInterface->m_clientList[player_->GetPlayerID()].m_marketplaceLocked)
+	else // If the market is not locked, then the player will have those market cards put back in the deck;
 	{
-		for(Card* mCard : currentMarketplaceCards)
-		{
-			mCard->m_playerID = -1;
-			mCard->m_slotID = -1;
-			mCard->m_cardArea = CardArea::DECK;
-		}
+		ClearMarketplaceCardsForClient(playerID);
 	}
 
+	DrawMarketplaceCardsForPlayerID(playerID);
+
+	// The player's market zone is now exactly the old cards (if locked) followed by the new ones;
+	SendCardTypesToPlayerIDForMarketplace(cardZones.GetCards(playerID, CardArea::MARKET), playerID);
+}
+
+// ----------------------------------------------------------------------------
+void Server::DrawMarketplaceCardsForPlayerID(int playerID_)
+{
+	CardZones& cardZones = g_Interface->cardZones();
+	int amountRequested = m_maxMarketplaceCards - cardZones.GetCardCount(playerID_, CardArea::MARKET);
+
 	// We will now pull out cards from the deck based on the amount needed;
 	for (int i = 0; i < amountRequested; ++i)
 	{
-		Cards availableCards = g_Interface->query().GetCards(CardMultiFilter(CardMultiFilter::Selector::AND,
-			{
-				CardBelongsToPlayerID(-1), // -1 means no one owns this card
-				CardInDeck()
-			}));
+		Card* choosenCard = cardZones.GetRandomCard(CardZones::UNOWNED_PLAYER_ID, CardArea::DECK);
+		if (!choosenCard)
+		{
+			break;
+		}
 
-		Card* choosenCard = availableCards.GetRandomCard();
-		choosenCard->m_playerID = player_->GetPlayerID();
-		choosenCard->m_cardArea = CardArea::MARKET;
-		rolledCardsForMarketPlace.push_back(choosenCard);
+		cardZones.Move(choosenCard, CardArea::MARKET, playerID_);
 	}
-
-	SendCardTypesToPlayerIDForMarketplace(rolledCardsForMarketPlace, player_->GetPlayerID());
 }
 
 // ----------------------------------------------------------------------------
 void Server::ClearMarketplaceCardsForClient(int playerID_)
 {
-	Cards marketCardsBelongingToPlayer = g_Interface->query().GetCards(CardMultiFilter(CardMultiFilter::Selector::AND,
-		{
-			CardBelongsToPlayerID(playerID_),
-			CardInMarketplace()
-		}));
+	CardZones& cardZones = g_Interface->cardZones();
+	const Cards& marketCardsBelongingToPlayer = cardZones.GetCards(playerID_, CardArea::MARKET);
 
-	for (Card* card : marketCardsBelongingToPlayer)
+	// Moving a card out shrinks the zone, so always take from the back;
+	while (!marketCardsBelongingToPlayer.empty())
 	{
-		card->m_playerID = -1;
+		Card* card = marketCardsBelongingToPlayer[marketCardsBelongingToPlayer.size() - 1];
 		card->m_slotID = -1;
-		card->m_cardArea = CardArea::DECK;
+		cardZones.Move(card, CardArea::DECK, CardZones::UNOWNED_PLAYER_ID);
 	}
 }
 
 // ----------------------------------------------------------------------------
-void Server::SendCardTypesToPlayerIDForMarketplace(Cards& rolledCardsForMarketPlace_, int playerID_)
+void Server::SendCardTypesToPlayerIDForMarketplace(const Cards& rolledCardsForMarketPlace_, int playerID_)
 {
 	RakNet::BitStream bsOut;
 	bsOut.Write((unsigned char)C_RECEIVECARDTYPESFORMARKETPLACE);
@@ -1394,89 +1396,46 @@ void Server::UpdateMarketplaceCardsBasedOnPurchaseByPlayer(unsigned int cardID_,
 	Card* card = g_Interface->query().GetCard(HasCardID(cardID_));
 	if (card)
 	{
-		card->m_cardArea = CardArea::HAND;
 		card->m_slotID = -1;
-		card->m_playerID = playerID_;
+		g_Interface->cardZones().Move(card, CardArea::HAND, playerID_);
 	}
 }
 
 // ----------------------------------------------------------------------------
 void Server::GetMarketplaceCardsForPlayerID(int playerID_)
 {
-	Cards marketplaceCardsForPlayer = g_Interface->query().GetCards(CardMultiFilter(CardMultiFilter::Selector::AND,
-		{
-			CardBelongsToPlayerID(playerID_),
-			CardInMarketplace()
-		}));
-
-	SendCardTypesToPlayerIDForMarketplace(marketplaceCardsForPlayer, playerID_);
+	SendCardTypesToPlayerIDForMarketplace(g_Interface->cardZones().GetCards(playerID_, CardArea::MARKET), playerID_);
 }
 
 // ----------------------------------------------------------------------------
 void Server::RollMarketplaceCardsForAIPlayer(Player*& player_)
 {
-	// Get the cards, if any, that are currently in the marketplace;
-	Cards rolledCardsForMarketPlace;
-	Cards currentMarketplaceCards = g_Interface->query().GetCards(CardMultiFilter(CardMultiFilter::Selector::AND,
-		{
-			CardBelongsToPlayerID(player_->GetPlayerID()),
-			CardInMarketplace()
-		}));
-
-	int amountRequested = m_maxMarketplaceCards - (int)currentMarketplaceCards.size();
+	int playerID = player_->GetPlayerID();
 
 	// If the player has locked their marketplace, then they will only need to fill the empty spaces;
 	if (player_->GetMarketplaceLocked())
 	{
-		// Put our current cards into the rolledCardsForMarketPlace list that we will return;
-		for (Card* oldCard : currentMarketplaceCards)
+		for (Card* oldCard : g_Interface->cardZones().GetCards(playerID, CardArea::MARKET))
 		{
 			oldCard->m_slotID = -1;
-			rolledCardsForMarketPlace.push_back(oldCard);
 		}
-
-		amountRequested = m_maxMarketplaceCards - (int)rolledCardsForMarketPlace.size();
 	}
 	else // If the market is not locked, then the player will have those market cards put back in the deck;
 	{
-		for (Card* mCard : currentMarketplaceCards)
-		{
-			mCard->m_playerID = -1;
-			mCard->m_slotID = -1;
-			mCard->m_cardArea = CardArea::DECK;
-		}
+		ClearMarketplaceCardsForClient(playerID);
 	}
 
-	// We will now pull out cards from the deck based on the amount needed;
-	for (int i = 0; i < amountRequested; ++i)
-	{
-		Cards availableCards = g_Interface->query().GetCards(CardMultiFilter(CardMultiFilter::Selector::AND,
-			{
-				CardBelongsToPlayerID(-1), // -1 means no one owns this card
-				CardInDeck()
-			}));
-
-		Card* choosenCard = availableCards.GetRandomCard();
-		choosenCard->m_playerID = player_->GetPlayerID();
-		choosenCard->m_cardArea = CardArea::MARKET;
-		rolledCardsForMarketPlace.push_back(choosenCard);
-	}
+	DrawMarketplaceCardsForPlayerID(playerID);
 }
 
 // ----------------------------------------------------------------------------
 void Server::GetAndSendCardsInHandForPlayerID(const int playerID_)
 {
-	Cards handCardsBelongingToPlayer = g_Interface->query().GetCards(CardMultiFilter(CardMultiFilter::Selector::AND,
-		{
-			CardBelongsToPlayerID(playerID_),
-			CardInHand()
-		}));
-
-	SendCardTypesToPlayerIDForHand(handCardsBelongingToPlayer, playerID_);
+	SendCardTypesToPlayerIDForHand(g_Interface->cardZones().GetCards(playerID_, CardArea::HAND), playerID_);
 }
 
 // ----------------------------------------------------------------------------
-void Server::SendCardTypesToPlayerIDForHand(Cards cardsInHand_, int playerID_)
+void Server::SendCardTypesToPlayerIDForHand(const Cards& cardsInHand_, int playerID_)
 {
 	RakNet::BitStream bsOut;
 	bsOut.Write((unsigned char)C_RECEIVECARDTYPESFORHAND);
@@ -1497,9 +1456,8 @@ void Server::RemoveCardFromSellingByPlayer(unsigned int cardID_)
 	Card* card = g_Interface->query().GetCard(HasCardID(cardID_));
 	if (card)
 	{
-		card->m_cardArea = CardArea::DECK;
 		card->m_slotID = -1;
-		card->m_playerID = -1;
+		g_Interface->cardZones().Move(card, CardArea::DECK, CardZones::UNOWNED_PLAYER_ID);
 	}
 }
 
@@ -1509,8 +1467,8 @@ void Server::RemoveCardFromPlacingUnitByPlayer(unsigned int cardID_)
 	Card* card = g_Interface->query().GetCard(HasCardID(cardID_));
 	if (card)
 	{
-		card->m_cardArea = CardArea::UNITFIELD;
 		card->m_slotID = -1;
+		g_Interface->cardZones().Move(card, CardArea::UNITFIELD, card->m_playerID);
 	}
 }
 
@@ -1577,7 +1535,7 @@ void Server::CreateNewUnitFromCardPlacedByPlayer(unsigned int cardID_, int unitS
 	if(card)
 	{
 		JobType jobType = (JobType)card->m_type;
-		Unit* unit = new Unit(jobType);
+		Unit* unit = g_Interface->CreateUnit(jobType);
 		unit->m_playerID = card->m_playerID;
 		unit->m_slotID = unitSlotID_;
 		unit->m_unitID = g_Interface->GetUnitIDAndIncrementCounter();
@@ -1589,12 +1547,101 @@ void Server::CreateNewUnitFromCardPlacedByPlayer(unsigned int cardID_, int unitS
 // ----------------------------------------------------------------------------
 void Server::GiveAllEntitiesMaxHealth()
 {
-	Units units;
+	g_Interface->ForEachUnit([](Unit* unit_)
+	{
+		unit_->m_health = unit_->m_unitDefinition->m_health;
+	});
+}
+
+// ----------------------------------------------------------------------------
+void Server::StartBattleSimulationForMatch(int matchID_, Player* firstPlayer_, Units& firstPlayerUnits_, Player* secondPlayer_, Units& secondPlayerUnits_, unsigned int seed_)
+{
+	BattleSimulationJob* battleSimulationJob = new BattleSimulationJob(matchID_, firstPlayer_->GetPlayerID(), secondPlayer_->GetPlayerID(), seed_);
+	battleSimulationJob->m_battleSimulator.AddUnits(BATTLE_SIDE_FIRST, firstPlayerUnits_);
+	battleSimulationJob->m_battleSimulator.AddUnits(BATTLE_SIDE_SECOND, secondPlayerUnits_);
+
+	// Finish callbacks are processed on the main thread;
+	battleSimulationJob->SetFinishCallback([this](Job* job_)
+	{
+		OnBattleSimulationComplete(static_cast<BattleSimulationJob*>(job_));
+	});
+
+	m_battleSimulationsRunning++;
+	m_allMatchesReportedBack = false;
+
+	g_theJobSystem->Run(battleSimulationJob);
+}
+
+// ----------------------------------------------------------------------------
+void Server::OnBattleSimulationComplete(BattleSimulationJob* battleSimulationJob_)
+{
+	const BattleResult& battleResult = battleSimulationJob_->m_battleResult;
+	int matchID = battleSimulationJob_->m_matchID;
+
+	// Once per match on the main thread, so these stay structured and are only formatted if someone reads the log;
+	LOG_STRUCTURED("server", "Match %i between players %i and %i finished in %i turns, side %i won by %i.", matchID,
+		battleSimulationJob_->m_firstPlayerID, battleSimulationJob_->m_secondPlayerID, battleResult.m_turnsTaken, battleResult.m_winningSide, battleResult.m_damageToLosingPlayer);
+
+	if (battleResult.m_hitTurnLimit)
+	{
+		LOG_STRUCTURED("battle", "Match %i hit the %i turn limit and was scored as a draw.", matchID, BattleSimulator::MAX_TURNS);
+	}
+
+	if (battleResult.m_effectsDropped > 0)
+	{
+		LOG_STRUCTURED("battle", "Match %i dropped %i effects from units already holding %i.", matchID, battleResult.m_effectsDropped, BattleUnit::MAX_EFFECTS);
+	}
+
+	switch (battleResult.m_winningSide)
+	{
+		case BATTLE_SIDE_FIRST:
+		{
+			CreateMatchReport(battleSimulationJob_->m_firstPlayerID, battleSimulationJob_->m_secondPlayerID, battleResult.m_damageToLosingPlayer, matchID);
+			break;
+		}
+
+		case BATTLE_SIDE_SECOND:
+		{
+			CreateMatchReport(battleSimulationJob_->m_secondPlayerID, battleSimulationJob_->m_firstPlayerID, battleResult.m_damageToLosingPlayer, matchID);
+			break;
+		}
+
+		default:
+		{
+			// Draw, nobody takes damage;
+			CreateMatchReport(battleSimulationJob_->m_firstPlayerID, battleSimulationJob_->m_secondPlayerID, 0, matchID, true);
+			break;
+		}
+	}
 
-	for (Unit* unit : m_units)
+	// Push the result to the human players of this match;
+	MatchReport& matchReport = m_matchReports.back();
+	int playerIDs[] = { battleSimulationJob_->m_firstPlayerID, battleSimulationJob_->m_secondPlayerID };
+	for (int playerID : playerIDs)
 	{
-		unit->m_health = unit->m_unitDefinition->m_health;
+		Player* player = g_Interface->query().GetPlayer(HasPlayerID(playerID));
+		if (player && !player->IsAIPlayer())
+		{
+			SendPlayerTheirMatchResult(playerID, matchReport);
+		}
 	}
+
+	m_battleSimulationsRunning--;
+	m_allMatchesReportedBack = (m_battleSimulationsRunning == 0);
+}
+
+// ----------------------------------------------------------------------------
+void Server::SendPlayerTheirMatchResult(int playerID_, MatchReport& matchReport_)
+{
+	RakNet::BitStream bsOut;
+	bsOut.Write((unsigned char)C_RECIEVEMATCHRESULTFORBATTLE);
+	bsOut.Write(matchReport_.GetWinningPlayerID());
+	bsOut.Write(matchReport_.GetLosingPlayerID());
+	bsOut.Write(matchReport_.GetDamageDealtToLosingPlayer());
+	bsOut.Write(matchReport_.GetMatchID());
+	bsOut.Write(matchReport_.GetIgnore());
+
+	g_theRakNetInterface->SendBitStreamToClient(&bsOut, playerID_);
 }
 
 // ----------------------------------------------------------------------------
@@ -1610,20 +1657,11 @@ void Server::VerifyAndProcessEachMatchReport()
 {
 	for(int matchID = 0; matchID < m_matchCount; ++matchID)
 	{
-		// Get the two match reports of each matchID; There should be 2 for now, until we deal with odd players;
-		std::vector<MatchReport> matchReportsOfMatchID = GetMatchReportsOfMatchID(matchID);
-		GUARANTEE_OR_DIE(matchReportsOfMatchID.size() == 2, "Verifying Match Reports and did not get a pair to verify against each other!");
+		// The Server's own battle simulation is the only report for each matchID;
+		FrameVector<MatchReport> matchReportsOfMatchID = GetMatchReportsOfMatchID(matchID);
+		GUARANTEE_OR_DIE(matchReportsOfMatchID.size() == 1, "Verifying Match Reports and did not get exactly one report for the match!");
 
-		// Compare the two, they should equal each other;
-		if(matchReportsOfMatchID[0] == matchReportsOfMatchID[1])
-		{
-			// If they equal each other, then Process Match Reports;
-			ProcessMatchReports(matchReportsOfMatchID);
-		}
-		else
-		{
-			ERROR_AND_DIE("Received Match Report of a matchID that did not match each other. This means two players disagree on what happened during their battle phase!");
-		}
+		ProcessMatchReports(matchReportsOfMatchID);
 	}
 }
 
@@ -1646,25 +1684,15 @@ bool Server::CheckForWinnerAndLoser()
 		}
 	}
 
-	Players alivePlayers = g_Interface->query().GetPlayers(PlayerMultiFilter(PlayerMultiFilter::Selector::AND,
-		{
-			IsPlayerAlive()
-		}));
-
-	if(alivePlayers.size() == 1)
+	if(g_Interface->query().CountPlayers(IsPlayerAlive()) == 1)
 	{
-		SendYouWinTheGameMessageToPlayerID(alivePlayers[0]->GetPlayerID());
+		Player* winningPlayer = g_Interface->query().FindPlayer(IsPlayerAlive());
+		SendYouWinTheGameMessageToPlayerID(winningPlayer->GetPlayerID());
 		KillConnectionWithAllClients();
 		return true;
 	}
 
-	Players aliveHumanPlayers = g_Interface->query().GetPlayers(PlayerMultiFilter(PlayerMultiFilter::Selector::AND,
-		{
-			IsPlayerAlive(),
-			IsHumanPlayer()
-		}));
-
-	if(aliveHumanPlayers.size() == 0)
+	if(g_Interface->query().CountPlayers(FilterAnd(IsPlayerAlive(), IsHumanPlayer())) == 0)
 	{
 		KillConnectionWithAllClients();
 		return true;
@@ -1674,16 +1702,12 @@ bool Server::CheckForWinnerAndLoser()
 }
 
 // ----------------------------------------------------------------------------
-void Server::ProcessMatchReports(std::vector<MatchReport>& matchReports)
+void Server::ProcessMatchReports(FrameVector<MatchReport>& matchReports)
 {
 	MatchReport& matchReport = matchReports[0];
 	if(matchReport.GetIgnore())
 	{
-		matchReport = matchReports[1];
-		if(matchReport.GetIgnore())
-		{
-			return;
-		}
+		return;
 	}
 
 	int losingPlayerID = matchReport.GetLosingPlayerID();
@@ -1707,11 +1731,11 @@ void Server::ProcessMatchReports(std::vector<MatchReport>& matchReports)
 }
 
 // ----------------------------------------------------------------------------
-std::vector<MatchReport> Server::GetMatchReportsOfMatchID(int matchID_)
+FrameVector<MatchReport> Server::GetMatchReportsOfMatchID(int matchID_)
 {
-	std::vector<MatchReport> matchReportsOfMatchID;
+	FrameVector<MatchReport> matchReportsOfMatchID;
 
-	for(MatchReport mr : m_matchReports)
+	for(const MatchReport& mr : m_matchReports)
 	{
 		if(mr.GetMatchID() == matchID_)
 		{
@@ -1745,10 +1769,10 @@ void Client::Update(float deltaSeconds_)
 			g_Interface->match().m_purchaseMap->Update(deltaSeconds_);
 
 			// For now, this is only unit animations during the Purchase Phase;
-			for (Unit* unit : m_units)
+			g_Interface->ForEachUnit([deltaSeconds_](Unit* unit_)
 			{
-				unit->PurchaseUpdate(deltaSeconds_);
-			}
+				unit_->PurchaseUpdate(deltaSeconds_);
+			});
 
 			break;
 		}
@@ -1759,28 +1783,25 @@ void Client::Update(float deltaSeconds_)
 			player->SetRandomNumberGeneratorSeed();
 
 			// Start, by getting an action unit, this is the unit starting their turn;
-			if(!m_actionUnit)
+			if(!g_Interface->GetUnit(m_actionUnit))
 			{
 				if (!CheckForWinnerOfBattlePhase())
 				{
+					g_Interface->query().FilterUnits(m_unitsGoingFirst, m_aliveUnitsGoingFirst, IsUnitNotDead());
+					g_Interface->query().FilterUnits(m_unitsGoingSecond, m_aliveUnitsGoingSecond, IsUnitNotDead());
+
 					if (m_isFirstPlayersTurn)
 					{
-						Units aliveUnitsGoingFirst = g_Interface->query().GetUnits(m_unitsGoingFirst, IsUnitNotDead());
-						Units aliveUnitsGoingSecond = g_Interface->query().GetUnits(m_unitsGoingSecond, IsUnitNotDead());
-
-						if (aliveUnitsGoingFirst.size() > 0)
+						if (m_aliveUnitsGoingFirst.size() > 0)
 						{
-							RunAttackSimulationOfAttackingVsDefending(aliveUnitsGoingFirst, aliveUnitsGoingSecond);
+							RunAttackSimulationOfAttackingVsDefending(m_aliveUnitsGoingFirst, m_aliveUnitsGoingSecond);
 						}
 					}
 					else
 					{
-						Units aliveUnitsGoingFirst = g_Interface->query().GetUnits(m_unitsGoingFirst, IsUnitNotDead());
-						Units aliveUnitsGoingSecond = g_Interface->query().GetUnits(m_unitsGoingSecond, IsUnitNotDead());
-
-						if (aliveUnitsGoingSecond.size() > 0)
+						if (m_aliveUnitsGoingSecond.size() > 0)
 						{
-							RunAttackSimulationOfAttackingVsDefending(aliveUnitsGoingSecond, aliveUnitsGoingFirst);
+							RunAttackSimulationOfAttackingVsDefending(m_aliveUnitsGoingSecond, m_aliveUnitsGoingFirst);
 						}
 					}
 				}
@@ -1792,18 +1813,19 @@ void Client::Update(float deltaSeconds_)
 			// If the action unit finished using all main abilities then their turn is over;
 			if(g_Interface->match().m_battleMap->m_actionTurnEnding)
 			{
-				if(m_actionUnit)
+				Unit* actionUnit = g_Interface->GetUnit(m_actionUnit);
+				if(actionUnit)
 				{
 					// This is the old actionUnit ending its action turn;
 					// We should create and start, do, end for each unit?
-					m_actionUnit->ResetStatusEffects();
-					m_actionUnit->ResetBuffEffects();
-					m_actionUnit->m_isMyTurnToDoAction = false;
-					m_actionUnit->m_dontDoStatusEffects = false;
-					m_actionUnit->m_dontDoBuffEffects = false;
-					m_actionUnit->m_dontDoDebuffEffects = false;
-					m_actionUnit = nullptr;
+					actionUnit->ResetStatusEffects();
+					actionUnit->ResetBuffEffects();
+					actionUnit->m_isMyTurnToDoAction = false;
+					actionUnit->m_dontDoStatusEffects = false;
+					actionUnit->m_dontDoBuffEffects = false;
+					actionUnit->m_dontDoDebuffEffects = false;
 				}
+				m_actionUnit = PoolHandle();
 			}
 
 			unsigned int newSeedPosition = g_theRandomNumberGenerator->GetCurrentPosition();
@@ -1913,19 +1935,20 @@ void Client::SwitchPhases()
 			GiveAllEntitiesMaxHealth();
 			m_messageSentToServerForPurchasePhaseComplete = false;
 			m_messageSentToServerForBattlePhaseComplete = false;
+			m_matchResultReceived = false;
 
 			int roll = g_theRandomNumberGenerator->GetRandomIntInRange(0, 2);
 			if (roll == 0)
 			{
-				g_Interface->match().m_battleMap->m_nameOfCurrentBattleBackground = "Data/Images/Backgrounds/PlainsBackground.png";
+				g_Interface->match().m_battleMap->SetBattleBackground("Data/Images/Backgrounds/PlainsBackground.png");
 			}
 			else if (roll == 1)
 			{
-				g_Interface->match().m_battleMap->m_nameOfCurrentBattleBackground = "Data/Images/Backgrounds/DesertBackground.png";
+				g_Interface->match().m_battleMap->SetBattleBackground("Data/Images/Backgrounds/DesertBackground.png");
 			}
 			else if (roll == 2)
 			{
-				g_Interface->match().m_battleMap->m_nameOfCurrentBattleBackground = "Data/Images/Backgrounds/DungeonBackground.png";
+				g_Interface->match().m_battleMap->SetBattleBackground("Data/Images/Backgrounds/DungeonBackground.png");
 			}
 
 			g_Interface->match().m_battleMap->StartTimer();
@@ -2031,7 +2054,8 @@ void Client::CleanupMarketplaceCards()
 	{
 		if ((*itr)->m_cardArea == CardArea::MARKET)
 		{
-			delete *itr;
+			g_Interface->cardZones().Remove(*itr);
+			g_Interface->DestroyCard(*itr);
 			itr = m_cards.erase(itr);
 
 		}
@@ -2078,15 +2102,15 @@ void Client::ToggleMarketplaceLock()
 void Client::CreateCardForMarketplace(CardType cardType_, unsigned int cardID_)
 {
 	Card* card = nullptr;
-	card = new Card(cardType_);
+	card = g_Interface->CreateCard(cardType_);
 	card->m_playerID = g_Interface->GetPlayer()->GetPlayerID();
 	card->m_cardID = cardID_;
 
-	Cards marketplaceCards = g_Interface->query().GetCards(CardInMarketplace());
-	card->m_slotID = (int)marketplaceCards.size();
+	card->m_slotID = g_Interface->cardZones().GetCardCount(card->m_playerID, CardArea::MARKET);
 	card->m_currentSpriteDefinition = g_Interface->match().m_jobIcons->GetSpriteDefinition((int)cardType_);
 	card->m_cardArea = CardArea::MARKET;
 	m_cards.push_back(card);
+	g_Interface->cardZones().Add(card);
 }
 
 // ----------------------------------------------------------------------------
@@ -2143,15 +2167,15 @@ void Client::SendUnitCreatedAtFromCardInHandToServer(unsigned int placeCardID_,
 void Client::CreateCardForHand(CardType cardType_, unsigned int cardID_)
 {
 	Card* card = nullptr;
-	card = new Card(cardType_);
+	card = g_Interface->CreateCard(cardType_);
 	card->m_playerID = g_Interface->GetPlayer()->GetPlayerID();
 	card->m_cardID = cardID_;
 
-	Cards handCards = g_Interface->query().GetCards(CardInHand());
-	card->m_slotID = (int)handCards.size();
+	card->m_slotID = g_Interface->cardZones().GetCardCount(card->m_playerID, CardArea::HAND);
 	card->m_currentSpriteDefinition = g_Interface->match().m_jobIcons->GetSpriteDefinition((int)cardType_);
 	card->m_cardArea = CardArea::HAND;
 	m_cards.push_back(card);
+	g_Interface->cardZones().Add(card);
 }
 
 // ----------------------------------------------------------------------------
@@ -2162,7 +2186,8 @@ void Client::CleanupHandCards()
 	{
 		if ((*itr)->m_cardArea == CardArea::HAND)
 		{
-			delete *itr;
+			g_Interface->cardZones().Remove(*itr);
+			g_Interface->DestroyCard(*itr);
 			itr = m_cards.erase(itr);
 
 		}
@@ -2177,7 +2202,7 @@ void Client::CleanupHandCards()
 void Client::CreateUnitForField(JobType jobType_, int unitID_, int slotID_)
 {
 	Unit* unit = nullptr;
-	unit = new Unit(jobType_);
+	unit = g_Interface->CreateUnit(jobType_);
 	unit->m_playerID = g_Interface->GetPlayer()->GetPlayerID();
 	unit->m_unitID = unitID_;
 	unit->m_slotID = slotID_;
@@ -2191,7 +2216,7 @@ void Client::CreateUnitForField(JobType jobType_, int unitID_, int slotID_)
 void Client::CreateEnemyUnitForEnemyField(JobType jobType_, int unitID_, int slotID_)
 {
 	Unit* unit = nullptr;
-	unit = new Unit(jobType_);
+	unit = g_Interface->CreateEnemyUnit(jobType_);
 	unit->m_playerID = g_Interface->GetEnemy()->GetPlayerID();
 	unit->m_unitID = unitID_;
 	unit->m_slotID = slotID_;
@@ -2207,7 +2232,7 @@ void Client::CleanupUnits()
 	// This will delete the client-side card from m_cards, NOT the server-side;
 	for (auto itr = m_units.begin(); itr != m_units.end(); ++itr)
 	{
-		delete *itr;
+		g_Interface->DestroyUnit(*itr);
 		*itr = nullptr;
 	}
 	m_units.clear();
@@ -2231,7 +2256,7 @@ void Client::CleanupEnemyUnits()
 	// This will delete the client-side card from m_cards, NOT the server-side;
 	for (auto itr = m_enemyUnits.begin(); itr != m_enemyUnits.end(); ++itr)
 	{
-		delete *itr;
+		g_Interface->DestroyUnit(*itr);
 		*itr = nullptr;
 	}
 	m_enemyUnits.clear();
@@ -2276,33 +2301,35 @@ void Client::RunAttackSimulationOfAttackingVsDefending(Units& attackingUnits, Un
 
 	g_Interface->match().GetBattleMap()->ResetActionTimer();
 
+	Unit* actionUnit = nullptr;
 	if (m_isFirstPlayersTurn)
 	{
-		m_actionUnit = attackingUnits.GetAliveUnitStartingAtIndex(m_firstPlayersAttackingUnitIndex);
+		actionUnit = attackingUnits.GetAliveUnitStartingAtIndex(m_firstPlayersAttackingUnitIndex);
 	}
 	else
 	{
-		m_actionUnit = attackingUnits.GetAliveUnitStartingAtIndex(m_secondPlayersAttackingUnitIndex);
+		actionUnit = attackingUnits.GetAliveUnitStartingAtIndex(m_secondPlayersAttackingUnitIndex);
 	}
+	m_actionUnit = g_Interface->GetUnitHandle(actionUnit);
 
-	GUARANTEE_OR_DIE(m_actionUnit->m_health != 0, "Picked a dead unit to do an action.");
+	GUARANTEE_OR_DIE(actionUnit->m_health != 0, "Picked a dead unit to do an action.");
 
 	// Starting the units action turn;
 	g_Interface->match().m_battleMap->m_actionTurnEnding = false;
-	m_actionUnit->m_isMyTurnToDoAction = true;
+	actionUnit->m_isMyTurnToDoAction = true;
 
 	// Our attacking unit will now use its main ability;
-	Ability* mainAbility = new Ability(m_actionUnit->m_unitDefinition->m_mainAbilityDefinition);
-	m_actionUnit->m_activeAbilities.push_back(mainAbility);
+	Ability* mainAbility = new Ability(actionUnit->m_unitDefinition->m_mainAbilityDefinition);
+	actionUnit->m_activeAbilities.push_back(mainAbility);
 	GUARANTEE_OR_DIE(mainAbility->m_lifetimeTotalTime > 0.0f, "Using an ability with no lifetime value.");
 	g_Interface->match().m_battleMap->m_actionTimer += mainAbility->m_lifetimeTotalTime;
 
-	AssignTargetAndCasterForMainAbility(mainAbility, m_actionUnit, attackingUnits, defendingUnits);
+	AssignTargetAndCasterForMainAbility(mainAbility, actionUnit, attackingUnits, defendingUnits);
 
 	float additionalTime = 0.2f;
 
 	//Status;
-	for (Ability*& status : m_actionUnit->m_activeStatusEffects)
+	for (Ability*& status : actionUnit->m_activeStatusEffects)
 	{
 		status->AddOffsetStartTimeToSequence(additionalTime);
 		additionalTime += (status->m_lifetimeTotalTime + 0.1f);
@@ -2310,7 +2337,7 @@ void Client::RunAttackSimulationOfAttackingVsDefending(Units& attackingUnits, Un
 	}
 
 	// Buff;
-	for(Ability*& buff : m_actionUnit->m_activeBuffs)
+	for(Ability*& buff : actionUnit->m_activeBuffs)
 	{
 		buff->AddOffsetStartTimeToSequence(additionalTime);
 		additionalTime += (buff->m_lifetimeTotalTime + 0.1f);
@@ -2318,7 +2345,7 @@ void Client::RunAttackSimulationOfAttackingVsDefending(Units& attackingUnits, Un
 	}
 
 	// Debuff;
-	for (Ability*& debuff : m_actionUnit->m_activeDebuffs)
+	for (Ability*& debuff : actionUnit->m_activeDebuffs)
 	{
 		debuff->AddOffsetStartTimeToSequence(additionalTime);
 		additionalTime += (debuff->m_lifetimeTotalTime + 0.1f);
@@ -2335,64 +2362,19 @@ void Client::RunAttackSimulationOfAttackingVsDefending(Units& attackingUnits, Un
 // ----------------------------------------------------------------------------
 bool Client::CheckForWinnerOfBattlePhase()
 {
-	Units unitsWhoWentFirst = g_Interface->query().GetUnits(m_unitsGoingFirst, IsUnitNotDead());
-	Units unitsWhoWentSeconds = g_Interface->query().GetUnits(m_unitsGoingSecond, IsUnitNotDead());
+	int aliveUnitsWhoWentFirst = g_Interface->query().CountUnits(m_unitsGoingFirst, IsUnitNotDead());
+	int aliveUnitsWhoWentSecond = g_Interface->query().CountUnits(m_unitsGoingSecond, IsUnitNotDead());
 
-	bool thereWasAWinner = false;
-	int damageDealtToLosingPlayer = 0;
-	int winningPlayerID = 0;
-	int losingPlayerID = 0;
-	Player*& player = g_Interface->GetPlayer();
-
-	if (unitsWhoWentFirst.size() == 0 && unitsWhoWentSeconds.size() == 0)
-	{
-		// Draw;
-		// I don't think this can happen yet. Maybe someday;
-	}
-	else if(unitsWhoWentFirst.size() == 0)
-	{
-		// Who ever went second won, figure out who that was;
-		if(player->GetGoesFirstForBattlePhase())
-		{
-			damageDealtToLosingPlayer = (int)unitsWhoWentSeconds.size();
-			winningPlayerID = g_Interface->GetEnemy()->GetPlayerID();
-			losingPlayerID = g_Interface->GetPlayer()->GetPlayerID();
-			g_theDevConsole->Print(Stringf("You lost, took [%d] damage!", damageDealtToLosingPlayer));
-		}
-		else // !m_goesFirst
-		{
-			damageDealtToLosingPlayer = (int)unitsWhoWentSeconds.size();
-			winningPlayerID = g_Interface->GetPlayer()->GetPlayerID();
-			losingPlayerID = g_Interface->GetEnemy()->GetPlayerID();
-			g_theDevConsole->Print(Stringf("You won, dealt [%d] damage!", damageDealtToLosingPlayer));
-		}
+	// The battle shown here is only playback, the Server resolves the match and pushes us the result;
+	bool thereWasAWinner = aliveUnitsWhoWentFirst == 0 || aliveUnitsWhoWentSecond == 0;
 
-		thereWasAWinner = true;
-	}
-	if (unitsWhoWentSeconds.size() == 0)
+	if(thereWasAWinner && !m_messageSentToServerForBattlePhaseComplete)
 	{
-		// Who ever went first won, figure out who that was;
-		if (player->GetGoesFirstForBattlePhase())
-		{
-			damageDealtToLosingPlayer = (int)unitsWhoWentFirst.size();
-			winningPlayerID = g_Interface->GetPlayer()->GetPlayerID();
-			losingPlayerID = g_Interface->GetEnemy()->GetPlayerID();
-			g_theDevConsole->Print(Stringf("You won, dealt [%d] damage!", damageDealtToLosingPlayer));
-		}
-		else // !m_goesFirst
+		if(m_matchResultReceived)
 		{
-			damageDealtToLosingPlayer = (int)unitsWhoWentFirst.size();
-			winningPlayerID = g_Interface->GetEnemy()->GetPlayerID();
-			losingPlayerID = g_Interface->GetPlayer()->GetPlayerID();
-			g_theDevConsole->Print(Stringf("You lost, took [%d] damage!", damageDealtToLosingPlayer));
+			PrintMatchResult();
 		}
 
-		thereWasAWinner = true;
-	}
-
-	if(thereWasAWinner && !m_messageSentToServerForBattlePhaseComplete)
-	{
-		SendMatchReportToServer(winningPlayerID, losingPlayerID, damageDealtToLosingPlayer, m_matchID);
 		SetMessageSentToServerForBattlePhaseComplete(true);
 		SendBattlePhaseCompleteToServer();
 	}
@@ -2401,16 +2383,33 @@ bool Client::CheckForWinnerOfBattlePhase()
 }
 
 // ----------------------------------------------------------------------------
-void Client::SendMatchReportToServer(int winningPlayerID_, int losingPlayerID_, int dmageDealtToLosingPlayer_, int matchID_)
+void Client::SetMatchResultForThisBattlePhase(const MatchReport& matchResult_)
 {
-	RakNet::BitStream bsOut;
-	bsOut.Write((unsigned char)S_WINNEROFMATCHBEINGREPORTED);
-	bsOut.Write(winningPlayerID_);
-	bsOut.Write(losingPlayerID_);
-	bsOut.Write(dmageDealtToLosingPlayer_);
-	bsOut.Write(matchID_);
+	m_matchResult = matchResult_;
+	m_matchResultReceived = true;
 
-	g_theRakNetInterface->SendBitStreamToServer(&bsOut);
+	// Playback already finished before the result arrived;
+	if(m_messageSentToServerForBattlePhaseComplete)
+	{
+		PrintMatchResult();
+	}
+}
+
+// ----------------------------------------------------------------------------
+void Client::PrintMatchResult()
+{
+	if(m_matchResult.GetIgnore())
+	{
+		g_theDevConsole->Print("Draw, nobody took damage!");
+	}
+	else if(m_matchResult.GetWinningPlayerID() == g_Interface->GetPlayer()->GetPlayerID())
+	{
+		g_theDevConsole->Print(Stringf("You won, dealt [%d] damage!", m_matchResult.GetDamageDealtToLosingPlayer()));
+	}
+	else
+	{
+		g_theDevConsole->Print(Stringf("You lost, took [%d] damage!", m_matchResult.GetDamageDealtToLosingPlayer()));
+	}
 }
 
 // ----------------------------------------------------------------------------
@@ -2562,7 +2561,7 @@ Interface::Interface(Game* game_)
 	: m_game(game_)
 	, m_action(m_units, m_cards)
 	, m_match(m_units, m_cards)
-	, m_query(m_units, m_cards, m_players)
+	, m_query(m_units, m_cards, m_players, m_unitPool, m_cardPool)
 	, m_debug(m_units, m_cards)
 	, m_server(m_units, m_cards, m_players)
 	, m_client(m_units, m_cards)
@@ -2572,15 +2571,11 @@ Interface::Interface(Game* game_)
 // ----------------------------------------------------------------------------
 Interface::~Interface()
 {
-	for (int u = 0; u < m_units.size(); ++u)
-	{
-		DELETE_POINTER(m_units[u]);
-	}
+	m_server.WaitForBattleSimulations();
 
-	for (int c = 0; c < m_cards.size(); ++c)
-	{
-		DELETE_POINTER(m_cards[c]);
-	}
+	// Units and Cards still alive are destroyed with their pools;
+	m_units.clear();
+	m_cards.clear();
 
 	for (int p = 0; p < m_players.size(); ++p)
 	{
@@ -2664,15 +2659,15 @@ void Interface::Render()
 	{
 		m_match.m_purchaseMap->Render();
 
-		for (Unit*& unit : m_units)
+		m_unitPool.ForEach([](Unit* unit_)
 		{
-			unit->PurchaseRender();
-		}
+			unit_->PurchaseRender();
+		});
 
-		for(Card*& card : m_cards)
+		m_cardPool.ForEach([](Card* card_)
 		{
-			card->PurchaseRender();
-		}
+			card_->PurchaseRender();
+		});
 	}
 }
 
@@ -2740,18 +2735,83 @@ unsigned int Interface::GetUnitIDAndIncrementCounter()
 	return m_unitIDCounter;
 }
 
+// ----------------------------------------------------------------------------
+Unit* Interface::CreateUnit(JobType unitType_)
+{
+	MEM_TAG_SCOPE(s_memTagUnits);
+	return m_unitPool.Create(unitType_);
+}
+
+// ----------------------------------------------------------------------------
+Unit* Interface::CreateEnemyUnit(JobType unitType_)
+{
+	MEM_TAG_SCOPE(s_memTagUnits);
+	return m_enemyUnitPool.Create(unitType_);
+}
+
+// ----------------------------------------------------------------------------
+void Interface::DestroyUnit(Unit* unit_)
+{
+	if (unit_ != nullptr && m_enemyUnitPool.Owns(unit_))
+	{
+		m_enemyUnitPool.Destroy(unit_);
+		return;
+	}
+
+	m_unitPool.Destroy(unit_);
+}
+
+// ----------------------------------------------------------------------------
+Unit* Interface::GetUnit(PoolHandle unitHandle_) const
+{
+	if (unitHandle_.IsValid() && (unitHandle_.m_index & ENEMY_UNIT_HANDLE_BIT) != 0)
+	{
+		unitHandle_.m_index &= ~ENEMY_UNIT_HANDLE_BIT;
+		return m_enemyUnitPool.Get(unitHandle_);
+	}
+
+	return m_unitPool.Get(unitHandle_);
+}
+
+// ----------------------------------------------------------------------------
+PoolHandle Interface::GetUnitHandle(const Unit* unit_) const
+{
+	if (unit_ != nullptr && m_enemyUnitPool.Owns(unit_))
+	{
+		PoolHandle handle = m_enemyUnitPool.GetHandle(unit_);
+		handle.m_index |= ENEMY_UNIT_HANDLE_BIT;
+		return handle;
+	}
+
+	return m_unitPool.GetHandle(unit_);
+}
+
+// ----------------------------------------------------------------------------
+Card* Interface::CreateCard(CardType cardType_)
+{
+	MEM_TAG_SCOPE(s_memTagCards);
+	return m_cardPool.Create(cardType_);
+}
+
+// ----------------------------------------------------------------------------
+void Interface::DestroyCard(Card* card_)
+{
+	m_cardPool.Destroy(card_);
+}
+
 // ----------------------------------------------------------------------------
 void Interface::ClearUnitsCardsPlayers()
 {
 	for (int u = 0; u < m_units.size(); ++u)
 	{
-		DELETE_POINTER(m_units[u]);
+		DestroyUnit(m_units[u]);
 	}
 	m_units.clear();
 
+	m_cardZones.Clear();
 	for (int c = 0; c < m_cards.size(); ++c)
 	{
-		DELETE_POINTER(m_cards[c]);
+		DestroyCard(m_cards[c]);
 	}
 	m_cards.clear();
 
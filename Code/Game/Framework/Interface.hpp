@@ -4,7 +4,12 @@
 #include "Game/Units/UnitDefinition.hpp"
 #include "Game/Cards/Cards.hpp"
 #include "Game/Cards/CardDefinition.hpp"
+#include "Game/Cards/CardZones.hpp"
 #include "Game/Gameplay/Players.hpp"
+#include "Game/Framework/FilterCombinators.hpp"
+
+#include "Engine/Memory/ObjectPool.hpp"
+#include "Engine/Memory/STLArenaAllocator.hpp"
 
 #include <vector>
 #include <map>
@@ -20,6 +25,7 @@ class BattleMap;
 class PurchaseMap;
 class SpriteSheet;
 class Ability;
+class BattleSimulationJob;
 
 typedef std::function<bool(const Unit* unit_)> UnitFilter;
 typedef std::function<bool(const Card* card_)> CardFilter;
@@ -144,7 +150,7 @@ struct Query
 
 public:
 
-	Query(Units& units_, Cards& cards_, Players& players_);
+	Query(Units& units_, Cards& cards_, Players& players_, const ObjectPool<Unit>& unitPool_, const ObjectPool<Card>& cardPool_);
 
 	// Filters;
 	int GetUnitCount(const UnitFilter& filter_) const;
@@ -161,6 +167,21 @@ public:
 	Players GetPlayers(Players& playersToFilter_, const PlayerFilter& filter_) const;
 	Player* GetPlayer(const PlayerFilter& filter_) const;
 
+	// Compiled filters; FILTER is a filter struct or a FilterAnd/FilterOr/FilterNot of them, so the test inlines;
+	// Nothing here allocates, the Filter* functions clear out_ and refill it so a kept-around out_ reuses its capacity;
+	// Without a list to filter, Units and Cards are walked straight out of their pools, in slot order;
+	template <typename FILTER> int CountUnits(const FILTER& filter_) const;
+	template <typename FILTER> int CountUnits(const Units& unitsToFilter_, const FILTER& filter_) const;
+	template <typename FILTER> int CountCards(const FILTER& filter_) const;
+	template <typename FILTER> int CountPlayers(const FILTER& filter_) const;
+	template <typename FILTER> void FilterUnits(Units& out_, const FILTER& filter_) const;
+	template <typename FILTER> void FilterUnits(const Units& unitsToFilter_, Units& out_, const FILTER& filter_) const;
+	template <typename FILTER> void FilterCards(Cards& out_, const FILTER& filter_) const;
+	template <typename FILTER> void FilterPlayers(Players& out_, const FILTER& filter_) const;
+	template <typename FILTER> void FilterPlayers(const Players& playersToFilter_, Players& out_, const FILTER& filter_) const;
+	template <typename FILTER, typename FUNC> void ForEachPlayer(const FILTER& filter_, FUNC func_) const;
+	template <typename FILTER> Card* FindCard(const FILTER& filter_) const;
+	template <typename FILTER> Player* FindPlayer(const FILTER& filter_) const;
 
 	// Game Queries;
 	Phase GetCurrentPhase();
@@ -170,8 +191,170 @@ private:
 	Units& m_units;
 	Cards& m_cards;
 	Players& m_players;
+
+	// Hold exactly what m_units and m_cards point at, see Interface;
+	const ObjectPool<Unit>& m_unitPool;
+	const ObjectPool<Card>& m_cardPool;
 };
 
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+int Query::CountUnits(const FILTER& filter_) const
+{
+	int count = 0;
+
+	m_unitPool.ForEach([&](const Unit* unit_)
+	{
+		count += filter_(unit_) ? 1 : 0;
+	});
+
+	return count;
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+int Query::CountUnits(const Units& unitsToFilter_, const FILTER& filter_) const
+{
+	int count = 0;
+
+	for (const Unit* unit : unitsToFilter_)
+	{
+		count += filter_(unit) ? 1 : 0;
+	}
+
+	return count;
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+int Query::CountCards(const FILTER& filter_) const
+{
+	int count = 0;
+
+	m_cardPool.ForEach([&](const Card* card_)
+	{
+		count += filter_(card_) ? 1 : 0;
+	});
+
+	return count;
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+int Query::CountPlayers(const FILTER& filter_) const
+{
+	int count = 0;
+
+	for (const Player* player : m_players)
+	{
+		count += filter_(player) ? 1 : 0;
+	}
+
+	return count;
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+void Query::FilterUnits(Units& out_, const FILTER& filter_) const
+{
+	out_.clear();
+
+	m_unitPool.ForEach([&](Unit* unit_)
+	{
+		if (filter_(unit_))
+		{
+			out_.push_back(unit_);
+		}
+	});
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+void Query::FilterUnits(const Units& unitsToFilter_, Units& out_, const FILTER& filter_) const
+{
+	out_.clear();
+
+	for (Unit* unit : unitsToFilter_)
+	{
+		if (filter_(unit))
+		{
+			out_.push_back(unit);
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+void Query::FilterCards(Cards& out_, const FILTER& filter_) const
+{
+	out_.clear();
+
+	m_cardPool.ForEach([&](Card* card_)
+	{
+		if (filter_(card_))
+		{
+			out_.push_back(card_);
+		}
+	});
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+void Query::FilterPlayers(Players& out_, const FILTER& filter_) const
+{
+	FilterPlayers(m_players, out_, filter_);
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+void Query::FilterPlayers(const Players& playersToFilter_, Players& out_, const FILTER& filter_) const
+{
+	out_.clear();
+
+	for (Player* player : playersToFilter_)
+	{
+		if (filter_(player))
+		{
+			out_.push_back(player);
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER, typename FUNC>
+void Query::ForEachPlayer(const FILTER& filter_, FUNC func_) const
+{
+	for (Player* player : m_players)
+	{
+		if (filter_(player))
+		{
+			func_(player);
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+Card* Query::FindCard(const FILTER& filter_) const
+{
+	return m_cardPool.FindIf(filter_);
+}
+
+// ----------------------------------------------------------------------------
+template <typename FILTER>
+Player* Query::FindPlayer(const FILTER& filter_) const
+{
+	for (Player* player : m_players)
+	{
+		if (filter_(player))
+		{
+			return player;
+		}
+	}
+
+	return nullptr;
+}
+
 // ----------------------------------------------------------------------------
 // Debug;
 // ----------------------------------------------------------------------------
@@ -205,6 +388,9 @@ public:
 	// Flow;
 	void Update(float deltaSeconds_);
 
+	// The battle Jobs call back into this Server and read the players, so they are handed back before either goes away;
+	void WaitForBattleSimulations();
+
 	// Starting the Game;
 	bool PreGameChecksAndSetups(float deltaSeconds_);
 	void SendStartMessageIfHaveNotSent();
@@ -242,15 +428,16 @@ public:
 	// Market;
 	int GetMaxMarketplaceCards();
 	void RollAndSendMarketplaceCardsForClient(Player*& player_);
+	void DrawMarketplaceCardsForPlayerID(int playerID_);
 	void ClearMarketplaceCardsForClient(int playerID_);
-	void SendCardTypesToPlayerIDForMarketplace(Cards& rolledCardsForMarketPlace_, int playerID_);
+	void SendCardTypesToPlayerIDForMarketplace(const Cards& rolledCardsForMarketPlace_, int playerID_);
 	void UpdateMarketplaceCardsBasedOnPurchaseByPlayer(unsigned int cardID_, int playerID_);
 	void GetMarketplaceCardsForPlayerID(int playerID_);
 	void RollMarketplaceCardsForAIPlayer(Player*& player_);
 	
 	// Hand;
 	void GetAndSendCardsInHandForPlayerID(const int playerID_);
-	void SendCardTypesToPlayerIDForHand(Cards cardsInHand_, int playerID_);
+	void SendCardTypesToPlayerIDForHand(const Cards& cardsInHand_, int playerID_);
 	void RemoveCardFromSellingByPlayer(unsigned int cardID_);
 	void RemoveCardFromPlacingUnitByPlayer(unsigned int cardID_);
 
@@ -263,12 +450,17 @@ public:
 	void CreateNewUnitFromCardPlacedByPlayer(unsigned int cardID_, int unitSlotID_);
 	void GiveAllEntitiesMaxHealth();
 
+	// Battle Simulation;
+	void StartBattleSimulationForMatch(int matchID_, Player* firstPlayer_, Units& firstPlayerUnits_, Player* secondPlayer_, Units& secondPlayerUnits_, unsigned int seed_);
+	void OnBattleSimulationComplete(BattleSimulationJob* battleSimulationJob_);
+	void SendPlayerTheirMatchResult(int playerID_, MatchReport& matchReport_);
+
 	// Match Report;
 	void CreateMatchReport(int winningPlayerID_, int losingPlayerID_, int damageDealtToLosingPlayer_, int matchID_, bool ignore_ = false);
 	void VerifyAndProcessEachMatchReport();
 	bool CheckForWinnerAndLoser();
-	void ProcessMatchReports(std::vector<MatchReport>& matchReports);
-	std::vector<MatchReport> GetMatchReportsOfMatchID(int matchID_);
+	void ProcessMatchReports(FrameVector<MatchReport>& matchReports);
+	FrameVector<MatchReport> GetMatchReportsOfMatchID(int matchID_);
 
 private:
 
@@ -290,8 +482,12 @@ private:
 	// Battle Phase;
 	bool m_allClientsSaidDoneWithBattlePhase = false;
 	int m_matchCount = 0;
+	int m_battleSimulationsRunning = 0;
 	bool m_allMatchesReportedBack = false;
-	std::vector<MatchReport> m_matchReports;
+	PhaseVector<MatchReport> m_matchReports;			// Only read in the Battle phase, dropped by SwitchPhases;
+
+	// Refilled every frame, kept here so it holds on to its capacity;
+	Players m_aiPlayersToUpdate;
 
 	// Shared Units and Cards;
 	int m_maxMarketplaceCards = 3;
@@ -358,7 +554,8 @@ public:
 	void SetMatchIDForThisBattlePhase(int matchID_);
 	void RunAttackSimulationOfAttackingVsDefending(Units& attackingUnits, Units& defendingUnits);
 	bool CheckForWinnerOfBattlePhase();
-	void SendMatchReportToServer(int winningPlayerID_, int losingPlayerID_, int dmageDealtToLosingPlayer_, int matchID_);
+	void SetMatchResultForThisBattlePhase(const MatchReport& matchResult_);
+	void PrintMatchResult();
 	Units& GetUnitsGoingFirst();
 	Units& GetUnitsGoingSecond();
 	void AssignTargetAndCasterForMainAbility(Ability*& mainAbility_, Unit*& attackingUnit_, Units& attackingUnits_, Units& defendingUnits_);
@@ -377,12 +574,17 @@ private:
 	bool m_marketplaceLocked = false;
 	
 	// Battle Phase Information To Temp Hold Onto;
-	Unit* m_actionUnit = nullptr;
+	// A handle, so a unit destroyed before its turn ends reads back as nullptr instead of dangling into the next battle;
+	PoolHandle m_actionUnit;
 	Units m_enemyUnits;
 	int m_matchID = -1;
+	MatchReport m_matchResult = MatchReport(-1, -1, 0, -1, true);
+	bool m_matchResultReceived = false;
 	
 	Units m_unitsGoingFirst;
 	Units m_unitsGoingSecond;
+	Units m_aliveUnitsGoingFirst;
+	Units m_aliveUnitsGoingSecond;
 	bool m_isFirstPlayersTurn = true;
 	int m_firstPlayersAttackingUnitIndex = 0;
 	int m_secondPlayersAttackingUnitIndex = 0;
@@ -415,6 +617,7 @@ public:
 	Debug&		debug()		{ return m_debug; }
 	Server&		server()	{ return m_server; }
 	Client&		client()	{ return m_client; }
+	CardZones&	cardZones()	{ return m_cardZones; }
 
 	void Init();
 	void Startup();
@@ -429,6 +632,18 @@ public:
 	unsigned int GetCardIDAndIncrementCounter();
 	unsigned int GetUnitIDAndIncrementCounter();
 
+	// Pooled Units and Cards; Every Unit and Card is created and destroyed through these;
+	Unit* CreateUnit(JobType unitType_);
+	Unit* CreateEnemyUnit(JobType unitType_);
+	void DestroyUnit(Unit* unit_);
+	Unit* GetUnit(PoolHandle unitHandle_) const;
+	PoolHandle GetUnitHandle(const Unit* unit_) const;
+	Card* CreateCard(CardType cardType_);
+	void DestroyCard(Card* card_);
+
+	// Every Unit in the shared Units, in slot order;
+	template <typename FUNC> void ForEachUnit(FUNC func_) const			{ m_unitPool.ForEach(func_); }
+
 	void ClearUnitsCardsPlayers();
 	
 	
@@ -442,8 +657,16 @@ private:
 	Server m_server;
 	Client m_client;
 
+	// Pools own the Units and Cards, m_units and m_cards only point into them;
+	// m_unitPool and m_cardPool hold exactly what m_units and m_cards point at, so the whole set can be walked in slot
+	// order; the Client's copies of its enemy's units are kept apart in m_enemyUnitPool for that;
+	ObjectPool<Unit> m_unitPool;
+	ObjectPool<Unit> m_enemyUnitPool;
+	ObjectPool<Card> m_cardPool;
+
 	Units m_units;
 	Cards m_cards;
+	CardZones m_cardZones;
 	Players m_players;
 
 	unsigned int m_cardIDCounter = 0u;
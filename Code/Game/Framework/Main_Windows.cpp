@@ -60,7 +60,7 @@ bool GameWindowsProcCallback( WindowContext* windowContext, uint msg, uintptr_t
 }	
 
 //-----------------------------------------------------------------------------------------------
-void Init()
+void Init( const char* commandLine )
 {
 	g_theApp = new App();
 	g_theWindowContext = new WindowContext();
@@ -69,7 +69,7 @@ void Init()
 
 	g_theRenderer = new RenderContext( g_theWindowContext );
 
-	g_theApp->Init();
+	g_theApp->Init( commandLine );
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -88,9 +88,9 @@ void Shutdown()
 }
 
 //-----------------------------------------------------------------------------------------------
-int WINAPI WinMain( HINSTANCE, HINSTANCE, LPSTR, int )
+int WINAPI WinMain( HINSTANCE, HINSTANCE, LPSTR commandLine, int )
 {
-	Init();
+	Init( commandLine );
 	Startup();
 
 	while( !g_theApp->IsQuitting() )
@@ -0,0 +1,47 @@
+#pragma once
+#include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/SpriteBatch.hpp"
+
+
+// ----------------------------------------------------------------------------
+// Sprite batch layers for the game camera, lower layers draw first;
+// Sprites on the same layer are regrouped by texture, so anything that has to stack gets its own layer;
+// ----------------------------------------------------------------------------
+enum RenderLayer : int
+{
+	RENDER_LAYER_BACKGROUND = 0,
+	RENDER_LAYER_MAP_UI,
+	RENDER_LAYER_MAP_ICONS,
+	RENDER_LAYER_UNITS,
+	RENDER_LAYER_CARDS,
+	RENDER_LAYER_CARD_ICONS,
+	RENDER_LAYER_FLOATING_CARD,
+	RENDER_LAYER_FLOATING_CARD_ICONS,
+	RENDER_LAYER_UNIT_UI,
+	RENDER_LAYER_ABILITIES,
+	RENDER_LAYER_TEXT,
+};
+
+// ----------------------------------------------------------------------------
+// Everything in the game is drawn with the same unlit shader, look it up once;
+// ----------------------------------------------------------------------------
+inline SpriteBatchKey GameSpriteKey(RenderLayer layer_, TextureView* textureView_)
+{
+	static const ShaderHandle s_spriteShader = g_theRenderer->AcquireShader("Data/Shaders/default_unlit_devconsole.shader");
+	return SpriteBatchKey(layer_, g_theRenderer->GetShader(s_spriteShader), textureView_);
+}
+
+// ----------------------------------------------------------------------------
+inline SpriteBatchKey GameSpriteKey(RenderLayer layer_, TextureHandle texture_)
+{
+	return GameSpriteKey(layer_, g_theRenderer->GetTextureView(texture_));
+}
+
+// ----------------------------------------------------------------------------
+// The font all the in-game text uses;
+// ----------------------------------------------------------------------------
+inline FontHandle GameFont()
+{
+	static const FontHandle s_gameFont = g_theRenderer->AcquireBitmapFontFixedWidth16x16("SquirrelFixedFont");
+	return s_gameFont;
+}
@@ -0,0 +1,353 @@
+#include "Game/Gameplay/BalanceRunner.hpp"
+
+// -----------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/RawNoise.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Buffer/BufferUtilities.hpp"
+
+// -----------------------------------------------------------------------
+#include "Game/Ability/AbilityDefinition.hpp"
+#include "Game/Units/UnitDefinition.hpp"
+
+#include <thread>
+
+
+// ------------------------------------------------------------------
+// Balance Totals;
+// ------------------------------------------------------------------
+void BalanceTotals::Add(const BalanceTotals& totals_)
+{
+	m_battles += totals_.m_battles;
+	m_wins[BATTLE_SIDE_FIRST] += totals_.m_wins[BATTLE_SIDE_FIRST];
+	m_wins[BATTLE_SIDE_SECOND] += totals_.m_wins[BATTLE_SIDE_SECOND];
+	m_draws += totals_.m_draws;
+	m_stalemates += totals_.m_stalemates;
+	m_turnsTaken += totals_.m_turnsTaken;
+	m_effectsDropped += totals_.m_effectsDropped;
+
+	for (int jobIndex = 0; jobIndex < (int)JobType::JOB_COUNT; ++jobIndex)
+	{
+		BalanceJobStats& jobStats = m_jobStats[jobIndex];
+		const BalanceJobStats& otherJobStats = totals_.m_jobStats[jobIndex];
+
+		jobStats.m_appearances += otherJobStats.m_appearances;
+		jobStats.m_wins += otherJobStats.m_wins;
+		jobStats.m_losses += otherJobStats.m_losses;
+		jobStats.m_draws += otherJobStats.m_draws;
+		jobStats.m_stalemates += otherJobStats.m_stalemates;
+		jobStats.m_turnsTaken += otherJobStats.m_turnsTaken;
+		jobStats.m_damageDealt += otherJobStats.m_damageDealt;
+		jobStats.m_healingDone += otherJobStats.m_healingDone;
+	}
+}
+
+// ------------------------------------------------------------------
+// Balance Run Job;
+// ------------------------------------------------------------------
+BalanceRunJob::BalanceRunJob(const BalanceRunSettings& settings_, const std::vector<JobType>& roster_, int firstBattle_, int battleCount_)
+	: m_settings(settings_)
+	, m_roster(roster_)
+	, m_firstBattle(firstBattle_)
+	, m_battleCount(battleCount_)
+{
+}
+
+// ------------------------------------------------------------------
+BalanceRunJob::~BalanceRunJob()
+{
+}
+
+// ------------------------------------------------------------------
+void BalanceRunJob::Execute()
+{
+	RandomNumberGenerator lineUpRandomNumberGenerator;
+	std::vector<JobType> firstLineUp;
+	std::vector<JobType> secondLineUp;
+	firstLineUp.reserve(m_settings.m_lineUpSize);
+	secondLineUp.reserve(m_settings.m_lineUpSize);
+
+	int lastBattle = m_firstBattle + m_battleCount;
+	for (int battleIndex = m_firstBattle; battleIndex < lastBattle; ++battleIndex)
+	{
+		// Separate streams for the line-ups and the battle, so the battle's rolls don't repeat the draws that picked its units;
+		unsigned int lineUpSeed = Get1dNoiseUint(battleIndex, m_settings.m_seed);
+		unsigned int battleSeed = Get1dNoiseUint(battleIndex, m_settings.m_seed + 1);
+		lineUpRandomNumberGenerator.NewSeed(lineUpSeed);
+		PickLineUp(lineUpRandomNumberGenerator, firstLineUp);
+		PickLineUp(lineUpRandomNumberGenerator, secondLineUp);
+
+		m_battleSimulator.Reset();
+		m_battleSimulator.AddUnits(BATTLE_SIDE_FIRST, firstLineUp);
+		m_battleSimulator.AddUnits(BATTLE_SIDE_SECOND, secondLineUp);
+		BattleResult battleResult = m_battleSimulator.Run(battleSeed);
+
+		m_totals.m_battles++;
+		m_totals.m_turnsTaken += battleResult.m_turnsTaken;
+		m_totals.m_effectsDropped += battleResult.m_effectsDropped;
+		if (battleResult.m_hitTurnLimit)
+		{
+			m_totals.m_stalemates++;
+		}
+		else if (battleResult.m_winningSide == BATTLE_SIDE_DRAW)
+		{
+			m_totals.m_draws++;
+		}
+		else
+		{
+			m_totals.m_wins[battleResult.m_winningSide]++;
+		}
+
+		for (const BattleUnit& battleUnit : m_battleSimulator.GetBattleUnits())
+		{
+			BalanceJobStats& jobStats = m_totals.m_jobStats[(int)battleUnit.m_type];
+			jobStats.m_appearances++;
+			jobStats.m_turnsTaken += battleUnit.m_turnsTaken;
+			jobStats.m_damageDealt += battleUnit.m_damageDealt;
+			jobStats.m_healingDone += battleUnit.m_healingDone;
+
+			if (battleResult.m_hitTurnLimit)
+			{
+				jobStats.m_stalemates++;
+			}
+			else if (battleResult.m_winningSide == BATTLE_SIDE_DRAW)
+			{
+				jobStats.m_draws++;
+			}
+			else if (battleResult.m_winningSide == battleUnit.m_side)
+			{
+				jobStats.m_wins++;
+			}
+			else
+			{
+				jobStats.m_losses++;
+			}
+		}
+	}
+}
+
+// ------------------------------------------------------------------
+void BalanceRunJob::PickLineUp(RandomNumberGenerator& randomNumberGenerator_, std::vector<JobType>& outLineUp_)
+{
+	outLineUp_.clear();
+
+	int rosterSize = (int)m_roster.size();
+	for (int unitIndex = 0; unitIndex < m_settings.m_lineUpSize; ++unitIndex)
+	{
+		outLineUp_.push_back(m_roster[randomNumberGenerator_.GetRandomIntLessThan(rosterSize)]);
+	}
+}
+
+// ------------------------------------------------------------------
+// Balance Runner;
+// ------------------------------------------------------------------
+BalanceRunner::~BalanceRunner()
+{
+	// The Jobs call back into this runner and read m_roster, so they all have to be handed back first;
+	// Once the JobSystem has shut down every Job has run, and their callbacks are never made;
+	while (IsRunning() && g_theJobSystem != nullptr && g_theJobSystem->IsRunning())
+	{
+		if (!g_theJobSystem->ProcessFinishCallbacksForJobCategory(JOBCATEGORY_GENERIC))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+// ------------------------------------------------------------------
+bool BalanceRunner::Start(const BalanceRunSettings& settings_)
+{
+	if (IsRunning())
+	{
+		g_theDevConsole->Print("A balance run is already in progress.");
+		return false;
+	}
+
+	if (settings_.m_battleCount <= 0 || settings_.m_lineUpSize <= 0)
+	{
+		g_theDevConsole->Print("A balance run needs at least one battle and one unit per side.");
+		return false;
+	}
+
+	BuildRoster();
+	if (m_roster.empty())
+	{
+		g_theDevConsole->Print("No unit definitions are loaded, the balance run has nothing to play.");
+		return false;
+	}
+
+	m_settings = settings_;
+	m_totals = BalanceTotals();
+	m_startTime = GetCurrentTimeSeconds();
+
+	// A few Jobs per core so a slow batch doesn't leave the other threads idle at the end;
+	int threadCount = (int)std::thread::hardware_concurrency();
+	if (threadCount < 1)
+	{
+		threadCount = 1;
+	}
+
+	int jobCount = threadCount * JOBS_PER_THREAD;
+	if (jobCount > m_settings.m_battleCount)
+	{
+		jobCount = m_settings.m_battleCount;
+	}
+
+	int battlesPerJob = m_settings.m_battleCount / jobCount;
+	int leftoverBattles = m_settings.m_battleCount % jobCount;
+	int firstBattle = 0;
+
+	g_theDevConsole->Print(Stringf("Starting balance run: %i battles, %i units per side, seed %u, %i jobs.", m_settings.m_battleCount, m_settings.m_lineUpSize, m_settings.m_seed, jobCount));
+
+	for (int jobIndex = 0; jobIndex < jobCount; ++jobIndex)
+	{
+		int battleCount = battlesPerJob + (jobIndex < leftoverBattles ? 1 : 0);
+
+		BalanceRunJob* balanceRunJob = new BalanceRunJob(m_settings, m_roster, firstBattle, battleCount);
+		balanceRunJob->SetFinishCallback([this](Job* job_)
+		{
+			OnBalanceRunJobComplete((BalanceRunJob*)job_);
+		});
+
+		firstBattle += battleCount;
+		m_jobsRunning++;
+		g_theJobSystem->Run(balanceRunJob);
+	}
+
+	return true;
+}
+
+// ------------------------------------------------------------------
+bool BalanceRunner::IsRunning() const
+{
+	return m_jobsRunning > 0;
+}
+
+// ------------------------------------------------------------------
+void BalanceRunner::BuildRoster()
+{
+	m_roster.clear();
+
+	for (const std::pair<const JobType, UnitDefinition*>& unitDefinitionPair : UnitDefinition::s_unitDefinitions)
+	{
+		// Units without a main ability can't take a turn, so they can't be simulated;
+		if (unitDefinitionPair.second->m_mainAbilityDefinition)
+		{
+			m_roster.push_back(unitDefinitionPair.first);
+		}
+	}
+}
+
+// ------------------------------------------------------------------
+void BalanceRunner::OnBalanceRunJobComplete(BalanceRunJob* job_)
+{
+	m_totals.Add(job_->m_totals);
+	m_jobsRunning--;
+
+	if (m_jobsRunning == 0)
+	{
+		Finish();
+	}
+}
+
+// ------------------------------------------------------------------
+void BalanceRunner::Finish()
+{
+	m_secondsTaken = GetCurrentTimeSeconds() - m_startTime;
+
+	PrintResults();
+
+	if (WriteResults())
+	{
+		g_theDevConsole->Print(Stringf("Balance results written to '%s'.", m_settings.m_filepath.c_str()));
+	}
+	else
+	{
+		g_theDevConsole->Print(Stringf("FAILED to write balance results to '%s'.", m_settings.m_filepath.c_str()));
+	}
+}
+
+// ------------------------------------------------------------------
+void BalanceRunner::PrintResults() const
+{
+	double battles = (double)m_totals.m_battles;
+	g_theDevConsole->Print(Stringf("Balance run finished: %llu battles in %.2fs (%.0f battles/s).", m_totals.m_battles, m_secondsTaken, battles / m_secondsTaken));
+	g_theDevConsole->Print(Stringf("First side wins %.1f%%, second side wins %.1f%%, draws %.1f%%, stalemates %.1f%%, average turns %.1f.",
+		100.0 * (double)m_totals.m_wins[BATTLE_SIDE_FIRST] / battles,
+		100.0 * (double)m_totals.m_wins[BATTLE_SIDE_SECOND] / battles,
+		100.0 * (double)m_totals.m_draws / battles,
+		100.0 * (double)m_totals.m_stalemates / battles,
+		(double)m_totals.m_turnsTaken / battles));
+
+	if (m_totals.m_effectsDropped > 0)
+	{
+		g_theDevConsole->Print(Stringf("%llu effects were dropped from units already holding %i, those battles are off.", m_totals.m_effectsDropped, BattleUnit::MAX_EFFECTS));
+	}
+
+	for (JobType jobType : m_roster)
+	{
+		const BalanceJobStats& jobStats = m_totals.m_jobStats[(int)jobType];
+		if (jobStats.m_appearances == 0)
+		{
+			continue;
+		}
+
+		double appearances = (double)jobStats.m_appearances;
+		g_theDevConsole->Print(Stringf("%-14s win %5.1f%%  turns %5.2f  damage %7.2f  healing %7.2f",
+			UnitDefinition::UnitTypeToString(jobType).c_str(),
+			100.0 * (double)jobStats.m_wins / appearances,
+			(double)jobStats.m_turnsTaken / appearances,
+			(double)jobStats.m_damageDealt / appearances,
+			(double)jobStats.m_healingDone / appearances));
+	}
+}
+
+// ------------------------------------------------------------------
+// Little endian; header, overall totals, then one row per JobType in the roster;
+// Counts are 64 bit, averages are per unit appearance;
+bool BalanceRunner::WriteResults() const
+{
+	Buffer buffer;
+	BufferWriter bufferWriter(buffer, BufferEndian::LITTLE);
+
+	// Header;
+	bufferWriter.AppendByteArray((const unsigned char*)"BRUN", 4);
+	bufferWriter.AppenedUInt32(BALANCE_RESULTS_VERSION);
+	bufferWriter.AppenedUInt32(m_settings.m_seed);
+	bufferWriter.AppenedUInt32((unsigned int)m_settings.m_lineUpSize);
+	bufferWriter.AppenedUInt32((unsigned int)m_roster.size());
+
+	// Totals;
+	double battles = (double)m_totals.m_battles;
+	bufferWriter.AppendUInt64(m_totals.m_battles);
+	bufferWriter.AppendUInt64(m_totals.m_wins[BATTLE_SIDE_FIRST]);
+	bufferWriter.AppendUInt64(m_totals.m_wins[BATTLE_SIDE_SECOND]);
+	bufferWriter.AppendUInt64(m_totals.m_draws);
+	bufferWriter.AppendUInt64(m_totals.m_stalemates);
+	bufferWriter.AppendUInt64(m_totals.m_effectsDropped);
+	bufferWriter.AppendFloat((float)((double)m_totals.m_turnsTaken / battles));
+	bufferWriter.AppendFloat((float)m_secondsTaken);
+
+	// Jobs;
+	for (JobType jobType : m_roster)
+	{
+		const BalanceJobStats& jobStats = m_totals.m_jobStats[(int)jobType];
+		double appearances = jobStats.m_appearances > 0 ? (double)jobStats.m_appearances : 1.0;
+
+		bufferWriter.AppendByte((unsigned char)jobType);
+		bufferWriter.AppendStringAfter8BitLength(UnitDefinition::UnitTypeToString(jobType));
+		bufferWriter.AppendUInt64(jobStats.m_appearances);
+		bufferWriter.AppendUInt64(jobStats.m_wins);
+		bufferWriter.AppendUInt64(jobStats.m_losses);
+		bufferWriter.AppendUInt64(jobStats.m_draws);
+		bufferWriter.AppendUInt64(jobStats.m_stalemates);
+		bufferWriter.AppendFloat((float)((double)jobStats.m_turnsTaken / appearances));
+		bufferWriter.AppendFloat((float)((double)jobStats.m_damageDealt / appearances));
+		bufferWriter.AppendFloat((float)((double)jobStats.m_healingDone / appearances));
+	}
+
+	return BufferWriter::SaveBinaryFromBuffer(m_settings.m_filepath, buffer);
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+// -----------------------------------------------------------------------
+#include "Engine/Job/Jobs.hpp"
+
+// -----------------------------------------------------------------------
+#include "Game/Gameplay/BattleSimulator.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// -----------------------------------------------------------------------
+// Monte Carlo balance runner; Plays a large number of seeded battles between random line-ups
+// of every loaded JobType across the generic JobSystem threads and writes the totals to a binary file;
+// Battle i always picks its line-ups from Get1dNoiseUint(i, runSeed) and fights with Get1dNoiseUint(i, runSeed + 1),
+// so a run is reproducible no matter how it is split;
+// -----------------------------------------------------------------------
+
+constexpr uint32_t BALANCE_RESULTS_VERSION = 2;
+
+// -----------------------------------------------------------------------
+struct BalanceRunSettings
+{
+	unsigned int m_seed = 0u;
+	int m_battleCount = 100000;
+	int m_lineUpSize = 5;
+	std::string m_filepath = "Data/BalanceResults.binary";
+};
+
+// -----------------------------------------------------------------------
+// Totals for one JobType, one count per unit taking part in a battle;
+struct BalanceJobStats
+{
+	uint64_t m_appearances = 0;
+	uint64_t m_wins = 0;
+	uint64_t m_losses = 0;
+	uint64_t m_draws = 0;
+	uint64_t m_stalemates = 0;						// Battles stopped at BattleSimulator::MAX_TURNS, not in m_draws;
+	uint64_t m_turnsTaken = 0;
+	uint64_t m_damageDealt = 0;
+	uint64_t m_healingDone = 0;
+};
+
+// -----------------------------------------------------------------------
+struct BalanceTotals
+{
+	uint64_t m_battles = 0;
+	uint64_t m_wins[BATTLE_SIDE_COUNT] = { 0, 0 };
+	uint64_t m_draws = 0;
+	uint64_t m_stalemates = 0;
+	uint64_t m_turnsTaken = 0;
+	uint64_t m_effectsDropped = 0;
+	BalanceJobStats m_jobStats[(int)JobType::JOB_COUNT];
+
+	void Add(const BalanceTotals& totals_);
+};
+
+// -----------------------------------------------------------------------
+// Plays battles [m_firstBattle, m_firstBattle + m_battleCount) with its own simulator;
+class BalanceRunJob : public Job
+{
+
+public:
+
+	BalanceRunJob(const BalanceRunSettings& settings_, const std::vector<JobType>& roster_, int firstBattle_, int battleCount_);
+	virtual ~BalanceRunJob();
+
+	virtual void Execute() override;
+
+private:
+
+	void PickLineUp(RandomNumberGenerator& randomNumberGenerator_, std::vector<JobType>& outLineUp_);
+
+public:
+
+	BalanceRunSettings m_settings;
+	const std::vector<JobType>& m_roster;
+	int m_firstBattle = 0;
+	int m_battleCount = 0;
+
+	BattleSimulator m_battleSimulator;
+	BalanceTotals m_totals;
+};
+
+// -----------------------------------------------------------------------
+class BalanceRunner
+{
+
+public:
+
+	static constexpr int JOBS_PER_THREAD = 4;
+
+	BalanceRunner() = default;
+	~BalanceRunner();
+
+	bool Start(const BalanceRunSettings& settings_);
+	bool IsRunning() const;
+
+private:
+
+	void BuildRoster();
+	void OnBalanceRunJobComplete(BalanceRunJob* job_);
+	void Finish();
+	void PrintResults() const;
+	bool WriteResults() const;
+
+private:
+
+	BalanceRunSettings m_settings;
+	std::vector<JobType> m_roster;
+	BalanceTotals m_totals;
+	int m_jobsRunning = 0;
+	double m_startTime = 0.0;
+	double m_secondsTaken = 0.0;
+};
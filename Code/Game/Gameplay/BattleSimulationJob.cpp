@@ -0,0 +1,22 @@
+#include "Game/Gameplay/BattleSimulationJob.hpp"
+
+
+// ------------------------------------------------------------------
+BattleSimulationJob::BattleSimulationJob(int matchID_, int firstPlayerID_, int secondPlayerID_, unsigned int seed_)
+	: m_matchID(matchID_)
+	, m_firstPlayerID(firstPlayerID_)
+	, m_secondPlayerID(secondPlayerID_)
+	, m_seed(seed_)
+{
+}
+
+// ------------------------------------------------------------------
+BattleSimulationJob::~BattleSimulationJob()
+{
+}
+
+// ------------------------------------------------------------------
+void BattleSimulationJob::Execute()
+{
+	m_battleResult = m_battleSimulator.Run(m_seed);
+}
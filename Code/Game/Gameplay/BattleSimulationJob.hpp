@@ -0,0 +1,32 @@
+#pragma once
+
+// -----------------------------------------------------------------------
+#include "Engine/Job/Jobs.hpp"
+
+// -----------------------------------------------------------------------
+#include "Game/Gameplay/BattleSimulator.hpp"
+
+// -----------------------------------------------------------------------
+// Resolves one match on a generic JobSystem thread;
+// The line-ups are copied into the simulator on the main thread, so Execute touches nothing shared but the definitions;
+// -----------------------------------------------------------------------
+class BattleSimulationJob : public Job
+{
+
+public:
+
+	BattleSimulationJob(int matchID_, int firstPlayerID_, int secondPlayerID_, unsigned int seed_);
+	virtual ~BattleSimulationJob();
+
+	virtual void Execute() override;
+
+public:
+
+	int m_matchID = -1;
+	int m_firstPlayerID = -1;
+	int m_secondPlayerID = -1;
+	unsigned int m_seed = 0u;
+
+	BattleSimulator m_battleSimulator;
+	BattleResult m_battleResult;
+};
@@ -0,0 +1,543 @@
+#include "Game/Gameplay/BattleSimulator.hpp"
+
+// ------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+// ------------------------------------------------------------------
+#include "Game/Units/Unit.hpp"
+#include "Game/Units/Units.hpp"
+#include "Game/Ability/AbilityDefinition.hpp"
+#include "Game/Ability/Term.hpp"
+
+
+// ------------------------------------------------------------------
+// Setup;
+// ------------------------------------------------------------------
+void BattleSimulator::Reset()
+{
+	m_lineUps.clear();
+	m_units.clear();
+}
+
+// ------------------------------------------------------------------
+void BattleSimulator::AddUnit(int side_, JobType unitType_)
+{
+	std::map<JobType, UnitDefinition*>::iterator unitIter = UnitDefinition::s_unitDefinitions.find(unitType_);
+	if (unitIter == UnitDefinition::s_unitDefinitions.end())
+	{
+		ERROR_AND_DIE("Attempted to simulate a Unit with a unit type that is not loaded.");
+	}
+
+	const UnitDefinition* unitDefinition = unitIter->second;
+	GUARANTEE_OR_DIE(unitDefinition->m_mainAbilityDefinition, "Attempted to simulate a Unit with no main ability.");
+
+	BattleUnit battleUnit;
+	battleUnit.m_unitDefinition = unitDefinition;
+	battleUnit.m_type			= unitType_;
+	battleUnit.m_side			= side_;
+	battleUnit.m_maxHealth		= unitDefinition->m_health;
+	battleUnit.m_health			= unitDefinition->m_health;
+	battleUnit.m_strength		= unitDefinition->m_strength;
+	battleUnit.m_intellect		= unitDefinition->m_intellect;
+	battleUnit.m_wisdom			= unitDefinition->m_wisdom;
+	battleUnit.m_constitution	= unitDefinition->m_constitution;
+
+	m_lineUps.push_back(battleUnit);
+}
+
+// ------------------------------------------------------------------
+void BattleSimulator::AddUnit(int side_, const Unit* unit_)
+{
+	AddUnit(side_, unit_->m_type);
+
+	// Take the stats the unit has right now, they can differ from its definition;
+	BattleUnit& battleUnit = m_lineUps.back();
+	battleUnit.m_health			= unit_->m_health;
+	battleUnit.m_strength		= unit_->m_strength;
+	battleUnit.m_intellect		= unit_->m_intellect;
+	battleUnit.m_wisdom			= unit_->m_wisdom;
+	battleUnit.m_constitution	= unit_->m_constitution;
+}
+
+// ------------------------------------------------------------------
+void BattleSimulator::AddUnits(int side_, Units& units_)
+{
+	for (Unit* unit : units_)
+	{
+		AddUnit(side_, unit);
+	}
+}
+
+// ------------------------------------------------------------------
+void BattleSimulator::AddUnits(int side_, const std::vector<JobType>& unitTypes_)
+{
+	for (JobType unitType : unitTypes_)
+	{
+		AddUnit(side_, unitType);
+	}
+}
+
+// ------------------------------------------------------------------
+// Flow;
+// ------------------------------------------------------------------
+BattleResult BattleSimulator::Run(unsigned int seed_)
+{
+	m_randomNumberGenerator.NewSeed(seed_);
+	m_units = m_lineUps;
+	m_result = BattleResult();
+	m_attackingUnitIndex[BATTLE_SIDE_FIRST] = 0;
+	m_attackingUnitIndex[BATTLE_SIDE_SECOND] = 0;
+
+	int side = BATTLE_SIDE_FIRST;
+	while (true)
+	{
+		GatherAliveUnits();
+
+		size_t aliveFirst = m_aliveUnits[BATTLE_SIDE_FIRST].size();
+		size_t aliveSecond = m_aliveUnits[BATTLE_SIDE_SECOND].size();
+
+		// Same winner rules as Client::CheckForWinnerOfBattlePhase;
+		if (aliveFirst == 0 && aliveSecond == 0)
+		{
+			m_result.m_winningSide = BATTLE_SIDE_DRAW;
+			break;
+		}
+		else if (aliveSecond == 0)
+		{
+			m_result.m_winningSide = BATTLE_SIDE_FIRST;
+			m_result.m_damageToLosingPlayer = (int)aliveFirst;
+			break;
+		}
+		else if (aliveFirst == 0)
+		{
+			m_result.m_winningSide = BATTLE_SIDE_SECOND;
+			m_result.m_damageToLosingPlayer = (int)aliveSecond;
+			break;
+		}
+
+		// Stalemates are a draw for the players, but are kept apart so balance numbers can tell them from a real draw;
+		if (m_result.m_turnsTaken >= MAX_TURNS)
+		{
+			m_result.m_winningSide = BATTLE_SIDE_DRAW;
+			m_result.m_hitTurnLimit = true;
+			break;
+		}
+
+		TakeTurn(side);
+
+		side = (side == BATTLE_SIDE_FIRST) ? BATTLE_SIDE_SECOND : BATTLE_SIDE_FIRST;
+		m_result.m_turnsTaken++;
+	}
+
+	return m_result;
+}
+
+// ------------------------------------------------------------------
+const std::vector<BattleUnit>& BattleSimulator::GetBattleUnits() const
+{
+	return m_units;
+}
+
+// ------------------------------------------------------------------
+// Turns;
+// ------------------------------------------------------------------
+void BattleSimulator::GatherAliveUnits()
+{
+	m_aliveUnits[BATTLE_SIDE_FIRST].clear();
+	m_aliveUnits[BATTLE_SIDE_SECOND].clear();
+
+	for (int unitIndex = 0; unitIndex < (int)m_units.size(); ++unitIndex)
+	{
+		const BattleUnit& unit = m_units[unitIndex];
+		if (unit.m_health > 0)
+		{
+			m_aliveUnits[unit.m_side].push_back(unitIndex);
+		}
+	}
+}
+
+// ------------------------------------------------------------------
+void BattleSimulator::TakeTurn(int side_)
+{
+	// Matches Units::GetAliveUnitStartingAtIndex over the alive units of this side;
+	std::vector<int>& aliveUnits = m_aliveUnits[side_];
+	int& attackingUnitIndex = m_attackingUnitIndex[side_];
+	if (attackingUnitIndex > (int)aliveUnits.size() - 1)
+	{
+		attackingUnitIndex = 0;
+	}
+
+	int actionUnitIndex = aliveUnits[attackingUnitIndex];
+	attackingUnitIndex++;
+
+	// The main ability target is chosen when the turn starts, before any status or buff runs;
+	const AbilityDefinition* mainAbilityDefinition = m_units[actionUnitIndex].m_unitDefinition->m_mainAbilityDefinition;
+
+	BattleEffect mainAbility;
+	mainAbility.m_abilityDefinition = mainAbilityDefinition;
+	mainAbility.m_casterIndex = actionUnitIndex;
+	mainAbility.m_targetIndex = PickMainAbilityTarget(mainAbilityDefinition, side_);
+
+	BattleUnit& actionUnit = m_units[actionUnitIndex];
+	actionUnit.m_turnsTaken++;
+
+	// Order must retain: Status, Buff, Main;
+	for (int statusIndex = 0; statusIndex < actionUnit.m_statusEffectCount && actionUnit.m_health > 0; ++statusIndex)
+	{
+		RunAbility(actionUnit.m_statusEffects[statusIndex]);
+	}
+
+	for (int buffIndex = 0; buffIndex < actionUnit.m_buffCount && actionUnit.m_health > 0; ++buffIndex)
+	{
+		RunAbility(actionUnit.m_buffs[buffIndex]);
+	}
+
+	RemoveDisspelledEffects(actionUnit);
+
+	if (actionUnit.m_health > 0)
+	{
+		RunAbility(mainAbility);
+		RemoveDisspelledEffects(m_units[mainAbility.m_targetIndex]);
+	}
+}
+
+// ------------------------------------------------------------------
+int BattleSimulator::PickMainAbilityTarget(const AbilityDefinition* abilityDefinition_, int side_)
+{
+	int enemySide = (side_ == BATTLE_SIDE_FIRST) ? BATTLE_SIDE_SECOND : BATTLE_SIDE_FIRST;
+
+	const std::vector<int>* candidates = nullptr;
+	switch (abilityDefinition_->m_targetAlliance)
+	{
+		case TargetAlliance::ENEMY:		{ candidates = &m_aliveUnits[enemySide];	break; }
+		case TargetAlliance::FRIENDLY:	{ candidates = &m_aliveUnits[side_];		break; }
+		default:
+		{
+			ERROR_AND_DIE("Ability does not know what to target!");
+			break;
+		}
+	}
+
+	GUARANTEE_OR_DIE(candidates->size() > 0, "Running an attack simulation with no targets.");
+
+	switch (abilityDefinition_->m_targetChoice)
+	{
+		case TargetChoice::RANDOM:
+		{
+			int randomTarget = m_randomNumberGenerator.GetRandomIntInRange(0, (int)candidates->size() - 1);
+			return (*candidates)[randomTarget];
+		}
+
+		case TargetChoice::LEASTDAMAGETAKEN:	{ return PickRandomFromDamageBand(*candidates, false); }
+		case TargetChoice::MOSTDAMAGETAKEN:		{ return PickRandomFromDamageBand(*candidates, true); }
+
+		default:
+		{
+			ERROR_AND_DIE("Main ability does not have a valid Target Choice!");
+			break;
+		}
+	}
+
+	return -1;
+}
+
+// ------------------------------------------------------------------
+int BattleSimulator::PickRandomFromDamageBand(const std::vector<int>& candidates_, bool mostDamaged_)
+{
+	// Same banding as Query::GetLeast/MostDamagedUnitsExcludingDeadUnits;
+	float healthPercentage = mostDamaged_ ? 100.0f : 0.0f;
+	for (int unitIndex : candidates_)
+	{
+		const BattleUnit& unit = m_units[unitIndex];
+		float currentHealthPercentage = (float)unit.m_health / (float)unit.m_maxHealth;
+
+		if ((mostDamaged_ && currentHealthPercentage < healthPercentage)
+		|| (!mostDamaged_ && currentHealthPercentage > healthPercentage))
+		{
+			healthPercentage = currentHealthPercentage;
+		}
+	}
+
+	float l_healthPercentage = healthPercentage - 0.2f;
+	float u_healthPercentage = healthPercentage + 0.2f;
+
+	// Count first then pick, so no list has to be built;
+	int bandCount = 0;
+	for (int unitIndex : candidates_)
+	{
+		const BattleUnit& unit = m_units[unitIndex];
+		float currentHealthPercentage = (float)unit.m_health / (float)unit.m_maxHealth;
+		if (currentHealthPercentage >= l_healthPercentage && currentHealthPercentage <= u_healthPercentage)
+		{
+			bandCount++;
+		}
+	}
+
+	int randomTarget = m_randomNumberGenerator.GetRandomIntInRange(0, bandCount - 1);
+	for (int unitIndex : candidates_)
+	{
+		const BattleUnit& unit = m_units[unitIndex];
+		float currentHealthPercentage = (float)unit.m_health / (float)unit.m_maxHealth;
+		if (currentHealthPercentage >= l_healthPercentage && currentHealthPercentage <= u_healthPercentage)
+		{
+			if (randomTarget == 0)
+			{
+				return unitIndex;
+			}
+
+			randomTarget--;
+		}
+	}
+
+	ERROR_AND_DIE("Main ability has no target.");
+	return -1;
+}
+
+// ------------------------------------------------------------------
+// Abilities;
+// ------------------------------------------------------------------
+void BattleSimulator::RunAbility(BattleEffect& effect_)
+{
+	const AbilityDefinition* abilityDefinition = effect_.m_abilityDefinition;
+	for (const TermInstruction& instruction : abilityDefinition->m_abilitySequence)
+	{
+		switch (instruction.m_termType)
+		{
+			case TermType::DAMAGE:
+			{
+				// Term::End grows modifiers above 1 every time the sequence runs;
+				int damageModifier = instruction.m_amount;
+				if (damageModifier > 1)
+				{
+					damageModifier += effect_.m_timesRun;
+				}
+
+				ApplyDamageOrHealing(effect_, damageModifier);
+				break;
+			}
+
+			case TermType::STATUS:
+			{
+				if (m_randomNumberGenerator.GetRandomFloatZeroToOne() <= instruction.m_value)
+				{
+					BattleUnit& target = m_units[effect_.m_targetIndex];
+					ApplyEffect(target.m_statusEffects, target.m_statusEffectCount, instruction.m_stringID, effect_.m_casterIndex, effect_.m_targetIndex);
+				}
+
+				break;
+			}
+
+			case TermType::DEBUFF:
+			{
+				// Debuffs are applied but never run, same as Unit::BattleUpdate;
+				if (m_randomNumberGenerator.GetRandomFloatZeroToOne() <= instruction.m_value)
+				{
+					BattleUnit& target = m_units[effect_.m_targetIndex];
+					ApplyEffect(target.m_debuffs, target.m_debuffCount, instruction.m_stringID, effect_.m_casterIndex, effect_.m_targetIndex);
+				}
+
+				break;
+			}
+
+			case TermType::BUFF:
+			{
+				if (m_randomNumberGenerator.GetRandomFloatZeroToOne() <= instruction.m_value)
+				{
+					ApplyBuff(instruction.m_stringID, effect_.m_casterIndex, effect_.m_targetIndex);
+				}
+
+				break;
+			}
+
+			case TermType::ATTACKCHANGE:
+			{
+				m_units[effect_.m_casterIndex].m_strength += instruction.m_amount;
+				break;
+			}
+
+			case TermType::DISSPELL:
+			{
+				Disspell(effect_.m_targetIndex);
+				effect_.m_disspelled = true;
+				break;
+			}
+
+			default:
+			{
+				// Anim, Movement, Effect and Audio are presentation only;
+				break;
+			}
+		}
+	}
+
+	effect_.m_timesRun++;
+}
+
+// ------------------------------------------------------------------
+void BattleSimulator::ApplyDamageOrHealing(BattleEffect& effect_, int damageModifier_)
+{
+	const AbilityDefinition* abilityDefinition = effect_.m_abilityDefinition;
+	BattleUnit& caster = m_units[effect_.m_casterIndex];
+	BattleUnit& target = m_units[effect_.m_targetIndex];
+
+	if (target.m_health <= 0)
+	{
+		return;
+	}
+
+	switch (abilityDefinition->m_targetAlliance)
+	{
+		case TargetAlliance::ENEMY:
+		{
+			int damage = 0;
+			switch (abilityDefinition->m_abilityClass)
+			{
+				case AbilityClass::PHYSICAL:
+				{
+					int multiplier = Clamp(caster.m_strength - target.m_constitution, 0, caster.m_strength);
+					damage = abilityDefinition->m_baseDamage * damageModifier_ * multiplier;
+					break;
+				}
+
+				case AbilityClass::MAGIC:
+				{
+					int multiplier = Clamp(caster.m_intellect - target.m_wisdom, 0, caster.m_intellect);
+					damage = abilityDefinition->m_baseDamage * multiplier;
+					break;
+				}
+
+				default:
+				{
+					ERROR_AND_DIE("Ability has an unknown Ability Class, it needs one!");
+					break;
+				}
+			}
+
+			target.m_health -= damage;
+			caster.m_damageDealt += damage;
+			m_result.m_damageDealt[caster.m_side] += damage;
+
+			if (target.m_health <= 0)
+			{
+				KillUnit(target);
+			}
+
+			break;
+		}
+
+		case TargetAlliance::FRIENDLY:
+		{
+			GUARANTEE_OR_DIE(abilityDefinition->m_abilityClass == AbilityClass::MAGIC, "We have no physical healing as of yet!");
+
+			int healAmount = abilityDefinition->m_baseDamage * damageModifier_ * caster.m_intellect;
+
+			target.m_health = Clamp(target.m_health + healAmount, 0, target.m_maxHealth);
+			caster.m_healingDone += healAmount;
+			m_result.m_healingDone[caster.m_side] += healAmount;
+
+			break;
+		}
+
+		default:
+		{
+			ERROR_AND_DIE("Ability does not have a target alliance!");
+			break;
+		}
+	}
+}
+
+// ------------------------------------------------------------------
+void BattleSimulator::ApplyEffect(BattleEffect* effects_, int& effectCount_, StringID abilityID_, int casterIndex_, int targetIndex_)
+{
+	const AbilityDefinition* abilityDefinition = AbilityDefinition::GetAbilityDefinition(abilityID_);
+
+	// An ability definition is only applied once per unit;
+	for (int effectIndex = 0; effectIndex < effectCount_; ++effectIndex)
+	{
+		if (effects_[effectIndex].m_abilityDefinition == abilityDefinition)
+		{
+			return;
+		}
+	}
+
+	// Card data can stack more than fit, the battle goes on without the extra one; the caller reports it;
+	if (effectCount_ >= BattleUnit::MAX_EFFECTS)
+	{
+		m_result.m_effectsDropped++;
+		return;
+	}
+
+	BattleEffect& effect = effects_[effectCount_++];
+	effect = BattleEffect();
+	effect.m_abilityDefinition = abilityDefinition;
+	effect.m_casterIndex = casterIndex_;
+	effect.m_targetIndex = targetIndex_;
+}
+
+// ------------------------------------------------------------------
+void BattleSimulator::ApplyBuff(StringID buffID_, int casterIndex_, int targetIndex_)
+{
+	const AbilityDefinition* buffDefinition = AbilityDefinition::GetAbilityDefinition(buffID_);
+
+	// Same as Ability::ApplyBuff followed by Unit::ApplyBuff, the buffed unit is both caster and target of the buff;
+	int buffedUnitIndex = -1;
+	switch (buffDefinition->m_targetChoice)
+	{
+		case TargetChoice::SELF:	{ buffedUnitIndex = casterIndex_; break; }
+		case TargetChoice::RANDOM:	{ buffedUnitIndex = targetIndex_; break; }
+		default:
+		{
+			ERROR_AND_DIE("Unknown buff target choice.");
+			break;
+		}
+	}
+
+	BattleUnit& buffedUnit = m_units[buffedUnitIndex];
+	ApplyEffect(buffedUnit.m_buffs, buffedUnit.m_buffCount, buffID_, buffedUnitIndex, buffedUnitIndex);
+}
+
+// ------------------------------------------------------------------
+void BattleSimulator::Disspell(int targetIndex_)
+{
+	BattleUnit& target = m_units[targetIndex_];
+	for (int statusIndex = 0; statusIndex < target.m_statusEffectCount; ++statusIndex)
+	{
+		target.m_statusEffects[statusIndex].m_disspelled = true;
+	}
+}
+
+// ------------------------------------------------------------------
+void BattleSimulator::RemoveDisspelledEffects(BattleUnit& unit_)
+{
+	int keptStatusEffects = 0;
+	for (int statusIndex = 0; statusIndex < unit_.m_statusEffectCount; ++statusIndex)
+	{
+		if (!unit_.m_statusEffects[statusIndex].m_disspelled)
+		{
+			unit_.m_statusEffects[keptStatusEffects++] = unit_.m_statusEffects[statusIndex];
+		}
+	}
+	unit_.m_statusEffectCount = keptStatusEffects;
+
+	int keptBuffs = 0;
+	for (int buffIndex = 0; buffIndex < unit_.m_buffCount; ++buffIndex)
+	{
+		if (!unit_.m_buffs[buffIndex].m_disspelled)
+		{
+			unit_.m_buffs[keptBuffs++] = unit_.m_buffs[buffIndex];
+		}
+	}
+	unit_.m_buffCount = keptBuffs;
+}
+
+// ------------------------------------------------------------------
+void BattleSimulator::KillUnit(BattleUnit& unit_)
+{
+	// Same as Unit::CheckForCleanupOfAbilities when health hits 0;
+	unit_.m_health = 0;
+	unit_.m_statusEffectCount = 0;
+	unit_.m_buffCount = 0;
+	unit_.m_debuffCount = 0;
+}
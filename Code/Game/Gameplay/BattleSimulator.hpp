@@ -0,0 +1,128 @@
+#pragma once
+
+// -----------------------------------------------------------------------
+#include "Engine/Core/RandomNumberGenerator.hpp"
+
+// -----------------------------------------------------------------------
+#include "Game/Units/UnitDefinition.hpp"
+
+#include <vector>
+
+class Unit;
+class Units;
+class AbilityDefinition;
+
+// -----------------------------------------------------------------------
+// Headless battle resolution. Two line-ups and a seed go in, a result comes out;
+// No renderer, dev console, RakNet or animation timers are touched, every term in
+// an ability sequence fires exactly once in sequence order (all terms in the data have a duration of 0);
+// -----------------------------------------------------------------------
+
+constexpr int BATTLE_SIDE_DRAW = -1;
+constexpr int BATTLE_SIDE_FIRST = 0;
+constexpr int BATTLE_SIDE_SECOND = 1;
+constexpr int BATTLE_SIDE_COUNT = 2;
+
+// -----------------------------------------------------------------------
+struct BattleResult
+{
+	int m_winningSide = BATTLE_SIDE_DRAW;
+	int m_damageToLosingPlayer = 0;						// Number of units the winning side has left alive;
+	int m_turnsTaken = 0;
+	int m_damageDealt[BATTLE_SIDE_COUNT] = { 0, 0 };
+	int m_healingDone[BATTLE_SIDE_COUNT] = { 0, 0 };
+	bool m_hitTurnLimit = false;						// Both sides still had units after MAX_TURNS, scored as a draw;
+	int m_effectsDropped = 0;							// Effects not applied because the unit already had MAX_EFFECTS;
+};
+
+// -----------------------------------------------------------------------
+// Status, Buff or Debuff living on a unit; the caster's stats are used when it runs;
+struct BattleEffect
+{
+	const AbilityDefinition* m_abilityDefinition = nullptr;
+	int m_casterIndex = -1;
+	int m_targetIndex = -1;
+	int m_timesRun = 0;									// Damage term modifiers above 1 grow by one each run;
+	bool m_disspelled = false;
+};
+
+// -----------------------------------------------------------------------
+struct BattleUnit
+{
+	// Per kind; past it a new effect is dropped and counted in BattleResult::m_effectsDropped;
+	static constexpr int MAX_EFFECTS = 8;
+
+	const UnitDefinition* m_unitDefinition = nullptr;
+	JobType m_type = JobType::INVALID;
+	int m_side = BATTLE_SIDE_FIRST;
+	int m_maxHealth = 0;
+	int m_health = 0;
+	int m_strength = 0;
+	int m_intellect = 0;
+	int m_wisdom = 0;
+	int m_constitution = 0;
+
+	BattleEffect m_statusEffects[MAX_EFFECTS];
+	BattleEffect m_buffs[MAX_EFFECTS];
+	BattleEffect m_debuffs[MAX_EFFECTS];
+	int m_statusEffectCount = 0;
+	int m_buffCount = 0;
+	int m_debuffCount = 0;
+
+	// Stats;
+	int m_turnsTaken = 0;
+	int m_damageDealt = 0;
+	int m_healingDone = 0;
+};
+
+// -----------------------------------------------------------------------
+class BattleSimulator
+{
+
+public:
+
+	static constexpr int MAX_TURNS = 1000;
+
+	BattleSimulator() = default;
+	~BattleSimulator() = default;
+
+	// Setup;
+	void Reset();
+	void AddUnit(int side_, JobType unitType_);
+	void AddUnit(int side_, const Unit* unit_);
+	void AddUnits(int side_, Units& units_);
+	void AddUnits(int side_, const std::vector<JobType>& unitTypes_);
+
+	// Resolves the battle from the line-ups, side BATTLE_SIDE_FIRST takes the first turn;
+	// Line-ups are left untouched so Run can be called again with another seed;
+	BattleResult Run(unsigned int seed_);
+
+	// Getters;
+	const std::vector<BattleUnit>& GetBattleUnits() const;
+
+private:
+
+	// Turns;
+	void GatherAliveUnits();
+	void TakeTurn(int side_);
+	int PickMainAbilityTarget(const AbilityDefinition* abilityDefinition_, int side_);
+	int PickRandomFromDamageBand(const std::vector<int>& candidates_, bool mostDamaged_);
+
+	// Abilities;
+	void RunAbility(BattleEffect& effect_);
+	void ApplyDamageOrHealing(BattleEffect& effect_, int damageModifier_);
+	void ApplyEffect(BattleEffect* effects_, int& effectCount_, StringID abilityID_, int casterIndex_, int targetIndex_);
+	void ApplyBuff(StringID buffID_, int casterIndex_, int targetIndex_);
+	void Disspell(int targetIndex_);
+	void RemoveDisspelledEffects(BattleUnit& unit_);
+	void KillUnit(BattleUnit& unit_);
+
+private:
+
+	RandomNumberGenerator m_randomNumberGenerator;
+	std::vector<BattleUnit> m_lineUps;
+	std::vector<BattleUnit> m_units;
+	std::vector<int> m_aliveUnits[BATTLE_SIDE_COUNT];
+	int m_attackingUnitIndex[BATTLE_SIDE_COUNT] = { 0, 0 };
+	BattleResult m_result;
+};
@@ -27,6 +27,16 @@
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/UI/UIWidget.hpp"
 #include "Engine/Input/InputSystem.hpp"
+#include "Engine/Memory/ArenaAllocator.hpp"
+#include "Engine/Async/AsyncQueueBenchmark.hpp"
+#include "Engine/Job/AssetLoader.hpp"
+#include "Engine/Renderer/VertexFormatBenchmark.hpp"
+#include "Engine/Core/ImageBenchmark.hpp"
+#include "Engine/Renderer/MeshImportBenchmark.hpp"
+#include "Engine/Profile/ProfileBenchmark.hpp"
+#include "Engine/Memory/BlockAllocatorBenchmark.hpp"
+#include "Engine/Core/PackArchive.hpp"
+#include "Engine/Core/FileUtils.hpp"
 
 // Game Includes ----------------------------------------------------------------------------------
 #include "Game/Framework/App.hpp"
@@ -40,6 +50,7 @@
 #include "Game/Cards/CardFilters.hpp"
 #include "Game/Gameplay/PlayerFilters.hpp"
 #include "Game/Gameplay/Player.hpp"
+#include "Game/Gameplay/BalanceRunner.hpp"
 
 // Third Party Includes ----------------------------------------------------------------------------
 #include "ThirdParty/RakNet/RakNetInterface.hpp"
@@ -70,9 +81,9 @@ static bool TestBinaryFileLoad(EventArgs& args)
 	const char* testFilePath = "Data/Test/Test.binary";
 	g_theDevConsole->Print(Stringf("Loading test binary file '%s'...\n", testFilePath));
 
-	// Load from disk
-	Buffer buff;
-	bool success = BufferWriter::LoadBinaryFileToExistingBuffer(testFilePath, &buff);
+	// Load from the pack archive or disk, parsed in place
+	DataFile testFile;
+	bool success = testFile.Open(testFilePath);
 	if (!success)
 	{
 		g_theDevConsole->Print(Stringf("FAILED to load file %s\n", testFilePath));
@@ -80,7 +91,7 @@ static bool TestBinaryFileLoad(EventArgs& args)
 	}
 
 	// Parse and verify - note that the test data is in the file TWICE; first as little-endian, then again as big
-	BufferParser bufParse(buff);
+	BufferParser bufParse(testFile.GetData(), testFile.GetSize());
 	g_theApp->m_theGame->ParseTestFileBufferData(bufParse, BufferEndian::LITTLE);
 	g_theApp->m_theGame->ParseTestFileBufferData(bufParse, BufferEndian::BIG);
 
@@ -98,6 +109,135 @@ static bool TestBinaryFileSave(EventArgs& args)
 	return true;
 }
 
+// -----------------------------------------------------------------------
+// balance_run battles=100000 lineup=5 seed=0 file=Data/BalanceResults.binary;
+static bool RunBalance(EventArgs& args)
+{
+	BalanceRunSettings settings;
+	settings.m_battleCount	= args.GetValue("battles", settings.m_battleCount);
+	settings.m_lineUpSize	= args.GetValue("lineup", settings.m_lineUpSize);
+	settings.m_seed			= (unsigned int)args.GetValue("seed", (int)settings.m_seed);
+	settings.m_filepath		= args.GetValue("file", settings.m_filepath);
+
+	return g_theApp->m_theGame->m_balanceRunner->Start(settings);
+}
+
+// -----------------------------------------------------------------------
+// queue_bench threads=8 items=200000;
+static bool RunQueueBenchmark(EventArgs& args)
+{
+	int maxThreads			= args.GetValue("threads", 8);
+	int itemsPerProducer	= args.GetValue("items", 200000);
+
+	RunAsyncQueueBenchmark(maxThreads, itemsPerProducer);
+	return true;
+}
+
+// -----------------------------------------------------------------------
+// vertex_bench quads=20000 frames=100;
+static bool RunVertexBenchmark(EventArgs& args)
+{
+	int quadsPerFrame	= args.GetValue("quads", 20000);
+	int frames			= args.GetValue("frames", 100);
+
+	RunVertexFormatBenchmark(quadsPerFrame, frames);
+	return true;
+}
+
+// -----------------------------------------------------------------------
+// image_bench iterations=20; the backgrounds the game loads, plus the loading screen;
+static bool RunPixelBenchmark(EventArgs& args)
+{
+	int iterations = args.GetValue("iterations", 20);
+
+	std::vector<std::string> imagePaths =
+	{
+		"Data/Images/Backgrounds/DesertBackground.png",
+		"Data/Images/Backgrounds/PlainsBackground.png",
+		"Data/Images/Backgrounds/DungeonBackground.png",
+		"Data/Images/Backgrounds/Library.png",
+		"Data/Images/Backgrounds/Loading.png"
+	};
+
+	RunImageBenchmark(imagePaths, iterations);
+	return true;
+}
+
+// -----------------------------------------------------------------------
+// mesh_bench iterations=5; the biggest buildings the game loads;
+static bool RunMeshBenchmark(EventArgs& args)
+{
+	int iterations = args.GetValue("iterations", 5);
+
+	std::vector<std::string> objPaths =
+	{
+		"Data/Models/towncenter.obj",
+		"Data/Models/GoblinHut.obj",
+		"Data/Models/GoblinTower.obj",
+		"Data/Models/Armory.obj",
+		"Data/Models/Tower.obj"
+	};
+
+	RunMeshImportBenchmark(objPaths, iterations);
+	return true;
+}
+
+// -----------------------------------------------------------------------
+// profile_bench scopes=1000000 threads=4;
+static bool RunProfileBenchmark(EventArgs& args)
+{
+	int scopes = args.GetValue("scopes", 1'000'000);
+	int threads = args.GetValue("threads", 4);
+
+	RunProfileScopeBenchmark(scopes, threads);
+	return true;
+}
+
+// -----------------------------------------------------------------------
+// block_bench threads=8 ops=1000000;
+static bool RunBlockBenchmark(EventArgs& args)
+{
+	int maxThreads			= args.GetValue("threads", 8);
+	int operationsPerThread	= args.GetValue("ops", 1'000'000);
+
+	RunBlockAllocatorBenchmark(maxThreads, operationsPerThread);
+	return true;
+}
+
+// -----------------------------------------------------------------------
+// pack_build src=Data out=Data.pack; Data.pack is remounted after, so the game reads from the new one;
+static bool BuildDataPack(EventArgs& args)
+{
+	std::string sourceFolder	= args.GetValue("src", std::string("Data"));
+	std::string archivePath		= args.GetValue("out", std::string(DATA_PACK_PATH));
+
+	// Only the mounted archive has to come down to be rewritten; any other out leaves it where it is;
+	// Files handed out from the old archive point into its mapping, so nothing may be loading while it's swapped;
+	bool isMountedArchive = (archivePath == DATA_PACK_PATH);
+	if(isMountedArchive)
+	{
+		g_theAssetLoader->FinishAll();
+		g_thePackArchive->Close();
+	}
+
+	PackBuildStats stats;
+	bool success = BuildPackArchive(sourceFolder, archivePath, PackBuildOptions(), &stats);
+	if(success)
+	{
+		g_theDevConsole->Print(Stringf("Packed %u files (%u compressed) from %s: %.1f MB -> %.1f MB in %s", stats.m_fileCount, stats.m_compressedCount, sourceFolder.c_str(),
+			(double)stats.m_sourceBytes / (1024.0 * 1024.0), (double)stats.m_archiveBytes / (1024.0 * 1024.0), archivePath.c_str()));
+	}
+	else
+	{
+		g_theDevConsole->Print(Stringf("FAILED to pack %s into %s", sourceFolder.c_str(), archivePath.c_str()));
+	}
+
+	if(isMountedArchive)
+	{
+		g_thePackArchive->Open(DATA_PACK_PATH);
+	}
+	return success;
+}
 
 // -----------------------------------------------------------------------
 static bool SetDevConsoleFontToFixedWidth16x16(EventArgs& args)
@@ -139,6 +279,7 @@ Game::~Game()
 	DELETE_POINTER(m_gameMainCamera);
 	DELETE_POINTER(m_uiCamera);
 	DELETE_POINTER(m_lobbyConsole);
+	DELETE_POINTER(m_balanceRunner);
 }
 
 // -----------------------------------------------------------------------
@@ -164,10 +305,19 @@ void Game::Init()
 	g_theEventSystem->SubscriptionEventCallbackFunction("test_fixedwidth", SetDevConsoleFontToFixedWidth16x16);
 	g_theEventSystem->SubscriptionEventCallbackFunction("test_proportional", SetDevConsoleFontToProportionalFont);
 	g_theEventSystem->SubscriptionEventCallbackFunction("test_fntfile", SetDevConsoleFontToFontUsingFNTFile);
+	g_theEventSystem->SubscriptionEventCallbackFunction("balance_run", RunBalance);
+	g_theEventSystem->SubscriptionEventCallbackFunction("queue_bench", RunQueueBenchmark);
+	g_theEventSystem->SubscriptionEventCallbackFunction("vertex_bench", RunVertexBenchmark);
+	g_theEventSystem->SubscriptionEventCallbackFunction("image_bench", RunPixelBenchmark);
+	g_theEventSystem->SubscriptionEventCallbackFunction("mesh_bench", RunMeshBenchmark);
+	g_theEventSystem->SubscriptionEventCallbackFunction("profile_bench", RunProfileBenchmark);
+	g_theEventSystem->SubscriptionEventCallbackFunction("block_bench", RunBlockBenchmark);
+	g_theEventSystem->SubscriptionEventCallbackFunction("pack_build", BuildDataPack);
 
 	m_gameMainCamera	= new Camera();
 	m_uiCamera			= new Camera();
 	m_lobbyConsole		= new LobbyConsole(this);
+	m_balanceRunner		= new BalanceRunner();
 
 	m_gameMainCamera->SetOrthographicProjection(Vec2::ZERO, Vec2(Map::WIDTH, Map::HEIGHT));
 	m_uiCamera->SetOrthographicProjection(Vec2::ZERO, Vec2(Map::WIDTH, Map::HEIGHT));
@@ -202,22 +352,6 @@ void Game::BeginFrame()
 	m_lobbyConsole->BeginFrame();
 }
 
-// -----------------------------------------------------------------------
-void Game::AsyncLoading()
-{
-	if (m_gameStateLoading == GAMESTATELOADING_LOADING)
-	{
-		if (!DoneLoading())
-		{
-			ContinueLoading();
-		}
-		else
-		{
-			EndLoadingThreads();
-		}
-	}
-}
-
 // -----------------------------------------------------------------------
 void Game::Update(float deltaSeconds_)
 {
@@ -301,8 +435,14 @@ void Game::EndFrame()
 		g_theAudioSystem->StopSound(m_mainMenuMusicPlaybackID);
 		m_mainMenuMusicPlaying = false;
 
+		// Normally streamed in long before, this only waits if the match starts first;
+		g_theAssetLoader->FinishAll();
+
 		m_gameState = GAMESTATE_PLAY;
 	}
+
+	// Everything this frame put in the main thread's frame arena is done with;
+	ArenaReset(ARENA_FRAME);
 }
 
 // -----------------------------------------------------------------------
@@ -314,7 +454,6 @@ bool Game::CheckLoading(float deltaSeconds_)
 	{
 		if (m_gameState == GAMESTATE_STARTUP)
 		{
-			AsyncLoading();
 			UpdateLoadingScreen(deltaSeconds_);
 		}
 
@@ -328,7 +467,6 @@ bool Game::CheckLoading(float deltaSeconds_)
 void Game::CreateLoadingScreen()
 {
 	m_screenBackground = AABB2::MakeFromMinsMaxs(Vec2((float)m_clientMins.x, (float)m_clientMins.y), Vec2((float)m_clientMaxs.x, (float)m_clientMaxs.y));
-	m_screenBackgroundTexture = g_theRenderer->CreateOrGetTextureViewFromFile("Data/Images/SplashScreens/Loading.png");
 }
 
 // -----------------------------------------------------------------------
@@ -346,10 +484,11 @@ void Game::UpdateLoadingScreen(float deltaSeconds_)
 	}
 
 	m_loadingBarWidth = Map::WIDTH * 0.7f;
-	m_loadingRatio = 1.0f - ((float)m_objectLoading / (float)m_objectsToLoad);
+	m_loadingRatio = g_theAssetLoader->GetProgress();
 	m_loadingBarProgress = m_loadingBarWidth * m_loadingRatio;
 
-	if(m_loadingRatio == 1.0f)
+	// The main menu only needs its own assets, the gameplay ones keep streaming in behind it;
+	if(g_theAssetLoader->IsPriorityDone(ASSET_PRIORITY_MAIN_MENU))
 	{
 		m_loadingMessage = "Press Space...";
 		if(g_theInputSystem->IsSpaceDown())
@@ -363,12 +502,16 @@ void Game::UpdateLoadingScreen(float deltaSeconds_)
 // -----------------------------------------------------------------------
 void Game::RenderLoadingScreen()
 {
-	AABB2 background = AABB2::MakeFromMinsMaxs(Vec2(0.0f, 0.0f), Vec2(Map::WIDTH, Map::HEIGHT));
-	std::vector<Vertex_PCU> backgroundVerts;
-	AddVertsForAABB2D(backgroundVerts, background, Rgba::WHITE);
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile("Data/Images/Backgrounds/Loading.png"));
-	g_theRenderer->DrawVertexArray((int)backgroundVerts.size(), &backgroundVerts[0]);
+	// Black until the background is in, asking the renderer for it now would load it on this thread;
+	if(g_theAssetLoader->IsLoaded("Data/Images/Backgrounds/Loading.png"))
+	{
+		AABB2 background = AABB2::MakeFromMinsMaxs(Vec2(0.0f, 0.0f), Vec2(Map::WIDTH, Map::HEIGHT));
+		std::vector<Vertex_PCU> backgroundVerts;
+		AddVertsForAABB2D(backgroundVerts, background, Rgba::WHITE);
+		g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
+		g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile("Data/Images/Backgrounds/Loading.png"));
+		g_theRenderer->DrawVertexArray((int)backgroundVerts.size(), &backgroundVerts[0]);
+	}
 
 	if(m_loadingRatio != 1.0f)
 	{
@@ -531,158 +674,71 @@ void Game::StartLoadingAssets()
 	UnitDefinition::LoadUnitsFromXML("Data/XML/Units.xml");
 	CardDefinition::LoadCardsFromXML("Data/XML/Cards.xml");
 
-	EnqueueWorkForTexturesAndGPUMeshes();
+	RequestTexturesAndMeshes();
 
-	uint coreCount = std::thread::hardware_concurrency();
-	for (uint i = 0; i < coreCount; ++i)
-	{
-		m_threads.emplace_back(CallImageAndMeshLoadThread);
-	}
+	m_gameStateLoading = GAMESTATELOADING_LOADING;
 }
 
 // -----------------------------------------------------------------------
-void Game::EnqueueWorkForTexturesAndGPUMeshes()
+// Loaded by g_theAssetLoader on the JobSystem, the loading screen first, then the main menu, then the rest;
+// The Match's sprite sheets request their own textures;
+// -----------------------------------------------------------------------
+void Game::RequestTexturesAndMeshes()
 {
+	// Loading Screen;
+	g_theAssetLoader->RequestTexture("Data/Images/Backgrounds/Loading.png", ASSET_PRIORITY_LOADING_SCREEN);
+
+	// Main Menu;
+	g_theAssetLoader->RequestTexture("Data/Sprites/Pointer.png", ASSET_PRIORITY_MAIN_MENU);
+	g_theAssetLoader->RequestTexture("Data/Sprites/MenuSelection.png", ASSET_PRIORITY_MAIN_MENU);
+
 	// Units;
-	StartLoadingTexture("Data/Sprites/Knight.png");
-	StartLoadingTexture("Data/Sprites/Blackmage.png");
-	StartLoadingTexture("Data/Sprites/Archer.png");
-	StartLoadingTexture("Data/Sprites/Warrior.png");
-	StartLoadingTexture("Data/Sprites/Whitemage.png");
-	StartLoadingTexture("Data/Sprites/Paladin.png");
-	StartLoadingTexture("Data/Sprites/Dragoon.png");
+	g_theAssetLoader->RequestTexture("Data/Sprites/Knight.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Blackmage.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Archer.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Warrior.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Whitemage.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Paladin.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Dragoon.png", ASSET_PRIORITY_GAMEPLAY);
 
 	// Portraits;
-	StartLoadingTexture("Data/Sprites/KnightPortrait.png");
-	StartLoadingTexture("Data/Sprites/BlackmagePortrait.png");
-	StartLoadingTexture("Data/Sprites/ArcherPortrait.png");
-	StartLoadingTexture("Data/Sprites/WarriorPortrait.png");
-	StartLoadingTexture("Data/Sprites/WhitemagePortrait.png");
-	StartLoadingTexture("Data/Sprites/PaladinPortrait.png");
-	StartLoadingTexture("Data/Sprites/DragoonPortrait.png");
+	g_theAssetLoader->RequestTexture("Data/Sprites/KnightPortrait.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/BlackmagePortrait.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/ArcherPortrait.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/WarriorPortrait.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/WhitemagePortrait.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/PaladinPortrait.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/DragoonPortrait.png", ASSET_PRIORITY_GAMEPLAY);
 
 	// Ability;
-	StartLoadingTexture("Data/Sprites/Abilities/Fire.png");
-	StartLoadingTexture("Data/Sprites/Abilities/Cure.png");
-	StartLoadingTexture("Data/Sprites/Abilities/Burn.png");
-	StartLoadingTexture("Data/Sprites/Abilities/Shimmer.png");
-	StartLoadingTexture("Data/Sprites/Abilities/Bleed.png");
+	g_theAssetLoader->RequestTexture("Data/Sprites/Abilities/Fire.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Abilities/Cure.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Abilities/Burn.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Abilities/Shimmer.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Abilities/Bleed.png", ASSET_PRIORITY_GAMEPLAY);
 
 	// Effects;
-	StartLoadingTexture("Data/Sprites/Effects/PhysicalHit.png");
+	g_theAssetLoader->RequestTexture("Data/Sprites/Effects/PhysicalHit.png", ASSET_PRIORITY_GAMEPLAY);
 
 	// Cards;
-	StartLoadingTexture("Data/Sprites/CardBorder.png");
-	StartLoadingTexture("Data/Sprites/JobIcons.png");
+	g_theAssetLoader->RequestTexture("Data/Sprites/CardBorder.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/JobIcons.png", ASSET_PRIORITY_GAMEPLAY);
 
 	// Purchase Phase;
-	StartLoadingTexture("Data/Sprites/Reroll.png");
-	StartLoadingTexture("Data/Sprites/Freeze.png");
-	StartLoadingTexture("Data/Sprites/TimerDisplay.png");
-	StartLoadingTexture("Data/Sprites/GoldIcon.png");
-	StartLoadingTexture("Data/Sprites/GoldIconBackground.png");
-	StartLoadingTexture("Data/Sprites/Lock.png");
+	g_theAssetLoader->RequestTexture("Data/Sprites/Reroll.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Freeze.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/TimerDisplay.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/GoldIcon.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/GoldIconBackground.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Sprites/Lock.png", ASSET_PRIORITY_GAMEPLAY);
 
 	// Battle Phase;
-	StartLoadingTexture("Data/Images/Backgrounds/DesertBackground.png");
-	StartLoadingTexture("Data/Images/Backgrounds/PlainsBackground.png");
-	StartLoadingTexture("Data/Images/Backgrounds/DungeonBackground.png");
+	g_theAssetLoader->RequestTexture("Data/Images/Backgrounds/DesertBackground.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Images/Backgrounds/PlainsBackground.png", ASSET_PRIORITY_GAMEPLAY);
+	g_theAssetLoader->RequestTexture("Data/Images/Backgrounds/DungeonBackground.png", ASSET_PRIORITY_GAMEPLAY);
 
 	// Purchase Phase;
-	StartLoadingTexture("Data/Images/Backgrounds/Library.png");
-
-	// Misc;
-	StartLoadingTexture("Data/Sprites/Pointer.png");
-	StartLoadingTexture("Data/Sprites/MenuSelection.png");
-
-	m_gameStateLoading = GAMESTATELOADING_LOADING;
-	m_objectsToLoad = m_objectLoading;
-}
-
-// -----------------------------------------------------------------------
-void Game::ImageAndMeshLoadThread()
-{
-	bool doneLoading = false;
-
-	ImageLoading imageLoading;
-	CPUMeshLoading cpuLoading;
-
-	while (!doneLoading)
-	{
-		bool gotImageWork = imageLoadingFromDiscQueue.Dequeue(&imageLoading);
-		if (gotImageWork)
-		{
-			imageLoading.image = new Image(imageLoading.imageName.c_str());
-			imageCreatingTextureQueue.Enqueue(imageLoading);
-		}
-
-		bool gotCPUWork = cpuLoadingFromDiscQueue.Dequeue(&cpuLoading);
-		if (gotCPUWork)
-		{
-			cpuLoading.cpuMesh = new CPUMesh();
-			cpuLoading.cpuMesh->SetLayout<Vertex_Lit>();
-			CreateMeshFromFile(cpuLoading.meshName.c_str(), cpuLoading.cpuMesh);
-			cpuCreatingGPUMeshQueue.Enqueue(cpuLoading);
-		}
-
-		if (!gotImageWork && !gotCPUWork)
-		{
-			doneLoading = true;
-		}
-
-		Sleep(0);
-	}
-}
-
-// -----------------------------------------------------------------------
-void Game::StartLoadingTexture(std::string nameOfTexture)
-{
-	ImageLoading loading = ImageLoading(nameOfTexture);
-
-	m_objectLoading++;
-	imageLoadingFromDiscQueue.Enqueue(loading);
-}
-
-// -----------------------------------------------------------------------
-void Game::ContinueLoading()
-{
-	ImageLoading imageLoading;
-	CPUMeshLoading cpuLoading;
-
-	bool gotImageWork = imageCreatingTextureQueue.Dequeue(&imageLoading);
-	if (gotImageWork)
-	{
-		g_theRenderer->CreateTextureViewFromImage(imageLoading.image, imageLoading.imageName);
-		m_objectLoading--;
-		delete imageLoading.image;
-		imageLoading.image = nullptr;
-	}
-
-	bool gotGPUWork = cpuCreatingGPUMeshQueue.Dequeue(&cpuLoading);
-	if (gotGPUWork)
-	{
-		g_theRenderer->CreateAndRegisterGPUMesh(cpuLoading.cpuMesh, cpuLoading.meshName);
-		m_objectLoading--;
-		delete cpuLoading.cpuMesh;
-		cpuLoading.cpuMesh = nullptr;
-	}
-}
-
-// -----------------------------------------------------------------------
-bool Game::DoneLoading()
-{
-	return m_objectLoading == 0;
-}
-
-// -----------------------------------------------------------------------
-void Game::EndLoadingThreads()
-{
-	for (std::thread& thread : m_threads)
-	{
-		thread.join();
-	}
-
-	m_threads.clear();
+	g_theAssetLoader->RequestTexture("Data/Images/Backgrounds/Library.png", ASSET_PRIORITY_GAMEPLAY);
 }
 
 // -----------------------------------------------------------------------
@@ -895,21 +951,6 @@ void Game::OnIncomingPacket(RakNet::Packet* packet)
 			break;
 		}
 
-		// ----------------------------------
-		case S_WINNEROFMATCHBEINGREPORTED:
-		{
-			if (g_theRakNetInterface->m_connection == ConnectionType::SERVER)
-			{
-				g_theRakNetInterface->ProcessMatchReport(packet);
-			}
-			else
-			{
-				ERROR_AND_DIE("A non-server application has received a SERVER_MESSAGE.");
-			}
-
-			break;
-		}
-
 		// ----------------------------------
 		case C_LOBBYMESSAGE:
 		{
@@ -1055,7 +1096,7 @@ void Game::OnIncomingPacket(RakNet::Packet* packet)
 				int receivedCardAmount = -1;
 				bsIn.Read(receivedCardAmount);
 
-				int handcards = g_Interface->query().GetCardCount(CardInHand());
+				int handcards = g_Interface->query().CountCards(CardInHand());
 				GUARANTEE_OR_DIE((receivedCardAmount + handcards) <= 3, "Received an Overflow of cards for players hand.");
 
 				for (int i = 0; i < receivedCardAmount; ++i)
@@ -1276,6 +1317,35 @@ void Game::OnIncomingPacket(RakNet::Packet* packet)
 			break;
 		}
 
+		// ----------------------------------
+		case C_RECIEVEMATCHRESULTFORBATTLE:
+		{
+			if (g_theRakNetInterface->m_connection == ConnectionType::CLIENT)
+			{
+				RakNet::BitStream bsIn(packet->data, packet->length, false);
+				bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+				int winningPlayerID = 0;
+				int losingPlayerID = 0;
+				int damageDealtToLosingPlayer = 0;
+				int matchID = 0;
+				bool ignore = false;
+				bsIn.Read(winningPlayerID);
+				bsIn.Read(losingPlayerID);
+				bsIn.Read(damageDealtToLosingPlayer);
+				bsIn.Read(matchID);
+				bsIn.Read(ignore);
+
+				MatchReport matchResult(winningPlayerID, losingPlayerID, damageDealtToLosingPlayer, matchID, ignore);
+				g_Interface->client().SetMatchResultForThisBattlePhase(matchResult);
+			}
+			else
+			{
+				ERROR_AND_DIE("A non-client application has received a CLIENT_MESSAGE.");
+			}
+
+			break;
+		}
+
 		// ----------------------------------
 		case C_YOUWINTHEGAME:
 		{
@@ -1387,7 +1457,7 @@ void Game::SetIsReady(bool isReady)
 void Game::LoadGameConfigFromXML(std::string xmlPath_)
 {
 	tinyxml2::XMLDocument gameConfigXMLDoc;
-	gameConfigXMLDoc.LoadFile(xmlPath_.c_str());
+	LoadXmlDocument(gameConfigXMLDoc, xmlPath_);
 
 	if (gameConfigXMLDoc.ErrorID() != tinyxml2::XML_SUCCESS)
 	{
@@ -1489,11 +1559,3 @@ void Game::ParseTestFileBufferData(BufferParser& bufParse, BufferEndian endianMo
 	GUARANTEE_RECOVERABLE(vertex.color == vcolorCheck, "");
 	GUARANTEE_RECOVERABLE(vertex.uvTexCoords == Vec2(0.125f, 0.625f), "");
 }
-
-// -----------------------------------------------------------------------
-// static;
-// -----------------------------------------------------------------------
-void CallImageAndMeshLoadThread()
-{
-	g_theApp->m_theGame->ImageAndMeshLoadThread();
-}
\ No newline at end of file
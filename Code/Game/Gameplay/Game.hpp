@@ -16,6 +16,7 @@ class Map;
 class Interface;
 class TextureView;
 class LobbyConsole;
+class BalanceRunner;
 
 enum GameStateLoading
 {
@@ -57,24 +58,6 @@ namespace RakNet
 	struct SystemAddress;
 }
 
-struct ImageLoading
-{
-	ImageLoading(){}
-	ImageLoading(std::string name_):imageName(name_){}
-
-	std::string imageName;
-	Image* image;
-};
-
-struct CPUMeshLoading
-{
-	CPUMeshLoading() {}
-	CPUMeshLoading(std::string name_):meshName(name_){}
-
-	std::string meshName;
-	CPUMesh* cpuMesh;
-};
-
 class Game
 {
 	
@@ -88,7 +71,6 @@ public:
 	void Init();
 	void Startup();
 	void BeginFrame();
-	void AsyncLoading();
 	void Update(float deltaSeconds_);
 	void Render();
 	void EndFrame();
@@ -109,12 +91,7 @@ public:
 
 	// Async Loading and Assets;
 	void StartLoadingAssets();
-	void EnqueueWorkForTexturesAndGPUMeshes();
-	void ImageAndMeshLoadThread();
-	void StartLoadingTexture(std::string nameOfTexture);
-	void ContinueLoading();
-	bool DoneLoading();
-	void EndLoadingThreads();
+	void RequestTexturesAndMeshes();
 
 	// RakNet;
 	void OnIncomingPacket(RakNet::Packet* packet);
@@ -149,6 +126,7 @@ public:
 	
 	
 	LobbyConsole* m_lobbyConsole = nullptr;
+	BalanceRunner* m_balanceRunner = nullptr;
 	std::string hostIP = "";
 	std::string m_username = "";
 
@@ -168,17 +146,9 @@ public:
 
 	// Screens;
 	AABB2 m_screenBackground;
-	TextureView* m_screenBackgroundTexture = nullptr;
 
 	// Async Loading and Assets;
 	GameStateLoading m_gameStateLoading = GAMESTATELOADING_INVALID;
-	int m_objectLoading = 0;
-	int m_objectsToLoad = 100;
-	std::vector<std::thread> m_threads;
-	AsyncQueue<ImageLoading> imageLoadingFromDiscQueue;
-	AsyncQueue<ImageLoading> imageCreatingTextureQueue;
-	AsyncQueue<CPUMeshLoading> cpuLoadingFromDiscQueue;
-	AsyncQueue<CPUMeshLoading> cpuCreatingGPUMeshQueue;
 	float m_loadingBarWidth = 0.0f;
 	float m_loadingBarProgress = 0.0f;
 	float m_loadingRatio = 0.0f;
@@ -203,5 +173,3 @@ public:
 
 
 };
-
-void CallImageAndMeshLoadThread();
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Input/GameInput.hpp"
 #include "Game/Framework/Interface.hpp"
+#include "Game/Framework/RenderLayers.hpp"
 #include "Game/Gameplay/PlayerFIlters.hpp"
 #include "Game/Cards/CardFilters.hpp"
 
@@ -58,6 +59,13 @@ void BattleMap::StartTimer()
 	m_actionTimer = m_baseTimeBetweenAction;
 }
 
+// ------------------------------------------------------------------
+void BattleMap::SetBattleBackground(const std::string& filename_)
+{
+	g_theRenderer->ReleaseResource(m_battleBackgroundTexture);
+	m_battleBackgroundTexture = g_theRenderer->AcquireTextureView(filename_);
+}
+
 // ------------------------------------------------------------------
 void BattleMap::Update(float deltaSeconds_)
 {
@@ -68,15 +76,12 @@ void BattleMap::Update(float deltaSeconds_)
 // ------------------------------------------------------------------
 void BattleMap::Render()
 {
+	SpriteBatch& spriteBatch = g_theRenderer->GetSpriteBatch();
+
 	// Displaying background;
-	std::vector<Vertex_PCU> backgroundVerts;
-	AddVertsForAABB2D(backgroundVerts, m_background, Rgba::WHITE);
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_nameOfCurrentBattleBackground));
-	g_theRenderer->DrawVertexArray((int)backgroundVerts.size(), &backgroundVerts[0]);
+	spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_BACKGROUND, m_battleBackgroundTexture), m_background, Rgba::WHITE);
 
 	// Displaying names;
-	std::vector<Vertex_PCU> textVerts;
 	std::string friendlyUsername = g_Interface->GetPlayer()->GetPlayerUsername();
 	int currentHealth = (int)g_Interface->GetPlayer()->GetPlayerHealth();
 	std::string friendlyInformation = Stringf("%s: %d(hp)", friendlyUsername.c_str(), currentHealth);
@@ -86,19 +91,15 @@ void BattleMap::Render()
 	Vec2 friendlyUsernamePlacement = m_friendlyUsernameDisplay.center - Vec2(1.0f, 0.5f);
 	Vec2 enemyUsernamePlacement = m_enemyUsernameDisplay.center - Vec2(1.0f, 0.5f);
 
-	BitMapFont* textFont = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
+	BitMapFont* textFont = g_theRenderer->GetBitmapFont(GameFont());
+	std::vector<Vertex_PCU2D>& textVerts = spriteBatch.AppendVerts(GameSpriteKey(RENDER_LAYER_TEXT, textFont->GetTextureView()));
 	textFont->AddVertsForText2D(textVerts, friendlyUsernamePlacement, 1.0f, friendlyInformation, Rgba::WHITE);
 	textFont->AddVertsForText2D(textVerts, enemyUsernamePlacement, 1.0f, enemyInformation, Rgba::WHITE);
-	g_theRenderer->BindTextureView(0u, textFont->GetTextureView());
-	g_theRenderer->DrawVertexArray((int)textVerts.size(), &textVerts[0]);
 
 	// Displaying Battle Information Windows;
-	std::vector<Vertex_PCU> battleInformationWindowsVerts;
-	AddVertsForAABB2D(battleInformationWindowsVerts, m_friendlyBattleInformationWindow, Rgba::THREEQUART_FFBLUE);
-	AddVertsForAABB2D(battleInformationWindowsVerts, m_enemyBattleInformationWindow, Rgba::THREEQUART_FFBLUE);
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, nullptr);
-	g_theRenderer->DrawVertexArray((int)battleInformationWindowsVerts.size(), &battleInformationWindowsVerts[0]);
+	SpriteBatchKey windowKey = GameSpriteKey(RENDER_LAYER_MAP_UI, nullptr);
+	spriteBatch.AddQuad(windowKey, m_friendlyBattleInformationWindow, Rgba::THREEQUART_FFBLUE);
+	spriteBatch.AddQuad(windowKey, m_enemyBattleInformationWindow, Rgba::THREEQUART_FFBLUE);
 
 	/*
 	std::vector<Vertex_PCU> battleInformationUnitSlotVerts;
@@ -317,6 +318,13 @@ void PurchaseMap::Startup()
 
 	m_background = AABB2::MakeFromMinsMaxs(Vec2(0.0f, 0.0f), Vec2(WIDTH, HEIGHT));
 
+	m_backgroundTexture = g_theRenderer->AcquireTextureView("Data/Images/Backgrounds/Library.png");
+	m_rerollTexture = g_theRenderer->AcquireTextureView("Data/Sprites/Reroll.png");
+	m_freezeTexture = g_theRenderer->AcquireTextureView("Data/Sprites/Freeze.png");
+	m_timerDisplayTexture = g_theRenderer->AcquireTextureView("Data/Sprites/TimerDisplay.png");
+	m_goldIconBackgroundTexture = g_theRenderer->AcquireTextureView("Data/Sprites/GoldIconBackground.png");
+	m_goldIconTexture = g_theRenderer->AcquireTextureView("Data/Sprites/GoldIcon.png");
+
 	m_timer = m_timeForPurchasePhase;
 }
 
@@ -388,36 +396,21 @@ void PurchaseMap::Update(float deltaSeconds_)
 // ------------------------------------------------------------------
 void PurchaseMap::Render()
 {
+	SpriteBatch& spriteBatch = g_theRenderer->GetSpriteBatch();
+
 	// Displaying background;
-	std::vector<Vertex_PCU> backgroundVerts;
-	AddVertsForAABB2D(backgroundVerts, m_background, Rgba::WHITE);
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile("Data/Images/Backgrounds/Library.png"));
-	g_theRenderer->DrawVertexArray((int)backgroundVerts.size(), &backgroundVerts[0]);
+	spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_BACKGROUND, m_backgroundTexture), m_background, Rgba::WHITE);
 
 	// Reroll;
-	std::vector<Vertex_PCU> rerollVerts;
-	AddVertsForAABB2D(rerollVerts, m_rerollButton, Rgba::WHITE);
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Reroll.png"));
-	g_theRenderer->DrawVertexArray((int)rerollVerts.size(), &rerollVerts[0]);
+	spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_MAP_UI, m_rerollTexture), m_rerollButton, Rgba::WHITE);
 
 	// Reroll;
-	std::vector<Vertex_PCU> freezeVerts;
-	AddVertsForAABB2D(freezeVerts, m_freezeButton, Rgba::WHITE);
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/Freeze.png"));
-	g_theRenderer->DrawVertexArray((int)freezeVerts.size(), &freezeVerts[0]);
+	spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_MAP_UI, m_freezeTexture), m_freezeButton, Rgba::WHITE);
 
 	// Timer;
-	std::vector<Vertex_PCU> timerVerts;
-	AddVertsForAABB2D(timerVerts, m_timerDisplay, Rgba::WHITE);
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/TimerDisplay.png"));
-	g_theRenderer->DrawVertexArray((int)timerVerts.size(), &timerVerts[0]);
+	spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_MAP_UI, m_timerDisplayTexture), m_timerDisplay, Rgba::WHITE);
 
 	// Timer Text;
-	std::vector<Vertex_PCU> textVerts;
 	Vec2 center;
 	if(m_timer < 10.0f)
 	{
@@ -436,45 +429,30 @@ void PurchaseMap::Render()
 	Vec2 usernamePlacement = m_usernameDisplay.center - Vec2(1.0f, 0.5f);
 
 
-	BitMapFont* textFont = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
+	BitMapFont* textFont = g_theRenderer->GetBitmapFont(GameFont());
+	std::vector<Vertex_PCU2D>& textVerts = spriteBatch.AppendVerts(GameSpriteKey(RENDER_LAYER_TEXT, textFont->GetTextureView()));
 	textFont->AddVertsForText2D(textVerts, center, 1.0f, time, Rgba::WHITE);
 	textFont->AddVertsForText2D(textVerts, usernamePlacement, 1.0f, information, Rgba::WHITE);
-	g_theRenderer->BindTextureView(0u, textFont->GetTextureView());
-	g_theRenderer->DrawVertexArray((int)textVerts.size(), &textVerts[0]);
 
-	// Gold;
-	std::vector<Vertex_PCU> goldVertsBackground;
+	// Gold; the icons sit on top of their backgrounds, so they get the layer above;
 	Player* player = g_Interface->GetPlayer();
 	int goldAmount = player->GetActualGold();
 	if(goldAmount > 0)
 	{
+		SpriteBatchKey goldBackgroundKey = GameSpriteKey(RENDER_LAYER_MAP_UI, m_goldIconBackgroundTexture);
+		SpriteBatchKey goldKey = GameSpriteKey(RENDER_LAYER_MAP_ICONS, m_goldIconTexture);
 		for (int x = 0; x < goldAmount; ++x)
 		{
-			AddVertsForAABB2D(goldVertsBackground, m_ourGoldSlots[x], Rgba::WHITE);
-		}
-		g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-		g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/GoldIconBackground.png"));
-		g_theRenderer->DrawVertexArray((int)goldVertsBackground.size(), &goldVertsBackground[0]);
-	}	
-
-	std::vector<Vertex_PCU> goldVerts;
-	goldAmount = player->GetActualGold();
-	if(goldAmount > 0)
-	{
-		for (int x = 0; x < goldAmount; ++x)
-		{
-			AddVertsForAABB2D(goldVerts, m_ourGoldSlots[x], Rgba::WHITE);
+			spriteBatch.AddQuad(goldBackgroundKey, m_ourGoldSlots[x], Rgba::WHITE);
+			spriteBatch.AddQuad(goldKey, m_ourGoldSlots[x], Rgba::WHITE);
 		}
-		g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-		g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile("Data/Sprites/GoldIcon.png"));
-		g_theRenderer->DrawVertexArray((int)goldVerts.size(), &goldVerts[0]);
 	}
 
 	// Add "glow" around card in hand if we have right click focus;
 	if(m_rightMouseFocus)
 	{
 		AABB2 cardSlotToHighlight = m_ourHandSlots[m_cardSlotInHandToBePlaced];
-		std::vector<Vertex_PCU> highlightVerts;
+		std::vector<Vertex_PCU2D>& highlightVerts = spriteBatch.AppendVerts(GameSpriteKey(RENDER_LAYER_MAP_UI, nullptr));
 
 		Line cardTopBorder = Line(cardSlotToHighlight.GetTopLeft(), cardSlotToHighlight.GetTopRight(), 1.0f);
 		Line cardRightBorder = Line(cardSlotToHighlight.GetTopRight(), cardSlotToHighlight.GetBottomRight(), 1.0f);
@@ -500,10 +478,6 @@ void PurchaseMap::Render()
 			AddVertsForLine2D(highlightVerts, slotBottomBorder, Rgba::YELLOW);
 			AddVertsForLine2D(highlightVerts, slotLeftBorder, Rgba::YELLOW);
 		}
-
-		g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-		g_theRenderer->BindTextureViewWithSampler(0, nullptr);
-		g_theRenderer->DrawVertexArray((int)highlightVerts.size(), &highlightVerts[0]);
 	}
 }
 
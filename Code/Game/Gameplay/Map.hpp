@@ -2,6 +2,7 @@
 
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/Vec2.hpp"
+#include "Engine/Renderer/ResourceRegistry.hpp"
 
 // Why is this pure virtual? I dont think it should be.
 
@@ -58,6 +59,7 @@ public:
 	Vec2 GetCenterPositionOfSlotInEnemyField(int slot_);
 
 	void ResetActionTimer();
+	void SetBattleBackground(const std::string& filename_);
 
 public:
 
@@ -71,7 +73,7 @@ public:
 	Vec2 m_unitSlotDimensions;
 
 	AABB2 m_background = AABB2();
-	std::string m_nameOfCurrentBattleBackground = "";
+	TextureHandle m_battleBackgroundTexture;
 	AABB2 m_friendlyUsernameDisplay;
 	AABB2 m_enemyUsernameDisplay;
 
@@ -172,6 +174,14 @@ public:
 	AABB2 m_timerDisplay;
 	AABB2 m_usernameDisplay;
 	float m_timer = 0.0f;
+
+	// Textures; acquired in Startup;
+	TextureHandle m_backgroundTexture;
+	TextureHandle m_rerollTexture;
+	TextureHandle m_freezeTexture;
+	TextureHandle m_timerDisplayTexture;
+	TextureHandle m_goldIconBackgroundTexture;
+	TextureHandle m_goldIconTexture;
 	float m_timeForPurchasePhase = 30.0f;
 
 };
\ No newline at end of file
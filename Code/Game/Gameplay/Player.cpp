@@ -235,7 +235,7 @@ void Player::RemoveMyMarketCards()
 	{
 		if ((*itr)->m_cardArea == CardArea::MARKET)
 		{
-			delete *itr;
+			g_Interface->DestroyCard(*itr);
 			itr = m_cards.erase(itr);
 
 		}
@@ -258,7 +258,7 @@ void Player::RemoveMyHandCards()
 	{
 		if ((*itr)->m_cardArea == CardArea::HAND)
 		{
-			delete *itr;
+			g_Interface->DestroyCard(*itr);
 			itr = m_cards.erase(itr);
 
 		}
@@ -291,7 +291,7 @@ void Player::RemoveMyUnits()
 
 	for (auto itr = m_units.begin(); itr != m_units.end();)
 	{
-		delete *itr;
+		g_Interface->DestroyUnit(*itr);
 		itr = m_units.erase(itr);
 	}
 }
@@ -312,7 +312,7 @@ void Player::RemoveEnemyUnits()
 
 	for (auto itr = m_enemyUnits.begin(); itr != m_enemyUnits.end();)
 	{
-		delete *itr;
+		g_Interface->DestroyUnit(*itr);
 		itr = m_enemyUnits.erase(itr);
 	}
 }
@@ -432,52 +432,34 @@ void AIPlayer::Update(float deltaSeconds_)
 		case Phase::PURCHASE:
 		{
 			// Get cards in hand, we need to make sure we have room in our hand to buy a card;
-			Cards handCards = g_Interface->query().GetCards(CardMultiFilter(CardMultiFilter::Selector::AND, 
-				{
-					CardBelongsToPlayerID(m_playerID),
-					CardInHand()
-				}));
-
-			int handSize = (int)handCards.size();
+			CardZones& cardZones = g_Interface->cardZones();
+			int handSize = cardZones.GetCardCount(m_playerID, CardArea::HAND);
 			if(handSize < m_maxHandCount)
 			{
 				// Check to see if we have the gold to buy a card;
 				if(m_actualGold > 0)
 				{
-					// Get the cards in our market, transfer one card from market to hand and lose 1 gold;
-					Cards marketCards = g_Interface->query().GetCards(CardMultiFilter(CardMultiFilter::Selector::AND,
-						{
-							CardBelongsToPlayerID(m_playerID),
-							CardInMarketplace()
-						}));
-					if(marketCards.size() > 0)
+					// Transfer one card from our market to our hand and lose 1 gold;
+					Card* card = cardZones.GetRandomCard(m_playerID, CardArea::MARKET);
+					if(card)
 					{
-						Card* card = marketCards.GetRandomCard();
-						card->m_cardArea = CardArea::HAND;
+						cardZones.Move(card, CardArea::HAND, m_playerID);
 						m_actualGold--;
 					}
 				}
 			}
 
 			// Get our units, we need to see if we have an open slot to play a card;
-			Units inPlayUnits = g_Interface->query().GetUnits(UnitBelongsToPlayerID(m_playerID));
-			int inPlaySize = (int)inPlayUnits.size();
+			int inPlaySize = g_Interface->query().CountUnits(UnitBelongsToPlayerID(m_playerID));
 			if(inPlaySize < 8)
 			{
-				// Get our cards in our hand again;
-				handCards = g_Interface->query().GetCards(CardMultiFilter(CardMultiFilter::Selector::AND,
-					{
-						CardBelongsToPlayerID(m_playerID),
-						CardInHand()
-					}));
-				if(handCards.size() > 0)
+				// Get a card from our hand again;
+				Card* cardToPlace = cardZones.GetRandomCard(m_playerID, CardArea::HAND);
+				if(cardToPlace)
 				{
-					Card* cardToPlace = handCards.GetRandomCard();
-
 					g_Interface->server().RemoveCardFromPlacingUnitByPlayer(cardToPlace->m_cardID);
-					g_Interface->server().CreateNewUnitFromCardPlacedByPlayer(cardToPlace->m_cardID, (int)inPlayUnits.size());
-					Units units = g_Interface->query().GetUnits(UnitBelongsToPlayerID(m_playerID));
-					m_units = units;
+					g_Interface->server().CreateNewUnitFromCardPlacedByPlayer(cardToPlace->m_cardID, inPlaySize);
+					g_Interface->query().FilterUnits(m_units, UnitBelongsToPlayerID(m_playerID));
 				}
 			}
 
@@ -488,7 +470,7 @@ void AIPlayer::Update(float deltaSeconds_)
 		{
 			if(!BattlePhaseComplete())
 			{
-				g_Interface->server().CreateMatchReport(0, 0, 0, m_matchID, true);
+				// The Server resolves the match, the AI has nothing to play back;
 				SetBattlePhaseComplete(true);
 			}
 
@@ -12,6 +12,7 @@
 // -----------------------------------------------------------------------
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Gameplay/Map.hpp"
+#include "Game/Framework/RenderLayers.hpp"
 
 // -----------------------------------------------------------------------
 LobbyConsole::LobbyConsole(Game* game_)
@@ -319,21 +320,22 @@ void LobbyConsole::AddLetterToCurrentTypingText(const std::string& devConsolePri
 // -----------------------------------------------------------------------
 void LobbyConsole::DisplayTextInTextArea()
 {
-	BitMapFont* font = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
+	BitMapFont* font = g_theRenderer->GetBitmapFont(GameFont());
 	Vec2 textStartPosition = m_lobbyTextArea.GetBottomLeft();
 
-	std::vector<Vertex_PCU> textVerts;
+	// Chat lines don't change once added, so their layouts come from the glyph run cache;
+	m_textVerts.clear();
 	for (int textIndex = 0; textIndex < m_texts.size(); textIndex++)
 	{
 		Vec2 printPosition(0.0f, (float)(m_texts.size() - textIndex));
 
-		font->AddVertsForText2D(textVerts, (textStartPosition + printPosition), 1.0f, m_texts[textIndex], Rgba::WHITE);
+		font->AddVertsForTextRun(m_textVerts, (textStartPosition + printPosition), 1.0f, m_texts[textIndex], Rgba::WHITE);
 	}
 
-	if ((int)textVerts.size() > 0)
+	if ((int)m_textVerts.size() > 0)
 	{
 		g_theRenderer->BindTextureView(0u, font->GetTextureView());
-		g_theRenderer->DrawVertexArray((int)textVerts.size(), &textVerts[0]);
+		g_theRenderer->DrawVertexArray(m_textVerts);
 	}
 }
 
@@ -352,41 +354,41 @@ void LobbyConsole::RemoveAllChatText()
 // -----------------------------------------------------------------------
 void LobbyConsole::DisplayTextInTypingArea() 
 {
-	BitMapFont* font = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
+	BitMapFont* font = g_theRenderer->GetBitmapFont(GameFont());
 
-	std::vector<Vertex_PCU> textVerts;
+	m_textVerts.clear();
 	Vec2 textStartPosition = m_lobbyTypingArea.GetBottomLeft() + Vec2(0.0f, 0.2f);
 
 	if(!m_game->m_isConnected && !m_focusedOnTypingArea && m_currentTypingText == "")
 	{
-		font->AddVertsForText2D(textVerts, textStartPosition, 1.0f, m_informationText, Rgba::HALF_GRAY);
+		font->AddVertsForTextRun(m_textVerts, textStartPosition, 1.0f, m_informationText, Rgba::HALF_GRAY);
 	}
 	else
 	{
-		font->AddVertsForText2D(textVerts, textStartPosition, 1.0f, m_currentTypingText, Rgba::WHITE);
+		font->AddVertsForTextRun(m_textVerts, textStartPosition, 1.0f, m_currentTypingText, Rgba::WHITE);
 	}
 	
 
-	if ((int)textVerts.size() > 0)
+	if ((int)m_textVerts.size() > 0)
 	{
 		g_theRenderer->BindTextureView(0u, font->GetTextureView());
-		g_theRenderer->DrawVertexArray((int)textVerts.size(), &textVerts[0]);
+		g_theRenderer->DrawVertexArray(m_textVerts);
 	}
 }
 
 // -----------------------------------------------------------------------
 void LobbyConsole::DisplayButtonText()
 {
-	BitMapFont* font = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
-	std::vector<Vertex_PCU> textVerts;
-	font->AddVertsForText2D(textVerts, m_lobbySendMessageButton.center - Vec2(2.0f, 0.8f), 0.75f, "Connect", Rgba::WHITE);
-	font->AddVertsForText2D(textVerts, m_lobbyBackButton.center - Vec2(2.0f, 0.8f), 0.75f, "Back", Rgba::WHITE);
+	BitMapFont* font = g_theRenderer->GetBitmapFont(GameFont());
+	m_textVerts.clear();
+	font->AddVertsForTextRun(m_textVerts, m_lobbySendMessageButton.center - Vec2(2.0f, 0.8f), 0.75f, "Connect", Rgba::WHITE);
+	font->AddVertsForTextRun(m_textVerts, m_lobbyBackButton.center - Vec2(2.0f, 0.8f), 0.75f, "Back", Rgba::WHITE);
 	if(m_game->m_isConnected)
 	{
-		font->AddVertsForText2D(textVerts, m_lobbyReadyButton.center - Vec2(2.0f, 0.8f), 0.75f, "Ready", Rgba::WHITE);
+		font->AddVertsForTextRun(m_textVerts, m_lobbyReadyButton.center - Vec2(2.0f, 0.8f), 0.75f, "Ready", Rgba::WHITE);
 	}
 	g_theRenderer->BindTextureView(0u, font->GetTextureView());
-	g_theRenderer->DrawVertexArray((int)textVerts.size(), &textVerts[0]);
+	g_theRenderer->DrawVertexArray(m_textVerts);
 }
 
 // ----------------------------------------------------------------------- 
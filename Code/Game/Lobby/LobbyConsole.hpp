@@ -2,6 +2,7 @@
 
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/Vec2.hpp"
+#include "Engine/Core/Vertex_PCU2D.hpp"
 
 #include <string.h>
 #include <vector>
@@ -77,6 +78,7 @@ public:
 	std::string m_informationText = "Enter username and press CONNECT!";
 	std::string m_currentTypingText = "";
 	std::vector<std::string> m_texts;
+	std::vector<Vertex_PCU2D> m_textVerts;		// Reused by the text display functions;
 
 	// Cursor;
 	bool m_cursorBlip = true;
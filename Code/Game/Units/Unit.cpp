@@ -8,10 +8,12 @@
 #include "Engine/Core/RandomNumberGenerator.hpp"
 #include "Engine/Renderer/SpriteAnimationDefinition.hpp"
 #include "Engine/Renderer/BitMapFont.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
 
 // ------------------------------------------------------------------
 #include "Game/Framework/App.hpp"
 #include "Game/Framework/Interface.hpp"
+#include "Game/Framework/RenderLayers.hpp"
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Gameplay/Map.hpp"
 #include "Game/Units/Units.hpp"
@@ -79,7 +81,7 @@ void Unit::Create(JobType unitType_)
 	m_constitution	= m_unitDefinition->m_constitution;
 	m_speed			= m_unitDefinition->m_speed;
 
-	m_currentAnimationName = "Idle";
+	m_currentAnimationID = UnitDefinition::IDLE_ANIMATION_ID;
 	m_animationTimer = 0.0f;
 }
 
@@ -149,29 +151,24 @@ void Unit::PurchaseUpdate(float deltaSeconds_)
 {
 	// Sprites and Animations;
 	m_animationTimer += deltaSeconds_;
-	SpriteAnimationDefinition* spriteAnimationDefinition = m_unitDefinition->m_animationSet["Idle"];
+	SpriteAnimationDefinition* spriteAnimationDefinition = m_unitDefinition->GetAnimation(UnitDefinition::IDLE_ANIMATION_ID);
 	m_currentSpriteDefinition = spriteAnimationDefinition->GetSpriteDefinitionAtTime(m_animationTimer);
 }
 
 // ------------------------------------------------------------------
 void Unit::BattleRender()
 {
-	std::vector<Vertex_PCU> boxVerts;
-
 	Vec2 dimensions = g_Interface->match().GetBattleMap()->m_unitSlotDimensions;
 	Vec2 centerSlot = m_location;
 
 	AABB2 box = AABB2(centerSlot, dimensions / 2);
 
 	m_currentSpriteDefinition.GetUVs(m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
-	AddVertsForAABB2D(boxVerts, box, Rgba::WHITE, m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
-
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_unitDefinition->m_texture));
-	g_theRenderer->DrawVertexArray((int)boxVerts.size(), &boxVerts[0]);
+	SpriteBatch& spriteBatch = g_theRenderer->GetSpriteBatch();
+	TextureView* unitTexture = g_theRenderer->GetTextureView(m_unitDefinition->m_textureHandle);
+	spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_UNITS, unitTexture), box, Rgba::WHITE, m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
 
 	// Portrait;
-	std::vector<Vertex_PCU> portraitVerts;
 	Vec2 portraitDimensions = g_Interface->match().GetBattleMap()->m_battleWindowUnitSlotDimensions;
 	portraitDimensions = portraitDimensions * Vec2(0.25f, 1.0f);
 	Vec2 portraitSlot = g_Interface->match().GetBattleMap()->m_friendlyBattleInformationUnitSlots[m_slotID].mins;
@@ -179,13 +176,10 @@ void Unit::BattleRender()
 	portraitSlot.y += portraitDimensions.y * 0.5f;
 	AABB2 portrait = AABB2(portraitSlot, portraitDimensions / 2);
 
-	AddVertsForAABB2D(portraitVerts, portrait, Rgba::WHITE);
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_unitDefinition->m_portrait));
-	g_theRenderer->DrawVertexArray((int)portraitVerts.size(), &portraitVerts[0]);
+	TextureView* portraitTexture = g_theRenderer->GetTextureView(m_unitDefinition->m_portraitHandle);
+	spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_UNIT_UI, portraitTexture), portrait, Rgba::WHITE);
 
 	// Stats;
-	std::vector<Vertex_PCU> statsVerts;
 	float offset = (portrait.maxs.y - portrait.mins.y) * 0.2f;
 	float xOffset = (portrait.maxs.x - portrait.mins.x) * 1.1f;
 	Vec2 healthPoint = portrait.center;
@@ -195,13 +189,11 @@ void Unit::BattleRender()
 	manaPoint.x += xOffset;
 	manaPoint.y -= offset;
 
-	std::string health = Stringf("%d / %d", m_health, m_unitDefinition->m_health);
-	std::string mana = Stringf("%d / %d", m_mana, m_unitDefinition->m_mana);
-	BitMapFont* statsFont = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
-	statsFont->AddVertsForText2D(statsVerts, healthPoint, 0.5f, health, Rgba::WHITE);
-	statsFont->AddVertsForText2D(statsVerts, manaPoint, 0.5f, mana, Rgba::WHITE);
-	g_theRenderer->BindTextureView(0u, statsFont->GetTextureView());
-	g_theRenderer->DrawVertexArray((int)statsVerts.size(), &statsVerts[0]);
+	UpdateStatsText();
+	BitMapFont* statsFont = g_theRenderer->GetBitmapFont(GameFont());
+	SpriteBatchKey statsKey = GameSpriteKey(RENDER_LAYER_TEXT, statsFont->GetTextureView());
+	statsFont->AddVertsForTextRun(spriteBatch.AppendVerts(statsKey), healthPoint, 0.5f, m_healthText, Rgba::WHITE);
+	statsFont->AddVertsForTextRun(spriteBatch.AppendVerts(statsKey), manaPoint, 0.5f, m_manaText, Rgba::WHITE);
 
 	if(m_justTookDamageAmount >= 0)
 	{
@@ -212,9 +204,9 @@ void Unit::BattleRender()
 		AABB2 box2 = AABB2::MakeFromMinsMaxs(start, end);
 
 		// Show the damage amount;
-		std::vector<Vertex_PCU> textVerts;
 		std::string amount = Stringf("%d", m_justTookDamageAmount);
-		BitMapFont* timerFont = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
+		BitMapFont* timerFont = g_theRenderer->GetBitmapFont(GameFont());
+		std::vector<Vertex_PCU2D>& textVerts = spriteBatch.AppendVerts(GameSpriteKey(RENDER_LAYER_TEXT, timerFont->GetTextureView()));
 		if(m_justTookDamageAmount > 0)
 		{
 			timerFont->AddVertsForText2D(textVerts, box2.center, 1.0f, amount, Rgba::RED);
@@ -223,9 +215,6 @@ void Unit::BattleRender()
 		{
 			timerFont->AddVertsForText2D(textVerts, box2.center, 1.0f, "Miss", Rgba::TEAL);
 		}
-		
-		g_theRenderer->BindTextureView(0u, timerFont->GetTextureView());
-		g_theRenderer->DrawVertexArray((int)textVerts.size(), &textVerts[0]);
 	}
 	else if(m_justHealedAmount >= 0)
 	{
@@ -236,13 +225,10 @@ void Unit::BattleRender()
 		AABB2 box2 = AABB2::MakeFromMinsMaxs(start, end);
 
 		// Show the damage amount;
-		std::vector<Vertex_PCU> textVerts;
 		std::string amount = Stringf("%d", m_justHealedAmount);
-		BitMapFont* timerFont = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
+		BitMapFont* timerFont = g_theRenderer->GetBitmapFont(GameFont());
+		std::vector<Vertex_PCU2D>& textVerts = spriteBatch.AppendVerts(GameSpriteKey(RENDER_LAYER_TEXT, timerFont->GetTextureView()));
 		timerFont->AddVertsForText2D(textVerts, box2.center, 1.0f, amount, Rgba::GREEN);
-
-		g_theRenderer->BindTextureView(0u, timerFont->GetTextureView());
-		g_theRenderer->DrawVertexArray((int)textVerts.size(), &textVerts[0]);
 	}
 
 	if(m_activeStatusEffects.size() > 0)
@@ -252,12 +238,9 @@ void Unit::BattleRender()
 		Vec2 end = position + Vec2(-1.0f, 2.0f);
 		AABB2 box3 = AABB2::MakeFromMinsMaxs(start, end);
 
-		// Show the damage amount;
-		std::vector<Vertex_PCU> statusIconVerts;
-		AddVertsForAABB2D(statusIconVerts, box3, Rgba::WHITE);
-		g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-		g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_activeStatusEffects[m_currentStatusEffectIconIndex]->GetAbilityStatusEffectIcon().c_str()));
-		g_theRenderer->DrawVertexArray((int)statusIconVerts.size(), &statusIconVerts[0]);
+		// Show the icon;
+		TextureHandle iconTexture = m_activeStatusEffects[m_currentStatusEffectIconIndex]->GetAbilityStatusEffectIcon();
+		spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_UNIT_UI, iconTexture), box3, Rgba::WHITE);
 	}
 
 	if (m_activeBuffs.size() > 0)
@@ -267,20 +250,15 @@ void Unit::BattleRender()
 		Vec2 end = position + Vec2(4.0f, 2.0f);
 		AABB2 box4 = AABB2::MakeFromMinsMaxs(start, end);
 
-		// Show the damage amount;
-		std::vector<Vertex_PCU> buffIconVerts;
-		AddVertsForAABB2D(buffIconVerts, box4, Rgba::WHITE);
-		g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-		g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_activeBuffs[m_currentBuffEffectIconIndex]->GetAbilityBuffEffectIcon().c_str()));
-		g_theRenderer->DrawVertexArray((int)buffIconVerts.size(), &buffIconVerts[0]);
+		// Show the icon;
+		TextureHandle iconTexture = m_activeBuffs[m_currentBuffEffectIconIndex]->GetAbilityBuffEffectIcon();
+		spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_UNIT_UI, iconTexture), box4, Rgba::WHITE);
 	}
 }
 
 // ------------------------------------------------------------------
 void Unit::BattleRenderEnemy()
 {
-	std::vector<Vertex_PCU> boxVerts;
-
 	Vec2 dimensions = g_Interface->match().GetBattleMap()->m_unitSlotDimensions;
 	Vec2 centerSlot = m_location;
 
@@ -293,14 +271,11 @@ void Unit::BattleRenderEnemy()
 	m_currentSpriteAnimationToptUV.x = m_currentSpriteAnimationBottomLeftUV.x;
 	m_currentSpriteAnimationBottomLeftUV.x = tempx;
 
-	AddVertsForAABB2D(boxVerts, box, Rgba::WHITE, m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
-
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_unitDefinition->m_texture));
-	g_theRenderer->DrawVertexArray((int)boxVerts.size(), &boxVerts[0]);
+	SpriteBatch& spriteBatch = g_theRenderer->GetSpriteBatch();
+	TextureView* unitTexture = g_theRenderer->GetTextureView(m_unitDefinition->m_textureHandle);
+	spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_UNITS, unitTexture), box, Rgba::WHITE, m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
 
 	// Portrait;
-	std::vector<Vertex_PCU> portraitVerts;
 	Vec2 portraitDimensions = g_Interface->match().GetBattleMap()->m_battleWindowUnitSlotDimensions;
 	portraitDimensions = portraitDimensions * Vec2(0.25f, 1.0f);
 	Vec2 portraitSlot = g_Interface->match().GetBattleMap()->m_enemyBattleInformationUnitSlots[m_slotID].mins;
@@ -308,13 +283,10 @@ void Unit::BattleRenderEnemy()
 	portraitSlot.y += portraitDimensions.y * 0.5f;
 	AABB2 portrait = AABB2(portraitSlot, portraitDimensions / 2);
 
-	AddVertsForAABB2D(portraitVerts, portrait, Rgba::WHITE);
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_unitDefinition->m_portrait));
-	g_theRenderer->DrawVertexArray((int)portraitVerts.size(), &portraitVerts[0]);
+	TextureView* portraitTexture = g_theRenderer->GetTextureView(m_unitDefinition->m_portraitHandle);
+	spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_UNIT_UI, portraitTexture), portrait, Rgba::WHITE);
 
 	// Stats;
-	std::vector<Vertex_PCU> statsVerts;
 	float offset = (portrait.maxs.y - portrait.mins.y) * 0.2f;
 	float xOffset = (portrait.maxs.x - portrait.mins.x) * 1.1f;
 	Vec2 healthPoint = portrait.center;
@@ -324,13 +296,11 @@ void Unit::BattleRenderEnemy()
 	manaPoint.x += xOffset;
 	manaPoint.y -= offset;
 
-	std::string health = Stringf("%d / %d", m_health, m_unitDefinition->m_health);
-	std::string mana = Stringf("%d / %d", m_mana, m_unitDefinition->m_mana);
-	BitMapFont* statsFont = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
-	statsFont->AddVertsForText2D(statsVerts, healthPoint, 0.5f, health, Rgba::WHITE);
-	statsFont->AddVertsForText2D(statsVerts, manaPoint, 0.5f, mana, Rgba::WHITE);
-	g_theRenderer->BindTextureView(0u, statsFont->GetTextureView());
-	g_theRenderer->DrawVertexArray((int)statsVerts.size(), &statsVerts[0]);
+	UpdateStatsText();
+	BitMapFont* statsFont = g_theRenderer->GetBitmapFont(GameFont());
+	SpriteBatchKey statsKey = GameSpriteKey(RENDER_LAYER_TEXT, statsFont->GetTextureView());
+	statsFont->AddVertsForTextRun(spriteBatch.AppendVerts(statsKey), healthPoint, 0.5f, m_healthText, Rgba::WHITE);
+	statsFont->AddVertsForTextRun(spriteBatch.AppendVerts(statsKey), manaPoint, 0.5f, m_manaText, Rgba::WHITE);
 
 	if (m_justTookDamageAmount >= 0)
 	{
@@ -341,9 +311,9 @@ void Unit::BattleRenderEnemy()
 		AABB2 box2 = AABB2::MakeFromMinsMaxs(start, end);
 
 		// Show the damage amount;
-		std::vector<Vertex_PCU> textVerts;
 		std::string amount = Stringf("%d", m_justTookDamageAmount);
-		BitMapFont* timerFont = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
+		BitMapFont* timerFont = g_theRenderer->GetBitmapFont(GameFont());
+		std::vector<Vertex_PCU2D>& textVerts = spriteBatch.AppendVerts(GameSpriteKey(RENDER_LAYER_TEXT, timerFont->GetTextureView()));
 		if (m_justTookDamageAmount > 0)
 		{
 			timerFont->AddVertsForText2D(textVerts, box2.center, 1.0f, amount, Rgba::RED);
@@ -352,9 +322,6 @@ void Unit::BattleRenderEnemy()
 		{
 			timerFont->AddVertsForText2D(textVerts, box2.center, 1.0f, "Miss", Rgba::TEAL);
 		}
-
-		g_theRenderer->BindTextureView(0u, timerFont->GetTextureView());
-		g_theRenderer->DrawVertexArray((int)textVerts.size(), &textVerts[0]);
 	}
 	else if (m_justHealedAmount >= 0)
 	{
@@ -365,13 +332,10 @@ void Unit::BattleRenderEnemy()
 		AABB2 box2 = AABB2::MakeFromMinsMaxs(start, end);
 
 		// Show the damage amount;
-		std::vector<Vertex_PCU> textVerts;
 		std::string amount = Stringf("%d", m_justHealedAmount);
-		BitMapFont* timerFont = g_theRenderer->CreateOrGetBitmapFontFixedWidth16x16("SquirrelFixedFont");
+		BitMapFont* timerFont = g_theRenderer->GetBitmapFont(GameFont());
+		std::vector<Vertex_PCU2D>& textVerts = spriteBatch.AppendVerts(GameSpriteKey(RENDER_LAYER_TEXT, timerFont->GetTextureView()));
 		timerFont->AddVertsForText2D(textVerts, box2.center, 1.0f, amount, Rgba::GREEN);
-
-		g_theRenderer->BindTextureView(0u, timerFont->GetTextureView());
-		g_theRenderer->DrawVertexArray((int)textVerts.size(), &textVerts[0]);
 	}
 
 	if (m_statusIconEffects > 0)
@@ -381,12 +345,9 @@ void Unit::BattleRenderEnemy()
 		Vec2 end = position + Vec2(4.0f, 2.0f);
 		AABB2 box3 = AABB2::MakeFromMinsMaxs(start, end);
 
-		// Show the damage amount;
-		std::vector<Vertex_PCU> statusIconVerts;
-		AddVertsForAABB2D(statusIconVerts, box3, Rgba::WHITE);
-		g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-		g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_activeStatusEffects[m_currentStatusEffectIconIndex]->GetAbilityStatusEffectIcon().c_str()));
-		g_theRenderer->DrawVertexArray((int)statusIconVerts.size(), &statusIconVerts[0]);
+		// Show the icon;
+		TextureHandle iconTexture = m_activeStatusEffects[m_currentStatusEffectIconIndex]->GetAbilityStatusEffectIcon();
+		spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_UNIT_UI, iconTexture), box3, Rgba::WHITE);
 	}
 
 	if (m_buffIconEffects > 0)
@@ -396,12 +357,9 @@ void Unit::BattleRenderEnemy()
 		Vec2 end = position + Vec2(-1.0f, 2.0f);
 		AABB2 box4 = AABB2::MakeFromMinsMaxs(start, end);
 
-		// Show the damage amount;
-		std::vector<Vertex_PCU> buffIconVerts;
-		AddVertsForAABB2D(buffIconVerts, box4, Rgba::WHITE);
-		g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-		g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_activeBuffs[m_currentBuffEffectIconIndex]->GetAbilityBuffEffectIcon().c_str()));
-		g_theRenderer->DrawVertexArray((int)buffIconVerts.size(), &buffIconVerts[0]);
+		// Show the icon;
+		TextureHandle iconTexture = m_activeBuffs[m_currentBuffEffectIconIndex]->GetAbilityBuffEffectIcon();
+		spriteBatch.AddQuad(GameSpriteKey(RENDER_LAYER_UNIT_UI, iconTexture), box4, Rgba::WHITE);
 	}
 }
 
@@ -410,8 +368,6 @@ void Unit::PurchaseRender()
 {
 	// We are rendering our opponents cards. We need to only render our cards.
 
-	std::vector<Vertex_PCU> boxVerts;
-
 	Vec2 dimensions = g_Interface->match().GetPurchaseMap()->m_unitSlotDimensions;
 	Vec2 centerSlot = Vec2(-10.0f, -10.0f);
 	if (m_slotID < 8)
@@ -422,13 +378,8 @@ void Unit::PurchaseRender()
 	AABB2 box = AABB2(centerSlot, dimensions / 2);
 
 	m_currentSpriteDefinition.GetUVs(m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
-	//AddVertsForAABB2D(boxVerts, box, Rgba::WHITE);
-	AddVertsForAABB2D(boxVerts, box, Rgba::WHITE, m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
-
-	g_theRenderer->BindShader("Data/Shaders/default_unlit_devconsole.shader");
-	//g_theRenderer->BindTextureViewWithSampler(0, nullptr);
-	g_theRenderer->BindTextureViewWithSampler(0, g_theRenderer->CreateOrGetTextureViewFromFile(m_unitDefinition->m_texture));
-	g_theRenderer->DrawVertexArray((int)boxVerts.size(), &boxVerts[0]);
+	TextureView* unitTexture = g_theRenderer->GetTextureView(m_unitDefinition->m_textureHandle);
+	g_theRenderer->GetSpriteBatch().AddQuad(GameSpriteKey(RENDER_LAYER_UNITS, unitTexture), box, Rgba::WHITE, m_currentSpriteAnimationBottomLeftUV, m_currentSpriteAnimationToptUV);
 }
 
 // ------------------------------------------------------------------
@@ -462,11 +413,11 @@ void Unit::UpdateSpriteDefinition(float deltaSeconds_)
 	if (m_health <= 0)
 	{
 		m_animationTimer = 0.0f;
-		spriteAnimationDefinition = m_unitDefinition->m_animationSet["Dead"];
+		spriteAnimationDefinition = m_unitDefinition->GetAnimation(UnitDefinition::DEAD_ANIMATION_ID);
 	}
 	else
 	{
-		spriteAnimationDefinition = m_unitDefinition->m_animationSet[m_currentAnimationName];
+		spriteAnimationDefinition = m_unitDefinition->GetAnimation(m_currentAnimationID);
 	}
 
 	m_currentSpriteDefinition = spriteAnimationDefinition->GetSpriteDefinitionAtTime(m_animationTimer);
@@ -530,9 +481,9 @@ void Unit::SetLocation(Vec2 location_)
 }
 
 // ------------------------------------------------------------------
-void Unit::ApplyStatus(const std::string& status_, Unit* caster_)
+void Unit::ApplyStatus(StringID statusID_, Unit* caster_)
 {
-	const AbilityDefinition* statusDef = AbilityDefinition::s_abilityDefinitions[status_];
+	const AbilityDefinition* statusDef = AbilityDefinition::GetAbilityDefinition(statusID_);
 
 	// Check to apply an abilityDef once for a debuff;
 	bool hasStatusAlready = CheckIfStatusAlreadyIsApplied(statusDef);
@@ -549,9 +500,9 @@ void Unit::ApplyStatus(const std::string& status_, Unit* caster_)
 }
 
 // ------------------------------------------------------------------
-void Unit::ApplyDebuff(const std::string& debuff_, Unit* caster_)
+void Unit::ApplyDebuff(StringID debuffID_, Unit* caster_)
 {
-	const AbilityDefinition* debuffDef = AbilityDefinition::s_abilityDefinitions[debuff_];
+	const AbilityDefinition* debuffDef = AbilityDefinition::GetAbilityDefinition(debuffID_);
 
 	// Check to apply an abilityDef once for a debuff;
 	bool hasDebuffAlready = CheckIfDebuffAlreadyIsApplied(debuffDef);
@@ -568,9 +519,9 @@ void Unit::ApplyDebuff(const std::string& debuff_, Unit* caster_)
 }
 
 // ------------------------------------------------------------------
-void Unit::ApplyBuff(const std::string& buff_, Unit* caster_)
+void Unit::ApplyBuff(StringID buffID_, Unit* caster_)
 {
-	const AbilityDefinition* buffDef = AbilityDefinition::s_abilityDefinitions[buff_];
+	const AbilityDefinition* buffDef = AbilityDefinition::GetAbilityDefinition(buffID_);
 
 	// Check to apply an abilityDef once for a buff;
 	bool hasbuffAlready = CheckIfBuffAlreadyIsApplied(buffDef);
@@ -920,3 +871,19 @@ void Unit::ResetBuffIcon()
 	m_currentBuffEffectIconIndex = 0;
 }
 
+
+// -----------------------------------------------------------------------
+void Unit::UpdateStatsText()
+{
+	if(m_healthTextValue != m_health)
+	{
+		m_healthText = Stringf("%d / %d", m_health, m_unitDefinition->m_health);
+		m_healthTextValue = m_health;
+	}
+
+	if(m_manaTextValue != m_mana)
+	{
+		m_manaText = Stringf("%d / %d", m_mana, m_unitDefinition->m_mana);
+		m_manaTextValue = m_mana;
+	}
+}
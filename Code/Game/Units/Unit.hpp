@@ -7,6 +7,8 @@
 // -----------------------------------------------------------------------
 #include "Game/Units/UnitDefinition.hpp"
 
+#include <limits.h>
+
 
 class Ability;
 
@@ -39,9 +41,9 @@ public:
 	Vec2 GetEnemyPosition();
 	Vec2 GetLocation();
 	void SetLocation(Vec2 location_);
-	void ApplyStatus(const std::string& status_, Unit* caster_);
-	void ApplyDebuff(const std::string& debuff_, Unit* caster_);
-	void ApplyBuff(const std::string& buff_, Unit* caster_);
+	void ApplyStatus(StringID statusID_, Unit* caster_);
+	void ApplyDebuff(StringID debuffID_, Unit* caster_);
+	void ApplyBuff(StringID buffID_, Unit* caster_);
 	void AttackChange(int amountChange_);
 	bool CheckIfStatusAlreadyIsApplied(const AbilityDefinition* newStatus_);
 	bool CheckIfDebuffAlreadyIsApplied(const AbilityDefinition* newDebuff_);
@@ -64,6 +66,9 @@ public:
 	void ResetStatusIcons();
 	void ResetBuffIcon();
 
+	// Stats text; only reformatted when the values change, so the text layout stays cached;
+	void UpdateStatsText();
+
 	int m_playerID = -1;
 	int m_slotID = -1;
 	unsigned int m_unitID = 0u;
@@ -79,12 +84,18 @@ public:
 	int m_wisdom = 0;
 	int m_constitution = 0;
 	int m_speed = 0;
-	std::string m_currentAnimationName = "";
+	StringID m_currentAnimationID = INVALID_STRING_ID;
 
 	int m_justTookDamageAmount = -1;
 	int m_justHealedAmount = -1;
 	float m_justTookDamageTimer = 0.0f;
 	float m_justTookDamageTimeAmount = 1.0f;
+
+	// "health / max" and "mana / max" for the battle window;
+	std::string m_healthText;
+	std::string m_manaText;
+	int m_healthTextValue = INT_MIN;
+	int m_manaTextValue = INT_MIN;
 	
 
 	// Sprite Information;
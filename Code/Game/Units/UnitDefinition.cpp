@@ -1,12 +1,17 @@
 #include "Game/Units/UnitDefinition.hpp"
 
 
+// ------------------------------------------------------------------
+#include "Engine/Renderer/RenderContext.hpp"
+
 // ------------------------------------------------------------------
 #include "Game/Framework/Interface.hpp"
 #include "Game/Ability/AbilityDefinition.hpp"
 
 // ------------------------------------------------------------------
 std::map<JobType, UnitDefinition*> UnitDefinition::s_unitDefinitions;
+const StringID UnitDefinition::IDLE_ANIMATION_ID = InternString("Idle");
+const StringID UnitDefinition::DEAD_ANIMATION_ID = InternString("Dead");
 
 // ------------------------------------------------------------------
 UnitDefinition::UnitDefinition(XmlElement* unitElement_)
@@ -22,6 +27,10 @@ UnitDefinition::UnitDefinition(XmlElement* unitElement_)
 	m_portrait =		ParseXmlAttribute(*unitElement_, "portrait", "");
 	m_texture =			ParseXmlAttribute(*unitElement_, "texture", "");
 
+	// Resolved once here, Unit rendering only ever uses the handles;
+	m_portraitHandle =	g_theRenderer->AcquireTextureView(m_portrait);
+	m_textureHandle =	g_theRenderer->AcquireTextureView(m_texture);
+
 	CheckForAndLoadAnimations(unitElement_);
 	CheckForAndLoadAbilities(unitElement_);
 }
@@ -37,7 +46,7 @@ UnitDefinition::~UnitDefinition()
 	}
 	s_unitDefinitions.clear();
 
-	std::map<std::string, SpriteAnimationDefinition*>::iterator spriteAnimDef_iter;
+	std::unordered_map<StringID, SpriteAnimationDefinition*>::iterator spriteAnimDef_iter;
 	for(spriteAnimDef_iter = m_animationSet.begin(); spriteAnimDef_iter != m_animationSet.end(); ++spriteAnimDef_iter)
 	{
 		delete spriteAnimDef_iter->second;
@@ -50,7 +59,7 @@ UnitDefinition::~UnitDefinition()
 void UnitDefinition::LoadUnitsFromXML(const char* filename_)
 {
 	tinyxml2::XMLDocument entityXMLDoc;
-	entityXMLDoc.LoadFile(filename_);
+	LoadXmlDocument(entityXMLDoc, filename_);
 
 	if (entityXMLDoc.ErrorID() != tinyxml2::XML_SUCCESS)
 	{
@@ -181,6 +190,15 @@ SpriteAnimationPlaybackType UnitDefinition::StringToSpriteAnimationPlaybackType(
 	return SPRITE_ANIMATION_PLAYBACK_UNKNOWN;
 }
 
+// ------------------------------------------------------------------
+SpriteAnimationDefinition* UnitDefinition::GetAnimation(StringID animationID_) const
+{
+	std::unordered_map<StringID, SpriteAnimationDefinition*>::const_iterator found = m_animationSet.find(animationID_);
+	GUARANTEE_OR_DIE(found != m_animationSet.end(), Stringf("Unit %s has no animation \"%s\".", UnitTypeToString(m_type).c_str(), GetInternedString(animationID_).c_str()));
+
+	return found->second;
+}
+
 // ------------------------------------------------------------------
 void UnitDefinition::CheckForAndLoadAnimations(XmlElement* unitElement_)
 {
@@ -197,7 +215,7 @@ void UnitDefinition::CheckForAndLoadAnimations(XmlElement* unitElement_)
 			float duration = ParseXmlAttribute(*animationElement, "duration", 1.0f);
 			SpriteAnimationPlaybackType playback = StringToSpriteAnimationPlaybackType((*animationElement, "playback", "loop"));
 
-			m_animationSet[animationName] = new SpriteAnimationDefinition(*g_Interface->match().m_unitSpriteSheets[unitType], start, end, duration, playback);
+			m_animationSet[InternString(animationName)] = new SpriteAnimationDefinition(*g_Interface->match().m_unitSpriteSheets[unitType], start, end, duration, playback);
 
 			animationElement = animationElement->NextSiblingElement();
 		}
@@ -229,7 +247,7 @@ void UnitDefinition::CheckForAndLoadMainAbilities(XmlElement* abilitiesElement_)
 		while (mainAbilityElement)
 		{
 			std::string mainAbilityName = ParseXmlAttribute(*mainAbilityElement, "ability_name", "");
-			m_mainAbilityDefinition = AbilityDefinition::s_abilityDefinitions[mainAbilityName];
+			m_mainAbilityDefinition = AbilityDefinition::FindAbilityDefinition(InternString(mainAbilityName));
 
 			mainAbilityElement = mainAbilityElement->NextSiblingElement();
 		}
@@ -248,7 +266,7 @@ void UnitDefinition::CheckForAndLoadReactionAbilties(XmlElement* abilitiesElemen
 		while (reactionAbilityElement)
 		{
 			std::string reactionAbilityName = ParseXmlAttribute(*reactionAbilityElement, "ability_name", "");
-			m_reactionAbilityDefinition = AbilityDefinition::s_abilityDefinitions[reactionAbilityName];
+			m_reactionAbilityDefinition = AbilityDefinition::FindAbilityDefinition(InternString(reactionAbilityName));
 
 			reactionAbilityElement = reactionAbilityElement->NextSiblingElement();
 		}
@@ -267,7 +285,7 @@ void UnitDefinition::CheckForAndLoadPassiveAbilities(XmlElement* abilitiesElemen
 		while (passiveAbilityElement)
 		{
 			std::string passiveAbilityName = ParseXmlAttribute(*passiveAbilityElement, "ability_name", "");
-			m_passiveAbilityDefinition = AbilityDefinition::s_abilityDefinitions[passiveAbilityName];
+			m_passiveAbilityDefinition = AbilityDefinition::FindAbilityDefinition(InternString(passiveAbilityName));
 
 			passiveAbilityElement = passiveAbilityElement->NextSiblingElement();
 		}
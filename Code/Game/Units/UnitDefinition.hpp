@@ -1,9 +1,12 @@
 #pragma once
 
 #include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/StringID.hpp"
 #include "Engine/Renderer/SpriteAnimationDefinition.hpp"
+#include "Engine/Renderer/ResourceRegistry.hpp"
 
 #include <map>
+#include <unordered_map>
 
 class AbilityDefinition;
 
@@ -63,6 +66,13 @@ public:
 	static std::string UnitTypeToString(const JobType jobType_);
 	static SpriteAnimationPlaybackType StringToSpriteAnimationPlaybackType(const std::string& playbackType_);
 
+	// Animations every unit is expected to have;
+	static const StringID IDLE_ANIMATION_ID;
+	static const StringID DEAD_ANIMATION_ID;
+
+	// Dies if this unit has no animation with that name;
+	SpriteAnimationDefinition* GetAnimation(StringID animationID_) const;
+
 	// Helpers for loading parts of a UnitDefinition;
 	void CheckForAndLoadAnimations(XmlElement* unitElement_);
 	void CheckForAndLoadAbilities(XmlElement* unitElement_);
@@ -84,9 +94,11 @@ public:
 	int m_speed = 0;
 	std::string m_portrait = "";
 	std::string m_texture = "";
+	TextureHandle m_portraitHandle;
+	TextureHandle m_textureHandle;
 
 	// Animations;
-	std::map<std::string, SpriteAnimationDefinition*> m_animationSet;
+	std::unordered_map<StringID, SpriteAnimationDefinition*> m_animationSet;
 	
 	// Static Map to hold Unit Definitions;
 	static std::map<JobType, UnitDefinition*> s_unitDefinitions;
@@ -14,7 +14,7 @@ public:
 	explicit Units(const std::vector<Unit*>& units_);
 
 	// Easy accessor;
-	std::vector<Unit*> operator()()						{ return m_units; }
+	const std::vector<Unit*>& operator()() const		{ return m_units; }
 
 	// Common functions found in std::vector implementations;
 	std::vector<Unit*>::iterator begin()				{ return m_units.begin(); }
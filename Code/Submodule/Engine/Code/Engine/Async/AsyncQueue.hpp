@@ -1,8 +1,9 @@
 #pragma once
 
-#include <queue>
-#include <mutex>
+#include "Engine/Async/MPMCQueue.hpp"
 
+// ------------------------------------------------------------------------------------------------
+// Unbounded multi producer, multi consumer queue; lock-free, see SegmentedMPMCQueue;
 // ------------------------------------------------------------------------------------------------
 template <typename T>
 class AsyncQueue
@@ -13,12 +14,15 @@ public:
 	void Enqueue(T const& v);
 	bool Dequeue(T* out);
 
-	inline bool IsEmpty() { return m_queue.size() == 0; }
+	// Moves the whole batch in one claim per segment instead of one per value;
+	void EnqueueBatch(T const* values, uint32_t count);
+	uint32_t DequeueBatch(T* out, uint32_t maxCount);
+
+	inline bool IsEmpty() const { return m_queue.IsEmpty(); }
 
 private:
 
-	std::queue<T> m_queue;
-	std::mutex m_mutex;
+	SegmentedMPMCQueue<T> m_queue;
 };
 
 
@@ -26,22 +30,23 @@ private:
 template <typename T>
 void AsyncQueue<T>::Enqueue(T const& v)
 {
-	std::scoped_lock<std::mutex> lock(m_mutex);
-	m_queue.push(v);
+	m_queue.Enqueue(v);
 }
 
 template <typename T>
 bool AsyncQueue<T>::Dequeue(T* out)
 {
-	std::scoped_lock<std::mutex> lock(m_mutex);
-	if(IsEmpty())
-	{
-		return false;
-	}
-	else
-	{
-		*out = m_queue.front();
-		m_queue.pop();
-		return true;
-	}
-}
\ No newline at end of file
+	return m_queue.TryDequeue(out);
+}
+
+template <typename T>
+void AsyncQueue<T>::EnqueueBatch(T const* values, uint32_t count)
+{
+	m_queue.EnqueueBatch(values, count);
+}
+
+template <typename T>
+uint32_t AsyncQueue<T>::DequeueBatch(T* out, uint32_t maxCount)
+{
+	return m_queue.TryDequeueBatch(out, maxCount);
+}
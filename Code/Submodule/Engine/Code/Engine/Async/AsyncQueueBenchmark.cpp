@@ -0,0 +1,156 @@
+#include "Engine/Async/AsyncQueueBenchmark.hpp"
+#include "Engine/Async/MPMCQueue.hpp"
+#include "Engine/Core/BenchmarkUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// ------------------------------------------------------------------------------------------------
+// The AsyncQueue this replaced, kept here as the baseline;
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+class LockedQueue
+{
+
+public:
+
+	void Enqueue(const T& value_)
+	{
+		std::scoped_lock<std::mutex> lock(m_mutex);
+		m_queue.push(value_);
+	}
+
+	bool TryDequeue(T* out_)
+	{
+		std::scoped_lock<std::mutex> lock(m_mutex);
+		if (m_queue.empty())
+		{
+			return false;
+		}
+
+		*out_ = m_queue.front();
+		m_queue.pop();
+		return true;
+	}
+
+private:
+
+	std::queue<T> m_queue;
+	std::mutex m_mutex;
+};
+
+// ------------------------------------------------------------------------------------------------
+static void PushValue(LockedQueue<uint64_t>& queue_, uint64_t value_)			{ queue_.Enqueue(value_); }
+static void PushValue(SegmentedMPMCQueue<uint64_t>& queue_, uint64_t value_)	{ queue_.Enqueue(value_); }
+static void PushValue(BoundedMPMCQueue<uint64_t>& queue_, uint64_t value_)
+{
+	// Full is expected under load, wait for the consumers;
+	while (!queue_.TryEnqueue(value_))
+	{
+		std::this_thread::yield();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename QUEUE>
+static double TimeProducersAndConsumers(QUEUE& queue_, int threadCount_, int itemsPerProducer_)
+{
+	const uint64_t totalItems = (uint64_t)threadCount_ * (uint64_t)itemsPerProducer_;
+
+	std::atomic<bool> go = false;
+	std::atomic<uint64_t> consumedCount = 0;
+	std::atomic<uint64_t> consumedSum = 0;
+	std::vector<std::thread> threads;
+
+	for (int producerIndex = 0; producerIndex < threadCount_; ++producerIndex)
+	{
+		threads.emplace_back([&queue_, &go, itemsPerProducer_]()
+		{
+			while (!go.load());
+
+			for (int itemIndex = 1; itemIndex <= itemsPerProducer_; ++itemIndex)
+			{
+				PushValue(queue_, (uint64_t)itemIndex);
+			}
+		});
+	}
+
+	for (int consumerIndex = 0; consumerIndex < threadCount_; ++consumerIndex)
+	{
+		threads.emplace_back([&queue_, &go, &consumedCount, &consumedSum, totalItems]()
+		{
+			while (!go.load());
+
+			uint64_t localSum = 0;
+			uint64_t value = 0;
+			while (consumedCount.load(std::memory_order_relaxed) < totalItems)
+			{
+				if (queue_.TryDequeue(&value))
+				{
+					localSum += value;
+					consumedCount.fetch_add(1, std::memory_order_relaxed);
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			consumedSum.fetch_add(localSum);
+		});
+	}
+
+	double startTime = GetCurrentTimeSeconds();
+	go.store(true);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	double elapsedSeconds = GetCurrentTimeSeconds() - startTime;
+
+	// Every producer pushes 1..N, so anything lost or doubled shows up in the sum;
+	uint64_t expectedSum = (uint64_t)threadCount_ * ((uint64_t)itemsPerProducer_ * ((uint64_t)itemsPerProducer_ + 1) / 2);
+	GUARANTEE_OR_DIE(consumedSum.load() == expectedSum, Stringf("Queue benchmark lost values with %i threads.", threadCount_));
+
+	return elapsedSeconds;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void PrintResult(const char* queueName_, int threadCount_, int itemsPerProducer_, double seconds_)
+{
+	double totalItems = (double)threadCount_ * (double)itemsPerProducer_;
+	PrintLine(Stringf("%-10s %2ip/%2ic %8.3fs %8.2f Mops/s", queueName_, threadCount_, threadCount_, seconds_, MillionsPerSecond(totalItems, seconds_)));
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunAsyncQueueBenchmark(int maxThreads_, int itemsPerProducer_)
+{
+	if (maxThreads_ < 1 || itemsPerProducer_ < 1)
+	{
+		return;
+	}
+
+	for (int threadCount = 1; threadCount <= maxThreads_; threadCount *= 2)
+	{
+		{
+			LockedQueue<uint64_t> queue;
+			PrintResult("mutex", threadCount, itemsPerProducer_, TimeProducersAndConsumers(queue, threadCount, itemsPerProducer_));
+		}
+
+		{
+			BoundedMPMCQueue<uint64_t> queue(4096);
+			PrintResult("bounded", threadCount, itemsPerProducer_, TimeProducersAndConsumers(queue, threadCount, itemsPerProducer_));
+		}
+
+		{
+			SegmentedMPMCQueue<uint64_t> queue;
+			PrintResult("segmented", threadCount, itemsPerProducer_, TimeProducersAndConsumers(queue, threadCount, itemsPerProducer_));
+		}
+	}
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+// Contention benchmark for the async queues;
+// Runs N producers against N consumers for N = 1, 2, 4... up to maxThreads_ on the old mutex queue,
+// BoundedMPMCQueue and SegmentedMPMCQueue, and prints millions of values moved per second to the DevConsole;
+// Blocks the caller until every run has finished;
+// ------------------------------------------------------------------------------------------------
+void RunAsyncQueueBenchmark(int maxThreads_, int itemsPerProducer_);
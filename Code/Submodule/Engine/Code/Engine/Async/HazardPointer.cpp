@@ -0,0 +1,101 @@
+#include "Engine/Async/HazardPointer.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <algorithm>
+
+// Records are never freed, an exiting thread's is reused by the next one to start;
+static std::atomic<hazard_record_t*> s_hazardRecords = nullptr;
+
+// ------------------------------------------------------------------------------------------------
+static hazard_record_t* AcquireHazardRecord()
+{
+	for (hazard_record_t* record = s_hazardRecords.load(); record != nullptr; record = record->m_next)
+	{
+		bool isInUse = false;
+		if (!record->m_isInUse.load() && record->m_isInUse.compare_exchange_strong(isInUse, true))
+		{
+			return record;
+		}
+	}
+
+	hazard_record_t* record = new hazard_record_t();
+	for (uint slotIndex = 0; slotIndex < HAZARD_SLOTS_PER_THREAD; ++slotIndex)
+	{
+		record->m_slots[slotIndex].store(nullptr);
+	}
+	record->m_isInUse.store(true);
+
+	hazard_record_t* head = s_hazardRecords.load();
+	do
+	{
+		record->m_next = head;
+	} while (!s_hazardRecords.compare_exchange_weak(head, record));
+
+	return record;
+}
+
+// ------------------------------------------------------------------------------------------------
+struct hazard_thread_t
+{
+	~hazard_thread_t()
+	{
+		if (m_record != nullptr)
+		{
+			for (uint slotIndex = 0; slotIndex < HAZARD_SLOTS_PER_THREAD; ++slotIndex)
+			{
+				m_record->m_slots[slotIndex].store(nullptr);
+			}
+			m_record->m_isInUse.store(false);
+		}
+	}
+
+	hazard_record_t* m_record = nullptr;
+	uint m_depth = 0;
+};
+
+static thread_local hazard_thread_t t_hazardThread;
+
+// ------------------------------------------------------------------------------------------------
+HazardPointer::HazardPointer()
+{
+	hazard_thread_t& hazardThread = t_hazardThread;
+	if (hazardThread.m_record == nullptr)
+	{
+		hazardThread.m_record = AcquireHazardRecord();
+	}
+
+	GUARANTEE_OR_DIE(hazardThread.m_depth < HAZARD_SLOTS_PER_THREAD, "HazardPointers nested deeper than HAZARD_SLOTS_PER_THREAD.");
+	m_slot = &hazardThread.m_record->m_slots[hazardThread.m_depth++];
+}
+
+// ------------------------------------------------------------------------------------------------
+HazardPointer::~HazardPointer()
+{
+	m_slot->store(nullptr);
+	--t_hazardThread.m_depth;
+}
+
+// ------------------------------------------------------------------------------------------------
+void HazardGetProtected(std::vector<const void*>& out_)
+{
+	out_.clear();
+	for (hazard_record_t* record = s_hazardRecords.load(); record != nullptr; record = record->m_next)
+	{
+		for (uint slotIndex = 0; slotIndex < HAZARD_SLOTS_PER_THREAD; ++slotIndex)
+		{
+			const void* pointer = record->m_slots[slotIndex].load();
+			if (pointer != nullptr)
+			{
+				out_.push_back(pointer);
+			}
+		}
+	}
+
+	std::sort(out_.begin(), out_.end());
+}
+
+// ------------------------------------------------------------------------------------------------
+bool HazardIsInList(const std::vector<const void*>& protected_, const void* pointer_)
+{
+	return std::binary_search(protected_.begin(), protected_.end(), pointer_);
+}
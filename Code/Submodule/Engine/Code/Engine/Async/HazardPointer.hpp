@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+typedef unsigned int uint;
+
+// How deep HazardPointers can nest on one thread;
+constexpr uint HAZARD_SLOTS_PER_THREAD = 4;
+
+// ------------------------------------------------------------------------------------------------
+// Hazard Pointers;
+// A thread publishes the shared pointer it is about to use; whoever unlinks the object checks the published ones
+// and only frees it once nobody has it, so lock-free structures free memory without a shared counter every
+// operation has to touch;
+// Every thread gets a record the first time it makes a HazardPointer, given back for reuse when it exits;
+// ------------------------------------------------------------------------------------------------
+struct hazard_record_t
+{
+	std::atomic<const void*> m_slots[HAZARD_SLOTS_PER_THREAD];
+	std::atomic<bool> m_isInUse;
+	hazard_record_t* m_next;
+};
+
+// Holds one of the calling thread's slots for as long as it lives;
+class HazardPointer
+{
+
+public:
+
+	HazardPointer();
+	~HazardPointer();
+
+	HazardPointer(const HazardPointer&) = delete;
+	HazardPointer& operator=(const HazardPointer&) = delete;
+
+	// Publishes what source_ points at, then checks it still does, so it was reachable when published;
+	// Safe to use until the next Protect or Clear, as long as it is only freed after being unlinked from source_;
+	template <typename T>
+	T* Protect(const std::atomic<T*>& source_)
+	{
+		T* pointer = source_.load();
+		while (true)
+		{
+			m_slot->store(pointer);
+			T* check = source_.load();
+			if (check == pointer)
+			{
+				return pointer;
+			}
+			pointer = check;
+		}
+	}
+
+	// Publishes without checking, the caller validates it some other way;
+	inline void Set(const void* pointer_)							{ m_slot->store(pointer_); }
+	inline void Clear()												{ m_slot->store(nullptr); }
+
+private:
+
+	std::atomic<const void*>* m_slot = nullptr;
+};
+
+// Every pointer published right now, sorted, for HazardIsInList;
+void HazardGetProtected(std::vector<const void*>& out_);
+bool HazardIsInList(const std::vector<const void*>& protected_, const void* pointer_);
@@ -0,0 +1,674 @@
+#pragma once
+#include "Engine/Async/HazardPointer.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <stdint.h>
+#include <atomic>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Keeps the producer and consumer counters off each other's cache line;
+constexpr size_t MPMC_CACHE_LINE_SIZE = 64;
+
+// ------------------------------------------------------------------------------------------------
+// Bounded lock-free queue, any number of producers and consumers;
+// Every cell carries a sequence number that says whose turn it is (Vyukov), so a producer and a consumer
+// only ever touch the position counter they need and the cell they claimed;
+// Try* returns false instead of waiting when the queue is full or empty;
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+class BoundedMPMCQueue
+{
+
+public:
+
+	// Capacity is rounded up to a power of two;
+	explicit BoundedMPMCQueue(uint32_t capacity_);
+	~BoundedMPMCQueue();
+
+	BoundedMPMCQueue(const BoundedMPMCQueue&) = delete;
+	BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+
+	bool TryEnqueue(const T& value_);
+	bool TryDequeue(T* out_);
+
+	// Claim as many consecutive cells as are ready in one step; return how many were moved;
+	uint32_t TryEnqueueBatch(const T* values_, uint32_t count_);
+	uint32_t TryDequeueBatch(T* out_, uint32_t maxCount_);
+
+	// A snapshot, other threads can change it right after;
+	bool IsEmpty() const;
+	uint32_t GetCapacity() const									{ return (uint32_t)(m_mask + 1); }
+
+private:
+
+	struct Cell
+	{
+		std::atomic<size_t> m_sequence;
+		alignas(T) unsigned char m_storage[sizeof(T)];
+
+		inline T* GetPointer()										{ return reinterpret_cast<T*>(m_storage); }
+	};
+
+private:
+
+	Cell* m_cells = nullptr;
+	size_t m_mask = 0;
+
+	alignas(MPMC_CACHE_LINE_SIZE) std::atomic<size_t> m_enqueuePosition;
+	alignas(MPMC_CACHE_LINE_SIZE) std::atomic<size_t> m_dequeuePosition;
+};
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+BoundedMPMCQueue<T>::BoundedMPMCQueue(uint32_t capacity_)
+{
+	size_t capacity = 2;
+	while (capacity < capacity_)
+	{
+		capacity <<= 1;
+	}
+
+	m_mask = capacity - 1;
+	m_cells = new Cell[capacity];
+	for (size_t cellIndex = 0; cellIndex < capacity; ++cellIndex)
+	{
+		m_cells[cellIndex].m_sequence.store(cellIndex, std::memory_order_relaxed);
+	}
+
+	m_enqueuePosition.store(0, std::memory_order_relaxed);
+	m_dequeuePosition.store(0, std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+BoundedMPMCQueue<T>::~BoundedMPMCQueue()
+{
+	// Destroy values that were published but never dequeued;
+	size_t lastPosition = m_enqueuePosition.load();
+	for (size_t position = m_dequeuePosition.load(); position != lastPosition; ++position)
+	{
+		Cell& cell = m_cells[position & m_mask];
+		if (cell.m_sequence.load() == position + 1)
+		{
+			cell.GetPointer()->~T();
+		}
+	}
+
+	delete[] m_cells;
+	m_cells = nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+bool BoundedMPMCQueue<T>::TryEnqueue(const T& value_)
+{
+	size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		Cell& cell = m_cells[position & m_mask];
+		size_t sequence = cell.m_sequence.load(std::memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+		if (difference == 0)
+		{
+			// Cell is free for this position, try to claim it;
+			if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				new (cell.m_storage) T(value_);
+				cell.m_sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (difference < 0)
+		{
+			// A consumer hasn't freed this cell from the last lap yet, we are full;
+			return false;
+		}
+		else
+		{
+			// Another producer got here first;
+			position = m_enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+bool BoundedMPMCQueue<T>::TryDequeue(T* out_)
+{
+	size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		Cell& cell = m_cells[position & m_mask];
+		size_t sequence = cell.m_sequence.load(std::memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+
+		if (difference == 0)
+		{
+			if (m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				T* value = cell.GetPointer();
+				*out_ = std::move(*value);
+				value->~T();
+
+				// Hand the cell to the producer one lap ahead;
+				cell.m_sequence.store(position + m_mask + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (difference < 0)
+		{
+			// Nothing has been published here yet, we are empty;
+			return false;
+		}
+		else
+		{
+			position = m_dequeuePosition.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+uint32_t BoundedMPMCQueue<T>::TryEnqueueBatch(const T* values_, uint32_t count_)
+{
+	if (count_ == 0)
+	{
+		return 0;
+	}
+
+	size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		// Count the free cells in a row from our position, nobody else can take them while the position is still ours;
+		uint32_t freeCount = 0;
+		while (freeCount < count_ && freeCount <= m_mask)
+		{
+			size_t sequence = m_cells[(position + freeCount) & m_mask].m_sequence.load(std::memory_order_acquire);
+			if (sequence != position + freeCount)
+			{
+				break;
+			}
+			freeCount++;
+		}
+
+		if (freeCount == 0)
+		{
+			size_t sequence = m_cells[position & m_mask].m_sequence.load(std::memory_order_acquire);
+			if ((intptr_t)sequence - (intptr_t)position < 0)
+			{
+				return 0;
+			}
+
+			position = m_enqueuePosition.load(std::memory_order_relaxed);
+			continue;
+		}
+
+		if (m_enqueuePosition.compare_exchange_weak(position, position + freeCount, std::memory_order_relaxed))
+		{
+			for (uint32_t valueIndex = 0; valueIndex < freeCount; ++valueIndex)
+			{
+				Cell& cell = m_cells[(position + valueIndex) & m_mask];
+				new (cell.m_storage) T(values_[valueIndex]);
+				cell.m_sequence.store(position + valueIndex + 1, std::memory_order_release);
+			}
+
+			return freeCount;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+uint32_t BoundedMPMCQueue<T>::TryDequeueBatch(T* out_, uint32_t maxCount_)
+{
+	if (maxCount_ == 0)
+	{
+		return 0;
+	}
+
+	size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		// Stop at the first cell that isn't published, order is kept even if later cells are ready;
+		uint32_t readyCount = 0;
+		while (readyCount < maxCount_ && readyCount <= m_mask)
+		{
+			size_t sequence = m_cells[(position + readyCount) & m_mask].m_sequence.load(std::memory_order_acquire);
+			if (sequence != position + readyCount + 1)
+			{
+				break;
+			}
+			readyCount++;
+		}
+
+		if (readyCount == 0)
+		{
+			size_t sequence = m_cells[position & m_mask].m_sequence.load(std::memory_order_acquire);
+			if ((intptr_t)sequence - (intptr_t)(position + 1) < 0)
+			{
+				return 0;
+			}
+
+			position = m_dequeuePosition.load(std::memory_order_relaxed);
+			continue;
+		}
+
+		if (m_dequeuePosition.compare_exchange_weak(position, position + readyCount, std::memory_order_relaxed))
+		{
+			for (uint32_t valueIndex = 0; valueIndex < readyCount; ++valueIndex)
+			{
+				Cell& cell = m_cells[(position + valueIndex) & m_mask];
+				T* value = cell.GetPointer();
+				out_[valueIndex] = std::move(*value);
+				value->~T();
+				cell.m_sequence.store(position + valueIndex + m_mask + 1, std::memory_order_release);
+			}
+
+			return readyCount;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+bool BoundedMPMCQueue<T>::IsEmpty() const
+{
+	size_t position = m_dequeuePosition.load(std::memory_order_acquire);
+	size_t sequence = m_cells[position & m_mask].m_sequence.load(std::memory_order_acquire);
+	return sequence != position + 1;
+}
+
+
+
+// ------------------------------------------------------------------------------------------------
+// Unbounded lock-free queue, any number of producers and consumers;
+// Values go into fixed size segments that are only filled once, front to back, and a full segment links a new one;
+// Every operation holds the segment it works on through a HazardPointer; drained segments are retired and freed
+// as soon as no thread has them published, so a thread can never be left holding a segment that was deleted under it;
+// Only allocates when a segment fills up, once per SEGMENT_CAPACITY values;
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY = 256>
+class SegmentedMPMCQueue
+{
+
+public:
+
+	SegmentedMPMCQueue();
+	~SegmentedMPMCQueue();
+
+	SegmentedMPMCQueue(const SegmentedMPMCQueue&) = delete;
+	SegmentedMPMCQueue& operator=(const SegmentedMPMCQueue&) = delete;
+
+	// Never fails, a new segment is linked if the current one is full;
+	void Enqueue(const T& value_);
+	bool TryDequeue(T* out_);
+
+	void EnqueueBatch(const T* values_, uint32_t count_);
+	uint32_t TryDequeueBatch(T* out_, uint32_t maxCount_);
+
+	// A snapshot, other threads can change it right after;
+	bool IsEmpty() const;
+
+private:
+
+	struct Cell
+	{
+		std::atomic<bool> m_isReady;
+		alignas(T) unsigned char m_storage[sizeof(T)];
+
+		inline T* GetPointer()										{ return reinterpret_cast<T*>(m_storage); }
+	};
+
+	struct Segment
+	{
+		Segment();
+
+		Cell m_cells[SEGMENT_CAPACITY];
+		alignas(MPMC_CACHE_LINE_SIZE) std::atomic<uint32_t> m_enqueueIndex;
+		alignas(MPMC_CACHE_LINE_SIZE) std::atomic<uint32_t> m_dequeueIndex;
+		std::atomic<Segment*> m_next;
+		Segment* m_nextRetired = nullptr;
+	};
+
+	Segment* LinkNewSegment(Segment* tail_, const T* values_, uint32_t count_, uint32_t& outEnqueued);
+	bool AdvanceHead(Segment* head_);
+	void RetireSegment(Segment* segment_);
+	void FreeRetiredSegments();
+	static void DestroySegment(Segment* segment_);
+
+private:
+
+	alignas(MPMC_CACHE_LINE_SIZE) std::atomic<Segment*> m_head;
+	alignas(MPMC_CACHE_LINE_SIZE) std::atomic<Segment*> m_tail;
+	alignas(MPMC_CACHE_LINE_SIZE) std::atomic<Segment*> m_retired;
+};
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::Segment::Segment()
+{
+	for (uint32_t cellIndex = 0; cellIndex < SEGMENT_CAPACITY; ++cellIndex)
+	{
+		m_cells[cellIndex].m_isReady.store(false, std::memory_order_relaxed);
+	}
+
+	m_enqueueIndex.store(0, std::memory_order_relaxed);
+	m_dequeueIndex.store(0, std::memory_order_relaxed);
+	m_next.store(nullptr, std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::SegmentedMPMCQueue()
+{
+	Segment* segment = new Segment();
+	m_head.store(segment);
+	m_tail.store(segment);
+	m_retired.store(nullptr);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::~SegmentedMPMCQueue()
+{
+	Segment* segment = m_head.load();
+	while (segment != nullptr)
+	{
+		Segment* next = segment->m_next.load();
+		DestroySegment(segment);
+		segment = next;
+	}
+
+	Segment* retired = m_retired.load();
+	while (retired != nullptr)
+	{
+		Segment* next = retired->m_nextRetired;
+		delete retired;
+		retired = next;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+void SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::Enqueue(const T& value_)
+{
+	EnqueueBatch(&value_, 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+void SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::EnqueueBatch(const T* values_, uint32_t count_)
+{
+	HazardPointer hazard;
+
+	while (count_ > 0)
+	{
+		Segment* tail = hazard.Protect(m_tail);
+
+		// Indices are never handed out twice, past SEGMENT_CAPACITY they are just wasted;
+		uint32_t firstIndex = tail->m_enqueueIndex.load(std::memory_order_relaxed);
+		uint32_t claimCount = 0;
+		while (firstIndex < SEGMENT_CAPACITY)
+		{
+			claimCount = (count_ < SEGMENT_CAPACITY - firstIndex) ? count_ : SEGMENT_CAPACITY - firstIndex;
+			if (tail->m_enqueueIndex.compare_exchange_weak(firstIndex, firstIndex + claimCount, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+
+		if (firstIndex < SEGMENT_CAPACITY)
+		{
+			for (uint32_t valueIndex = 0; valueIndex < claimCount; ++valueIndex)
+			{
+				Cell& cell = tail->m_cells[firstIndex + valueIndex];
+				new (cell.m_storage) T(values_[valueIndex]);
+				cell.m_isReady.store(true, std::memory_order_release);
+			}
+
+			values_ += claimCount;
+			count_ -= claimCount;
+			continue;
+		}
+
+		// Full, link a new segment or help whoever already did;
+		Segment* next = tail->m_next.load();
+		if (next == nullptr)
+		{
+			uint32_t enqueued = 0;
+			next = LinkNewSegment(tail, values_, count_, enqueued);
+			values_ += enqueued;
+			count_ -= enqueued;
+		}
+
+		m_tail.compare_exchange_strong(tail, next);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+typename SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::Segment* SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::LinkNewSegment(Segment* tail_, const T* values_, uint32_t count_, uint32_t& outEnqueued)
+{
+	// Fill the new segment before it is visible, so the values we came with land in it for sure;
+	Segment* segment = new Segment();
+	uint32_t fillCount = (count_ < SEGMENT_CAPACITY) ? count_ : SEGMENT_CAPACITY;
+	for (uint32_t valueIndex = 0; valueIndex < fillCount; ++valueIndex)
+	{
+		new (segment->m_cells[valueIndex].m_storage) T(values_[valueIndex]);
+		segment->m_cells[valueIndex].m_isReady.store(true, std::memory_order_relaxed);
+	}
+	segment->m_enqueueIndex.store(fillCount, std::memory_order_relaxed);
+
+	Segment* expected = nullptr;
+	if (tail_->m_next.compare_exchange_strong(expected, segment))
+	{
+		outEnqueued = fillCount;
+		return segment;
+	}
+
+	// Someone else linked first, ours was never seen;
+	DestroySegment(segment);
+	outEnqueued = 0;
+	return expected;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+bool SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::TryDequeue(T* out_)
+{
+	return TryDequeueBatch(out_, 1) == 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+uint32_t SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::TryDequeueBatch(T* out_, uint32_t maxCount_)
+{
+	uint32_t dequeued = 0;
+	bool retiredSegment = false;
+
+	{
+		HazardPointer hazard;
+
+		while (dequeued < maxCount_)
+		{
+			Segment* head = hazard.Protect(m_head);
+			uint32_t firstIndex = head->m_dequeueIndex.load(std::memory_order_relaxed);
+
+			if (firstIndex >= SEGMENT_CAPACITY)
+			{
+				// Drained for good, move on if there is somewhere to go;
+				if (!AdvanceHead(head))
+				{
+					break;
+				}
+				retiredSegment = true;
+				continue;
+			}
+
+			// Take the published cells in a row, stopping at the first one a producer is still writing;
+			uint32_t readyCount = 0;
+			while (readyCount < maxCount_ - dequeued && firstIndex + readyCount < SEGMENT_CAPACITY
+				&& head->m_cells[firstIndex + readyCount].m_isReady.load(std::memory_order_acquire))
+			{
+				readyCount++;
+			}
+
+			if (readyCount == 0)
+			{
+				break;
+			}
+
+			if (!head->m_dequeueIndex.compare_exchange_weak(firstIndex, firstIndex + readyCount, std::memory_order_relaxed))
+			{
+				continue;
+			}
+
+			for (uint32_t valueIndex = 0; valueIndex < readyCount; ++valueIndex)
+			{
+				T* value = head->m_cells[firstIndex + valueIndex].GetPointer();
+				out_[dequeued++] = std::move(*value);
+				value->~T();
+			}
+		}
+	}
+
+	// Try again once traffic stops too, for segments someone still had published last time;
+	if (retiredSegment || (dequeued == 0 && m_retired.load(std::memory_order_relaxed) != nullptr))
+	{
+		FreeRetiredSegments();
+	}
+
+	return dequeued;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+bool SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::AdvanceHead(Segment* head_)
+{
+	Segment* next = head_->m_next.load();
+	if (next == nullptr)
+	{
+		return false;
+	}
+
+	// A lagging tail must not be left pointing at the segment we are about to retire;
+	Segment* expectedTail = head_;
+	m_tail.compare_exchange_strong(expectedTail, next);
+
+	Segment* expectedHead = head_;
+	if (m_head.compare_exchange_strong(expectedHead, next))
+	{
+		RetireSegment(head_);
+	}
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+void SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::RetireSegment(Segment* segment_)
+{
+	Segment* retired = m_retired.load();
+	do
+	{
+		segment_->m_nextRetired = retired;
+	} while (!m_retired.compare_exchange_weak(retired, segment_));
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+void SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::FreeRetiredSegments()
+{
+	Segment* retired = m_retired.exchange(nullptr);
+	if (retired == nullptr)
+	{
+		return;
+	}
+
+	// A retired segment is already unlinked, so nobody can publish it again; only what is published now can still be in use;
+	std::vector<const void*> protectedPointers;
+	HazardGetProtected(protectedPointers);
+
+	Segment* keptFirst = nullptr;
+	Segment* keptLast = nullptr;
+	while (retired != nullptr)
+	{
+		Segment* next = retired->m_nextRetired;
+		if (HazardIsInList(protectedPointers, retired))
+		{
+			retired->m_nextRetired = keptFirst;
+			keptFirst = retired;
+			keptLast = (keptLast != nullptr) ? keptLast : retired;
+		}
+		else
+		{
+			delete retired;
+		}
+		retired = next;
+	}
+
+	if (keptFirst == nullptr)
+	{
+		return;
+	}
+
+	// At most one per published slot, put them back for the next pass;
+	Segment* current = m_retired.load();
+	do
+	{
+		keptLast->m_nextRetired = current;
+	} while (!m_retired.compare_exchange_weak(current, keptFirst));
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+void SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::DestroySegment(Segment* segment_)
+{
+	// Destroy values that were published but never dequeued;
+	uint32_t first = segment_->m_dequeueIndex.load();
+	uint32_t last = segment_->m_enqueueIndex.load();
+	last = (last < SEGMENT_CAPACITY) ? last : SEGMENT_CAPACITY;
+	for (uint32_t cellIndex = first; cellIndex < last; ++cellIndex)
+	{
+		if (segment_->m_cells[cellIndex].m_isReady.load())
+		{
+			segment_->m_cells[cellIndex].GetPointer()->~T();
+		}
+	}
+
+	delete segment_;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SEGMENT_CAPACITY>
+bool SegmentedMPMCQueue<T, SEGMENT_CAPACITY>::IsEmpty() const
+{
+	HazardPointer headHazard;
+	HazardPointer nextHazard;
+
+	while (true)
+	{
+		const Segment* head = headHazard.Protect(m_head);
+		uint32_t dequeueIndex = head->m_dequeueIndex.load(std::memory_order_acquire);
+		if (dequeueIndex < SEGMENT_CAPACITY)
+		{
+			return !head->m_cells[dequeueIndex].m_isReady.load(std::memory_order_acquire);
+		}
+
+		// Drained, whatever is left lives in the next segment; it can't have been retired while head is still the head;
+		const Segment* next = head->m_next.load();
+		if (next == nullptr)
+		{
+			return true;
+		}
+
+		nextHazard.Set(next);
+		if (m_head.load() == head)
+		{
+			return !next->m_cells[0].m_isReady.load(std::memory_order_acquire);
+		}
+	}
+}
@@ -1,4 +1,5 @@
 #include "Engine/Audio/AudioSystem.hpp"
+#include "Engine/Memory/Memory.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "Game/Framework/App.hpp"
 #include "Engine/Renderer/Camera.hpp"
@@ -132,6 +133,7 @@ ChannelGroupID AudioSystem::CreateOrGetChannelGroup( const std::string& channelG
 //-----------------------------------------------------------------------------------------------
 SoundID AudioSystem::CreateOrGetSound( const std::string& soundFilePath )
 {
+	MEM_TAG_SCOPE(MEM_TAG_AUDIO);
 	std::map< std::string, SoundID >::iterator found = m_registeredSoundIDs.find( soundFilePath );
 	if( found != m_registeredSoundIDs.end() )
 	{
@@ -422,9 +422,16 @@ bool BufferWriter::LoadBinaryFileToExistingBuffer(const std::string& filepath_,
 // ------------------------------------------------------------------
 bool BufferWriter::SaveBinaryFromBuffer(const std::string& filepath_, const Buffer& buff_)
 {
-	filepath_;
-	buff_;
-	return false;
+	FILE* file = fopen(filepath_.c_str(), "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	size_t result = fwrite(buff_.data(), 1, buff_.size(), file);
+	fclose(file);
+
+	return result == buff_.size();
 }
 
 // ------------------------------------------------------------------
@@ -515,6 +522,21 @@ void BufferWriter::AppenedUInt32(unsigned int u)
 	memcpy(&m_buffer[originalOffset], data, sizeof(unsigned int));
 }
 
+// ------------------------------------------------------------------
+void BufferWriter::AppendUInt64(uint64_t u)
+{
+	unsigned char* data = (unsigned char*)(&u);
+
+	if (IsEndianModeOppositeNative())
+	{
+		Reverse8BytesInPlace(data);
+	}
+
+	size_t originalOffset = m_buffer.size();
+	ReserveAdditional(sizeof(uint64_t));
+	memcpy(&m_buffer[originalOffset], data, sizeof(uint64_t));
+}
+
 // ------------------------------------------------------------------
 void BufferWriter::AppendFloat(float f)
 {
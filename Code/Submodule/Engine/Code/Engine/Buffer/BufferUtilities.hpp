@@ -6,6 +6,7 @@
 #include "Engine/Core/Rgba.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
 
+#include <stdint.h>
 #include <string.h>
 #include <vector>
 
@@ -110,6 +111,7 @@ public:
 	void AppendChar(char c);
 	void AppendInt32(int i);
 	void AppenedUInt32(unsigned int u);
+	void AppendUInt64(uint64_t u);
 	void AppendFloat(float f);
 	void AppendDouble(double d);
 	void AppendBool(bool b);
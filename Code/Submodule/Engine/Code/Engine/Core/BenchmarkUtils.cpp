@@ -0,0 +1,19 @@
+#include "Engine/Core/BenchmarkUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+// ------------------------------------------------------------------------------------------------
+void PrintLine(const std::string& line_)
+{
+	DebuggerPrintf("%s\n", line_.c_str());
+	if (g_theDevConsole != nullptr)
+	{
+		g_theDevConsole->Print(line_);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+double MillionsPerSecond(double count_, double seconds_)
+{
+	return (seconds_ > 0.0) ? (count_ / seconds_) / 1000000.0 : 0.0;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "Engine/Core/Time.hpp"
+
+#include <string>
+
+// ------------------------------------------------------------------------------------------------
+// Output and timing shared by the *Benchmark files and the stats commands;
+// ------------------------------------------------------------------------------------------------
+
+// To the debugger output, and to the DevConsole once there is one;
+void PrintLine(const std::string& line_);
+
+// Millions of count_ per second, 0 when nothing measurable was timed;
+double MillionsPerSecond(double count_, double seconds_);
+
+// Seconds taken to call function_ iterations_ times;
+template <typename FUNCTION>
+double TimeIterations(int iterations_, FUNCTION function_)
+{
+	double startTime = GetCurrentTimeSeconds();
+	for (int iteration = 0; iteration < iterations_; ++iteration)
+	{
+		function_();
+	}
+	return GetCurrentTimeSeconds() - startTime;
+}
@@ -280,20 +280,28 @@ void DevConsole::DisplayTextInTextArea(float lineHeight, BitMapFont* fontToUse)
 {
 	float displayHeight = 0.2f;
 
-	std::vector<Vertex_PCU> textVerts;
+	m_textVerts.clear();
 	Vec2 textStartPosition( 0.5f, 1.5f);
 
-	for(int textIndex = 0; textIndex < m_texts.size(); textIndex++)
+	// Newest line first, and stop at the top of the console; history past it is never drawn;
+	// Printed lines don't change, so after their first frame the layouts come from the glyph run cache;
+	float topOfConsole = m_devConsoleCamera->m_maxOrtho.y;
+	for(int textIndex = (int)m_texts.size() - 1; textIndex >= 0; textIndex--)
 	{
 		Vec2 printPosition(0.0f, (float)(m_texts.size() - textIndex));
-		
-		fontToUse->AddVertsForText2D(textVerts, (textStartPosition + printPosition) * lineHeight, displayHeight, m_texts[textIndex], m_textcolors[textIndex]);
+		Vec2 linePosition = (textStartPosition + printPosition) * lineHeight;
+		if(linePosition.y >= topOfConsole)
+		{
+			break;
+		}
+
+		fontToUse->AddVertsForTextRun(m_textVerts, linePosition, displayHeight, m_texts[textIndex], m_textcolors[textIndex]);
 	}
 
-	if((int)textVerts.size() > 0)
+	if((int)m_textVerts.size() > 0)
 	{
 		g_theRenderer->BindTextureView( 0u, fontToUse->GetTextureView() );
-		g_theRenderer->DrawVertexArray((int)textVerts.size(), &textVerts[0]);
+		g_theRenderer->DrawVertexArray(m_textVerts);
 	}
 }
 
@@ -302,15 +310,15 @@ void DevConsole::DisplayTextInTypingArea(float lineHeight, BitMapFont* fontToUse
 	UNUSED(lineHeight);
 	float displayHeight = 0.2f;
 
-	std::vector<Vertex_PCU> textVerts;
+	m_textVerts.clear();
 	Vec2 textStartPosition = Vec2( 0.15f, 0.15f );
 
-	fontToUse->AddVertsForText2D(textVerts, textStartPosition, displayHeight, m_currentTypingText, Rgba::WHITE);
+	fontToUse->AddVertsForTextRun(m_textVerts, textStartPosition, displayHeight, m_currentTypingText, Rgba::WHITE);
 
-	if((int)textVerts.size() > 0)
+	if((int)m_textVerts.size() > 0)
 	{
 		g_theRenderer->BindTextureView( 0u, fontToUse->GetTextureView() );
-		g_theRenderer->DrawVertexArray((int)textVerts.size(), &textVerts[0]);
+		g_theRenderer->DrawVertexArray(m_textVerts);
 	}
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Memory/Memory.hpp"
+#include "Engine/Core/Vertex_PCU2D.hpp"
 
 #include <map>
 #include <vector>
@@ -11,9 +12,6 @@ class BitMapFont;
 struct Camera;
 struct Rgba;
 
-extern std::atomic<size_t> memtrack_allocationCount;
-extern std::atomic<size_t> memtrack_byteCount;
-
 class DevConsole
 {
 public:
@@ -107,6 +105,9 @@ private:
 	std::vector<std::string>		m_textHistory;
 	std::vector<std::string>		m_texts;
 	std::vector<Rgba>				m_textcolors;
+
+	// Reused every frame by the const render functions;
+	mutable std::vector<Vertex_PCU2D>	m_textVerts;
 };
 
 extern DevConsole*	g_theDevConsole;
@@ -1,5 +1,6 @@
 #include "Engine/Core/FileUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/PackArchive.hpp"
 
 #include <fstream>
 
@@ -39,3 +40,61 @@ unsigned long CreateFileBuffer( const std::string& filename, char** outData )
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+DataFile::DataFile( const std::string& filepath_ )
+{
+	Open(filepath_);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DataFile::Open( const std::string& filepath_ )
+{
+	Close();
+
+	if(g_thePackArchive != nullptr)
+	{
+		const PackArchiveEntry* entry = g_thePackArchive->FindEntry(filepath_);
+		if(entry != nullptr)
+		{
+			if(entry->m_compression == PACK_COMPRESSION_NONE)
+			{
+				m_data = g_thePackArchive->GetStoredData(*entry);
+				m_size = (size_t)entry->m_size;
+			}
+			else if(g_thePackArchive->ReadEntry(*entry, &m_inflatedData))
+			{
+				m_data = m_inflatedData.data();
+				m_size = m_inflatedData.size();
+			}
+			else
+			{
+				return false;
+			}
+
+			m_isOpen = true;
+			m_isFromArchive = true;
+			return true;
+		}
+	}
+
+	if(!m_looseFile.Open(filepath_))
+	{
+		return false;
+	}
+
+	m_data = m_looseFile.GetData();
+	m_size = m_looseFile.GetSize();
+	m_isOpen = true;
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void DataFile::Close()
+{
+	m_looseFile.Close();
+	std::vector<unsigned char>().swap(m_inflatedData);
+	m_data = nullptr;
+	m_size = 0;
+	m_isOpen = false;
+	m_isFromArchive = false;
+}
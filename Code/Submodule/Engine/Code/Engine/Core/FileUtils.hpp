@@ -1,6 +1,44 @@
 #pragma once
+#include "Engine/Core/MemoryMappedFile.hpp"
+
 #include <string>
+#include <vector>
 
 
 unsigned long CreateFileBuffer(const std::string& filename, char** outData);
 
+// ----------------------------------------------------------------------------
+// DataFile;
+// Read only bytes of a game file, without a copy where it can: a view into g_thePackArchive when the
+// file is stored there uncompressed, inflated into its own buffer when compressed there, and otherwise
+// the loose file, memory mapped; the bytes stay valid until Close or destruction;
+// ----------------------------------------------------------------------------
+class DataFile
+{
+
+public:
+
+	DataFile() {}
+	explicit DataFile(const std::string& filepath_);
+
+	DataFile(const DataFile&) = delete;
+	DataFile& operator=(const DataFile&) = delete;
+
+	bool Open(const std::string& filepath_);
+	void Close();
+
+	inline bool IsOpen() const								{ return m_isOpen; }
+	inline bool IsFromArchive() const						{ return m_isFromArchive; }
+	inline const unsigned char* GetData() const				{ return m_data; }
+	inline const char* GetText() const						{ return (const char*)m_data; }		// Not zero terminated;
+	inline size_t GetSize() const							{ return m_size; }
+
+private:
+
+	MemoryMappedFile m_looseFile;
+	std::vector<unsigned char> m_inflatedData;
+	const unsigned char* m_data = nullptr;
+	size_t m_size = 0;
+	bool m_isOpen = false;
+	bool m_isFromArchive = false;
+};
@@ -1,5 +1,10 @@
 #include "Engine/Core/Image.hpp"
+#include "Engine/Core/FileUtils.hpp"
 #include "Engine/Core/Rgba.hpp"
+#include "Engine/Core/PixelUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <string.h>
 
 #pragma warning(disable:4100) // unreferenced formal parameter
 #define STB_IMAGE_IMPLEMENTATION
@@ -8,65 +13,22 @@
 #include "ThirdParty/stb/stb_write.h"
 
 Image::Image(const IntVec2& size)
+	: Image(size, Rgba::WHITE)
 {
-	m_dimensions.x = size.x;
-	m_dimensions.y = size.y;
-
-	int numTexels = size.x * size.y;
-
-	m_imageRawData = new unsigned char[numTexels * 4];
-	m_texels.resize(numTexels);
-
-	for(int texelIndex = 0; texelIndex < numTexels; texelIndex++)
-	{
-		m_texels[texelIndex].SetRgbaBytes(255, 255, 255, 255);
-		m_imageRawData[texelIndex] = 255;
-		m_imageRawData[texelIndex + 1] = 255;
-		m_imageRawData[texelIndex + 2] = 255;
-		m_imageRawData[texelIndex + 3] = 255;
-	}
 }
 
 Image::Image( const IntVec2& size, const Vec3& color )
+	: Image(size, Rgba(color.x, color.y, color.z, 1.0f))
 {
-	m_dimensions.x = size.x;
-	m_dimensions.y = size.y;
-	Vec3 newColor = color * 255.0f;
-
-	int numTexels = size.x * size.y;
-
-	m_imageRawData = new unsigned char[numTexels * 4];
-	m_texels.resize(numTexels);
-
-	for(int texelIndex = 0; texelIndex < numTexels; texelIndex++)
-	{
-		m_texels[texelIndex].SetRgbaBytes((unsigned char)newColor.x, (unsigned char)newColor.y, (unsigned char)newColor.z, 255);
-		m_imageRawData[texelIndex]		= (unsigned char)newColor.x;
-		m_imageRawData[texelIndex + 1]	= (unsigned char)newColor.y;
-		m_imageRawData[texelIndex + 2]	= (unsigned char)newColor.z;
-		m_imageRawData[texelIndex + 3]	= 255;
-	}
 }
 
 Image::Image( const IntVec2& size, const Rgba& color )
 {
 	m_dimensions.x = size.x;
 	m_dimensions.y = size.y;
-	Rgba newColor = color * 255.0f;
-
-	int numTexels = size.x * size.y;
 
-	m_imageRawData = new unsigned char[numTexels * 4];
-	m_texels.resize(numTexels);
-
-	for(int texelIndex = 0; texelIndex < numTexels; texelIndex++)
-	{
-		m_texels[texelIndex].SetRgbaBytes((unsigned char)newColor.r, (unsigned char)newColor.g, (unsigned char)newColor.b, (unsigned char)newColor.a);
-		m_imageRawData[texelIndex]		= (unsigned char)newColor.r;
-		m_imageRawData[texelIndex + 1]	= (unsigned char)newColor.g;
-		m_imageRawData[texelIndex + 2]	= (unsigned char)newColor.b;
-		m_imageRawData[texelIndex + 3]	= (unsigned char)newColor.a;
-	}
+	m_pixels.resize(GetImageBufferSize());
+	Fill(color);
 }
 
 Image::Image( const char* imageFilePath )
@@ -75,76 +37,29 @@ Image::Image( const char* imageFilePath )
 	int imageTexelSizeX = 0; // Filled in for us to indicate image width
 	int imageTexelSizeY = 0; // Filled in for us to indicate image height
 	int numComponents = 0;   // Filled in for us to indicate how many color components the image had (e.g. 3=RGB=24bit, 4=RGBA=32bit)
-	int numComponentsRequested = 0; // don't care; we support 3 (24-bit RGB) or 4 (32-bit RGBA)
+	int numComponentsRequested = 0; // don't care; we expand whatever it has to RGBA8
 
-	//stbi_set_flip_vertically_on_load( 1 ); // We prefer uvTexCoords has origin (0,0) at BOTTOM LEFT
-	unsigned char* data = stbi_load( imageFilePath, &imageTexelSizeX, &imageTexelSizeY, &numComponents, numComponentsRequested );
-	m_imageRawData = new unsigned char[imageTexelSizeX * imageTexelSizeY * 4];
-	
-	m_dimensions.x = imageTexelSizeX;
-	m_dimensions.y = imageTexelSizeY;
-
-	int numTexels = imageTexelSizeX * imageTexelSizeY;
-	m_texels.resize(numTexels);
-
-	if(numComponents == 3)
-	{		
-		for(int texelIndex = 0; texelIndex < numTexels; texelIndex++)
-		{
-
-			int redByteIndex = (texelIndex * numComponents) + 0;
-			int greenByteIndex = (texelIndex * numComponents) + 1;
-			int blueByteIndex = (texelIndex * numComponents) + 2;
-
-			unsigned char redByte = data[redByteIndex];
-			unsigned char greenByte = data[greenByteIndex];
-			unsigned char blueByte = data[blueByteIndex];
-
-			m_texels[texelIndex].SetRgbaBytes(redByte, greenByte, blueByte);
-			m_imageRawData[texelIndex * 4] = redByte;
-			m_imageRawData[texelIndex * 4 + 1] = greenByte;
-			m_imageRawData[texelIndex * 4 + 2] = blueByte;
-			m_imageRawData[texelIndex * 4 + 3] = 255;
-		}
-	}
-	else if(numComponents == 4)
-	{
-		for(int texelIndex = 0; texelIndex < numTexels; texelIndex++)
-		{
-			int redByteIndex = (texelIndex * numComponents) + 0;
-			int greenByteIndex = (texelIndex * numComponents) + 1;
-			int blueByteIndex = (texelIndex * numComponents) + 2;
-			int alphaByteIndex = (texelIndex * numComponents) + 3;
-
-			unsigned char redByte = data[redByteIndex];
-			unsigned char greenByte = data[greenByteIndex];
-			unsigned char blueByte = data[blueByteIndex];
-			unsigned char alphaByte = data[alphaByteIndex];
-
-			// this needs to be in rgba hpp/cpp
-			m_texels[texelIndex].SetRgbaBytes(redByte, greenByte, blueByte, alphaByte); 
-			m_imageRawData[texelIndex * numComponents] = redByte;
-			m_imageRawData[texelIndex * numComponents + 1] = greenByte;
-			m_imageRawData[texelIndex * numComponents + 2] = blueByte;
-			m_imageRawData[texelIndex * numComponents + 3] = alphaByte;
-		}
-	}
-	else
-	{
-		ERROR_AND_DIE("Could not read image.");
-	}
+	// Decoded straight from the pack archive or the mapped file;
+	DataFile imageFile(imageFilePath);
 
-	STBI_FREE(data);
+	//stbi_set_flip_vertically_on_load( 1 ); // We prefer uvTexCoords has origin (0,0) at BOTTOM LEFT
+	unsigned char* data = stbi_load_from_memory( imageFile.GetData(), (int)imageFile.GetSize(), &imageTexelSizeX, &imageTexelSizeY, &numComponents, numComponentsRequested );
+	SetFromDecodedData(data, imageTexelSizeX, imageTexelSizeY, numComponents);
 }
 
+Image::Image( const unsigned char* fileData, size_t fileSize, const char* imageFilePath )
+	:m_imageFilePath(imageFilePath)
+{
+	int imageTexelSizeX = 0;
+	int imageTexelSizeY = 0;
+	int numComponents = 0;
 
-
-
+	unsigned char* data = stbi_load_from_memory( fileData, (int)fileSize, &imageTexelSizeX, &imageTexelSizeY, &numComponents, 0 );
+	SetFromDecodedData(data, imageTexelSizeX, imageTexelSizeY, numComponents);
+}
 
 Image::~Image()
 {
-	delete m_imageRawData;
-	m_imageRawData = nullptr;
 }
 
 const std::string& Image::GetImageFilePath() const
@@ -154,8 +69,13 @@ const std::string& Image::GetImageFilePath() const
 
 const Rgba& Image::GetTexelColor( int texelX, int texelY ) const
 {
+	if(m_floatTexels.empty())
+	{
+		MakeFloatView();
+	}
+
 	int texelColorIndex = texelX + texelY * m_dimensions.x;
-	return m_texels[texelColorIndex];
+	return m_floatTexels[texelColorIndex];
 }
 
 const Rgba& Image::GetTexelColor( const IntVec2& texelCoords ) const
@@ -163,6 +83,13 @@ const Rgba& Image::GetTexelColor( const IntVec2& texelCoords ) const
 	return GetTexelColor(texelCoords.x, texelCoords.y);
 }
 
+uint32_t Image::GetTexelRgba8( int texelX, int texelY ) const
+{
+	uint32_t texel;
+	memcpy(&texel, &m_pixels[((size_t)texelX + (size_t)texelY * (size_t)m_dimensions.x) * 4], 4);
+	return texel;
+}
+
 IntVec2 Image::GetDimensions() const
 {
 	return m_dimensions;
@@ -173,15 +100,79 @@ uint Image::GetBytesPerPixel() const
 	return 4;
 }
 
-unsigned char* Image::GetImageBuffer() const
+size_t Image::GetImageBufferSize() const
+{
+	return (size_t)m_dimensions.x * (size_t)m_dimensions.y * GetBytesPerPixel();
+}
+
+const unsigned char* Image::GetImageBuffer() const
+{
+	return m_pixels.data();
+}
+
+unsigned char* Image::GetImageBuffer()
+{
+	// Caller may write through it;
+	ReleaseFloatView();
+	return m_pixels.data();
+}
+
+void Image::Fill( const Rgba& color )
+{
+	FillPixelsRgba8(GetImageBuffer(), (size_t)m_dimensions.x * (size_t)m_dimensions.y, PackRgba8(color));
+}
+
+void Image::PremultiplyAlpha()
+{
+	PremultiplyAlphaRgba8(GetImageBuffer(), (size_t)m_dimensions.x * (size_t)m_dimensions.y);
+}
+
+void Image::FlipVertically()
+{
+	FlipRowsVertically(GetImageBuffer(), m_dimensions.x, m_dimensions.y, GetBytesPerPixel());
+}
+
+void Image::ReleaseFloatView() const
+{
+	std::vector<Rgba>().swap(m_floatTexels);
+}
+
+void Image::SetFromDecodedData( unsigned char* decodedData, int width, int height, int numComponents )
+{
+	if(decodedData == nullptr)
+	{
+		ERROR_AND_DIE(Stringf("Could not read image \"%s\".", m_imageFilePath.c_str()));
+	}
+
+	m_dimensions.x = width;
+	m_dimensions.y = height;
+
+	// The decoded copy is only alive until it is expanded, this buffer is the only one kept;
+	m_pixels.resize(GetImageBufferSize());
+	bool isExpanded = ExpandToRgba8(decodedData, numComponents, m_pixels.data(), (size_t)width * (size_t)height);
+	STBI_FREE(decodedData);
+
+	if(!isExpanded)
+	{
+		ERROR_AND_DIE(Stringf("Could not read image \"%s\", %i components.", m_imageFilePath.c_str(), numComponents));
+	}
+}
+
+void Image::MakeFloatView() const
 {
-	return m_imageRawData;
+	size_t numTexels = (size_t)m_dimensions.x * (size_t)m_dimensions.y;
+	m_floatTexels.resize(numTexels);
+
+	const unsigned char* texel = m_pixels.data();
+	for(size_t texelIndex = 0; texelIndex < numTexels; texelIndex++, texel += 4)
+	{
+		m_floatTexels[texelIndex].SetRgbaBytes(texel[0], texel[1], texel[2], texel[3]);
+	}
 }
 
 bool Image::SaveImageToDisc(char const *filename)
 {	
-	int returnvalue = stbi_write_png(filename, m_dimensions.x, m_dimensions.y, 4, m_imageRawData, m_dimensions.x * 4);
+	int returnvalue = stbi_write_png(filename, m_dimensions.x, m_dimensions.y, 4, m_pixels.data(), m_dimensions.x * 4);
 
 	return returnvalue == 1;
 }
-
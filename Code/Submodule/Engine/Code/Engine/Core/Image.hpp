@@ -2,12 +2,20 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/IntVec2.hpp"
 
+#include <stdint.h>
+#include <string>
 #include <vector>
 
 typedef unsigned int uint;
 
 struct Rgba;
 
+//-----------------------------------------------------------------------------------------------
+// Image;
+// One tightly packed RGBA8 buffer, the format the textures are created with;
+// GetTexelColor() needs float texels, they are only built the first time it is called (16 bytes a
+// pixel), and dropped again on any write through the non const GetImageBuffer() or ReleaseFloatView();
+//-----------------------------------------------------------------------------------------------
 class Image
 {
 public:
@@ -15,27 +23,34 @@ public:
 	Image(const IntVec2& size, const Vec3& color);
 	Image(const IntVec2& size, const Rgba& color);
 	Image(const char* imageFilePath);
+	Image(const unsigned char* fileData, size_t fileSize, const char* imageFilePath);	// Decodes a file already in memory, the path is only kept as the name;
 	~Image();
 
 	const std::string& GetImageFilePath() const;
 	const Rgba& GetTexelColor(int texelX, int texelY) const;
 	const Rgba& GetTexelColor(const IntVec2& texelCoords) const;
+	uint32_t GetTexelRgba8(int texelX, int texelY) const;			// Red in the lowest byte, see PackRgba8;
 	IntVec2 GetDimensions() const;
 	uint GetBytesPerPixel() const;
-	unsigned char* GetImageBuffer() const;
-
-	bool SaveImageToDisc(char const *filename);
+	size_t GetImageBufferSize() const;
+	const unsigned char* GetImageBuffer() const;
+	unsigned char* GetImageBuffer();
 
+	void Fill(const Rgba& color);
+	void PremultiplyAlpha();
+	void FlipVertically();
+	void ReleaseFloatView() const;
 
+	bool SaveImageToDisc(char const *filename);
 
-public:
+private:
 
-	unsigned char* m_imageRawData = nullptr;	
+	void SetFromDecodedData(unsigned char* decodedData, int width, int height, int numComponents);	// Takes ownership of decodedData;
+	void MakeFloatView() const;
 
 private:
 	std::string m_imageFilePath;
 	IntVec2 m_dimensions = IntVec2(0, 0);
-	std::vector<Rgba> m_texels;
-	
-
-};
\ No newline at end of file
+	std::vector<unsigned char> m_pixels;
+	mutable std::vector<Rgba> m_floatTexels;
+};
@@ -0,0 +1,12 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// ------------------------------------------------------------------------------------------------
+// Pixel routine benchmark at the sizes of the given images;
+// Only the headers are read (stbi_info), the buffers are synthetic, so it times the conversions and
+// not the PNG decode; each routine runs iterations_ times against the per texel loops Image used to
+// have, and the resident bytes of the old RGBA8 + float layout are printed next to RGBA8 alone;
+// Prints to the DevConsole and blocks the caller;
+// ------------------------------------------------------------------------------------------------
+void RunImageBenchmark(const std::vector<std::string>& imagePaths_, int iterations_);
@@ -0,0 +1,155 @@
+#include "Engine/Core/MemoryMappedFile.hpp"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+// ------------------------------------------------------------------------------------------------
+MemoryMappedFile::MemoryMappedFile(const std::string& filepath_)
+{
+	Open(filepath_);
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile()
+{
+	Close();
+}
+
+#ifdef _WIN32
+
+// ------------------------------------------------------------------------------------------------
+// The file handle is closed as soon as the mapping exists, the mapping keeps the file alive; a handle left open
+// with FILE_SHARE_READ would stop anything from opening the file to rewrite it;
+// ------------------------------------------------------------------------------------------------
+bool MemoryMappedFile::Open(const std::string& filepath_)
+{
+	Close();
+
+	HANDLE fileHandle = CreateFileA(filepath_.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if(fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	// Zero length files can't be mapped;
+	HANDLE mappingHandle = nullptr;
+	if(fileSize.QuadPart > 0)
+	{
+		mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if(mappingHandle == nullptr)
+		{
+			CloseHandle(fileHandle);
+			return false;
+		}
+	}
+	CloseHandle(fileHandle);
+
+	m_path = filepath_;
+	m_size = (size_t)fileSize.QuadPart;
+	m_isOpen = true;
+
+	if(mappingHandle == nullptr)
+	{
+		return true;
+	}
+	m_mappingHandle = mappingHandle;
+
+	m_data = (const unsigned char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if(m_data == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryMappedFile::Close()
+{
+	if(m_data != nullptr)
+	{
+		UnmapViewOfFile(m_data);
+	}
+	if(m_mappingHandle != nullptr)
+	{
+		CloseHandle((HANDLE)m_mappingHandle);
+	}
+
+	m_path.clear();
+	m_data = nullptr;
+	m_size = 0;
+	m_isOpen = false;
+	m_mappingHandle = nullptr;
+}
+
+#else
+
+// ------------------------------------------------------------------------------------------------
+// The descriptor is closed as soon as the view exists, the view keeps the file alive;
+// ------------------------------------------------------------------------------------------------
+bool MemoryMappedFile::Open(const std::string& filepath_)
+{
+	Close();
+
+	int fileDescriptor = open(filepath_.c_str(), O_RDONLY);
+	if(fileDescriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStats;
+	if(fstat(fileDescriptor, &fileStats) != 0)
+	{
+		close(fileDescriptor);
+		return false;
+	}
+
+	size_t fileSize = (size_t)fileStats.st_size;
+	if(fileSize > 0)
+	{
+		void* view = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		if(view == MAP_FAILED)
+		{
+			close(fileDescriptor);
+			return false;
+		}
+		m_data = (const unsigned char*)view;
+	}
+	close(fileDescriptor);
+
+	m_path = filepath_;
+	m_size = fileSize;
+	m_isOpen = true;
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryMappedFile::Close()
+{
+	if(m_data != nullptr)
+	{
+		munmap((void*)m_data, m_size);
+	}
+
+	m_path.clear();
+	m_data = nullptr;
+	m_size = 0;
+	m_isOpen = false;
+}
+
+#endif
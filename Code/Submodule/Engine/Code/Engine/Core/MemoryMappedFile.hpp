@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stddef.h>
+#include <string>
+
+// ----------------------------------------------------------------------------
+// MemoryMappedFile;
+// Read only view of a whole file; the OS pages it in on first touch, so nothing is copied
+// and unread parts cost nothing; the view stays valid until Close or destruction;
+// ----------------------------------------------------------------------------
+class MemoryMappedFile
+{
+
+public:
+
+	MemoryMappedFile() {}
+	explicit MemoryMappedFile(const std::string& filepath_);
+	~MemoryMappedFile();
+
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+	MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+	// False if the file is missing or can't be mapped; an empty file opens with no data;
+	bool Open(const std::string& filepath_);
+	void Close();
+
+	inline bool IsOpen() const								{ return m_isOpen; }
+	inline const unsigned char* GetData() const				{ return m_data; }
+	inline size_t GetSize() const							{ return m_size; }
+	inline const std::string& GetPath() const				{ return m_path; }
+
+private:
+
+	std::string m_path;
+	const unsigned char* m_data = nullptr;
+	size_t m_size = 0;
+	bool m_isOpen = false;
+
+	// The mapping's HANDLE on Windows, the file itself isn't held open;
+	void* m_mappingHandle = nullptr;
+};
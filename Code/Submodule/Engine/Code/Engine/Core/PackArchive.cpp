@@ -0,0 +1,439 @@
+#include "Engine/Core/PackArchive.hpp"
+#include "Engine/Core/CRC32.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "ThirdParty/stb/stb_image.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+// Defined by stb_write.h (compiled in Image.cpp), which only declares it in its implementation half;
+extern "C" unsigned char* stbi_zlib_compress( unsigned char* data, int data_len, int* out_len, int quality );
+
+PackArchive* g_thePackArchive = nullptr;
+
+// ------------------------------------------------------------------------------------------------
+static inline char NormalizePathChar( char character )
+{
+	if(character == '\\')
+	{
+		return '/';
+	}
+	if(character >= 'A' && character <= 'Z')
+	{
+		return character - 'A' + 'a';
+	}
+	return character;
+}
+
+// ------------------------------------------------------------------------------------------------
+// FNV-1a over the normalized characters;
+// ------------------------------------------------------------------------------------------------
+uint64_t HashPackPath( const char* path_, size_t length_ )
+{
+	uint64_t hash = 14695981039346656037ull;
+	for(size_t charIndex = 0; charIndex < length_; ++charIndex)
+	{
+		hash = (hash ^ (uint8_t)NormalizePathChar(path_[charIndex])) * 1099511628211ull;
+	}
+	return hash;
+}
+
+// ------------------------------------------------------------------------------------------------
+PackArchive::~PackArchive()
+{
+	Close();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PackArchive::Open( const std::string& archivePath_ )
+{
+	Close();
+
+	if(!m_archiveFile.Open(archivePath_))
+	{
+		return false;
+	}
+
+	const unsigned char* data = m_archiveFile.GetData();
+	uint64_t size = m_archiveFile.GetSize();
+	if(size < sizeof(PackArchiveHeader))
+	{
+		DebuggerPrintf("PackArchive: \"%s\" is too small.\n", archivePath_.c_str());
+		m_archiveFile.Close();
+		return false;
+	}
+
+	const PackArchiveHeader* header = (const PackArchiveHeader*)data;
+	uint64_t entriesEnd = header->m_entriesOffset + (uint64_t)header->m_entryCount * sizeof(PackArchiveEntry);
+	uint64_t slotsEnd = header->m_slotsOffset + (uint64_t)header->m_slotCount * sizeof(uint);
+	uint64_t namesEnd = header->m_namesOffset + header->m_namesSize;
+
+	bool isValid = header->m_magic == PACK_ARCHIVE_MAGIC
+		&& header->m_version == PACK_ARCHIVE_VERSION
+		&& header->m_slotCount > 0
+		&& (header->m_slotCount & (header->m_slotCount - 1)) == 0
+		&& header->m_slotCount >= header->m_entryCount
+		&& header->m_entriesOffset % alignof(PackArchiveEntry) == 0
+		&& header->m_slotsOffset % alignof(uint) == 0
+		&& entriesEnd <= size && slotsEnd <= size && namesEnd <= size;
+
+	if(isValid)
+	{
+		const PackArchiveEntry* entries = (const PackArchiveEntry*)(data + header->m_entriesOffset);
+		for(uint entryIndex = 0; entryIndex < header->m_entryCount && isValid; ++entryIndex)
+		{
+			const PackArchiveEntry& entry = entries[entryIndex];
+			isValid = entry.m_dataOffset + entry.m_storedSize <= size
+				&& (uint64_t)entry.m_nameOffset + entry.m_nameLength <= header->m_namesSize
+				&& entry.m_compression < PACK_COMPRESSION_COUNT
+				&& (entry.m_compression != PACK_COMPRESSION_NONE || entry.m_storedSize == entry.m_size);
+		}
+	}
+
+	if(!isValid)
+	{
+		DebuggerPrintf("PackArchive: \"%s\" is not a version %u pack archive.\n", archivePath_.c_str(), PACK_ARCHIVE_VERSION);
+		m_archiveFile.Close();
+		return false;
+	}
+
+	m_header = header;
+	m_entries = (const PackArchiveEntry*)(data + header->m_entriesOffset);
+	m_slots = (const uint*)(data + header->m_slotsOffset);
+	m_names = (const char*)(data + header->m_namesOffset);
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void PackArchive::Close()
+{
+	m_archiveFile.Close();
+	m_header = nullptr;
+	m_entries = nullptr;
+	m_slots = nullptr;
+	m_names = nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string PackArchive::GetEntryPath( uint entryIndex_ ) const
+{
+	const PackArchiveEntry& entry = m_entries[entryIndex_];
+	return std::string(m_names + entry.m_nameOffset, entry.m_nameLength);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PackArchive::IsEntryPath( const PackArchiveEntry& entry_, const char* path_, size_t length_ ) const
+{
+	if(entry_.m_nameLength != length_)
+	{
+		return false;
+	}
+
+	const char* name = m_names + entry_.m_nameOffset;
+	for(size_t charIndex = 0; charIndex < length_; ++charIndex)
+	{
+		if(NormalizePathChar(name[charIndex]) != NormalizePathChar(path_[charIndex]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+const PackArchiveEntry* PackArchive::FindEntry( const std::string& path_ ) const
+{
+	if(!IsOpen())
+	{
+		return nullptr;
+	}
+
+	// "./Data/..." is the same file as "Data/...";
+	const char* path = path_.c_str();
+	size_t length = path_.size();
+	while(length >= 2 && path[0] == '.' && (path[1] == '/' || path[1] == '\\'))
+	{
+		path += 2;
+		length -= 2;
+	}
+
+	uint64_t hash = HashPackPath(path, length);
+	uint mask = m_header->m_slotCount - 1;
+	for(uint probe = 0, slot = (uint)hash & mask; probe < m_header->m_slotCount; ++probe, slot = (slot + 1) & mask)
+	{
+		uint slotValue = m_slots[slot];
+		if(slotValue == 0 || slotValue > m_header->m_entryCount)
+		{
+			return nullptr;
+		}
+
+		const PackArchiveEntry& entry = m_entries[slotValue - 1];
+		if(entry.m_pathHash == hash && IsEntryPath(entry, path, length))
+		{
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+const unsigned char* PackArchive::GetStoredData( const PackArchiveEntry& entry_ ) const
+{
+	return m_archiveFile.GetData() + entry_.m_dataOffset;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PackArchive::GetView( const std::string& path_, const unsigned char** outData_, size_t* outSize_ ) const
+{
+	const PackArchiveEntry* entry = FindEntry(path_);
+	if(entry == nullptr || entry->m_compression != PACK_COMPRESSION_NONE)
+	{
+		return false;
+	}
+
+	*outData_ = GetStoredData(*entry);
+	*outSize_ = (size_t)entry->m_size;
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PackArchive::ReadEntry( const PackArchiveEntry& entry_, std::vector<unsigned char>* outData_ ) const
+{
+	const unsigned char* storedData = GetStoredData(entry_);
+	if(entry_.m_compression == PACK_COMPRESSION_NONE)
+	{
+		outData_->assign(storedData, storedData + entry_.m_size);
+		return true;
+	}
+
+	outData_->resize((size_t)entry_.m_size);
+	int inflatedSize = stbi_zlib_decode_buffer((char*)outData_->data(), (int)entry_.m_size, (const char*)storedData, (int)entry_.m_storedSize);
+	if(inflatedSize != (int)entry_.m_size || CRC32((const void*)outData_->data(), (int)outData_->size()) != entry_.m_crc32)
+	{
+		DebuggerPrintf("PackArchive: entry \"%s\" is corrupt.\n", std::string(m_names + entry_.m_nameOffset, entry_.m_nameLength).c_str());
+		outData_->clear();
+		return false;
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builder;
+// ------------------------------------------------------------------------------------------------
+struct PackBuildEntry
+{
+	std::string m_path;
+	std::string m_normalizedPath;
+	std::vector<unsigned char> m_storedData;
+	PackArchiveEntry m_entry;
+};
+
+// ------------------------------------------------------------------------------------------------
+static std::string NormalizePath( const std::string& path_ )
+{
+	std::string normalized = path_;
+	for(char& character : normalized)
+	{
+		character = NormalizePathChar(character);
+	}
+	return normalized;
+}
+
+// ------------------------------------------------------------------------------------------------
+static inline uint64_t AlignUp( uint64_t value_, uint64_t alignment_ )
+{
+	return (value_ + alignment_ - 1) / alignment_ * alignment_;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool BuildPackArchive( const std::string& sourceFolder_, const std::string& archivePath_, const PackBuildOptions& options_, PackBuildStats* outStats_ )
+{
+	namespace fs = std::filesystem;
+
+	std::error_code errorCode;
+	if(!fs::is_directory(sourceFolder_, errorCode))
+	{
+		DebuggerPrintf("BuildPackArchive: \"%s\" is not a folder.\n", sourceFolder_.c_str());
+		return false;
+	}
+
+	std::vector<std::string> excludedFolders;
+	for(const std::string& excludedFolder : options_.m_excludedFolders)
+	{
+		excludedFolders.push_back(NormalizePath(excludedFolder) + "/");
+	}
+
+	std::string normalizedArchivePath = NormalizePath(fs::path(archivePath_).generic_string());
+	uint64_t alignment = options_.m_alignment > 0 ? options_.m_alignment : 1;
+
+	// Gather, in path order so each folder is one run of the archive;
+	std::vector<PackBuildEntry> buildEntries;
+	for(fs::recursive_directory_iterator fileIter(sourceFolder_, errorCode), endIter; fileIter != endIter; fileIter.increment(errorCode))
+	{
+		if(errorCode || !fileIter->is_regular_file(errorCode))
+		{
+			continue;
+		}
+
+		PackBuildEntry buildEntry;
+		buildEntry.m_path = fileIter->path().generic_string();
+		buildEntry.m_normalizedPath = NormalizePath(buildEntry.m_path);
+
+		bool isExcluded = buildEntry.m_normalizedPath == normalizedArchivePath;
+		for(const std::string& excludedFolder : excludedFolders)
+		{
+			isExcluded = isExcluded || buildEntry.m_normalizedPath.compare(0, excludedFolder.size(), excludedFolder) == 0;
+		}
+		if(!isExcluded)
+		{
+			buildEntries.push_back(std::move(buildEntry));
+		}
+	}
+
+	std::sort(buildEntries.begin(), buildEntries.end(), [](const PackBuildEntry& a, const PackBuildEntry& b) { return a.m_normalizedPath < b.m_normalizedPath; });
+
+	// Read and compress;
+	PackBuildStats stats;
+	uint64_t namesSize = 0;
+	for(PackBuildEntry& buildEntry : buildEntries)
+	{
+		std::ifstream fileStream(buildEntry.m_path, std::ios::binary | std::ios::ate);
+		if(!fileStream.is_open())
+		{
+			DebuggerPrintf("BuildPackArchive: could not read \"%s\".\n", buildEntry.m_path.c_str());
+			return false;
+		}
+
+		std::vector<unsigned char> fileData((size_t)fileStream.tellg());
+		fileStream.seekg(0);
+		fileStream.read((char*)fileData.data(), (std::streamsize)fileData.size());
+
+		PackArchiveEntry& entry = buildEntry.m_entry;
+		entry.m_pathHash = HashPackPath(buildEntry.m_path.c_str(), buildEntry.m_path.size());
+		entry.m_size = fileData.size();
+		entry.m_crc32 = CRC32((const void*)fileData.data(), (int)fileData.size());
+		entry.m_nameOffset = (uint)namesSize;
+		entry.m_nameLength = (uint)buildEntry.m_path.size();
+		namesSize += buildEntry.m_path.size();
+
+		std::string extension = NormalizePath(fs::path(buildEntry.m_path).extension().string());
+		bool wantsCompression = !fileData.empty() && std::find(options_.m_compressedExtensions.begin(), options_.m_compressedExtensions.end(), extension) != options_.m_compressedExtensions.end();
+		if(wantsCompression)
+		{
+			int compressedSize = 0;
+			unsigned char* compressedData = stbi_zlib_compress(fileData.data(), (int)fileData.size(), &compressedSize, 8);
+			if(compressedData != nullptr && (float)compressedSize < (float)fileData.size() * options_.m_minCompressionRatio)
+			{
+				buildEntry.m_storedData.assign(compressedData, compressedData + compressedSize);
+				entry.m_compression = PACK_COMPRESSION_ZLIB;
+				++stats.m_compressedCount;
+			}
+			free(compressedData);
+		}
+
+		if(entry.m_compression == PACK_COMPRESSION_NONE)
+		{
+			buildEntry.m_storedData.swap(fileData);
+		}
+		entry.m_storedSize = buildEntry.m_storedData.size();
+
+		++stats.m_fileCount;
+		stats.m_sourceBytes += entry.m_size;
+	}
+
+	// Layout;
+	PackArchiveHeader header;
+	header.m_entryCount = (uint)buildEntries.size();
+	header.m_slotCount = 16;
+	while(header.m_slotCount < header.m_entryCount * 2)
+	{
+		header.m_slotCount *= 2;
+	}
+	header.m_alignment = (uint)alignment;
+	header.m_entriesOffset = sizeof(PackArchiveHeader);
+	header.m_slotsOffset = header.m_entriesOffset + (uint64_t)header.m_entryCount * sizeof(PackArchiveEntry);
+	header.m_namesOffset = header.m_slotsOffset + (uint64_t)header.m_slotCount * sizeof(uint);
+	header.m_namesSize = namesSize;
+
+	uint64_t dataOffset = header.m_namesOffset + header.m_namesSize;
+	std::vector<uint> slots(header.m_slotCount, 0);
+	for(uint entryIndex = 0; entryIndex < header.m_entryCount; ++entryIndex)
+	{
+		PackArchiveEntry& entry = buildEntries[entryIndex].m_entry;
+		dataOffset = AlignUp(dataOffset, alignment);
+		entry.m_dataOffset = dataOffset;
+		dataOffset += entry.m_storedSize;
+
+		uint slot = (uint)entry.m_pathHash & (header.m_slotCount - 1);
+		while(slots[slot] != 0)
+		{
+			slot = (slot + 1) & (header.m_slotCount - 1);
+		}
+		slots[slot] = entryIndex + 1;
+	}
+
+	// Write next to the archive and swap it in, the old one may still be mapped by a reader;
+	std::string tempPath = Stringf("%s.%zx.tmp", archivePath_.c_str(), std::hash<std::thread::id>()(std::this_thread::get_id()));
+	{
+		std::ofstream archiveStream(tempPath, std::ios::binary | std::ios::trunc);
+		if(!archiveStream.is_open())
+		{
+			DebuggerPrintf("BuildPackArchive: could not write \"%s\".\n", tempPath.c_str());
+			return false;
+		}
+
+		archiveStream.write((const char*)&header, sizeof(header));
+		for(const PackBuildEntry& buildEntry : buildEntries)
+		{
+			archiveStream.write((const char*)&buildEntry.m_entry, sizeof(PackArchiveEntry));
+		}
+		archiveStream.write((const char*)slots.data(), (std::streamsize)slots.size() * sizeof(uint));
+		for(const PackBuildEntry& buildEntry : buildEntries)
+		{
+			archiveStream.write(buildEntry.m_path.data(), (std::streamsize)buildEntry.m_path.size());
+		}
+
+		static const char s_padding[256] = {};
+		uint64_t writtenBytes = header.m_namesOffset + header.m_namesSize;
+		for(const PackBuildEntry& buildEntry : buildEntries)
+		{
+			while(writtenBytes < buildEntry.m_entry.m_dataOffset)
+			{
+				uint64_t paddingBytes = std::min<uint64_t>(buildEntry.m_entry.m_dataOffset - writtenBytes, sizeof(s_padding));
+				archiveStream.write(s_padding, (std::streamsize)paddingBytes);
+				writtenBytes += paddingBytes;
+			}
+			archiveStream.write((const char*)buildEntry.m_storedData.data(), (std::streamsize)buildEntry.m_storedData.size());
+			writtenBytes += buildEntry.m_storedData.size();
+		}
+
+		if(!archiveStream.good())
+		{
+			archiveStream.close();
+			fs::remove(tempPath, errorCode);
+			DebuggerPrintf("BuildPackArchive: writing \"%s\" failed.\n", tempPath.c_str());
+			return false;
+		}
+		stats.m_archiveBytes = writtenBytes;
+	}
+
+	fs::rename(tempPath, archivePath_, errorCode);
+	if(errorCode)
+	{
+		fs::remove(tempPath, errorCode);
+		DebuggerPrintf("BuildPackArchive: could not replace \"%s\", is it still open?\n", archivePath_.c_str());
+		return false;
+	}
+
+	if(outStats_ != nullptr)
+	{
+		*outStats_ = stats;
+	}
+	return true;
+}
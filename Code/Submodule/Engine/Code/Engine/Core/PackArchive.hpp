@@ -0,0 +1,128 @@
+#pragma once
+#include "Engine/Core/MemoryMappedFile.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+typedef unsigned int uint;
+
+// ----------------------------------------------------------------------------
+// Pack archive format, native endian;
+// Header, entry table, hash slots and entry names come first so opening touches one or two pages;
+// entry data follows, aligned and in path order so a folder's files sit next to each other;
+// ----------------------------------------------------------------------------
+constexpr uint PACK_ARCHIVE_MAGIC		= 0x4B434150;		// "PACK";
+constexpr uint PACK_ARCHIVE_VERSION		= 1;
+
+enum ePackCompression : uint
+{
+	PACK_COMPRESSION_NONE = 0,			// Handed out in place;
+	PACK_COMPRESSION_ZLIB,				// Inflated into the reader's buffer;
+
+	PACK_COMPRESSION_COUNT
+};
+
+struct PackArchiveHeader
+{
+	uint m_magic = PACK_ARCHIVE_MAGIC;
+	uint m_version = PACK_ARCHIVE_VERSION;
+	uint m_entryCount = 0;
+	uint m_slotCount = 0;				// Power of two, at least twice the entries;
+	uint m_alignment = 0;
+	uint m_reserved = 0;
+	uint64_t m_entriesOffset = 0;
+	uint64_t m_slotsOffset = 0;			// uint per slot, entry index + 1, 0 is empty;
+	uint64_t m_namesOffset = 0;
+	uint64_t m_namesSize = 0;
+};
+
+struct PackArchiveEntry
+{
+	uint64_t m_pathHash = 0;			// See HashPackPath;
+	uint64_t m_dataOffset = 0;
+	uint64_t m_storedSize = 0;
+	uint64_t m_size = 0;
+	uint m_nameOffset = 0;
+	uint m_nameLength = 0;
+	uint m_compression = PACK_COMPRESSION_NONE;
+	uint m_crc32 = 0;					// Of the uncompressed bytes;
+};
+
+// Paths are matched without case and with either slash, "Data\XML\Cards.xml" finds "data/xml/cards.xml";
+uint64_t HashPackPath( const char* path_, size_t length_ );
+
+// ----------------------------------------------------------------------------
+// PackArchive;
+// Maps the whole archive once; lookups hash the path into the slot table and never allocate;
+// Read only after Open, so any thread can look things up;
+// ----------------------------------------------------------------------------
+class PackArchive
+{
+
+public:
+
+	PackArchive() {}
+	~PackArchive();
+
+	PackArchive(const PackArchive&) = delete;
+	PackArchive& operator=(const PackArchive&) = delete;
+
+	// False for a missing file or one that doesn't pass the header checks;
+	bool Open(const std::string& archivePath_);
+	void Close();
+
+	inline bool IsOpen() const								{ return m_header != nullptr; }
+	inline uint GetEntryCount() const						{ return IsOpen() ? m_header->m_entryCount : 0; }
+	inline const PackArchiveEntry& GetEntry(uint entryIndex_) const { return m_entries[entryIndex_]; }
+	std::string GetEntryPath(uint entryIndex_) const;
+
+	const PackArchiveEntry* FindEntry(const std::string& path_) const;
+	inline bool Contains(const std::string& path_) const	{ return FindEntry(path_) != nullptr; }
+
+	// The stored bytes of an entry, compressed or not; valid while the archive is open;
+	const unsigned char* GetStoredData(const PackArchiveEntry& entry_) const;
+
+	// Uncompressed entries only; the view points into the mapped archive;
+	bool GetView(const std::string& path_, const unsigned char** outData_, size_t* outSize_) const;
+
+	// Any entry; compressed entries are inflated and checked against their CRC32;
+	bool ReadEntry(const PackArchiveEntry& entry_, std::vector<unsigned char>* outData_) const;
+
+private:
+
+	bool IsEntryPath(const PackArchiveEntry& entry_, const char* path_, size_t length_) const;
+
+private:
+
+	MemoryMappedFile m_archiveFile;
+	const PackArchiveHeader* m_header = nullptr;
+	const PackArchiveEntry* m_entries = nullptr;
+	const uint* m_slots = nullptr;
+	const char* m_names = nullptr;
+};
+
+// ----------------------------------------------------------------------------
+// Builder;
+// Packs every file under sourceFolder_ (paths as seen from the working directory, e.g. "Data/XML/Cards.xml");
+// ----------------------------------------------------------------------------
+struct PackBuildOptions
+{
+	uint m_alignment = 16;
+	std::vector<std::string> m_compressedExtensions = { ".xml", ".hlsl", ".shader", ".mat", ".mesh", ".obj", ".mtl", ".fnt", ".txt" };
+	std::vector<std::string> m_excludedFolders = { "Data/Cache", "Data/Log", "Data/Replays", "Data/Screenshots", "Data/Audio" };		// Written at runtime, or streamed by FMOD itself;
+	float m_minCompressionRatio = 0.9f;		// Compressed entries bigger than this fraction are stored instead;
+};
+
+struct PackBuildStats
+{
+	uint m_fileCount = 0;
+	uint m_compressedCount = 0;
+	uint64_t m_sourceBytes = 0;
+	uint64_t m_archiveBytes = 0;
+};
+
+bool BuildPackArchive( const std::string& sourceFolder_, const std::string& archivePath_, const PackBuildOptions& options_ = PackBuildOptions(), PackBuildStats* outStats_ = nullptr );
+
+// Mounted by the App when there is a Data.pack; DataFile reads through it first;
+extern PackArchive* g_thePackArchive;
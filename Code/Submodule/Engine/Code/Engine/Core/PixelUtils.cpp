@@ -0,0 +1,183 @@
+#include "Engine/Core/PixelUtils.hpp"
+
+#include <string.h>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+	#define PIXEL_UTILS_SSE2
+	#include <emmintrin.h>
+#endif
+
+//-----------------------------------------------------------------------------------------------
+static inline unsigned char MultiplyUnorm8( unsigned int value, unsigned int alpha )
+{
+	// value * alpha / 255 rounded, without the divide;
+	unsigned int product = value * alpha + 128;
+	return (unsigned char)((product + (product >> 8)) >> 8);
+}
+
+//-----------------------------------------------------------------------------------------------
+void FillPixelsRgba8( unsigned char* pixels, size_t pixelCount, uint32_t packedColor )
+{
+	size_t pixelIndex = 0;
+
+#if defined(PIXEL_UTILS_SSE2)
+	__m128i color4 = _mm_set1_epi32((int)packedColor);
+	for(; pixelIndex + 4 <= pixelCount; pixelIndex += 4)
+	{
+		_mm_storeu_si128((__m128i*)(pixels + pixelIndex * 4), color4);
+	}
+#endif
+
+	for(; pixelIndex < pixelCount; ++pixelIndex)
+	{
+		memcpy(pixels + pixelIndex * 4, &packedColor, 4);
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+void PremultiplyAlphaRgba8( unsigned char* pixels, size_t pixelCount )
+{
+	size_t pixelIndex = 0;
+
+#if defined(PIXEL_UTILS_SSE2)
+	// 4 pixels at a time, widened to 16 bits so the products fit;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i bias = _mm_set1_epi16(128);
+	const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000);
+
+	for(; pixelIndex + 4 <= pixelCount; pixelIndex += 4)
+	{
+		__m128i* address = (__m128i*)(pixels + pixelIndex * 4);
+		__m128i source = _mm_loadu_si128(address);
+
+		__m128i low = _mm_unpacklo_epi8(source, zero);
+		__m128i high = _mm_unpackhi_epi8(source, zero);
+
+		// Each pixel's alpha copied to its 4 lanes;
+		__m128i lowAlpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(low, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		__m128i highAlpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(high, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+		// Same rounding as MultiplyUnorm8;
+		low = _mm_add_epi16(_mm_mullo_epi16(low, lowAlpha), bias);
+		low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+		high = _mm_add_epi16(_mm_mullo_epi16(high, highAlpha), bias);
+		high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+
+		__m128i result = _mm_packus_epi16(low, high);
+		result = _mm_or_si128(_mm_andnot_si128(alphaMask, result), _mm_and_si128(alphaMask, source));
+		_mm_storeu_si128(address, result);
+	}
+#endif
+
+	for(; pixelIndex < pixelCount; ++pixelIndex)
+	{
+		unsigned char* pixel = pixels + pixelIndex * 4;
+		unsigned int alpha = pixel[3];
+		pixel[0] = MultiplyUnorm8(pixel[0], alpha);
+		pixel[1] = MultiplyUnorm8(pixel[1], alpha);
+		pixel[2] = MultiplyUnorm8(pixel[2], alpha);
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+static void SwapBytes( unsigned char* a, unsigned char* b, size_t byteCount )
+{
+	size_t byteIndex = 0;
+
+#if defined(PIXEL_UTILS_SSE2)
+	for(; byteIndex + 16 <= byteCount; byteIndex += 16)
+	{
+		__m128i aBytes = _mm_loadu_si128((const __m128i*)(a + byteIndex));
+		__m128i bBytes = _mm_loadu_si128((const __m128i*)(b + byteIndex));
+		_mm_storeu_si128((__m128i*)(a + byteIndex), bBytes);
+		_mm_storeu_si128((__m128i*)(b + byteIndex), aBytes);
+	}
+#endif
+
+	for(; byteIndex < byteCount; ++byteIndex)
+	{
+		unsigned char temp = a[byteIndex];
+		a[byteIndex] = b[byteIndex];
+		b[byteIndex] = temp;
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+void FlipRowsVertically( unsigned char* pixels, int width, int height, int bytesPerPixel )
+{
+	size_t rowBytes = (size_t)width * (size_t)bytesPerPixel;
+	for(int topRow = 0, bottomRow = height - 1; topRow < bottomRow; ++topRow, --bottomRow)
+	{
+		SwapBytes(pixels + (size_t)topRow * rowBytes, pixels + (size_t)bottomRow * rowBytes, rowBytes);
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+void ExpandRgbToRgba8( const unsigned char* rgb, unsigned char* rgba, size_t pixelCount )
+{
+	if(pixelCount == 0)
+	{
+		return;
+	}
+
+	// SSE2 has no byte shuffle, so this goes a pixel per 32 bit load; it reads one byte past each
+	// pixel, which is only safe before the last one;
+	const uint32_t opaque = 0xFF000000;
+	size_t pixelIndex = 0;
+	for(; pixelIndex + 1 < pixelCount; ++pixelIndex)
+	{
+		uint32_t pixel;
+		memcpy(&pixel, rgb + pixelIndex * 3, 4);
+		pixel = (pixel & 0x00FFFFFF) | opaque;
+		memcpy(rgba + pixelIndex * 4, &pixel, 4);
+	}
+
+	const unsigned char* lastRgb = rgb + pixelIndex * 3;
+	unsigned char* lastRgba = rgba + pixelIndex * 4;
+	lastRgba[0] = lastRgb[0];
+	lastRgba[1] = lastRgb[1];
+	lastRgba[2] = lastRgb[2];
+	lastRgba[3] = 255;
+}
+
+//-----------------------------------------------------------------------------------------------
+bool ExpandToRgba8( const unsigned char* source, int sourceComponents, unsigned char* rgba, size_t pixelCount )
+{
+	switch(sourceComponents)
+	{
+		case 4:
+		{
+			memcpy(rgba, source, pixelCount * 4);
+			return true;
+		}
+		case 3:
+		{
+			ExpandRgbToRgba8(source, rgba, pixelCount);
+			return true;
+		}
+		case 2:
+		{
+			for(size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex)
+			{
+				unsigned char gray = source[pixelIndex * 2];
+				uint32_t pixel = gray | (gray << 8) | (gray << 16) | ((uint32_t)source[pixelIndex * 2 + 1] << 24);
+				memcpy(rgba + pixelIndex * 4, &pixel, 4);
+			}
+			return true;
+		}
+		case 1:
+		{
+			for(size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex)
+			{
+				unsigned char gray = source[pixelIndex];
+				uint32_t pixel = gray | (gray << 8) | (gray << 16) | 0xFF000000;
+				memcpy(rgba + pixelIndex * 4, &pixel, 4);
+			}
+			return true;
+		}
+		default:
+		{
+			return false;
+		}
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------------------------
+// RGBA8 pixel routines for Image; buffers are tightly packed, 4 bytes per pixel, red first;
+// SSE2 where the target has it (every x64 build, and Win32 with the default /arch:SSE2), scalar otherwise;
+// Unaligned buffers are fine, the odd pixels at the end go through the scalar path;
+//-----------------------------------------------------------------------------------------------
+
+// Every pixel set to packedColor, see PackRgba8;
+void FillPixelsRgba8( unsigned char* pixels, size_t pixelCount, uint32_t packedColor );
+
+// rgb *= a / 255, rounded; alpha is left as is;
+void PremultiplyAlphaRgba8( unsigned char* pixels, size_t pixelCount );
+
+// Swaps rows top to bottom, in place;
+void FlipRowsVertically( unsigned char* pixels, int width, int height, int bytesPerPixel = 4 );
+
+// 1 (gray), 2 (gray, alpha), 3 (rgb) or 4 (rgba) components in, RGBA8 out; returns false for anything else;
+// in and out must not overlap;
+bool ExpandToRgba8( const unsigned char* source, int sourceComponents, unsigned char* rgba, size_t pixelCount );
+void ExpandRgbToRgba8( const unsigned char* rgb, unsigned char* rgba, size_t pixelCount );
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>
+
 struct Rgba
 {
 
@@ -74,4 +76,35 @@ public:
 	static Rgba QUART_BROWN;
 };
 
+//-----------------------------------------------------------------------------------------------
+// RGBA8 packing, for vertex colors and Image texels; values are clamped to 0..1 before they are quantized;
+//-----------------------------------------------------------------------------------------------
+inline uint8_t PackUnorm8( float value )
+{
+	value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+	return (uint8_t)(value * 255.0f + 0.5f);
+}
+
+inline uint16_t PackUnorm16( float value )
+{
+	value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+	return (uint16_t)(value * 65535.0f + 0.5f);
+}
 
+// Red in the lowest byte, the memory order DXGI_FORMAT_R8G8B8A8_UNORM reads on a little endian CPU;
+inline uint32_t PackRgba8( const Rgba& color )
+{
+	return (uint32_t)PackUnorm8(color.r)
+		| ((uint32_t)PackUnorm8(color.g) << 8)
+		| ((uint32_t)PackUnorm8(color.b) << 16)
+		| ((uint32_t)PackUnorm8(color.a) << 24);
+}
+
+inline Rgba UnpackRgba8( uint32_t packedColor )
+{
+	const float toFloat = 1.0f / 255.0f;
+	return Rgba((float)(packedColor & 0xFF) * toFloat,
+		(float)((packedColor >> 8) & 0xFF) * toFloat,
+		(float)((packedColor >> 16) & 0xFF) * toFloat,
+		(float)((packedColor >> 24) & 0xFF) * toFloat);
+}
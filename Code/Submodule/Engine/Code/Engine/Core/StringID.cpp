@@ -0,0 +1,81 @@
+#include "Engine/Core/StringID.hpp"
+#include "Engine/Core/CRC32.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+// ----------------------------------------------------------------------------
+// Function statics so interning from other statics' constructors is safe;
+static std::unordered_map<StringID, std::string>& GetStringTable()
+{
+	static std::unordered_map<StringID, std::string> s_stringTable;
+	return s_stringTable;
+}
+
+static std::mutex& GetStringTableLock()
+{
+	static std::mutex s_stringTableLock;
+	return s_stringTableLock;
+}
+
+// ----------------------------------------------------------------------------
+StringID GetStringID(const std::string& string_)
+{
+	if (string_.empty())
+	{
+		return INVALID_STRING_ID;
+	}
+
+	return (StringID)CRC32(string_);
+}
+
+// ----------------------------------------------------------------------------
+StringID InternString(const std::string& string_)
+{
+	StringID stringID = GetStringID(string_);
+	if (stringID == INVALID_STRING_ID)
+	{
+		return INVALID_STRING_ID;
+	}
+
+	std::lock_guard<std::mutex> lock(GetStringTableLock());
+
+	std::unordered_map<StringID, std::string>& stringTable = GetStringTable();
+	std::unordered_map<StringID, std::string>::iterator found = stringTable.find(stringID);
+	if (found == stringTable.end())
+	{
+		stringTable.emplace(stringID, string_);
+	}
+	else
+	{
+		GUARANTEE_OR_DIE(found->second == string_, Stringf("StringID collision between \"%s\" and \"%s\".", found->second.c_str(), string_.c_str()));
+	}
+
+	return stringID;
+}
+
+// ----------------------------------------------------------------------------
+StringID InternString(const char* string_)
+{
+	return InternString(std::string(string_));
+}
+
+// ----------------------------------------------------------------------------
+const std::string& GetInternedString(StringID stringID_)
+{
+	static const std::string s_emptyString;
+
+	std::lock_guard<std::mutex> lock(GetStringTableLock());
+
+	std::unordered_map<StringID, std::string>& stringTable = GetStringTable();
+	std::unordered_map<StringID, std::string>::iterator found = stringTable.find(stringID_);
+	if (found == stringTable.end())
+	{
+		return s_emptyString;
+	}
+
+	// Entries are never removed, so the reference stays good;
+	return found->second;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+// ----------------------------------------------------------------------------
+// Interned strings; a StringID is the CRC32 of the string, so the same text gives the same ID on every run and machine;
+// Intern names when data is loaded and pass the IDs around at runtime, comparing or looking up an ID is just an integer;
+// Two different strings hashing the same is caught when the second one is interned;
+// ----------------------------------------------------------------------------
+typedef uint32_t StringID;
+
+constexpr StringID INVALID_STRING_ID = 0;
+
+StringID InternString(const std::string& string_);
+StringID InternString(const char* string_);
+StringID GetStringID(const std::string& string_);			// Hashes without recording the string, for lookups of names that may not be interned;
+const std::string& GetInternedString(StringID stringID_);	// Empty string for IDs that were never interned;
@@ -136,6 +136,66 @@ void AddVertsForLine2D(std::vector<Vertex_PCU>& vertexArray, const Line& line, c
 	AddVertsForLine2D(vertexArray, line.lineStart, line.lineEnd, line.lineThickness, color);
 }
 
+void AddVertsForAABB2D( std::vector<Vertex_PCU2D>& vertexArray, const AABB2& box, const Rgba& color, const Vec2& uvAtMins/*=Vec2(0.0f,1.0f)*/, const Vec2& uvAtMaxs/*=Vec2(1.0f,0.0f)*/ )
+{
+	uint32_t packedColor = PackRgba8(color);
+
+	// The four corners of our box.
+	Vec2 positionBL(box.mins.x, box.mins.y);
+	Vec2 positionBR(box.maxs.x, box.mins.y);
+	Vec2 positionTL(box.mins.x, box.maxs.y);
+	Vec2 positionTR(box.maxs.x, box.maxs.y);
+
+	// The four UV of our box.
+	Vec2 uvBL(uvAtMins.x, uvAtMins.y);
+	Vec2 uvBR(uvAtMaxs.x, uvAtMins.y);
+	Vec2 uvTL(uvAtMins.x, uvAtMaxs.y);
+	Vec2 uvTR(uvAtMaxs.x, uvAtMaxs.y);
+
+	// The two sets of 3 verts for a box.
+	vertexArray.push_back(Vertex_PCU2D(positionBL, packedColor, uvBL));
+	vertexArray.push_back(Vertex_PCU2D(positionBR, packedColor, uvBR));
+	vertexArray.push_back(Vertex_PCU2D(positionTR, packedColor, uvTR));
+
+	vertexArray.push_back(Vertex_PCU2D(positionBL, packedColor, uvBL));
+	vertexArray.push_back(Vertex_PCU2D(positionTR, packedColor, uvTR));
+	vertexArray.push_back(Vertex_PCU2D(positionTL, packedColor, uvTL));
+}
+
+void AddVertsForLine2D( std::vector<Vertex_PCU2D>& vertexArray, const Vec2& start, const Vec2& end, float thickness, const Rgba& color )
+{
+	uint32_t packedColor = PackRgba8(color);
+
+	// Hard code a zero vector UV
+	Vec2 uvTexCoords(0.0f, 0.0f);
+
+	// Calculate dimensions
+	float halfThickness = thickness / 2;
+	Vec2 halfForward = end - start;
+	halfForward.ClampLength(halfThickness);
+	Vec2 halfLeft = halfForward.GetRotated90Degrees();
+
+	// The four corners of our line
+	Vec2 pFL = end + halfForward + halfLeft;
+	Vec2 pFR = end + halfForward - halfLeft;
+	Vec2 pBL = start - halfForward + halfLeft;
+	Vec2 pBR = start - halfForward - halfLeft;
+
+	// The two sets of 3 verts for a box.
+	vertexArray.push_back(Vertex_PCU2D(pBL, packedColor, uvTexCoords));
+	vertexArray.push_back(Vertex_PCU2D(pBR, packedColor, uvTexCoords));
+	vertexArray.push_back(Vertex_PCU2D(pFR, packedColor, uvTexCoords));
+
+	vertexArray.push_back(Vertex_PCU2D(pBL, packedColor, uvTexCoords));
+	vertexArray.push_back(Vertex_PCU2D(pFR, packedColor, uvTexCoords));
+	vertexArray.push_back(Vertex_PCU2D(pFL, packedColor, uvTexCoords));
+}
+
+void AddVertsForLine2D( std::vector<Vertex_PCU2D>& vertexArray, const Line& line, const Rgba& color )
+{
+	AddVertsForLine2D(vertexArray, line.lineStart, line.lineEnd, line.lineThickness, color);
+}
+
 void AddVertsForLine3D( std::vector<Vertex_PCU>& vertexArray, const Vec3& start, const Vec3& end, float thickness, const Rgba& color )
 {
 	// Hard code a zero vector UV
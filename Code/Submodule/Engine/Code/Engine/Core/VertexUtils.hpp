@@ -1,5 +1,6 @@
 #pragma once
 #include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCU2D.hpp"
 //-----------------------------------------------------------------------------------------------
 #include <vector>
 
@@ -27,5 +28,10 @@ void AddVertsForRay2D( std::vector<Vertex_PCU>& vertexArray, const Line& line, f
 void AddVertsForRing2D( std::vector<Vertex_PCU>& vertexArray, const Vec2& center, float radius, float thickness, const Rgba& color, int numSides = 64 );
 //void AddVertsForConvexPoly2D(std::vector<Vertex_PCU>& vertexArray, const ConvexPoly2D& convexPoly2D, const Rgba& color);
 
+// Vertex_PCU2D versions, the color is packed once per shape;
+void AddVertsForAABB2D( std::vector<Vertex_PCU2D>& vertexArray, const AABB2& box, const Rgba& color, const Vec2& uvAtMins = Vec2(0.0f, 1.0f), const Vec2& uvAtMaxs = Vec2(1.0f, 0.0f) );
+void AddVertsForLine2D( std::vector<Vertex_PCU2D>& vertexArray, const Vec2& start, const Vec2& end, float thickness, const Rgba& color );
+void AddVertsForLine2D( std::vector<Vertex_PCU2D>& vertexArray, const Line& line, const Rgba& color );
+
 void TransformVertex2D(Vertex_PCU& vertex, float uniformScale, float rotationDegreesAboutZ, Vec2& translationXY);
 void TransformVertexArray2D(int numVertexes, Vertex_PCU* vertexes, float uniformScale, float rotationDegreesAboutZ, const Vec2& translationXY);
@@ -0,0 +1,97 @@
+#include "Engine/Core/Vertex_PCU2D.hpp"
+#include "Engine/Renderer/BufferLayout.hpp"
+#include "Engine/Core/VertexMaster.hpp"
+#include "Engine/UnitTests/UnitTests.hpp"
+
+#include <stddef.h>
+
+//-----------------------------------------------------------------------------------------------
+STATIC BufferAttribute_t Vertex_PCU2D::LAYOUT[] =
+{
+	BufferAttribute_t("POSITION", DATA_TYPE_VEC2, offsetof(Vertex_PCU2D, position)),
+	BufferAttribute_t("COLOR", DATA_TYPE_RGBA8, offsetof(Vertex_PCU2D, color)),
+	BufferAttribute_t("TEXCOORD", DATA_TYPE_VEC2_UNORM16, offsetof(Vertex_PCU2D, uvTexCoords)),
+
+	BufferAttribute_t()
+};
+
+//-----------------------------------------------------------------------------------------------
+STATIC void Vertex_PCU2D::CopyFromMaster( void *buffer, VertexMaster const *src, unsigned int count )
+{
+	Vertex_PCU2D* dst = (Vertex_PCU2D*)buffer;
+
+	for(unsigned int i = 0; i < count; i++)
+	{
+		dst[i] = Vertex_PCU2D(Vec2(src[i].position.x, src[i].position.y), src[i].color, src[i].uv);
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+STATIC Vertex_PCU2D Vertex_PCU2D::FromVertexPCU( const Vertex_PCU& vertex )
+{
+	return Vertex_PCU2D(Vec2(vertex.position.x, vertex.position.y), vertex.color, vertex.uvTexCoords);
+}
+
+//-----------------------------------------------------------------------------------------------
+Vertex_PCU Vertex_PCU2D::ToVertexPCU() const
+{
+	return Vertex_PCU(Vec3(position.x, position.y, 0.0f), GetColor(), GetUVTexCoords());
+}
+
+//-----------------------------------------------------------------------------------------------
+Rgba Vertex_PCU2D::GetColor() const
+{
+	return UnpackRgba8(color);
+}
+
+//-----------------------------------------------------------------------------------------------
+Vec2 Vertex_PCU2D::GetUVTexCoords() const
+{
+	const float toFloat = 1.0f / 65535.0f;
+	return Vec2((float)uvTexCoords[0] * toFloat, (float)uvTexCoords[1] * toFloat);
+}
+
+//-----------------------------------------------------------------------------------------------
+void ConvertVertexArrayTo2D( const Vertex_PCU* vertexes, unsigned int count, std::vector<Vertex_PCU2D>& out )
+{
+	size_t firstOut = out.size();
+	out.resize(firstOut + count);
+
+	Vertex_PCU2D* dst = out.data() + firstOut;
+	for(unsigned int i = 0; i < count; i++)
+	{
+		dst[i] = Vertex_PCU2D::FromVertexPCU(vertexes[i]);
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+void ConvertVertexArrayTo2D( const std::vector<Vertex_PCU>& vertexes, std::vector<Vertex_PCU2D>& out )
+{
+	if(vertexes.empty())
+	{
+		return;
+	}
+
+	ConvertVertexArrayTo2D(vertexes.data(), (unsigned int)vertexes.size(), out);
+}
+
+//-----------------------------------------------------------------------------------------------
+UNITTEST("Vertex_PCU2D Packing", "Core", 0)
+{
+	if(sizeof(Vertex_PCU2D) != 16)														{ return false; }
+
+	Vertex_PCU source(Vec3(1.5f, -2.0f, 7.0f), Rgba(1.0f, 0.0f, 0.5f, 0.25f), Vec2(0.25f, 1.0f));
+	Vertex_PCU2D packed = Vertex_PCU2D::FromVertexPCU(source);
+
+	// Red in the lowest byte, 0.5 and 0.25 round to the nearest byte;
+	if(packed.color != 0x408000FF)														{ return false; }
+	if(packed.uvTexCoords[0] != 16384 || packed.uvTexCoords[1] != 65535)				{ return false; }
+
+	// Position survives as is, z is dropped;
+	Vertex_PCU unpacked = packed.ToVertexPCU();
+	if(unpacked.position.x != 1.5f || unpacked.position.y != -2.0f || unpacked.position.z != 0.0f)	{ return false; }
+
+	// Out of range UVs clamp instead of wrapping;
+	Vertex_PCU2D clamped(Vec2(0.0f, 0.0f), Rgba::WHITE, Vec2(-1.0f, 2.0f));
+	return clamped.uvTexCoords[0] == 0 && clamped.uvTexCoords[1] == 65535 && clamped.color == 0xFFFFFFFF;
+}
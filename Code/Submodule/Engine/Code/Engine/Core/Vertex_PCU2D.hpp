@@ -0,0 +1,56 @@
+#pragma once
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Rgba.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+
+struct BufferAttribute_t;
+struct VertexMaster;
+
+//-----------------------------------------------------------------------------------------------
+// Vertex_PCU2D;
+// 16 byte vertex for 2D sprites, UI and text, Vertex_PCU is 36;
+// Same semantics as Vertex_PCU so the same shaders take it, POSITION.z reads as 0 and the color
+// and UVs come in as normalized floats; UVs outside 0..1 (wrapping) need Vertex_PCU;
+//-----------------------------------------------------------------------------------------------
+struct Vertex_PCU2D
+{
+
+public:
+
+	Vec2 position;
+	uint32_t color = 0xFFFFFFFF;
+	uint16_t uvTexCoords[2] = { 0, 0 };
+
+public:
+
+	// Construction/Destruction
+	Vertex_PCU2D() {}
+	explicit Vertex_PCU2D( const Vec2& position, uint32_t packedColor, const Vec2& uvTexCoords )
+		: position( position )
+		, color( packedColor )
+	{
+		this->uvTexCoords[0] = PackUnorm16(uvTexCoords.x);
+		this->uvTexCoords[1] = PackUnorm16(uvTexCoords.y);
+	};
+	explicit Vertex_PCU2D( const Vec2& position, const Rgba& color, const Vec2& uvTexCoords )
+		: Vertex_PCU2D( position, PackRgba8(color), uvTexCoords )
+	{
+	};
+
+	// Conversion; drops z, quantizes color and UVs;
+	static Vertex_PCU2D FromVertexPCU( const Vertex_PCU& vertex );
+	Vertex_PCU ToVertexPCU() const;
+	Rgba GetColor() const;
+	Vec2 GetUVTexCoords() const;
+
+	static BufferAttribute_t LAYOUT[];
+	static void CopyFromMaster( void *buffer, VertexMaster const *src, unsigned int count );
+};
+
+// Appends the converted vertexes to the end of out;
+void ConvertVertexArrayTo2D( const Vertex_PCU* vertexes, unsigned int count, std::vector<Vertex_PCU2D>& out );
+void ConvertVertexArrayTo2D( const std::vector<Vertex_PCU>& vertexes, std::vector<Vertex_PCU2D>& out );
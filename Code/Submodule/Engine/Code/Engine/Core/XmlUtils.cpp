@@ -6,6 +6,7 @@
 #include "Engine/Math/IntRange.hpp"
 #include "Engine/Math/FloatRange.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Core/FileUtils.hpp"
 
 std::string ParseXmlAttribute( const XmlElement& element, const char* attributeName, const std::string& defaultValue )
 {
@@ -112,3 +113,15 @@ AABB2 ParseXmlAttribute( const XmlElement& element, const char* attributeName, c
 	return attribute.size() > 0 ? aabb2Attribute : defaultValue;
 }
 
+tinyxml2::XMLError LoadXmlDocument( tinyxml2::XMLDocument& document, const std::string& filepath )
+{
+	DataFile xmlFile;
+	if(!xmlFile.Open(filepath))
+	{
+		// Let tinyxml2 fail on it, so the document carries the usual file not found error;
+		return document.LoadFile(filepath.c_str());
+	}
+
+	// tinyxml2 parses in place, so Parse still takes its own copy; this only saves the fopen and fread;
+	return document.Parse(xmlFile.GetText(), xmlFile.GetSize());
+}
@@ -30,5 +30,8 @@ IntRange ParseXmlAttribute( const XmlElement& element, const char* attributeName
 FloatRange ParseXmlAttribute( const XmlElement& element, const char* attributeName, const FloatRange& defaultValue );
 AABB2 ParseXmlAttribute( const XmlElement& element, const char* attributeName, const AABB2& defaultValue );
 
+// LoadFile through DataFile, so packed files are found too; check document.ErrorID() as with LoadFile;
+tinyxml2::XMLError LoadXmlDocument( tinyxml2::XMLDocument& document, const std::string& filepath );
+
 
 
@@ -0,0 +1,447 @@
+#include "Engine/Job/AssetLoader.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/VertexLit.hpp"
+#include "Engine/Memory/Memory.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/SpriteSheet.hpp"
+
+#include <thread>
+
+AssetLoader* g_theAssetLoader = nullptr;
+
+// ----------------------------------------------------------------------------
+// Loading Jobs; each one finishes its stage even when an earlier one failed, so progress stays exact;
+// ----------------------------------------------------------------------------
+class ReadAssetJob : public Job
+{
+
+public:
+
+	ReadAssetJob(AssetLoader* loader_, AssetRecord* record_) : m_loader(loader_), m_record(record_) {}
+
+	virtual void Execute() override
+	{
+		MEM_TAG_SCOPE(MEM_TAG_ASSETS);
+
+		// CreateMeshFromFile maps the descriptor and its sources (or their mesh cache) itself;
+		if(m_record->m_type == ASSET_TYPE_TEXTURE)
+		{
+			bool isRead = m_record->m_file.Open(m_record->m_path);
+			if(!isRead || m_record->m_file.GetSize() == 0)
+			{
+				DebuggerPrintf("AssetLoader: could not read \"%s\".\n", m_record->m_path.c_str());
+				m_record->m_state = ASSET_STATE_FAILED;
+			}
+		}
+
+		if(m_record->m_state != ASSET_STATE_FAILED)
+		{
+			m_record->m_state = ASSET_STATE_DECODING;
+		}
+		m_loader->OnStageFinished();
+	}
+
+	AssetLoader* m_loader = nullptr;
+	AssetRecord* m_record = nullptr;
+};
+
+// ----------------------------------------------------------------------------
+class DecodeAssetJob : public Job
+{
+
+public:
+
+	DecodeAssetJob(AssetLoader* loader_, AssetRecord* record_) : m_loader(loader_), m_record(record_) {}
+
+	virtual void Execute() override
+	{
+		MEM_TAG_SCOPE(MEM_TAG_ASSETS);
+
+		if(m_record->m_state != ASSET_STATE_FAILED)
+		{
+			if(m_record->m_type == ASSET_TYPE_TEXTURE)
+			{
+				m_record->m_image = new Image(m_record->m_file.GetData(), m_record->m_file.GetSize(), m_record->m_path.c_str());
+				m_record->m_file.Close();
+			}
+			else
+			{
+				m_record->m_cpuMesh = new CPUMesh();
+				m_record->m_cpuMesh->SetLayout<Vertex_Lit>();
+				CreateMeshFromFile(m_record->m_path.c_str(), m_record->m_cpuMesh);
+			}
+
+			m_record->m_state = ASSET_STATE_UPLOADING;
+		}
+
+		m_loader->OnStageFinished();
+	}
+
+	AssetLoader* m_loader = nullptr;
+	AssetRecord* m_record = nullptr;
+};
+
+// ----------------------------------------------------------------------------
+class UploadAssetJob : public Job
+{
+
+public:
+
+	UploadAssetJob(AssetLoader* loader_, AssetRecord* record_) : m_loader(loader_), m_record(record_)
+	{
+		m_jobCategory = JOBCATEGORY_MAIN;
+	}
+
+	virtual void Execute() override
+	{
+		if(m_record->m_image != nullptr)
+		{
+			g_theRenderer->CreateTextureViewFromImage(m_record->m_image, m_record->m_path);
+			delete m_record->m_image;
+			m_record->m_image = nullptr;
+		}
+
+		if(m_record->m_cpuMesh != nullptr)
+		{
+			g_theRenderer->CreateAndRegisterGPUMesh(m_record->m_cpuMesh, m_record->m_path);
+			delete m_record->m_cpuMesh;
+			m_record->m_cpuMesh = nullptr;
+		}
+
+		if(m_record->m_state != ASSET_STATE_FAILED)
+		{
+			m_record->m_state = ASSET_STATE_LOADED;
+		}
+		m_loader->OnStageFinished();
+		m_loader->OnAssetUploaded(m_record);
+	}
+
+	AssetLoader* m_loader = nullptr;
+	AssetRecord* m_record = nullptr;
+};
+
+// ----------------------------------------------------------------------------
+class AssetCallbackJob : public Job
+{
+
+public:
+
+	AssetCallbackJob(AssetLoader* loader_, std::function<void()> callback_) : m_loader(loader_), m_callback(callback_)
+	{
+		m_jobCategory = JOBCATEGORY_MAIN;
+	}
+
+	virtual void Execute() override
+	{
+		// Whatever the callback points at may already be gone once the loader is being destroyed;
+		if(!m_loader->IsShuttingDown())
+		{
+			m_callback();
+		}
+		m_loader->OnCallbackFinished();
+	}
+
+	AssetLoader* m_loader = nullptr;
+	std::function<void()> m_callback;
+};
+
+// ----------------------------------------------------------------------------
+// AssetLoader;
+// ----------------------------------------------------------------------------
+AssetLoader::AssetLoader(int maxInFlight_ /*= -1*/)
+{
+	if(maxInFlight_ > 0)
+	{
+		m_maxInFlight = maxInFlight_;
+	}
+	else
+	{
+		int hardwareThreadCount = (int)std::thread::hardware_concurrency();
+		m_maxInFlight = (hardwareThreadCount > 0) ? hardwareThreadCount * 2 : 8;
+	}
+}
+
+// ----------------------------------------------------------------------------
+// Must go before the JobSystem shuts down; requests that never started are dropped, the ones
+// in flight are waited on so no Job is left pointing at a record; WhenLoaded callbacks still queued
+// are run through without calling them, so the JobSystem deletes them;
+// ----------------------------------------------------------------------------
+AssetLoader::~AssetLoader()
+{
+	m_isShuttingDown = true;
+
+	for(AssetRecord* record : m_queuedRecords)
+	{
+		for(Job* dependentJob : record->m_uploadJob->m_successors)
+		{
+			delete dependentJob;
+			--m_pendingCallbackCount;
+		}
+
+		delete record->m_uploadJob;
+		delete record->m_decodeJob;
+		delete record->m_readJob;
+	}
+	m_queuedRecords.clear();
+
+	while(m_inFlightCount > 0 || m_pendingCallbackCount > 0)
+	{
+		if(!g_theJobSystem->ProcessJobCategory(JOBCATEGORY_MAIN) && !g_theJobSystem->ProcessJobCategory(JOBCATEGORY_GENERIC))
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	for(std::pair<const std::string, AssetRecord*>& recordPair : m_records)
+	{
+		delete recordPair.second;
+	}
+	m_records.clear();
+}
+
+// ----------------------------------------------------------------------------
+void AssetLoader::RequestTexture(const std::string& path_, eAssetPriority priority_)
+{
+	Request(path_, ASSET_TYPE_TEXTURE, priority_);
+}
+
+// ----------------------------------------------------------------------------
+void AssetLoader::RequestMesh(const std::string& path_, eAssetPriority priority_)
+{
+	Request(path_, ASSET_TYPE_MESH, priority_);
+}
+
+// ----------------------------------------------------------------------------
+void AssetLoader::WhenLoaded(const std::string& path_, std::function<void()> onLoaded_)
+{
+	AssetRecord* record = FindRecord(path_);
+	GUARANTEE_OR_DIE(record != nullptr, Stringf("AssetLoader::WhenLoaded on \"%s\", which was never requested.", path_.c_str()));
+
+	// The upload Job is gone once it has run, nothing left to wait for;
+	if(record->m_uploadJob == nullptr)
+	{
+		onLoaded_();
+		return;
+	}
+
+	Job* callbackJob = new AssetCallbackJob(this, onLoaded_);
+	callbackJob->AddPredecessor(record->m_uploadJob);
+	++m_pendingCallbackCount;
+	g_theJobSystem->Run(callbackJob);
+}
+
+// ----------------------------------------------------------------------------
+void AssetLoader::RequestSpriteSheetTexture(SpriteSheet* spriteSheet_, const std::string& texturePath_, eAssetPriority priority_)
+{
+	RequestTexture(texturePath_, priority_);
+	WhenLoaded(texturePath_, [spriteSheet_, texturePath_]()
+	{
+		spriteSheet_->SetTextureView(g_theRenderer->CreateOrGetTextureViewFromFile(texturePath_));
+	});
+}
+
+// ----------------------------------------------------------------------------
+void AssetLoader::Update(uint uploadBudgetMS_)
+{
+	SubmitQueuedRequests();
+
+	// Always, a WhenLoaded callback can be left in JOBCATEGORY_MAIN after the last upload and nothing else runs it;
+	g_theJobSystem->ProcessJobCategoryForMS(JOBCATEGORY_MAIN, uploadBudgetMS_);
+
+	// Uploads free up slots;
+	SubmitQueuedRequests();
+}
+
+// ----------------------------------------------------------------------------
+void AssetLoader::FinishAll()
+{
+	while(!IsDone())
+	{
+		SubmitQueuedRequests();
+
+		if(!g_theJobSystem->ProcessJobCategory(JOBCATEGORY_MAIN) && !g_theJobSystem->ProcessJobCategory(JOBCATEGORY_GENERIC))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+eAssetState AssetLoader::GetState(const std::string& path_) const
+{
+	AssetRecord* record = FindRecord(path_);
+	if(record == nullptr)
+	{
+		return ASSET_STATE_COUNT;
+	}
+
+	return (eAssetState)record->m_state.load();
+}
+
+// ----------------------------------------------------------------------------
+bool AssetLoader::IsLoaded(const std::string& path_) const
+{
+	return GetState(path_) == ASSET_STATE_LOADED;
+}
+
+// ----------------------------------------------------------------------------
+bool AssetLoader::IsDone() const
+{
+	return m_finishedCount == m_requestedCount && m_pendingCallbackCount == 0;
+}
+
+// ----------------------------------------------------------------------------
+bool AssetLoader::IsPriorityDone(eAssetPriority priority_) const
+{
+	for(int priority = 0; priority <= (int)priority_; ++priority)
+	{
+		if(m_finishedCountByPriority[priority] != m_requestedCountByPriority[priority])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+float AssetLoader::GetProgress() const
+{
+	if(m_requestedCount == 0)
+	{
+		return 1.0f;
+	}
+
+	return (float)m_finishedStageCount.load() / (float)(m_requestedCount * 3);
+}
+
+// ----------------------------------------------------------------------------
+void AssetLoader::OnStageFinished()
+{
+	++m_finishedStageCount;
+}
+
+// ----------------------------------------------------------------------------
+void AssetLoader::OnAssetUploaded(AssetRecord* record_)
+{
+	// Still inside the upload Job, which deletes itself after this;
+	record_->m_uploadJob = nullptr;
+
+	--m_inFlightCount;
+	++m_finishedCount;
+	++m_finishedCountByPriority[record_->m_priority];
+	if(record_->m_state == ASSET_STATE_FAILED)
+	{
+		++m_failedCount;
+	}
+}
+
+// ----------------------------------------------------------------------------
+void AssetLoader::OnCallbackFinished()
+{
+	--m_pendingCallbackCount;
+}
+
+// ----------------------------------------------------------------------------
+AssetRecord* AssetLoader::Request(const std::string& path_, eAssetType type_, eAssetPriority priority_)
+{
+	AssetRecord* record = FindRecord(path_);
+	if(record != nullptr)
+	{
+		GUARANTEE_OR_DIE(record->m_type == type_, Stringf("AssetLoader: \"%s\" was requested as two different asset types.", path_.c_str()));
+
+		if(record->m_state == ASSET_STATE_QUEUED && priority_ < record->m_priority)
+		{
+			--m_requestedCountByPriority[record->m_priority];
+			++m_requestedCountByPriority[priority_];
+			record->m_priority = priority_;
+		}
+		return record;
+	}
+
+	record = new AssetRecord();
+	record->m_path = path_;
+	record->m_type = type_;
+	record->m_priority = priority_;
+	record->m_requestIndex = m_nextRequestIndex++;
+
+	// read -> decode -> upload, none of them are Run until the request is submitted;
+	record->m_readJob = new ReadAssetJob(this, record);
+	record->m_decodeJob = new DecodeAssetJob(this, record);
+	record->m_uploadJob = new UploadAssetJob(this, record);
+	record->m_decodeJob->AddPredecessor(record->m_readJob);
+	record->m_uploadJob->AddPredecessor(record->m_decodeJob);
+
+	m_records[path_] = record;
+	m_queuedRecords.push_back(record);
+
+	++m_requestedCount;
+	++m_requestedCountByPriority[priority_];
+
+	return record;
+}
+
+// ----------------------------------------------------------------------------
+AssetRecord* AssetLoader::FindRecord(const std::string& path_) const
+{
+	std::map<std::string, AssetRecord*>::const_iterator recordPair = m_records.find(path_);
+	if(recordPair == m_records.end())
+	{
+		return nullptr;
+	}
+
+	return recordPair->second;
+}
+
+// ----------------------------------------------------------------------------
+AssetRecord* AssetLoader::PopHighestPriorityRequest()
+{
+	if(m_queuedRecords.empty())
+	{
+		return nullptr;
+	}
+
+	// A few hundred requests at most, a scan is fine;
+	size_t bestIndex = 0;
+	for(size_t recordIndex = 1; recordIndex < m_queuedRecords.size(); ++recordIndex)
+	{
+		const AssetRecord* record = m_queuedRecords[recordIndex];
+		const AssetRecord* best = m_queuedRecords[bestIndex];
+		if(record->m_priority < best->m_priority || (record->m_priority == best->m_priority && record->m_requestIndex < best->m_requestIndex))
+		{
+			bestIndex = recordIndex;
+		}
+	}
+
+	AssetRecord* bestRecord = m_queuedRecords[bestIndex];
+	m_queuedRecords.erase(m_queuedRecords.begin() + bestIndex);
+	return bestRecord;
+}
+
+// ----------------------------------------------------------------------------
+void AssetLoader::SubmitQueuedRequests()
+{
+	while(m_inFlightCount < m_maxInFlight)
+	{
+		AssetRecord* record = PopHighestPriorityRequest();
+		if(record == nullptr)
+		{
+			return;
+		}
+
+		Job* readJob = record->m_readJob;
+		Job* decodeJob = record->m_decodeJob;
+		record->m_readJob = nullptr;
+		record->m_decodeJob = nullptr;
+		record->m_state = ASSET_STATE_READING;
+		++m_inFlightCount;
+
+		// Back to front, so each stage is only waiting on the one before it when the read starts;
+		g_theJobSystem->Run(record->m_uploadJob);
+		g_theJobSystem->Run(decodeJob);
+		g_theJobSystem->Run(readJob);
+	}
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include "Engine/Job/Jobs.hpp"
+#include "Engine/Core/FileUtils.hpp"
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef unsigned int uint;
+
+class Image;
+class CPUMesh;
+class SpriteSheet;
+
+// Lower loads first; everything of one priority is submitted before the next one starts;
+enum eAssetPriority : int
+{
+	ASSET_PRIORITY_LOADING_SCREEN = 0,
+	ASSET_PRIORITY_MAIN_MENU,
+	ASSET_PRIORITY_GAMEPLAY,
+
+	ASSET_PRIORITY_COUNT
+};
+
+enum eAssetType : int
+{
+	ASSET_TYPE_TEXTURE = 0,
+	ASSET_TYPE_MESH,
+
+	ASSET_TYPE_COUNT
+};
+
+enum eAssetState : int
+{
+	ASSET_STATE_QUEUED = 0,		// Requested, waiting for a slot;
+	ASSET_STATE_READING,		// Generic Job, opens the file;
+	ASSET_STATE_DECODING,		// Generic Job, memory to Image or CPUMesh;
+	ASSET_STATE_UPLOADING,		// Main Job, waiting for AssetLoader::Update;
+	ASSET_STATE_LOADED,
+	ASSET_STATE_FAILED,
+
+	ASSET_STATE_COUNT
+};
+
+// ----------------------------------------------------------------------------
+// One requested file and the Jobs that load it; owned by the AssetLoader;
+// ----------------------------------------------------------------------------
+struct AssetRecord
+{
+	std::string m_path;
+	eAssetType m_type = ASSET_TYPE_TEXTURE;
+	eAssetPriority m_priority = ASSET_PRIORITY_GAMEPLAY;
+	uint m_requestIndex = 0;						// Keeps request order within a priority;
+	std::atomic<int> m_state = ASSET_STATE_QUEUED;
+
+	// Handed from stage to stage, empty again once uploaded;
+	DataFile m_file;							// A view into the pack archive or the mapped file, not a copy;
+	Image* m_image = nullptr;
+	CPUMesh* m_cpuMesh = nullptr;
+
+	// Only valid until they run; the upload Job is what dependents wait on;
+	Job* m_readJob = nullptr;
+	Job* m_decodeJob = nullptr;
+	Job* m_uploadJob = nullptr;
+};
+
+// ----------------------------------------------------------------------------
+// AssetLoader;
+// Streams textures and meshes through the JobSystem: a read and a decode Job on the generic workers,
+// then an upload Job in JOBCATEGORY_MAIN, since the device context belongs to the main thread;
+// Only m_maxInFlight assets are between read and upload at once, so decoded Images don't pile up
+// waiting for the main thread and high priority requests never queue behind low ones;
+// Requests, dependents and Update are main thread only;
+// ----------------------------------------------------------------------------
+class AssetLoader
+{
+
+public:
+
+	explicit AssetLoader(int maxInFlight_ = -1);		// -1 is twice the hardware threads;
+	~AssetLoader();
+
+	// Requesting the same path again only raises its priority, if it hasn't started yet;
+	void RequestTexture(const std::string& path_, eAssetPriority priority_);
+	void RequestMesh(const std::string& path_, eAssetPriority priority_);
+
+	// Main thread callback once the asset is uploaded (or failed), right away if it already is;
+	// It is a main thread Job that waits on the upload Job;
+	void WhenLoaded(const std::string& path_, std::function<void()> onLoaded_);
+
+	// The sheet's UVs don't need the texture, so it can be made and handed out now; its texture view is set once loaded;
+	void RequestSpriteSheetTexture(SpriteSheet* spriteSheet_, const std::string& texturePath_, eAssetPriority priority_);
+
+	// Starts queued reads and runs main thread uploads for up to uploadBudgetMS_;
+	void Update(uint uploadBudgetMS_);
+
+	// Blocks until everything requested is loaded and its WhenLoaded callbacks have run, the main thread helps with the generic Jobs;
+	void FinishAll();
+
+	eAssetState GetState(const std::string& path_) const;
+	bool IsLoaded(const std::string& path_) const;
+	bool IsDone() const;										// Loaded, and no WhenLoaded callback left to run;
+	bool IsPriorityDone(eAssetPriority priority_) const;		// Everything at this priority or higher is done;
+
+	// 0 to 1, each asset counts three stages (read, decode, upload);
+	float GetProgress() const;
+	inline int GetRequestedCount() const				{ return m_requestedCount; }
+	inline int GetFinishedCount() const					{ return m_finishedCount; }
+	inline int GetFailedCount() const					{ return m_failedCount; }
+
+public:
+
+	// Called by the loading Jobs;
+	void OnStageFinished();
+	void OnAssetUploaded(AssetRecord* record_);
+	void OnCallbackFinished();
+	inline bool IsShuttingDown() const					{ return m_isShuttingDown; }
+
+private:
+
+	AssetRecord* Request(const std::string& path_, eAssetType type_, eAssetPriority priority_);
+	AssetRecord* FindRecord(const std::string& path_) const;
+	AssetRecord* PopHighestPriorityRequest();
+	void SubmitQueuedRequests();
+
+private:
+
+	std::map<std::string, AssetRecord*> m_records;
+	std::vector<AssetRecord*> m_queuedRecords;
+	uint m_nextRequestIndex = 0;
+
+	int m_maxInFlight = 8;
+	int m_inFlightCount = 0;
+
+	int m_requestedCount = 0;
+	int m_finishedCount = 0;				// Loaded or failed;
+	int m_failedCount = 0;
+	int m_requestedCountByPriority[ASSET_PRIORITY_COUNT] = {};
+	int m_finishedCountByPriority[ASSET_PRIORITY_COUNT] = {};
+	int m_pendingCallbackCount = 0;			// WhenLoaded Jobs made and not yet run or deleted;
+	bool m_isShuttingDown = false;
+
+	std::atomic<int> m_finishedStageCount = 0;
+};
+
+extern AssetLoader* g_theAssetLoader;
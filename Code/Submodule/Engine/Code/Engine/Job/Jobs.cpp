@@ -1,21 +1,43 @@
 #include "Engine/Job/Jobs.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/Time.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Profile/Profile.hpp"
+#include "Engine/Memory/ArenaAllocator.hpp"
+
+#include <thread>
+#include <typeinfo>
+
+// How many times an idle worker looks for work before it parks;
+constexpr int WORKER_SPIN_COUNT = 64;
 
 JobSystem* g_theJobSystem = nullptr;
 JobCategory* m_jobCategories = nullptr;
 std::vector<std::thread> m_genericThreads;
 uint genericThreadCount = 1;
 
+// -1 on any thread that isn't a generic worker;
+thread_local int t_workerIndex = -1;
+
+// Successor released by the Job this worker just finished, run before anything else;
+thread_local Job* t_continuationJob = nullptr;
+
 
-static void GenericThreadWorkerMain()
+static void GenericThreadWorkerMain(uint workerIndex)
 {
+	t_workerIndex = (int)workerIndex;
+	ProfilerSetThreadName(Stringf("Job Worker %u", workerIndex).c_str());
+
 	// Only process Generic Threads when the JobSystem is running;
 	while(g_theJobSystem->IsRunning())
 	{
-		g_theJobSystem->WaitForWork();
+		while(g_theJobSystem->ProcessJobCategory(JOBCATEGORY_GENERIC))
+		{
+			// A worker's frame arena lasts one Job;
+			ArenaReset(ARENA_FRAME);
+		}
 
-		while(g_theJobSystem->ProcessJobCategory(JOBCATEGORY_GENERIC));
+		g_theJobSystem->WaitForWork();
 	}
 
 	g_theJobSystem->FinishJobsForJobCategory(JOBCATEGORY_GENERIC);
@@ -26,8 +48,8 @@ static void GenericThreadWorkerMain()
 // ----------------------------------------------------------------------------
 void JobCategory::Enqueue(Job* job)
 {
+	// Only Generic work wakes the workers, see JobSystem::EnqueueGenericJob;
 	m_pendingQueue.Enqueue(job);
-	g_theJobSystem->SignalWork();
 }
 
 // ----------------------------------------------------------------------------
@@ -55,8 +77,8 @@ void JobCategory::Dequeue(Job*& outJob)
 // ----------------------------------------------------------------------------
 void JobCategory::EnqueueFinished(Job* job)
 {
+	// Finish callbacks are run by whoever owns the category, not the workers;
 	m_finishQueue.Enqueue(job);
-	g_theJobSystem->SignalWork();
 }
 
 // ----------------------------------------------------------------------------
@@ -104,7 +126,14 @@ bool Job::TryStart()
 
 	if(newCount == 0)
 	{
-		m_jobCategories[m_jobCategory].Enqueue(this);
+		if(m_jobCategory == JOBCATEGORY_GENERIC)
+		{
+			g_theJobSystem->EnqueueGenericJob(this);
+		}
+		else
+		{
+			m_jobCategories[m_jobCategory].Enqueue(this);
+		}
 		return true;
 	}
 
@@ -117,6 +146,19 @@ void Job::FinishJob()
 	// Go through our job's successors;
 	for(Job* jobSuccessor : m_successors)
 	{
+		// On a worker, the first Generic successor we release runs next on this thread, no queue and no wake;
+		if(t_workerIndex >= 0 && t_continuationJob == nullptr && jobSuccessor->m_jobCategory == JOBCATEGORY_GENERIC)
+		{
+			int newCount = --jobSuccessor->m_predecessorCount;
+			ASSERT(newCount >= 0);
+
+			if(newCount == 0)
+			{
+				t_continuationJob = jobSuccessor;
+			}
+			continue;
+		}
+
 		// If we have a successor, then try to start it;
 		jobSuccessor->TryStart();
 	}
@@ -167,11 +209,15 @@ void JobSystem::Startup(int numberGenericThreads /*= -1*/, int numberCategories
 		genericThreadCount = numberGenericThreads;
 	}
 
-	m_signal.Create(0, genericThreadCount);
+	// Deques must all exist before any worker can try to steal;
+	for (uint i = 0; i < genericThreadCount; i++)
+	{
+		m_workerDeques.push_back(new WorkStealingDeque<Job*>());
+	}
 
 	for (uint i = 0; i < genericThreadCount; i++)
 	{
-		m_genericThreads.emplace_back(GenericThreadWorkerMain);
+		m_genericThreads.emplace_back(GenericThreadWorkerMain, i);
 	}
 }
 
@@ -185,6 +231,16 @@ void JobSystem::Shutdown()
 	{
 		m_genericThreads[i].join();
 	}
+	m_genericThreads.clear();
+
+	// Anything a worker pushed to its deque while the others were already leaving;
+	FinishJobsForJobCategory(JOBCATEGORY_GENERIC);
+
+	for (WorkStealingDeque<Job*>* workerDeque : m_workerDeques)
+	{
+		delete workerDeque;
+	}
+	m_workerDeques.clear();
 
 	delete[] m_jobCategories;
 	m_jobCategories = nullptr;
@@ -205,7 +261,11 @@ void JobSystem::ProcessJobCategoryForMS(int jobCategory, uint ms)
 	bool timeLimitPassed = false;
 	do 
 	{
-		ProcessJobCategory(jobCategory);
+		// Out of Jobs, don't spin out the rest of the budget;
+		if(!ProcessJobCategory(jobCategory))
+		{
+			break;
+		}
 
 		end = GetCurrentTimeSeconds() * 1000.0;
 		timeLimitPassed = (end - start) > ms ? true : false;
@@ -217,10 +277,19 @@ void JobSystem::ProcessJobCategoryForMS(int jobCategory, uint ms)
 bool JobSystem::ProcessJobCategory(int jobCategory)
 {
 	Job* job = nullptr;
-	m_jobCategories[jobCategory].TryDequeue(job);
+	if(jobCategory == JOBCATEGORY_GENERIC)
+	{
+		DequeueGenericJob(job);
+	}
+	else
+	{
+		m_jobCategories[jobCategory].TryDequeue(job);
+	}
 
 	if(job)
 	{
+		// The type's name lives as long as the program, so the profiler can keep just the pointer;
+		PROFILE_SCOPE(typeid(*job).name());
 		job->Execute();
 		job->FinishJob();
 
@@ -255,10 +324,18 @@ void JobSystem::FinishJobsForJobCategory(int jobCategory)
 	while(true)
 	{
 		Job* job = nullptr;
-		m_jobCategories[jobCategory].TryDequeue(job);
+		if(jobCategory == JOBCATEGORY_GENERIC)
+		{
+			DequeueGenericJob(job);
+		}
+		else
+		{
+			m_jobCategories[jobCategory].TryDequeue(job);
+		}
 
 		if (job)
 		{
+			PROFILE_SCOPE(typeid(*job).name());
 			job->Execute();
 			job->FinishJob();
 		}
@@ -270,3 +347,149 @@ void JobSystem::FinishJobsForJobCategory(int jobCategory)
 }
 
 
+
+// ----------------------------------------------------------------------------
+void JobSystem::EnqueueGenericJob(Job* job)
+{
+	// A worker keeps what it spawns, it is the most likely to have the data in cache;
+	if(t_workerIndex >= 0)
+	{
+		m_workerDeques[t_workerIndex]->Push(job);
+	}
+	else
+	{
+		m_jobCategories[JOBCATEGORY_GENERIC].Enqueue(job);
+	}
+
+	SignalWork();
+}
+
+// ----------------------------------------------------------------------------
+bool JobSystem::DequeueGenericJob(Job*& outJob)
+{
+	if(t_workerIndex >= 0)
+	{
+		if(t_continuationJob != nullptr)
+		{
+			outJob = t_continuationJob;
+			t_continuationJob = nullptr;
+			return true;
+		}
+
+		if(m_workerDeques[t_workerIndex]->Pop(&outJob))
+		{
+			return true;
+		}
+	}
+
+	if(m_jobCategories[JOBCATEGORY_GENERIC].m_pendingQueue.Dequeue(&outJob))
+	{
+		return true;
+	}
+
+	// Steal, starting after ourselves so the thieves spread over the workers;
+	uint workerCount = (uint)m_workerDeques.size();
+	uint firstVictim = (t_workerIndex >= 0) ? (uint)t_workerIndex + 1 : 0;
+	for(uint i = 0; i < workerCount; ++i)
+	{
+		uint victim = (firstVictim + i) % workerCount;
+		if((int)victim == t_workerIndex)
+		{
+			continue;
+		}
+
+		if(m_workerDeques[victim]->Steal(&outJob))
+		{
+			return true;
+		}
+	}
+
+	outJob = nullptr;
+	return false;
+}
+
+// ----------------------------------------------------------------------------
+bool JobSystem::HasGenericWork() const
+{
+	if(!m_jobCategories[JOBCATEGORY_GENERIC].m_pendingQueue.IsEmpty())
+	{
+		return true;
+	}
+
+	for(const WorkStealingDeque<Job*>* workerDeque : m_workerDeques)
+	{
+		if(!workerDeque->IsEmpty())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// ----------------------------------------------------------------------------
+void JobSystem::WaitForWork()
+{
+	// New work usually shows up right after the last Job, look a few times before paying for a sleep;
+	for(int spin = 0; spin < WORKER_SPIN_COUNT; ++spin)
+	{
+		if(HasGenericWork() || !IsRunning())
+		{
+			return;
+		}
+		std::this_thread::yield();
+	}
+
+	std::unique_lock<std::mutex> lock(m_parkLock);
+	m_parkedWorkerCount.fetch_add(1);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	// Check again now that we are counted, anyone enqueuing after this will see us and wake us;
+	if(HasGenericWork() || !IsRunning())
+	{
+		m_parkedWorkerCount.fetch_sub(1);
+		return;
+	}
+
+	m_parkSignal.wait(lock, [this]() { return m_wakeTokens > 0 || !IsRunning(); });
+	if(m_wakeTokens > 0)
+	{
+		--m_wakeTokens;
+	}
+	m_parkedWorkerCount.fetch_sub(1);
+}
+
+// ----------------------------------------------------------------------------
+void JobSystem::SignalWork()
+{
+	// Pairs with the fence in WaitForWork, either we see the parked worker or it sees our Job;
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if(m_parkedWorkerCount.load() == 0)
+	{
+		return;
+	}
+
+	{
+		std::scoped_lock<std::mutex> lock(m_parkLock);
+
+		// Every parked worker already has a wake on the way;
+		if(m_wakeTokens >= m_parkedWorkerCount.load())
+		{
+			return;
+		}
+		++m_wakeTokens;
+	}
+
+	m_parkSignal.notify_one();
+}
+
+// ----------------------------------------------------------------------------
+void JobSystem::SignalAll()
+{
+	{
+		std::scoped_lock<std::mutex> lock(m_parkLock);
+		m_wakeTokens = m_parkedWorkerCount.load();
+	}
+
+	m_parkSignal.notify_all();
+}
@@ -1,9 +1,13 @@
 #pragma once
 #include "Engine/Async/AsyncQueue.hpp"
-#include "Engine/Semaphore/Semaphore.hpp"
+#include "Engine/Job/WorkStealingDeque.hpp"
+#include "Engine/Memory/BlockAllocator.hpp"
 
 #include <vector>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 
 typedef unsigned int uint;
 
@@ -47,6 +51,9 @@ class Job
 
 public:
 
+	// Jobs come and go every frame, every derived Job is pooled by size;
+	BLOCK_ALLOCATED_CLASS()
+
 	Job();
 	virtual ~Job() {}
 
@@ -86,7 +93,7 @@ public:
 
 	void Run(Job* job);
 
-	inline bool IsRunning() { return m_isRunning; }
+	inline bool IsRunning() const { return m_isRunning; }
 
 	// Return number of Jobs processed;
 	void ProcessJobCategoryForMS(int jobCategory, uint ms); // Process until no more Jobs, or MS has passed;
@@ -94,15 +101,27 @@ public:
 	bool ProcessFinishCallbacksForJobCategory(int jobCategory);		   // Process category until no more Jobs;
 	void FinishJobsForJobCategory(int jobCategory);		   // Process category until no more Jobs;
 
-	Semaphore m_signal;
-	inline void WaitForWork()	{ m_signal.Acquire(); }
-	inline void SignalWork()	{ m_signal.Release(1); }
-	inline void SignalAll()		{ m_signal.ReleaseAll(); }
+	// Generic Jobs; a worker pushes to and pops from its own deque, everyone else goes through the category queue;
+	// Idle workers steal from the other workers' deques before they park;
+	void EnqueueGenericJob(Job* job);
+	bool DequeueGenericJob(Job*& outJob);
+	bool HasGenericWork() const;
+
+	// Parking; workers spin for a bit before they sleep, and an enqueue only takes the lock when someone is asleep;
+	void WaitForWork();
+	void SignalWork();		// Wakes one parked worker, if any;
+	void SignalAll();
 
 private:	
 
-	bool m_isRunning = false;
-	
+	std::atomic<bool> m_isRunning = false;
+
+	std::vector<WorkStealingDeque<Job*>*> m_workerDeques;
+
+	std::mutex m_parkLock;
+	std::condition_variable m_parkSignal;
+	std::atomic<int> m_parkedWorkerCount = 0;
+	int m_wakeTokens = 0;	// Guarded by m_parkLock;
 };
 
 extern JobSystem* g_theJobSystem;
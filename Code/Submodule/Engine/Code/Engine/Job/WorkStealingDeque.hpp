@@ -0,0 +1,180 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// WorkStealingDeque;
+// Chase-Lev deque, one owner thread pushes and pops at the bottom (LIFO, cache warm),
+// any other thread steals from the top (FIFO, oldest work first);
+// T must be trivially copyable, it is meant for Job*;
+// Grows when full; old rings are kept until the deque is destroyed since a thief may still be reading one;
+// ----------------------------------------------------------------------------
+template <typename T>
+class WorkStealingDeque
+{
+
+public:
+
+	explicit WorkStealingDeque(uint32_t capacity = 1024);
+	~WorkStealingDeque();
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+	// Owner thread only;
+	void Push(T value);
+	bool Pop(T* out);
+
+	// Any thread; fails if empty or if it lost the race for the top value;
+	bool Steal(T* out);
+
+	// A snapshot, other threads can change it right after;
+	bool IsEmpty() const;
+
+private:
+
+	struct Ring
+	{
+		explicit Ring(int64_t capacity) : m_capacity(capacity), m_mask(capacity - 1), m_slots(new std::atomic<T>[(size_t)capacity]) {}
+		~Ring()											{ delete[] m_slots; }
+
+		inline T Get(int64_t index) const				{ return m_slots[index & m_mask].load(std::memory_order_relaxed); }
+		inline void Put(int64_t index, T value)			{ m_slots[index & m_mask].store(value, std::memory_order_relaxed); }
+
+		int64_t m_capacity;
+		int64_t m_mask;
+		std::atomic<T>* m_slots;
+	};
+
+	Ring* Grow(Ring* ring, int64_t bottom, int64_t top);
+
+private:
+
+	alignas(64) std::atomic<int64_t> m_top;
+	alignas(64) std::atomic<int64_t> m_bottom;
+	std::atomic<Ring*> m_ring;
+	std::vector<Ring*> m_retiredRings;					// Owner thread only;
+};
+
+// ----------------------------------------------------------------------------
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(uint32_t capacity)
+{
+	int64_t ringCapacity = 2;
+	while (ringCapacity < (int64_t)capacity)
+	{
+		ringCapacity <<= 1;
+	}
+
+	m_top.store(0, std::memory_order_relaxed);
+	m_bottom.store(0, std::memory_order_relaxed);
+	m_ring.store(new Ring(ringCapacity), std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque()
+{
+	delete m_ring.load();
+	for (Ring* ring : m_retiredRings)
+	{
+		delete ring;
+	}
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+void WorkStealingDeque<T>::Push(T value)
+{
+	int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+	int64_t top = m_top.load(std::memory_order_acquire);
+	Ring* ring = m_ring.load(std::memory_order_relaxed);
+
+	if (bottom - top > ring->m_capacity - 1)
+	{
+		ring = Grow(ring, bottom, top);
+	}
+
+	ring->Put(bottom, value);
+	std::atomic_thread_fence(std::memory_order_release);
+	m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+bool WorkStealingDeque<T>::Pop(T* out)
+{
+	int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+	Ring* ring = m_ring.load(std::memory_order_relaxed);
+	m_bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = m_top.load(std::memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		// Was empty;
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	*out = ring->Get(bottom);
+	if (top == bottom)
+	{
+		// Last value, race the thieves for it;
+		bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return won;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+bool WorkStealingDeque<T>::Steal(T* out)
+{
+	int64_t top = m_top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+	if (top >= bottom)
+	{
+		return false;
+	}
+
+	Ring* ring = m_ring.load(std::memory_order_acquire);
+	T value = ring->Get(top);
+	if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	*out = value;
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+bool WorkStealingDeque<T>::IsEmpty() const
+{
+	int64_t top = m_top.load(std::memory_order_acquire);
+	int64_t bottom = m_bottom.load(std::memory_order_acquire);
+	return top >= bottom;
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+typename WorkStealingDeque<T>::Ring* WorkStealingDeque<T>::Grow(Ring* ring, int64_t bottom, int64_t top)
+{
+	Ring* biggerRing = new Ring(ring->m_capacity * 2);
+	for (int64_t index = top; index < bottom; ++index)
+	{
+		biggerRing->Put(index, ring->Get(index));
+	}
+
+	m_retiredRings.push_back(ring);
+	m_ring.store(biggerRing, std::memory_order_release);
+	return biggerRing;
+}
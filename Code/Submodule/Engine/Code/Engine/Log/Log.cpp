@@ -1,39 +1,202 @@
 #include "Engine/Log/Log.hpp"
+#include "Engine/Log/LogBinary.hpp"
+#include "Engine/Core/BenchmarkUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/RandomNumberGenerator.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/NamedStrings.hpp"
 #include "Engine/Profile/Profile.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Memory/Memory.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <stdarg.h>
+#include <string_view>
 
+// -----------------------------------------------------------------------
+// A message in a staging buffer: the header, the callstack if there is one, the message and the filter, both
+// with their terminator, rounded up to LOG_RECORD_ALIGNMENT;
+// A structured message has the format id and the argument bytes where the message would be, no terminator;
+// -----------------------------------------------------------------------
+enum eLogRecordFlags : uint32_t
+{
+	LOG_RECORD_PADDING		= 1 << 0,		// Fills the end of the buffer when the next record doesn't fit there;
+	LOG_RECORD_CALLSTACK	= 1 << 1,
+	LOG_RECORD_TRUNCATED	= 1 << 2,
+	LOG_RECORD_STRUCTURED	= 1 << 3,
+};
 
+struct log_record_header_t
+{
+	uint32_t recordSize;
+	uint32_t messageSize;
+	uint32_t filterSize;
+	uint32_t flags;
+	uint64_t timestamp;		// Puts the threads' messages back in order;
+};
 
+constexpr size_t LOG_RECORD_ALIGNMENT = 8;
+constexpr const char* LOG_TRUNCATED_SUFFIX = "...";
+
+// -----------------------------------------------------------------------
+// One thread's staging buffer; the thread moves the write index, the log thread the read index;
+// Indices only grow, a byte lives at index & m_mask;
+// -----------------------------------------------------------------------
+struct log_thread_buffer_t
+{
+	uint8_t* m_data = nullptr;
+	size_t m_capacity = 0;
+	size_t m_mask = 0;
+
+	alignas(64) std::atomic<uint64_t> m_writeIndex = 0;
+	std::atomic<uint64_t> m_messageCount = 0;
+	std::atomic<uint64_t> m_dropCount = 0;
+	std::atomic<uint64_t> m_blockCount = 0;
+
+	alignas(64) std::atomic<uint64_t> m_readIndex = 0;
+	uint64_t m_reportedDropCount = 0;		// Log thread only;
+
+	bool m_isInUse = false;					// Guarded by m_threadBufferLock;
+};
+
+// -----------------------------------------------------------------------
+// Hands the buffer back when its thread exits, once the log thread has drained it another thread can have it;
+// -----------------------------------------------------------------------
+struct log_thread_buffer_owner_t
+{
+	log_thread_buffer_t* m_buffer = nullptr;
+	uint m_generation = 0;
+
+	~log_thread_buffer_owner_t();
+};
 
 // -----------------------------------------------------------------------
 // Global Declaration
 // -----------------------------------------------------------------------
 LogSystem* g_theLogSystem = nullptr;
-bool g_theLogSystemFlushRequested = false;
+std::atomic<bool> g_theLogSystemFlushRequested = false;
+
+// Bumped by init and shutdown, a thread's cached buffer is only good for the LogSystem it came from;
+static std::atomic<uint> g_logGeneration = 0;
+static thread_local log_thread_buffer_t* t_logBuffer = nullptr;
+static thread_local uint t_logBufferGeneration = 0;
+static thread_local log_thread_buffer_owner_t t_logBufferOwner;
+static thread_local char t_logFormatBuffer[LOG_MAX_MESSAGE_SIZE];
+
+// Between LogBeginStructured and LogCommitStructured;
+static thread_local log_thread_buffer_t* t_structuredBuffer = nullptr;
+static thread_local uint64_t t_structuredWriteIndex = 0;
+
+// Every LOG_STRUCTURED call site's format, by id; outlives the LogSystem, call sites register once per run;
+static std::vector<const char*> g_logFormats;
+static std::mutex g_logFormatLock;
+
+// Filters rarely change, each thread keeps what it looked up until the version moves;
+// Built filter names would fill it forever, so past LOG_FILTER_CACHE_SIZE the oldest entry is replaced;
+constexpr uint LOG_FILTER_CACHE_SIZE = 32;
+
+struct log_filter_cache_entry_t
+{
+	const char* pointer;
+	std::string name;		// A pointer to a temporary can come back as another filter;
+	bool isShown;
+};
+static std::atomic<uint> g_logFilterVersion = 1;
+static thread_local std::vector<log_filter_cache_entry_t> t_filterCache;
+static thread_local uint t_filterCacheVersion = 0;
+static thread_local uint t_filterCacheNext = 0;
+
+// Hooks run on the log thread, a Logf from one must never wait on the log thread for room;
+static thread_local bool t_isLogThread = false;
 
 
 // -----------------------------------------------------------------------
 // Static Methods Used for Callbacks
 // -----------------------------------------------------------------------
 
-static void LogTest();
+static void LogTest(uint messageCount, bool isStructured);
+// log_thread_test threads=<cores - 1> messages=100000 policy=drop|block structured=false;
+// Same messages every run, times until the last one is on disk; structured=true logs them with LOG_STRUCTURED;
 static bool LogThreadTest(EventArgs& args)
+{
+	int coreCount = (int)std::thread::hardware_concurrency() - 1;
+	int threadCount = args.GetValue("threads", coreCount > 1 ? coreCount : 1);
+	int messageCount = args.GetValue("messages", LOG_MESSAGES_PER_THREAD_TEST);
+	std::string policy = args.GetValue("policy", "drop");
+	bool isStructured = args.GetValue("structured", false);
+
+	int oldPolicy = g_theLogSystem->m_overflowPolicy;
+	LogSetOverflowPolicy(policy == "block" ? LOG_OVERFLOW_BLOCK : LOG_OVERFLOW_DROP);
+
+	LogFlush();
+	log_stats_t before = LogGetStats();
+	double startTime = GetCurrentTimeSeconds();
+
+	std::vector<std::thread> threads;
+	for (int threadIndex = 0; threadIndex < threadCount; ++threadIndex) 
+	{
+		threads.emplace_back(LogTest, (uint)messageCount, isStructured);
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	double loggedTime = GetCurrentTimeSeconds();
+
+	LogFlush();
+	double flushedTime = GetCurrentTimeSeconds();
+	log_stats_t after = LogGetStats();
+
+	LogSetOverflowPolicy((eLogOverflowPolicy)oldPolicy);
+
+	uint64_t logged = after.m_messageCount - before.m_messageCount;
+	uint64_t dropped = after.m_dropCount - before.m_dropCount;
+	double megabytes = (double)(after.m_bytesWritten - before.m_bytesWritten) / (1024.0 * 1024.0);
+	double seconds = flushedTime - startTime;
+
+	PrintLine(Stringf("Log throughput, %d threads x %d %s messages, %s on a full buffer, %s file", threadCount, messageCount, isStructured ? "structured" : "formatted",
+		policy == "block" ? "block" : "drop", g_theLogSystem->m_fileFormat == LOG_FILE_BINARY ? "binary" : "text"));
+	PrintLine(Stringf("  logged  %10llu  %8.2f M msg/s  (%.1f ns per Logf per thread)", logged, seconds > 0.0 ? (double)logged / seconds / 1'000'000.0 : 0.0,
+		logged > 0 ? (loggedTime - startTime) * 1'000'000'000.0 * threadCount / (double)(logged + dropped) : 0.0));
+	PrintLine(Stringf("  dropped %10llu  blocked %llu", dropped, after.m_blockCount - before.m_blockCount));
+	PrintLine(Stringf("  written %10.2f MB  %8.1f MB/s  in %llu writes", megabytes, seconds > 0.0 ? megabytes / seconds : 0.0, after.m_fileWriteCount - before.m_fileWriteCount));
+	PrintLine(Stringf("  buffers %10u  %8.2f MB of %.2f MB", after.m_threadBufferCount, (double)after.m_memoryUsed / (1024.0 * 1024.0),
+		(double)g_theLogSystem->m_memoryBudget / (1024.0 * 1024.0)));
+
+	return true;
+}
+
+// log_stats;
+static bool LogStats(EventArgs& args)
 {
 	args;
 
-	uint core_count = std::thread::hardware_concurrency() - 1;
-	for (uint i = 0; i < core_count; ++i) 
+	log_stats_t stats = LogGetStats();
+	PrintLine(Stringf("Log: %llu messages, %llu dropped, %llu blocked, %.2f MB in %llu writes, %u buffers using %.2f MB",
+		stats.m_messageCount, stats.m_dropCount, stats.m_blockCount, (double)stats.m_bytesWritten / (1024.0 * 1024.0), stats.m_fileWriteCount,
+		stats.m_threadBufferCount, (double)stats.m_memoryUsed / (1024.0 * 1024.0)));
+
+	return true;
+}
+
+// log_decode in=<binary log> out=<text file>;
+static bool LogDecode(EventArgs& args)
+{
+	std::string binaryPath = args.GetValue("in", "");
+	std::string textPath = args.GetValue("out", binaryPath + ".txt");
+
+	if(LogDecodeBinaryFile(binaryPath.c_str(), textPath.c_str()))
+	{
+		PrintLine(Stringf("Decoded %s to %s", binaryPath.c_str(), textPath.c_str()));
+	}
+	else
 	{
-		std::thread test_thread(LogTest);
-		test_thread.detach();
+		PrintLine(Stringf("Couldn't decode all of %s, not a binary log or cut short", binaryPath.c_str()));
 	}
 
 	return true;
@@ -136,80 +299,643 @@ void LogSystem::LogUnhook(LogHookCallbackFunction cb)
 	HookUnLock();
 }
 
+// -----------------------------------------------------------------------
+// Staging Buffers
+// -----------------------------------------------------------------------
+log_thread_buffer_owner_t::~log_thread_buffer_owner_t()
+{
+	if(!m_buffer || !g_theLogSystem || m_generation != g_logGeneration)
+	{
+		return;
+	}
+
+	std::scoped_lock<std::mutex> lock(g_theLogSystem->m_threadBufferLock);
+	m_buffer->m_isInUse = false;
+}
+
+// -----------------------------------------------------------------------
+// Nullptr once the memory budget is spent; the thread doesn't ask again, its messages count as dropped;
+// -----------------------------------------------------------------------
+static log_thread_buffer_t* AcquireThreadBuffer()
+{
+	MEM_TAG_SCOPE(MEM_TAG_LOG);
+	std::scoped_lock<std::mutex> lock(g_theLogSystem->m_threadBufferLock);
+
+	t_logBufferGeneration = g_logGeneration;
+	t_logBuffer = nullptr;
+
+	for(log_thread_buffer_t* buffer : g_theLogSystem->m_threadBuffers)
+	{
+		if(!buffer->m_isInUse && buffer->m_readIndex.load(std::memory_order_acquire) == buffer->m_writeIndex.load(std::memory_order_relaxed))
+		{
+			t_logBuffer = buffer;
+			break;
+		}
+	}
+
+	size_t capacity = (size_t)LOG_THREAD_BUFFER_KB * 1024;
+	if(!t_logBuffer && g_theLogSystem->m_memoryUsed + capacity <= g_theLogSystem->m_memoryBudget)
+	{
+		t_logBuffer = new log_thread_buffer_t();
+		t_logBuffer->m_data = (uint8_t*)UntrackedAlloc(capacity);
+		t_logBuffer->m_capacity = capacity;
+		t_logBuffer->m_mask = capacity - 1;
+
+		g_theLogSystem->m_memoryUsed += capacity;
+		g_theLogSystem->m_threadBuffers.push_back(t_logBuffer);
+	}
+
+	if(t_logBuffer)
+	{
+		t_logBuffer->m_isInUse = true;
+		t_logBufferOwner.m_buffer = t_logBuffer;
+		t_logBufferOwner.m_generation = t_logBufferGeneration;
+	}
+
+	return t_logBuffer;
+}
+
+// -----------------------------------------------------------------------
+// Room for a record of recordSize_ bytes, in one piece; nullptr if it was dropped;
+// -----------------------------------------------------------------------
+static uint8_t* ReserveRecord(log_thread_buffer_t* buffer_, size_t recordSize_, uint64_t* outWriteIndex_)
+{
+	uint64_t writeIndex = buffer_->m_writeIndex.load(std::memory_order_relaxed);
+	size_t offset = (size_t)(writeIndex & buffer_->m_mask);
+	size_t contiguous = buffer_->m_capacity - offset;
+
+	// Records never wrap, the end of the buffer is skipped instead;
+	size_t skipSize = contiguous < recordSize_ ? contiguous : 0;
+	size_t neededSize = skipSize + recordSize_;
+
+	// Would never fit, waiting won't help;
+	if(recordSize_ > buffer_->m_capacity / 2)
+	{
+		buffer_->m_dropCount.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	while(neededSize > buffer_->m_capacity - (size_t)(writeIndex - buffer_->m_readIndex.load(std::memory_order_acquire)))
+	{
+		g_theLogSystem->SignalWork();
+
+		if(g_theLogSystem->m_overflowPolicy == LOG_OVERFLOW_DROP || !g_theLogSystem->IsRunning() || t_isLogThread)
+		{
+			buffer_->m_dropCount.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		buffer_->m_blockCount.fetch_add(1, std::memory_order_relaxed);
+		std::this_thread::yield();
+	}
+
+	// Too small for a header and the reader knows to skip it, otherwise say how much to skip;
+	if(skipSize >= sizeof(log_record_header_t))
+	{
+		log_record_header_t* padding = (log_record_header_t*)(buffer_->m_data + offset);
+		padding->recordSize = (uint32_t)skipSize;
+		padding->flags = LOG_RECORD_PADDING;
+	}
+
+	*outWriteIndex_ = writeIndex + skipSize;
+	return buffer_->m_data + (size_t)((writeIndex + skipSize) & buffer_->m_mask);
+}
+
+// -----------------------------------------------------------------------
+// This thread's buffer, nullptr if it couldn't get one; the message counts as dropped;
+// -----------------------------------------------------------------------
+static log_thread_buffer_t* GetThreadBuffer()
+{
+	log_thread_buffer_t* buffer = t_logBuffer;
+	if(t_logBufferGeneration != g_logGeneration.load(std::memory_order_relaxed))
+	{
+		buffer = AcquireThreadBuffer();
+	}
+	if(!buffer)
+	{
+		g_theLogSystem->m_unbufferedDropCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	return buffer;
+}
+
+// -----------------------------------------------------------------------
+// Reserves the record and fills in everything but the message; returns where the message goes;
+// -----------------------------------------------------------------------
+static uint8_t* BeginRecord(log_thread_buffer_t* buffer_, const char* filter_, const Callstack* callstack_, size_t messageSize_, uint32_t flags_, uint64_t* outEndIndex_)
+{
+	size_t filterSize = strlen(filter_) + 1;
+	size_t callstackSize = callstack_ ? sizeof(Callstack) : 0;
+	size_t recordSize = sizeof(log_record_header_t) + callstackSize + messageSize_ + filterSize;
+	recordSize = (recordSize + LOG_RECORD_ALIGNMENT - 1) & ~(LOG_RECORD_ALIGNMENT - 1);
+
+	uint64_t writeIndex = 0;
+	uint8_t* record = ReserveRecord(buffer_, recordSize, &writeIndex);
+	if(!record)
+	{
+		return nullptr;
+	}
+
+	log_record_header_t* header = (log_record_header_t*)record;
+	header->recordSize = (uint32_t)recordSize;
+	header->messageSize = (uint32_t)messageSize_;
+	header->filterSize = (uint32_t)filterSize;
+	header->flags = flags_ | (callstack_ ? LOG_RECORD_CALLSTACK : 0);
+	header->timestamp = (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+
+	uint8_t* payload = record + sizeof(log_record_header_t);
+	if(callstack_)
+	{
+		memcpy(payload, callstack_, callstackSize);
+		payload += callstackSize;
+	}
+	memcpy(payload + messageSize_, filter_, filterSize);
+
+	*outEndIndex_ = writeIndex + recordSize;
+	return payload;
+}
+
+// -----------------------------------------------------------------------
+// Hands the record to the log thread;
+// -----------------------------------------------------------------------
+static void PublishRecord(log_thread_buffer_t* buffer_, uint64_t endIndex_)
+{
+	buffer_->m_writeIndex.store(endIndex_, std::memory_order_release);
+	buffer_->m_messageCount.fetch_add(1, std::memory_order_relaxed);
+
+	// Past half full, don't wait for the log thread's next look;
+	if((size_t)(endIndex_ - buffer_->m_readIndex.load(std::memory_order_relaxed)) > buffer_->m_capacity / 2)
+	{
+		g_theLogSystem->SignalWork();
+	}
+}
+
+// -----------------------------------------------------------------------
+// One vsnprintf into the thread's scratch, then a copy into the staging buffer;
+// -----------------------------------------------------------------------
+static void LogWrite(const char* filter, const Callstack* callstack, const char* format, va_list argumentList)
+{
+	if(!g_theLogSystem->IsFiltered(filter))
+	{
+		return;
+	}
+
+	log_thread_buffer_t* buffer = GetThreadBuffer();
+	if(!buffer)
+	{
+		return;
+	}
+
+	uint32_t flags = 0;
+	int formattedLength = vsnprintf(t_logFormatBuffer, LOG_MAX_MESSAGE_SIZE, format, argumentList);
+	size_t messageLength = formattedLength > 0 ? (size_t)formattedLength : 0;
+	if(messageLength >= LOG_MAX_MESSAGE_SIZE)
+	{
+		size_t suffixLength = strlen(LOG_TRUNCATED_SUFFIX);
+		messageLength = LOG_MAX_MESSAGE_SIZE - 1;
+		memcpy(t_logFormatBuffer + messageLength - suffixLength, LOG_TRUNCATED_SUFFIX, suffixLength);
+		flags |= LOG_RECORD_TRUNCATED;
+	}
+
+	uint64_t endIndex = 0;
+	uint8_t* message = BeginRecord(buffer, filter, callstack, messageLength + 1, flags, &endIndex);
+	if(!message)
+	{
+		return;
+	}
+
+	memcpy(message, t_logFormatBuffer, messageLength);
+	message[messageLength] = '\0';
+	PublishRecord(buffer, endIndex);
+}
+
+// -----------------------------------------------------------------------
+uint LogRegisterFormat(const char* format)
+{
+	std::scoped_lock<std::mutex> lock(g_logFormatLock);
+
+	g_logFormats.push_back(format);
+	return (uint)g_logFormats.size() - 1;
+}
+
+// -----------------------------------------------------------------------
+const char* LogGetFormat(uint formatId)
+{
+	std::scoped_lock<std::mutex> lock(g_logFormatLock);
+
+	return formatId < g_logFormats.size() ? g_logFormats[formatId] : nullptr;
+}
+
+// -----------------------------------------------------------------------
+uint8_t* LogBeginStructured(const char* filter, uint formatId, size_t argumentSize)
+{
+	t_structuredBuffer = GetThreadBuffer();
+	if(!t_structuredBuffer)
+	{
+		return nullptr;
+	}
+
+	uint8_t* message = BeginRecord(t_structuredBuffer, filter, nullptr, sizeof(uint32_t) + argumentSize, LOG_RECORD_STRUCTURED, &t_structuredWriteIndex);
+	if(!message)
+	{
+		return nullptr;
+	}
+
+	uint32_t formatId32 = formatId;
+	memcpy(message, &formatId32, sizeof(uint32_t));
+	return message + sizeof(uint32_t);
+}
+
+// -----------------------------------------------------------------------
+void LogCommitStructured()
+{
+	PublishRecord(t_structuredBuffer, t_structuredWriteIndex);
+}
+
 // -----------------------------------------------------------------------
 // Statics
 // -----------------------------------------------------------------------
-static void LogThread()
+struct log_pending_record_t
 {
-	// Create a log file
-	FILE* file = fopen(g_theLogSystem->m_filename.c_str(), "wb");
-	if(!file)
+	const log_record_header_t* header;
+	log_message_t message;
+
+	// LOG_RECORD_STRUCTURED;
+	uint32_t formatId;
+	const uint8_t* arguments;
+	size_t argumentSize;
+};
+
+// -----------------------------------------------------------------------
+// The log thread's file, a block at a time;
+// -----------------------------------------------------------------------
+struct log_file_writer_t
+{
+	FILE* m_file = nullptr;
+	eLogFileFormat m_format = LOG_FILE_TEXT;
+	std::vector<char> m_block;
+	std::string m_text;
+
+	// LOG_FILE_BINARY, what the file already has;
+	std::map<std::string, uint, std::less<>> m_filterIndices;
+	std::vector<bool> m_isFormatWritten;
+	uint64_t m_lastTimeNS = 0;
+
+	// A copy of the registry, so the lock is only taken for a new id;
+	std::vector<const char*> m_formats;
+};
+
+// -----------------------------------------------------------------------
+static void WriteBlock(log_file_writer_t& writer_)
+{
+	if(writer_.m_block.empty())
 	{
-		GUARANTEE_RECOVERABLE(!file, "Log file not found.");
 		return;
 	}
 
-	while(g_theLogSystem->IsRunning())
+	fwrite(writer_.m_block.data(), 1, writer_.m_block.size(), writer_.m_file);
+	g_theLogSystem->m_bytesWritten += writer_.m_block.size();
+	++g_theLogSystem->m_fileWriteCount;
+	writer_.m_block.clear();
+}
+
+// -----------------------------------------------------------------------
+// Writes out the block first if size_ more bytes would go past LOG_WRITE_BLOCK_SIZE;
+// -----------------------------------------------------------------------
+static void ReserveBlock(log_file_writer_t& writer_, size_t size_)
+{
+	if(writer_.m_block.size() + size_ > LOG_WRITE_BLOCK_SIZE)
 	{
-		g_theLogSystem->WaitForWork();
+		WriteBlock(writer_);
+	}
+}
 
-		log_message_t* msg;
-		size_t size;
-		while((msg = (log_message_t*)g_theLogSystem->m_asyncRingBuffer.TryLockRead(&size)) != nullptr)
+// -----------------------------------------------------------------------
+static void AppendToBlock(log_file_writer_t& writer_, const char* data_, size_t size_)
+{
+	ReserveBlock(writer_, size_);
+	writer_.m_block.insert(writer_.m_block.end(), data_, data_ + size_);
+}
+
+// -----------------------------------------------------------------------
+static const char* FindFormat(log_file_writer_t& writer_, uint32_t formatId_)
+{
+	if(formatId_ >= writer_.m_formats.size())
+	{
+		std::scoped_lock<std::mutex> lock(g_logFormatLock);
+		writer_.m_formats = g_logFormats;
+	}
+
+	return formatId_ < writer_.m_formats.size() ? writer_.m_formats[formatId_] : "(unknown format)";
+}
+
+// -----------------------------------------------------------------------
+static uint64_t GetTimeDelta(log_file_writer_t& writer_, uint64_t timestamp_)
+{
+	std::chrono::steady_clock::duration time((std::chrono::steady_clock::rep)timestamp_);
+	uint64_t timeNS = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+
+	int64_t deltaNS = (int64_t)(timeNS - writer_.m_lastTimeNS);
+	writer_.m_lastTimeNS = timeNS;
+	return LogZigZagEncode(deltaNS);
+}
+
+// -----------------------------------------------------------------------
+// LOG_FILE_BINARY, the filter's index, declared the first time it is used;
+// -----------------------------------------------------------------------
+static uint WriteFilter(log_file_writer_t& writer_, const char* filter_, size_t filterLength_)
+{
+	std::string_view filter(filter_, filterLength_);
+	auto found = writer_.m_filterIndices.find(filter);
+	if(found != writer_.m_filterIndices.end())
+	{
+		return found->second;
+	}
+
+	uint filterIndex = (uint)writer_.m_filterIndices.size();
+	writer_.m_filterIndices.emplace(std::string(filter), filterIndex);
+
+	ReserveBlock(writer_, filterLength_ + 16);
+	writer_.m_block.push_back(LOG_STREAM_RECORD_FILTER);
+	LogAppendVarint(writer_.m_block, filterIndex);
+	LogAppendString(writer_.m_block, filter_, filterLength_);
+	return filterIndex;
+}
+
+// -----------------------------------------------------------------------
+// A finished message, as a line or a LOG_STREAM_RECORD_TEXT;
+// -----------------------------------------------------------------------
+static void WriteText(log_file_writer_t& writer_, uint64_t timestamp_, const char* filter_, size_t filterLength_, const char* text_, size_t textLength_)
+{
+	if(writer_.m_format == LOG_FILE_TEXT)
+	{
+		if(filterLength_ > 0)
+		{
+			AppendToBlock(writer_, filter_, filterLength_);
+			AppendToBlock(writer_, ": ", 2);
+		}
+		AppendToBlock(writer_, text_, textLength_);
+		AppendToBlock(writer_, "\n", 1);
+		return;
+	}
+
+	uint filterIndex = WriteFilter(writer_, filter_, filterLength_);
+
+	ReserveBlock(writer_, textLength_ + 32);
+	writer_.m_block.push_back(LOG_STREAM_RECORD_TEXT);
+	LogAppendVarint(writer_.m_block, GetTimeDelta(writer_, timestamp_));
+	LogAppendVarint(writer_.m_block, filterIndex);
+	LogAppendString(writer_.m_block, text_, textLength_);
+}
+
+// -----------------------------------------------------------------------
+// LOG_FILE_BINARY, the arguments as LOG_STRUCTURED wrote them;
+// -----------------------------------------------------------------------
+static void WriteStructured(log_file_writer_t& writer_, const log_pending_record_t& record_)
+{
+	uint filterIndex = WriteFilter(writer_, record_.message.filter, record_.message.filterSize - 1);
+
+	if(record_.formatId >= writer_.m_isFormatWritten.size())
+	{
+		writer_.m_isFormatWritten.resize(record_.formatId + 1, false);
+	}
+	if(!writer_.m_isFormatWritten[record_.formatId])
+	{
+		const char* format = FindFormat(writer_, record_.formatId);
+		size_t formatLength = strlen(format);
+
+		ReserveBlock(writer_, formatLength + 16);
+		writer_.m_block.push_back(LOG_STREAM_RECORD_FORMAT);
+		LogAppendVarint(writer_.m_block, record_.formatId);
+		LogAppendString(writer_.m_block, format, formatLength);
+		writer_.m_isFormatWritten[record_.formatId] = true;
+	}
+
+	ReserveBlock(writer_, record_.argumentSize + 32);
+	writer_.m_block.push_back(LOG_STREAM_RECORD_MESSAGE);
+	LogAppendVarint(writer_.m_block, GetTimeDelta(writer_, record_.header->timestamp));
+	LogAppendVarint(writer_.m_block, filterIndex);
+	LogAppendVarint(writer_.m_block, record_.formatId);
+	LogAppendString(writer_.m_block, (const char*)record_.arguments, record_.argumentSize);
+}
+
+// -----------------------------------------------------------------------
+// Everything staged right now, from every thread, oldest first; one write for it all unless it is more than a block;
+// -----------------------------------------------------------------------
+static bool DrainThreadBuffers(log_file_writer_t& writer_, std::vector<log_pending_record_t>& pending_)
+{
+	std::vector<log_thread_buffer_t*> buffers;
+	{
+		std::scoped_lock<std::mutex> lock(g_theLogSystem->m_threadBufferLock);
+		buffers = g_theLogSystem->m_threadBuffers;
+	}
+
+	std::vector<uint64_t> drainedIndices(buffers.size());
+	pending_.clear();
+
+	for(size_t bufferIndex = 0; bufferIndex < buffers.size(); ++bufferIndex)
+	{
+		log_thread_buffer_t* buffer = buffers[bufferIndex];
+		uint64_t writeIndex = buffer->m_writeIndex.load(std::memory_order_acquire);
+		uint64_t readIndex = buffer->m_readIndex.load(std::memory_order_relaxed);
+
+		while(readIndex < writeIndex)
 		{
-			for(int i = 0; i < g_theLogSystem->m_hookers.size(); i++)
+			size_t offset = (size_t)(readIndex & buffer->m_mask);
+			size_t contiguous = buffer->m_capacity - offset;
+			if(contiguous < sizeof(log_record_header_t))
 			{
-				g_theLogSystem->m_hookers[i](msg);
+				readIndex += contiguous;
+				continue;
 			}
 
-			if(msg->filterSize > 0)
+			const log_record_header_t* header = (const log_record_header_t*)(buffer->m_data + offset);
+			readIndex += header->recordSize;
+			if(header->flags & LOG_RECORD_PADDING)
 			{
-				fwrite(msg->filter, 1, msg->filterSize - 1, file);
-				fwrite(": ", 1, 2, file);
+				continue;
 			}
-			
-			fwrite(msg->message, 1, msg->messageSize - 1, file);
 
-			if(msg->callstackf)
+			const uint8_t* payload = (const uint8_t*)(header + 1);
+			log_pending_record_t record;
+			record.header = header;
+			record.message.callstackf = (header->flags & LOG_RECORD_CALLSTACK) != 0;
+			if(record.message.callstackf)
 			{
-				fwrite("\n", 1, 1, file);
-				fwrite("### Requested Callstack ###\n", 1, 28, file);
-				std::vector<std::string> callstack = CallstackToString(msg->callstack);
-				for(int i = 0; i < callstack.size(); i++)
-				{
-					fwrite(callstack[i].c_str(), 1, strlen(callstack[i].c_str()), file);
-					fwrite("\n", 1, 1, file);
-				}
+				memcpy(&record.message.callstack, payload, sizeof(Callstack));
+				payload += sizeof(Callstack);
 			}
+			record.message.message = (char*)payload;
+			record.message.messageSize = header->messageSize;
+			record.message.filter = (char*)payload + header->messageSize;
+			record.message.filterSize = header->filterSize;
+
+			record.formatId = 0;
+			record.arguments = nullptr;
+			record.argumentSize = 0;
+			if(header->flags & LOG_RECORD_STRUCTURED)
+			{
+				memcpy(&record.formatId, payload, sizeof(uint32_t));
+				record.arguments = payload + sizeof(uint32_t);
+				record.argumentSize = header->messageSize - sizeof(uint32_t);
+			}
+			pending_.push_back(record);
+		}
 
-			fwrite("\n", 1, 1, file);
+		drainedIndices[bufferIndex] = readIndex;
+	}
+
+	std::stable_sort(pending_.begin(), pending_.end(), [](const log_pending_record_t& lhs, const log_pending_record_t& rhs)
+	{
+		return lhs.header->timestamp < rhs.header->timestamp;
+	});
 
-			g_theLogSystem->m_asyncRingBuffer.UnlockRead(msg);
+	g_theLogSystem->HookLock();
+	bool isHooked = !g_theLogSystem->m_hookers.empty();
+	for(log_pending_record_t& record : pending_)
+	{
+		log_message_t* msg = &record.message;
+		bool isStructured = (record.header->flags & LOG_RECORD_STRUCTURED) != 0;
+
+		// Only formatted when something is going to read it;
+		if(isStructured && (isHooked || writer_.m_format == LOG_FILE_TEXT))
+		{
+			writer_.m_text.clear();
+			LogFormatArguments(FindFormat(writer_, record.formatId), record.arguments, record.argumentSize, writer_.m_text);
+			msg->message = (char*)writer_.m_text.c_str();
+			msg->messageSize = writer_.m_text.size() + 1;
+		}
+
+		for(int i = 0; i < g_theLogSystem->m_hookers.size(); i++)
+		{
+			g_theLogSystem->m_hookers[i](msg);
 		}
 
-		if(g_theLogSystemFlushRequested)
+		if(isStructured && writer_.m_format == LOG_FILE_BINARY)
+		{
+			WriteStructured(writer_, record);
+		}
+		else if(msg->callstackf)
+		{
+			writer_.m_text.assign(msg->message, msg->messageSize - 1);
+			writer_.m_text += "\n### Requested Callstack ###\n";
+			std::vector<std::string> callstack = CallstackToString(msg->callstack);
+			for(int i = 0; i < callstack.size(); i++)
+			{
+				writer_.m_text += callstack[i];
+				writer_.m_text += "\n";
+			}
+			WriteText(writer_, record.header->timestamp, msg->filter, msg->filterSize - 1, writer_.m_text.data(), writer_.m_text.size());
+		}
+		else
 		{
-			fflush(file);
-			g_theLogSystemFlushRequested = false;
+			WriteText(writer_, record.header->timestamp, msg->filter, msg->filterSize - 1, msg->message, msg->messageSize - 1);
 		}
 	}
+	g_theLogSystem->HookUnLock();
 
-	fclose(file);
+	for(size_t bufferIndex = 0; bufferIndex < buffers.size(); ++bufferIndex)
+	{
+		log_thread_buffer_t* buffer = buffers[bufferIndex];
+		buffer->m_readIndex.store(drainedIndices[bufferIndex], std::memory_order_release);
+
+		uint64_t dropCount = buffer->m_dropCount.load(std::memory_order_relaxed);
+		if(dropCount != buffer->m_reportedDropCount)
+		{
+			std::string note = Stringf("log: %llu messages dropped, a thread's buffer was full", dropCount - buffer->m_reportedDropCount);
+			WriteText(writer_, (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count(), "", 0, note.c_str(), note.size());
+			buffer->m_reportedDropCount = dropCount;
+		}
+	}
+
+	WriteBlock(writer_);
+
+	return !pending_.empty();
 }
 
-static void LogTest()
+// -----------------------------------------------------------------------
+static void LogThread()
+{
+	t_isLogThread = true;
+	ProfilerSetThreadName("Log");
+	MEM_TAG_SCOPE(MEM_TAG_LOG);
+
+	log_file_writer_t writer;
+	writer.m_format = g_theLogSystem->m_fileFormat;
+
+	// Create a log file
+	writer.m_file = fopen(g_theLogSystem->m_filename.c_str(), "wb");
+	if(!writer.m_file)
+	{
+		GUARANTEE_RECOVERABLE(!writer.m_file, "Log file not found.");
+		return;
+	}
+
+	// Blocks go straight to the file, the CRT buffer would only split them up;
+	setvbuf(writer.m_file, nullptr, _IONBF, 0);
+
+	writer.m_block.reserve(LOG_WRITE_BLOCK_SIZE);
+	std::vector<log_pending_record_t> pending;
+
+	if(writer.m_format == LOG_FILE_BINARY)
+	{
+		LogStreamHeader header;
+		AppendToBlock(writer, (const char*)&header, sizeof(header));
+	}
+
+	while(true)
+	{
+		// Read before draining, so everything logged before the stop is written;
+		bool isRunning = g_theLogSystem->IsRunning();
+		bool isFlushRequested = g_theLogSystemFlushRequested;
+
+		{
+			// One scope per drain, so exports show the log thread next to the threads it writes for;
+			PROFILE_SCOPE("LogDrain");
+			DrainThreadBuffers(writer, pending);
+
+			if(isFlushRequested)
+			{
+				fflush(writer.m_file);
+				g_theLogSystemFlushRequested = false;
+			}
+		}
+
+		if(!isRunning)
+		{
+			break;
+		}
+
+		g_theLogSystem->WaitForWork();
+	}
+
+	if(writer.m_format == LOG_FILE_BINARY)
+	{
+		writer.m_block.push_back(LOG_STREAM_RECORD_END);
+		WriteBlock(writer);
+	}
+
+	fclose(writer.m_file);
+}
+
+static void LogTest(uint messageCount, bool isStructured)
 {
 	std::thread::id this_id = std::this_thread::get_id();
 	size_t hash_id = std::hash<std::thread::id>{}(this_id);
 	char const* format = "Thread[%llu]: Printing Message %u";
 
-	for (uint i = 0; i < LOG_MESSAGES_PER_THREAD_TEST; ++i)
+	for (uint i = 0; i < messageCount; ++i)
 	{
 // 		if (g_theRandomNumberGenerator->RandomCoinFlip())
 // 		{
 // 			LogCallstackf("debug", format, hash_id, i);
 // 		}
 // 		else 
+		if (isStructured)
+		{
+			LOG_STRUCTURED("debug", "Thread[%llu]: Printing Message %u", hash_id, i);
+		}
+		else
 		{
 			Logf("debug", format, hash_id, i);
 		}
@@ -217,17 +943,22 @@ static void LogTest()
 }
 
 // -----------------------------------------------------------------------
-void LogSystemInit(const char* logFile_)
+void LogSystemInit(const char* logFile_, uint memoryMB /*= LOG_DEFAULT_MEMORY_MB*/, eLogFileFormat fileFormat /*= LOG_FILE_TEXT*/)
 {
+	MEM_TAG_SCOPE(MEM_TAG_LOG);
 	g_theLogSystem = new LogSystem();
 
-	g_theLogSystem->m_asyncRingBuffer.Init(1'000'000'000);
+	g_theLogSystem->m_memoryBudget = (size_t)memoryMB * 1024 * 1024;
 	g_theLogSystem->m_filename = logFile_;
+	g_theLogSystem->m_fileFormat = fileFormat;
 	g_theLogSystem->m_signal.Create(0, 1);
+	++g_logGeneration;
 
 	g_theLogSystem->m_thread = std::thread(LogThread);
 
 	g_theEventSystem->SubscriptionEventCallbackFunction("log_thread_test", LogThreadTest);
+	g_theEventSystem->SubscriptionEventCallbackFunction("log_stats", LogStats);
+	g_theEventSystem->SubscriptionEventCallbackFunction("log_decode", LogDecode);
 	g_theEventSystem->SubscriptionEventCallbackFunction("log_enable_all", LogEnableAllFilters);
 	g_theEventSystem->SubscriptionEventCallbackFunction("log_disable_all", LogDisableAllFilters);
 	g_theEventSystem->SubscriptionEventCallbackFunction("log_enable_filter", LogEnableSingleFilter);
@@ -239,89 +970,72 @@ void LogSystemInit(const char* logFile_)
 // -----------------------------------------------------------------------
 void LogSystemShutdown()
 {
-	g_theLogSystem->Stop();
-
 	Logf("", "Shutting down log system...");
 
+	g_theLogSystem->Stop();
+
 	g_theLogSystem->SignalWork();
 	g_theLogSystem->m_thread.join();
+	g_theLogSystem->m_signal.Destroy();
+
+	// Threads still holding a buffer see the generation move and stop using it;
+	++g_logGeneration;
+	for(log_thread_buffer_t* buffer : g_theLogSystem->m_threadBuffers)
+	{
+		UntrackedFree(buffer->m_data);
+		delete buffer;
+	}
+	g_theLogSystem->m_threadBuffers.clear();
 
 	delete g_theLogSystem;
 	g_theLogSystem = nullptr;
 }
 
 // -----------------------------------------------------------------------
-void Logf(const char* filter, const char* format, ...)
+void LogSetOverflowPolicy(eLogOverflowPolicy policy)
+{
+	g_theLogSystem->m_overflowPolicy = policy;
+}
+
+// -----------------------------------------------------------------------
+log_stats_t LogGetStats()
 {
-	if (!g_theLogSystem->IsFiltered(filter))
+	log_stats_t stats;
+	stats.m_dropCount = g_theLogSystem->m_unbufferedDropCount;
+	stats.m_bytesWritten = g_theLogSystem->m_bytesWritten;
+	stats.m_fileWriteCount = g_theLogSystem->m_fileWriteCount;
+
+	std::scoped_lock<std::mutex> lock(g_theLogSystem->m_threadBufferLock);
+	for(log_thread_buffer_t* buffer : g_theLogSystem->m_threadBuffers)
 	{
-		return;
+		stats.m_messageCount += buffer->m_messageCount.load(std::memory_order_relaxed);
+		stats.m_dropCount += buffer->m_dropCount.load(std::memory_order_relaxed);
+		stats.m_blockCount += buffer->m_blockCount.load(std::memory_order_relaxed);
 	}
+	stats.m_threadBufferCount = (uint)g_theLogSystem->m_threadBuffers.size();
+	stats.m_memoryUsed = g_theLogSystem->m_memoryUsed;
 
-	log_message_t logMessage;
+	return stats;
+}
 
+// -----------------------------------------------------------------------
+void Logf(const char* filter, const char* format, ...)
+{
 	va_list argumentList;
-	va_list copyList;
 	va_start(argumentList, format);
-	va_copy(copyList, argumentList);
-
-	size_t logMessageSize = sizeof(log_message_t);
-	size_t messageSize = (size_t)vsnprintf(nullptr, 0, format, copyList) + 1; va_end(copyList);
-	size_t filterSize = strlen(filter) + 1;
-
-	size_t bytesNeeded = logMessageSize + messageSize + filterSize;
-	logMessage.messageSize = messageSize;
-	logMessage.filterSize = filterSize;
-
-	void* ptr = g_theLogSystem->m_asyncRingBuffer.LockWrite(bytesNeeded);
-	logMessage.message = (char*)ptr + logMessageSize;
-	logMessage.filter = logMessage.message + messageSize;
-
-	memcpy(ptr, &logMessage, logMessageSize);
-	vsnprintf(logMessage.message, messageSize, format, argumentList); va_end(argumentList);
-	memcpy(logMessage.filter, filter, filterSize);
-
-	g_theLogSystem->m_asyncRingBuffer.UnlockWrite(ptr);
-
-	g_theLogSystem->SignalWork();
+	LogWrite(filter, nullptr, format, argumentList);
+	va_end(argumentList);
 }
 
 // -----------------------------------------------------------------------
 void LogCallstackf(const char* filter, const char* format, ...)
 {
-	if (!g_theLogSystem->IsFiltered(filter))
-	{
-		return;
-	}
-
-	log_message_t logMessage;
-	logMessage.callstackf = true;
+	Callstack callstack = GetCallstack();
 
 	va_list argumentList;
-	va_list copyList;
 	va_start(argumentList, format);
-	va_copy(copyList, argumentList);
-
-	size_t logMessageSize = sizeof(log_message_t);
-	size_t messageSize = (size_t)vsnprintf(nullptr, 0, format, copyList) + 1; va_end(copyList);
-	size_t filterSize = strlen(filter) + 1;
-
-	size_t bytesNeeded = logMessageSize + messageSize + filterSize;
-	logMessage.messageSize = messageSize;
-	logMessage.filterSize = filterSize;
-
-	void* ptr = g_theLogSystem->m_asyncRingBuffer.LockWrite(bytesNeeded);
-	logMessage.message = (char*)ptr + logMessageSize;
-	logMessage.filter = logMessage.message + messageSize;
-
-	logMessage.callstack = GetCallstack();
-	memcpy(ptr, &logMessage, logMessageSize);
-	vsnprintf(logMessage.message, messageSize, format, argumentList); va_end(argumentList);
-	memcpy(logMessage.filter, filter, filterSize);
-
-	g_theLogSystem->m_asyncRingBuffer.UnlockWrite(ptr);
-
-	g_theLogSystem->SignalWork();
+	LogWrite(filter, &callstack, format, argumentList);
+	va_end(argumentList);
 }
 
 // -----------------------------------------------------------------------
@@ -397,6 +1111,7 @@ void LogSystem::LogEnableAll()
 	{
 		filter.second = true;
 	}
+	++g_logFilterVersion;
 }
 
 // -----------------------------------------------------------------------
@@ -409,6 +1124,7 @@ void LogSystem::LogDisableAll()
 	{
 		filter.second = false;
 	}
+	++g_logFilterVersion;
 }
 
 // -----------------------------------------------------------------------
@@ -417,20 +1133,8 @@ void LogSystem::LogEnable(const char* filter)
 	std::scoped_lock lock(m_filterLock);
 
 	// If we enable a filter, then we want it to show;
-	std::map< std::string, bool >::iterator found = m_filters.find(filter);
-	if (found != m_filters.end())
-	{
-		found->second = true;
-	}
-	else
-	{
-		LogAddFilter(filter);
-		found = m_filters.find(filter);
-		if (found != m_filters.end())
-		{
-			found->second = true;
-		}
-	}
+	m_filters[filter] = true;
+	++g_logFilterVersion;
 }
 
 // -----------------------------------------------------------------------
@@ -439,20 +1143,8 @@ void LogSystem::LogDisable(const char* filter)
 	std::scoped_lock lock(m_filterLock);
 
 	// If we disable a filter, then we want it to not show;
-	std::map< std::string, bool >::iterator found = m_filters.find(filter);
-	if (found != m_filters.end())
-	{
-		found->second = false;
-	}
-	else
-	{
-		LogAddFilter(filter);
-		found = m_filters.find(filter);
-		if (found != m_filters.end())
-		{
-			found->second = false;
-		}
-	}
+	m_filters[filter] = false;
+	++g_logFilterVersion;
 }
 
 // -----------------------------------------------------------------------
@@ -478,6 +1170,7 @@ void LogSystem::LogRemoveFilter(const char* filter)
 	{
 		m_filters.erase(found);
 	}
+	++g_logFilterVersion;
 }
 
 // -----------------------------------------------------------------------
@@ -486,21 +1179,53 @@ void LogSystem::LogClearFilters()
 	std::scoped_lock lock(m_filterLock);
 
 	m_filters.clear();
+	++g_logFilterVersion;
 }
 
 // -----------------------------------------------------------------------
 bool LogSystem::IsFiltered(const char* filter)
 {
-	std::scoped_lock lock(m_filterLock);
+	// Most calls pass the same literal every time, so the thread's cache goes by pointer;
+	uint version = g_logFilterVersion.load(std::memory_order_acquire);
+	if (t_filterCacheVersion != version)
+	{
+		t_filterCache.clear();
+		t_filterCacheVersion = version;
+		t_filterCacheNext = 0;
+	}
 
-	std::map< std::string, bool >::iterator found = m_filters.find(filter);
-	if (found != m_filters.end())
+	for (const log_filter_cache_entry_t& cached : t_filterCache)
 	{
-		return found->second;
+		if (cached.pointer == filter && cached.name == filter)
+		{
+			return cached.isShown;
+		}
+	}
+
+	bool isShown = true;
+	{
+		std::scoped_lock lock(m_filterLock);
+
+		std::map< std::string, bool >::iterator found = m_filters.find(filter);
+		if (found != m_filters.end())
+		{
+			isShown = found->second;
+		}
+		else
+		{
+			m_filters[filter] = m_listMode;
+			isShown = m_listMode;
+		}
+	}
+
+	if (t_filterCache.size() < LOG_FILTER_CACHE_SIZE)
+	{
+		t_filterCache.push_back({ filter, filter, isShown });
 	}
 	else
 	{
-		m_filters[filter] = m_listMode;
-		return m_listMode;
+		t_filterCache[t_filterCacheNext] = { filter, filter, isShown };
+		t_filterCacheNext = (t_filterCacheNext + 1) % LOG_FILTER_CACHE_SIZE;
 	}
+	return isShown;
 }
@@ -1,19 +1,30 @@
 #pragma once
 #include "Engine/Async/AsyncQueue.hpp"
 #include "Engine/Semaphore/Semaphore.hpp"
-#include "Engine/Async/AsyncRingBuffer.hpp"
 #include "Engine/Callstack/Callstack.hpp"
 
+#include <atomic>
 #include <functional>
 #include <thread>
 #include <mutex>
 #include <map>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <type_traits>
 
-#define LOG_MESSAGES_PER_THREAD_TEST 1024
+// log_thread_test's default, per thread;
+#define LOG_MESSAGES_PER_THREAD_TEST 100000
+
+constexpr uint LOG_DEFAULT_MEMORY_MB = 8;				// Every thread's staging buffer together;
+constexpr uint LOG_THREAD_BUFFER_KB = 256;				// One thread's; with the default 32 threads can log at once;
+constexpr uint LOG_MAX_MESSAGE_SIZE = 4096;				// Longer messages are cut, see LOG_TRUNCATED_SUFFIX;
+constexpr uint LOG_WRITE_BLOCK_SIZE = 256 * 1024;		// The log thread writes the file in blocks of up to this;
+constexpr uint LOG_THREAD_WAKE_MS = 10;					// Longest a message waits before the log thread looks;
 
-class AsyncRingBuffer;
 class reporter_node_t;
 struct profiler_node_t;
+struct log_thread_buffer_t;
 
 struct log_message_t
 {
@@ -28,7 +39,37 @@ struct log_message_t
 };
 using LogHookCallbackFunction = void(*)(log_message_t* logt);
 
+// What a Logf does when its thread's buffer is full;
+enum eLogOverflowPolicy : int
+{
+	LOG_OVERFLOW_DROP = 0,		// Counted and thrown away, the log notes how many; never stalls the caller;
+	LOG_OVERFLOW_BLOCK,			// Waits for the log thread to make room; a Logf from a hook, on the log thread, drops instead;
+};
+
+// What the log thread writes to the file;
+enum eLogFileFormat : int
+{
+	LOG_FILE_TEXT = 0,			// A line per message, LOG_STRUCTURED messages formatted by the log thread;
+	LOG_FILE_BINARY,			// LOG_STRUCTURED messages stay raw, see LogBinary.hpp; log_decode makes the text;
+};
+
+struct log_stats_t
+{
+	uint64_t m_messageCount = 0;		// Made it into a buffer;
+	uint64_t m_dropCount = 0;			// Full buffer, or the thread couldn't get one within the memory budget;
+	uint64_t m_blockCount = 0;			// Times a Logf had to wait, LOG_OVERFLOW_BLOCK only;
+	uint64_t m_bytesWritten = 0;
+	uint64_t m_fileWriteCount = 0;
+	uint m_threadBufferCount = 0;
+	size_t m_memoryUsed = 0;
+};
+
 
+// -----------------------------------------------------------------------
+// Every thread that logs formats into its own staging buffer, a single producer single consumer ring,
+// so Logf takes no lock; the log thread drains all of them, puts the messages back in time order and
+// writes the file a block at a time;
+// -----------------------------------------------------------------------
 class LogSystem
 {
 
@@ -37,10 +78,10 @@ public:
 	std::thread m_thread;
 	std::string m_filename;
 
-	AsyncRingBuffer m_asyncRingBuffer;
 	Semaphore m_signal;
 
-	inline void WaitForWork() { m_signal.Acquire(); }
+	// Wakes up on its own every LOG_THREAD_WAKE_MS, a Logf only signals when its buffer is filling up;
+	inline void WaitForWork() { m_signal.AcquireFor(LOG_THREAD_WAKE_MS); }
 	inline void SignalWork() { m_signal.Release(1); }
 
 	inline bool IsRunning() { return m_isRunning; }
@@ -51,9 +92,25 @@ public:
 
 public:
 
-	bool m_isRunning = true;
+	std::atomic<bool> m_isRunning = true;
 	std::mutex cdHookLock;
 
+	// Staging Buffers
+	// Handed out on a thread's first message and taken back when it exits; the lock is only for that;
+	std::vector<log_thread_buffer_t*> m_threadBuffers;
+	std::mutex m_threadBufferLock;
+	size_t m_memoryBudget = (size_t)LOG_DEFAULT_MEMORY_MB * 1024 * 1024;
+	size_t m_memoryUsed = 0;
+	std::atomic<int> m_overflowPolicy = LOG_OVERFLOW_DROP;
+	eLogFileFormat m_fileFormat = LOG_FILE_TEXT;
+
+	// Messages from threads that couldn't get a buffer;
+	std::atomic<uint64_t> m_unbufferedDropCount = 0;
+
+	// Log thread only, read by LogGetStats;
+	std::atomic<uint64_t> m_bytesWritten = 0;
+	std::atomic<uint64_t> m_fileWriteCount = 0;
+
 	// Filtering
 	void LogEnableAll();					// All messages log;
 	void LogDisableAll();					// Not messages log;
@@ -85,13 +142,16 @@ public:
 };
 
 extern LogSystem* g_theLogSystem;
-extern bool g_theLogSystemFlushRequested;
+extern std::atomic<bool> g_theLogSystemFlushRequested;
 
 
 
-void LogSystemInit(const char* logFile);
+void LogSystemInit(const char* logFile, uint memoryMB = LOG_DEFAULT_MEMORY_MB, eLogFileFormat fileFormat = LOG_FILE_TEXT);
 void LogSystemShutdown(); // A final flush of the log file and properly close down;
 
+void LogSetOverflowPolicy(eLogOverflowPolicy policy);
+log_stats_t LogGetStats();
+
 // Commands expose;
 // Log
 // LogEnableAll
@@ -99,7 +159,9 @@ void LogSystemShutdown(); // A final flush of the log file and properly close do
 // LogEnable
 // LogDisable
 // LogFlushTest
-// LogThreadTest
+// LogThreadTest, a throughput benchmark
+// LogStats
+// LogDecode, a binary log to text
 // LogHookDevConsole
 
 // Logs a message with the given filter;
@@ -114,7 +176,146 @@ void LogReport(std::vector<profiler_node_t*> profiler_node, int i = 1);
 // Confirms all messages have been processed (committed to disk)
 void LogFlush();
 
+// -----------------------------------------------------------------------
+// Structured Logging
+// LOG_STRUCTURED copies the arguments' bytes into the thread's buffer instead of formatting them; the log
+// thread formats them for a text log and for the hooks, a binary log keeps them as they are;
+// The format is registered once per call site and kept by pointer, so it has to be a literal;
+// Takes integers, enums, bools, floats, pointers, C strings and std::strings, strings are cut at LOG_MAX_MESSAGE_SIZE;
+// -----------------------------------------------------------------------
+#define LOG_STRUCTURED(filter, format, ...) \
+	do { static const uint s_logFormatId = LogRegisterFormat(format); LogStructured(filter, s_logFormatId, ##__VA_ARGS__); } while(0)
+
+enum eLogArgType : uint8_t
+{
+	LOG_ARG_INT32 = 0,			// 4 bytes, also smaller integers, enums and bools;
+	LOG_ARG_UINT32,
+	LOG_ARG_INT64,				// 8 bytes;
+	LOG_ARG_UINT64,
+	LOG_ARG_DOUBLE,				// 8 bytes, floats too;
+	LOG_ARG_POINTER,			// 8 bytes;
+	LOG_ARG_STRING,				// 2 byte length, then the characters, no terminator;
+
+	LOG_ARG_TYPE_COUNT
+};
+
+uint LogRegisterFormat(const char* format);
+const char* LogGetFormat(uint formatId);
 
+// Room for argumentSize bytes in this thread's buffer, nullptr if the message was dropped;
+// Nothing is visible to the log thread until LogCommitStructured;
+uint8_t* LogBeginStructured(const char* filter, uint formatId, size_t argumentSize);
+void LogCommitStructured();
 
+// -----------------------------------------------------------------------
+template<typename T, bool IS_ENUM = std::is_enum_v<T>>
+struct log_integer_t { using type = T; };
 
+template<typename T>
+struct log_integer_t<T, true> { using type = std::underlying_type_t<T>; };
 
+inline size_t LogStringArgumentLength(const char* string)
+{
+	size_t length = string ? strlen(string) : 6;
+	return length < LOG_MAX_MESSAGE_SIZE ? length : LOG_MAX_MESSAGE_SIZE;
+}
+
+// -----------------------------------------------------------------------
+template<typename T>
+inline size_t LogArgumentSize(const T& value)
+{
+	using type = std::decay_t<T>;
+	if constexpr(std::is_same_v<type, char*> || std::is_same_v<type, const char*>)
+	{
+		return 1 + sizeof(uint16_t) + LogStringArgumentLength(value);
+	}
+	else if constexpr(std::is_same_v<type, std::string>)
+	{
+		return 1 + sizeof(uint16_t) + (value.size() < LOG_MAX_MESSAGE_SIZE ? value.size() : LOG_MAX_MESSAGE_SIZE);
+	}
+	else if constexpr(std::is_floating_point_v<type> || std::is_pointer_v<type>)
+	{
+		return 1 + 8;
+	}
+	else
+	{
+		static_assert(std::is_integral_v<type> || std::is_enum_v<type>, "LOG_STRUCTURED takes integers, enums, floats, pointers and strings");
+		return 1 + (sizeof(type) > 4 ? 8 : 4);
+	}
+}
+
+// -----------------------------------------------------------------------
+inline uint8_t* LogWriteStringArgument(uint8_t* cursor, const char* string, size_t length)
+{
+	uint16_t length16 = (uint16_t)length;
+	*cursor = LOG_ARG_STRING;
+	memcpy(cursor + 1, &length16, sizeof(uint16_t));
+	memcpy(cursor + 1 + sizeof(uint16_t), string, length);
+	return cursor + 1 + sizeof(uint16_t) + length;
+}
+
+// -----------------------------------------------------------------------
+template<typename T>
+inline uint8_t* LogWriteArgument(uint8_t* cursor, const T& value)
+{
+	using type = std::decay_t<T>;
+	if constexpr(std::is_same_v<type, char*> || std::is_same_v<type, const char*>)
+	{
+		const char* string = value ? value : "(null)";
+		return LogWriteStringArgument(cursor, string, LogStringArgumentLength(string));
+	}
+	else if constexpr(std::is_same_v<type, std::string>)
+	{
+		return LogWriteStringArgument(cursor, value.data(), value.size() < LOG_MAX_MESSAGE_SIZE ? value.size() : LOG_MAX_MESSAGE_SIZE);
+	}
+	else if constexpr(std::is_floating_point_v<type>)
+	{
+		double real = (double)value;
+		*cursor = LOG_ARG_DOUBLE;
+		memcpy(cursor + 1, &real, 8);
+		return cursor + 1 + 8;
+	}
+	else if constexpr(std::is_pointer_v<type>)
+	{
+		uint64_t address = (uint64_t)(uintptr_t)value;
+		*cursor = LOG_ARG_POINTER;
+		memcpy(cursor + 1, &address, 8);
+		return cursor + 1 + 8;
+	}
+	else if constexpr(sizeof(type) > 4)
+	{
+		uint64_t bits = (uint64_t)value;
+		*cursor = std::is_signed_v<typename log_integer_t<type>::type> ? LOG_ARG_INT64 : LOG_ARG_UINT64;
+		memcpy(cursor + 1, &bits, 8);
+		return cursor + 1 + 8;
+	}
+	else
+	{
+		uint32_t bits = (uint32_t)value;
+		*cursor = std::is_signed_v<typename log_integer_t<type>::type> ? LOG_ARG_INT32 : LOG_ARG_UINT32;
+		memcpy(cursor + 1, &bits, 4);
+		return cursor + 1 + 4;
+	}
+}
+
+// -----------------------------------------------------------------------
+// Use LOG_STRUCTURED; the filter is checked before any argument is looked at;
+// -----------------------------------------------------------------------
+template<typename... ARGS>
+inline void LogStructured(const char* filter, uint formatId, const ARGS&... args)
+{
+	if(!g_theLogSystem->IsFiltered(filter))
+	{
+		return;
+	}
+
+	size_t argumentSize = (size_t(0) + ... + LogArgumentSize(args));
+	uint8_t* cursor = LogBeginStructured(filter, formatId, argumentSize);
+	if(!cursor)
+	{
+		return;
+	}
+
+	((cursor = LogWriteArgument(cursor, args)), ...);
+	LogCommitStructured();
+}
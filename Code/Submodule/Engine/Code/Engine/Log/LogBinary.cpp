@@ -0,0 +1,418 @@
+#include "Engine/Log/LogBinary.hpp"
+#include "Engine/Log/Log.hpp"
+#include "Engine/Core/MemoryMappedFile.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+// -----------------------------------------------------------------------
+void LogAppendVarint(std::vector<char>& out_, uint64_t value_)
+{
+	while(value_ >= 0x80)
+	{
+		out_.push_back((char)((value_ & 0x7F) | 0x80));
+		value_ >>= 7;
+	}
+	out_.push_back((char)value_);
+}
+
+// -----------------------------------------------------------------------
+void LogAppendString(std::vector<char>& out_, const char* string_, size_t length_)
+{
+	LogAppendVarint(out_, length_);
+	out_.insert(out_.end(), string_, string_ + length_);
+}
+
+// -----------------------------------------------------------------------
+// Formatting
+// -----------------------------------------------------------------------
+struct log_argument_t
+{
+	uint8_t m_type = LOG_ARG_TYPE_COUNT;
+	int64_t m_integer = 0;			// Sign extended for LOG_ARG_INT32;
+	double m_real = 0.0;
+	std::string m_string;
+};
+
+// -----------------------------------------------------------------------
+static bool ReadArgument(const uint8_t*& cursor_, const uint8_t* end_, log_argument_t& out_)
+{
+	if(cursor_ >= end_)
+	{
+		return false;
+	}
+
+	out_.m_type = *cursor_++;
+	switch(out_.m_type)
+	{
+		case LOG_ARG_INT32:
+		case LOG_ARG_UINT32:
+		{
+			if(end_ - cursor_ < 4)
+			{
+				return false;
+			}
+
+			uint32_t bits;
+			memcpy(&bits, cursor_, 4);
+			cursor_ += 4;
+			out_.m_integer = out_.m_type == LOG_ARG_INT32 ? (int64_t)(int32_t)bits : (int64_t)bits;
+			out_.m_real = (double)out_.m_integer;
+			return true;
+		}
+		case LOG_ARG_INT64:
+		case LOG_ARG_UINT64:
+		case LOG_ARG_POINTER:
+		{
+			if(end_ - cursor_ < 8)
+			{
+				return false;
+			}
+
+			memcpy(&out_.m_integer, cursor_, 8);
+			cursor_ += 8;
+			out_.m_real = out_.m_type == LOG_ARG_UINT64 ? (double)(uint64_t)out_.m_integer : (double)out_.m_integer;
+			return true;
+		}
+		case LOG_ARG_DOUBLE:
+		{
+			if(end_ - cursor_ < 8)
+			{
+				return false;
+			}
+
+			memcpy(&out_.m_real, cursor_, 8);
+			cursor_ += 8;
+			out_.m_integer = (int64_t)out_.m_real;
+			return true;
+		}
+		case LOG_ARG_STRING:
+		{
+			uint16_t length;
+			if(end_ - cursor_ < 2)
+			{
+				return false;
+			}
+
+			memcpy(&length, cursor_, 2);
+			cursor_ += 2;
+			if(end_ - cursor_ < length)
+			{
+				return false;
+			}
+
+			out_.m_string.assign((const char*)cursor_, length);
+			cursor_ += length;
+			return true;
+		}
+		default:
+		{
+			return false;
+		}
+	}
+}
+
+// -----------------------------------------------------------------------
+template<typename T>
+static void AppendFormatted(std::string& out_, const char* spec_, T value_)
+{
+	char stackBuffer[128];
+	int length = snprintf(stackBuffer, sizeof(stackBuffer), spec_, value_);
+	if(length < 0)
+	{
+		return;
+	}
+
+	if((size_t)length < sizeof(stackBuffer))
+	{
+		out_.append(stackBuffer, (size_t)length);
+		return;
+	}
+
+	size_t start = out_.size();
+	out_.resize(start + (size_t)length + 1);
+	snprintf(&out_[start], (size_t)length + 1, spec_, value_);
+	out_.resize(start + (size_t)length);
+}
+
+// -----------------------------------------------------------------------
+void LogFormatArguments(const char* format_, const uint8_t* arguments_, size_t argumentSize_, std::string& out_)
+{
+	const uint8_t* cursor = arguments_;
+	const uint8_t* end = arguments_ + argumentSize_;
+	log_argument_t argument;
+	std::string spec;
+
+	const char* character = format_;
+	while(*character)
+	{
+		if(*character != '%')
+		{
+			const char* literalEnd = strchr(character, '%');
+			size_t literalLength = literalEnd ? (size_t)(literalEnd - character) : strlen(character);
+			out_.append(character, literalLength);
+			character += literalLength;
+			continue;
+		}
+
+		const char* specStart = character++;
+		if(*character == '%')
+		{
+			out_ += '%';
+			++character;
+			continue;
+		}
+
+		// Flags, width and precision are kept, a * takes an argument and becomes its digits;
+		spec = "%";
+		while(*character && strchr("-+ #0", *character))
+		{
+			spec += *character++;
+		}
+
+		for(int part = 0; part < 2; ++part)
+		{
+			if(part == 1)
+			{
+				if(*character != '.')
+				{
+					break;
+				}
+				spec += *character++;
+			}
+
+			if(*character == '*')
+			{
+				++character;
+				if(ReadArgument(cursor, end, argument))
+				{
+					spec += std::to_string((int)argument.m_integer);
+				}
+			}
+			while(*character >= '0' && *character <= '9')
+			{
+				spec += *character++;
+			}
+		}
+
+		// Length modifiers are replaced by the argument's own;
+		while(*character && strchr("hljztLIq", *character))
+		{
+			if(*character == 'I' && ((character[1] == '6' && character[2] == '4') || (character[1] == '3' && character[2] == '2')))
+			{
+				character += 2;
+			}
+			++character;
+		}
+
+		char conversion = *character;
+		if(!conversion)
+		{
+			out_.append(specStart);
+			break;
+		}
+		++character;
+
+		if(conversion == 'n')
+		{
+			ReadArgument(cursor, end, argument);
+			continue;
+		}
+		if(!strchr("diuoxXcfFeEgGaAsp", conversion))
+		{
+			out_.append(specStart, (size_t)(character - specStart));
+			continue;
+		}
+
+		if(!ReadArgument(cursor, end, argument))
+		{
+			out_.append("(missing)");
+			continue;
+		}
+
+		// Like printf, a 32 bit argument given to the other signedness keeps its 32 bits;
+		bool is32Bit = argument.m_type == LOG_ARG_INT32 || argument.m_type == LOG_ARG_UINT32;
+		switch(conversion)
+		{
+			case 'd':
+			case 'i':
+			{
+				spec += "lld";
+				AppendFormatted(out_, spec.c_str(), is32Bit ? (long long)(int32_t)argument.m_integer : (long long)argument.m_integer);
+				break;
+			}
+			case 'u':
+			case 'o':
+			case 'x':
+			case 'X':
+			{
+				spec += "ll";
+				spec += conversion;
+				AppendFormatted(out_, spec.c_str(), is32Bit ? (unsigned long long)(uint32_t)argument.m_integer : (unsigned long long)argument.m_integer);
+				break;
+			}
+			case 'c':
+			{
+				spec += 'c';
+				AppendFormatted(out_, spec.c_str(), (int)argument.m_integer);
+				break;
+			}
+			case 'p':
+			{
+				spec += 'p';
+				AppendFormatted(out_, spec.c_str(), (void*)(uintptr_t)argument.m_integer);
+				break;
+			}
+			case 's':
+			{
+				spec += 's';
+				AppendFormatted(out_, spec.c_str(), argument.m_type == LOG_ARG_STRING ? argument.m_string.c_str() : "(not a string)");
+				break;
+			}
+			default:
+			{
+				spec += conversion;
+				AppendFormatted(out_, spec.c_str(), argument.m_real);
+				break;
+			}
+		}
+	}
+}
+
+// -----------------------------------------------------------------------
+// Decoding
+// -----------------------------------------------------------------------
+static bool ReadVarint(const uint8_t*& cursor_, const uint8_t* end_, uint64_t& out_)
+{
+	out_ = 0;
+	for(int shift = 0; shift < 64 && cursor_ < end_; shift += 7)
+	{
+		uint8_t byte = *cursor_++;
+		out_ |= (uint64_t)(byte & 0x7F) << shift;
+		if(!(byte & 0x80))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// -----------------------------------------------------------------------
+static bool ReadString(const uint8_t*& cursor_, const uint8_t* end_, std::string& out_)
+{
+	uint64_t length;
+	if(!ReadVarint(cursor_, end_, length) || (uint64_t)(end_ - cursor_) < length)
+	{
+		return false;
+	}
+
+	out_.assign((const char*)cursor_, (size_t)length);
+	cursor_ += length;
+	return true;
+}
+
+// -----------------------------------------------------------------------
+static void WriteTextLine(FILE* file_, const std::string& filter_, const char* text_, size_t textLength_)
+{
+	if(!filter_.empty())
+	{
+		fwrite(filter_.data(), 1, filter_.size(), file_);
+		fwrite(": ", 1, 2, file_);
+	}
+	fwrite(text_, 1, textLength_, file_);
+	fwrite("\n", 1, 1, file_);
+}
+
+// -----------------------------------------------------------------------
+bool LogDecodeBinaryFile(const char* binaryPath_, const char* textPath_)
+{
+	MemoryMappedFile binaryFile;
+	if(!binaryFile.Open(binaryPath_) || binaryFile.GetSize() < sizeof(LogStreamHeader))
+	{
+		return false;
+	}
+
+	LogStreamHeader header;
+	memcpy(&header, binaryFile.GetData(), sizeof(LogStreamHeader));
+	if(header.m_magic != LOG_STREAM_MAGIC || header.m_version != LOG_STREAM_VERSION || header.m_headerSize > binaryFile.GetSize())
+	{
+		return false;
+	}
+
+	FILE* textFile = fopen(textPath_, "wb");
+	if(!textFile)
+	{
+		return false;
+	}
+
+	std::vector<std::string> filters;
+	std::vector<std::string> formats;
+	std::string text;
+	std::string emptyFilter;
+
+	const uint8_t* cursor = binaryFile.GetData() + header.m_headerSize;
+	const uint8_t* end = binaryFile.GetData() + binaryFile.GetSize();
+	bool isComplete = false;
+	bool isGood = true;
+
+	while(isGood && cursor < end)
+	{
+		uint8_t recordType = *cursor++;
+		uint64_t index = 0;
+		uint64_t timeDelta = 0;
+
+		switch(recordType)
+		{
+			case LOG_STREAM_RECORD_END:
+			{
+				isComplete = true;
+				cursor = end;
+				break;
+			}
+			case LOG_STREAM_RECORD_FILTER:
+			case LOG_STREAM_RECORD_FORMAT:
+			{
+				std::vector<std::string>& names = recordType == LOG_STREAM_RECORD_FILTER ? filters : formats;
+				isGood = ReadVarint(cursor, end, index) && index < (1 << 24);
+				if(isGood)
+				{
+					names.resize(names.size() > index ? names.size() : (size_t)index + 1);
+					isGood = ReadString(cursor, end, names[(size_t)index]);
+				}
+				break;
+			}
+			case LOG_STREAM_RECORD_MESSAGE:
+			{
+				uint64_t formatId = 0;
+				uint64_t argumentSize = 0;
+				isGood = ReadVarint(cursor, end, timeDelta) && ReadVarint(cursor, end, index) && ReadVarint(cursor, end, formatId)
+					&& ReadVarint(cursor, end, argumentSize) && (uint64_t)(end - cursor) >= argumentSize;
+				if(isGood)
+				{
+					text.clear();
+					LogFormatArguments(formatId < formats.size() ? formats[(size_t)formatId].c_str() : "(unknown format)", cursor, (size_t)argumentSize, text);
+					WriteTextLine(textFile, index < filters.size() ? filters[(size_t)index] : emptyFilter, text.data(), text.size());
+					cursor += argumentSize;
+				}
+				break;
+			}
+			case LOG_STREAM_RECORD_TEXT:
+			{
+				isGood = ReadVarint(cursor, end, timeDelta) && ReadVarint(cursor, end, index) && ReadString(cursor, end, text);
+				if(isGood)
+				{
+					WriteTextLine(textFile, index < filters.size() ? filters[(size_t)index] : emptyFilter, text.data(), text.size());
+				}
+				break;
+			}
+			default:
+			{
+				isGood = false;
+				break;
+			}
+		}
+	}
+
+	fclose(textFile);
+	return isGood && isComplete;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// -----------------------------------------------------------------------
+// Binary Log;
+// What the log thread writes with LOG_FILE_BINARY: LOG_STRUCTURED messages stay a format id and the raw
+// argument bytes, the format string is written once, the first time it is used; Logf messages are kept as text;
+// log_decode turns it back into the same text LOG_FILE_TEXT would have written;
+//
+// A header, then records one after the other, each a type byte and its fields, ended by LOG_STREAM_RECORD_END;
+// Integers are LEB128 varints, strings are a varint length and the bytes, no terminator;
+// Times are nanoseconds, zigzag encoded, from the record before, a late thread can be a little behind;
+// Arguments are as LOG_STRUCTURED wrote them, see eLogArgType, in the writing machine's byte order;
+//
+//   LOG_STREAM_RECORD_FILTER	filterIndex, filter
+//   LOG_STREAM_RECORD_FORMAT	formatId, format
+//   LOG_STREAM_RECORD_MESSAGE	timeDeltaNS, filterIndex, formatId, argumentSize, arguments
+//   LOG_STREAM_RECORD_TEXT		timeDeltaNS, filterIndex, text
+// -----------------------------------------------------------------------
+constexpr uint32_t LOG_STREAM_MAGIC = 0x42474F4C;		// "LOGB";
+constexpr uint16_t LOG_STREAM_VERSION = 1;
+
+struct LogStreamHeader
+{
+	uint32_t m_magic = LOG_STREAM_MAGIC;
+	uint16_t m_version = LOG_STREAM_VERSION;
+	uint16_t m_headerSize = sizeof(LogStreamHeader);
+};
+
+enum eLogStreamRecordType : uint8_t
+{
+	LOG_STREAM_RECORD_END = 0,
+	LOG_STREAM_RECORD_FILTER,
+	LOG_STREAM_RECORD_FORMAT,
+	LOG_STREAM_RECORD_MESSAGE,
+	LOG_STREAM_RECORD_TEXT,
+};
+
+void LogAppendVarint(std::vector<char>& out_, uint64_t value_);
+void LogAppendString(std::vector<char>& out_, const char* string_, size_t length_);
+inline uint64_t LogZigZagEncode(int64_t value_)		{ return ((uint64_t)value_ << 1) ^ (uint64_t)(value_ >> 63); }
+inline int64_t LogZigZagDecode(uint64_t value_)		{ return (int64_t)(value_ >> 1) ^ -(int64_t)(value_ & 1); }
+
+// printf over arguments written by LOG_STRUCTURED; each conversion takes the next argument and is redone with
+// the argument's real type, so a %d given a 64 bit value still prints right; missing ones print as (missing);
+void LogFormatArguments(const char* format_, const uint8_t* arguments_, size_t argumentSize_, std::string& out_);
+
+// Writes the text log a binary log stands for; false if it isn't one or it is cut short, what was read is still written;
+bool LogDecodeBinaryFile(const char* binaryPath_, const char* textPath_);
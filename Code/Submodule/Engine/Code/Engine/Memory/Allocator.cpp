@@ -1,3 +1,4 @@
 #include "Engine/Memory/Allocator.hpp"
 
-
+TrackedAllocator TrackedAllocator::s_instance;
+UntrackedAllocator UntrackedAllocator::s_instance;
@@ -0,0 +1,290 @@
+#include "Engine/Memory/ArenaAllocator.hpp"
+#include "Engine/Core/BenchmarkUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <string.h>
+#include <vector>
+
+// -----------------------------------------------------------------------
+ArenaAllocator::~ArenaAllocator()
+{
+	deinit();
+}
+
+// -----------------------------------------------------------------------
+bool ArenaAllocator::init(Allocator* base, size_t chunk_size)
+{
+	deinit();
+
+	m_base = base;
+	m_chunk_size = chunk_size;
+
+	return m_base != nullptr && m_chunk_size > 0;
+}
+
+// -----------------------------------------------------------------------
+void ArenaAllocator::deinit()
+{
+	free_chunks();
+
+	m_base = nullptr;
+	m_used_bytes = 0;
+	m_peak_bytes = 0;
+	m_allocation_count = 0;
+}
+
+// -----------------------------------------------------------------------
+void* ArenaAllocator::alloc(size_t size)
+{
+	return alloc_aligned(size, ARENA_DEFAULT_ALIGNMENT);
+}
+
+// -----------------------------------------------------------------------
+void ArenaAllocator::free(void* ptr)
+{
+	ptr;
+}
+
+// -----------------------------------------------------------------------
+void* ArenaAllocator::alloc_aligned(size_t size, size_t alignment)
+{
+	// Two allocations never share an address;
+	size = size > 0 ? size : 1;
+
+	uintptr_t mask = (uintptr_t)alignment - 1;
+	uintptr_t start = (m_cursor + mask) & ~mask;
+	if (m_cursor == 0 || start + size > m_end)
+	{
+		if (!allocate_chunk(size + alignment))
+		{
+			return nullptr;
+		}
+		start = (m_cursor + mask) & ~mask;
+	}
+
+	size_t used = m_used_bytes.load(std::memory_order_relaxed) + (size_t)(start + size - m_cursor);
+	m_cursor = start + size;
+
+	m_used_bytes.store(used, std::memory_order_relaxed);
+	if (used > m_peak_bytes.load(std::memory_order_relaxed))
+	{
+		m_peak_bytes.store(used, std::memory_order_relaxed);
+	}
+	m_allocation_count.store(m_allocation_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	return (void*)start;
+}
+
+// -----------------------------------------------------------------------
+void ArenaAllocator::reset()
+{
+	size_t peak = m_peak_bytes.load(std::memory_order_relaxed);
+	m_last_peak_bytes.store(peak, std::memory_order_relaxed);
+	if (peak > m_high_water_bytes.load(std::memory_order_relaxed))
+	{
+		m_high_water_bytes.store(peak, std::memory_order_relaxed);
+	}
+	m_used_bytes.store(0, std::memory_order_relaxed);
+	m_peak_bytes.store(0, std::memory_order_relaxed);
+	m_allocation_count.store(0, std::memory_order_relaxed);
+
+	if (m_chunk_count > 1)
+	{
+		// Next time one chunk holds all of it;
+		m_chunk_size = std::max(m_chunk_size, (size_t)m_capacity_bytes.load(std::memory_order_relaxed));
+		free_chunks();
+	}
+	else if (m_chunk_list != nullptr)
+	{
+		uintptr_t first = (uintptr_t)(m_chunk_list + 1);
+
+#if defined(_DEBUG)
+		// Anything still holding on to last frame's memory reads garbage instead of nearly right values;
+		memset((void*)first, 0xDD, (size_t)(m_cursor - first));
+#endif
+
+		m_cursor = first;
+	}
+}
+
+// -----------------------------------------------------------------------
+arena_stats_t ArenaAllocator::get_stats() const
+{
+	arena_stats_t stats;
+	stats.m_usedBytes = m_used_bytes.load(std::memory_order_relaxed);
+	stats.m_peakBytes = m_peak_bytes.load(std::memory_order_relaxed);
+	stats.m_lastPeakBytes = m_last_peak_bytes.load(std::memory_order_relaxed);
+	stats.m_highWaterBytes = std::max(m_high_water_bytes.load(std::memory_order_relaxed), stats.m_peakBytes);
+	stats.m_capacityBytes = m_capacity_bytes.load(std::memory_order_relaxed);
+	stats.m_allocationCount = m_allocation_count.load(std::memory_order_relaxed);
+	stats.m_chunkAllocationCount = m_chunk_allocation_count.load(std::memory_order_relaxed);
+
+	return stats;
+}
+
+// -----------------------------------------------------------------------
+bool ArenaAllocator::allocate_chunk(size_t min_size)
+{
+	if (m_base == nullptr)
+	{
+		return false;
+	}
+
+	size_t size = std::max(m_chunk_size, min_size);
+
+	arena_chunk_t* chunk;
+	{
+		MEM_TAG_SCOPE(MEM_TAG_ARENA);
+		chunk = (arena_chunk_t*)m_base->alloc(sizeof(arena_chunk_t) + size);
+	}
+	if (chunk == nullptr)
+	{
+		return false;
+	}
+
+	chunk->next = m_chunk_list;
+	chunk->size = size;
+	m_chunk_list = chunk;
+	++m_chunk_count;
+
+	m_cursor = (uintptr_t)(chunk + 1);
+	m_end = m_cursor + size;
+
+	m_capacity_bytes.store(m_capacity_bytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+	m_chunk_allocation_count.store(m_chunk_allocation_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	return true;
+}
+
+// -----------------------------------------------------------------------
+void ArenaAllocator::free_chunks()
+{
+	while (m_chunk_list != nullptr)
+	{
+		arena_chunk_t* chunk = m_chunk_list;
+		m_chunk_list = m_chunk_list->next;
+		m_base->free(chunk);
+	}
+
+	m_chunk_count = 0;
+	m_cursor = 0;
+	m_end = 0;
+	m_capacity_bytes = 0;
+}
+
+// -----------------------------------------------------------------------
+// Thread Arenas
+// -----------------------------------------------------------------------
+static const char* s_arenaLifetimeNames[ARENA_LIFETIME_COUNT] = { "Frame", "Phase" };
+static const size_t s_arenaChunkSizes[ARENA_LIFETIME_COUNT] = { 256 * 1024, 64 * 1024 };
+
+struct arena_thread_t;
+
+struct arena_registry_t
+{
+	std::mutex m_lock;
+	std::vector<arena_thread_t*> m_threads;
+};
+
+// Function-local, so it is there for a thread that starts before main;
+static arena_registry_t& GetArenaRegistry()
+{
+	static arena_registry_t s_registry;
+	return s_registry;
+}
+
+struct arena_thread_t
+{
+	arena_thread_t()
+	{
+		for (int lifetime = 0; lifetime < ARENA_LIFETIME_COUNT; ++lifetime)
+		{
+			m_arenas[lifetime].init(&TrackedAllocator::s_instance, s_arenaChunkSizes[lifetime]);
+		}
+
+		arena_registry_t& registry = GetArenaRegistry();
+		std::scoped_lock lock(registry.m_lock);
+		registry.m_threads.push_back(this);
+	}
+
+	~arena_thread_t()
+	{
+		arena_registry_t& registry = GetArenaRegistry();
+		std::scoped_lock lock(registry.m_lock);
+		registry.m_threads.erase(std::find(registry.m_threads.begin(), registry.m_threads.end(), this));
+
+		// Chunks are given back by the arenas' destructors;
+	}
+
+	ArenaAllocator m_arenas[ARENA_LIFETIME_COUNT];
+};
+
+// -----------------------------------------------------------------------
+ArenaAllocator& ArenaGet(eArenaLifetime lifetime_)
+{
+	static thread_local arena_thread_t t_arenaThread;
+	return t_arenaThread.m_arenas[lifetime_];
+}
+
+// -----------------------------------------------------------------------
+void ArenaReset(eArenaLifetime lifetime_)
+{
+	ArenaGet(lifetime_).reset();
+}
+
+// -----------------------------------------------------------------------
+arena_stats_t ArenaGetStats(eArenaLifetime lifetime_)
+{
+	arena_stats_t total;
+
+	arena_registry_t& registry = GetArenaRegistry();
+	std::scoped_lock lock(registry.m_lock);
+	for (arena_thread_t* arenaThread : registry.m_threads)
+	{
+		arena_stats_t stats = arenaThread->m_arenas[lifetime_].get_stats();
+		total.m_usedBytes += stats.m_usedBytes;
+		total.m_peakBytes += stats.m_peakBytes;
+		total.m_lastPeakBytes += stats.m_lastPeakBytes;
+		total.m_highWaterBytes += stats.m_highWaterBytes;
+		total.m_capacityBytes += stats.m_capacityBytes;
+		total.m_allocationCount += stats.m_allocationCount;
+		total.m_chunkAllocationCount += stats.m_chunkAllocationCount;
+	}
+
+	return total;
+}
+
+// -----------------------------------------------------------------------
+// Commands
+// arena_stats;
+static bool ArenaStatsCommand(EventArgs& args)
+{
+	args;
+
+	PrintLine(Stringf("  %-6s %12s %12s %12s %12s %12s %8s %7s", "Arena", "Used", "Peak", "Last Peak", "High Water", "Capacity", "Allocs", "Chunks"));
+	for (int lifetime = 0; lifetime < ARENA_LIFETIME_COUNT; ++lifetime)
+	{
+		arena_stats_t stats = ArenaGetStats((eArenaLifetime)lifetime);
+		PrintLine(Stringf("  %-6s %12s %12s %12s %12s %12s %8zu %7zu", s_arenaLifetimeNames[lifetime],
+			GetSizeString(stats.m_usedBytes).c_str(),
+			GetSizeString(stats.m_peakBytes).c_str(),
+			GetSizeString(stats.m_lastPeakBytes).c_str(),
+			GetSizeString(stats.m_highWaterBytes).c_str(),
+			GetSizeString(stats.m_capacityBytes).c_str(),
+			stats.m_allocationCount,
+			stats.m_chunkAllocationCount));
+	}
+
+	return true;
+}
+
+// -----------------------------------------------------------------------
+void ArenaSystemInit()
+{
+	g_theEventSystem->SubscriptionEventCallbackFunction("arena_stats", ArenaStatsCommand);
+}
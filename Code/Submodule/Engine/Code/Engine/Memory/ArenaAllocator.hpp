@@ -0,0 +1,107 @@
+#pragma once
+#include "Engine/Memory/Allocator.hpp"
+
+#include <atomic>
+
+typedef unsigned int uint;
+
+constexpr size_t ARENA_DEFAULT_ALIGNMENT = 16;
+
+struct arena_chunk_t
+{
+	arena_chunk_t* next;
+	size_t size;				// Bytes after the header;
+};
+
+struct arena_stats_t
+{
+	size_t m_usedBytes = 0;				// Since the last reset;
+	size_t m_peakBytes = 0;				// Most used since the last reset, the frame so far;
+	size_t m_lastPeakBytes = 0;			// Most used before the last reset, the last whole frame;
+	size_t m_highWaterBytes = 0;		// Most used between any two resets;
+	size_t m_capacityBytes = 0;			// Held from the base allocator;
+	size_t m_allocationCount = 0;		// Since the last reset;
+	size_t m_chunkAllocationCount = 0;	// Times it went to the base allocator, ever;
+};
+
+// -----------------------------------------------------------------------
+// Arena Allocator;
+// Hands out memory by moving a cursor through chunks from its base allocator; free does nothing,
+// everything is given back at once by reset, which keeps the chunks for the next use;
+// If it had to take more than one chunk, reset gives them back and the next chunk is big enough for all of it,
+// so after a frame or two a frame's worth fits in one chunk;
+// One thread at a time, see ArenaGet for one per thread;
+// -----------------------------------------------------------------------
+class ArenaAllocator : public Allocator
+{
+
+public:
+
+	ArenaAllocator() = default;
+	~ArenaAllocator();
+
+	// Chunks come from base, each at least chunk_size;
+	bool init(Allocator* base, size_t chunk_size);
+	void deinit();
+
+	// interface implementation
+	virtual void* alloc(size_t size) final; // ARENA_DEFAULT_ALIGNMENT
+	virtual void free(void* ptr) final; // nothing, the memory lasts until reset
+
+	// unique to an arena allocator
+	void* alloc_aligned(size_t size, size_t alignment);
+
+	// Everything it handed out is invalid after this;
+	void reset();
+
+	arena_stats_t get_stats() const;
+
+private:
+
+	// Makes a new chunk with room for at least min_size the current one;
+	bool allocate_chunk(size_t min_size);
+	void free_chunks();
+
+private:
+
+	Allocator* m_base = nullptr;
+
+	arena_chunk_t* m_chunk_list = nullptr;
+	uint m_chunk_count = 0;
+	size_t m_chunk_size = 0;
+
+	uintptr_t m_cursor = 0;
+	uintptr_t m_end = 0;
+
+	// Only the owning thread writes these, the others can read them for arena_stats;
+	std::atomic<size_t> m_used_bytes = 0;
+	std::atomic<size_t> m_peak_bytes = 0;
+	std::atomic<size_t> m_last_peak_bytes = 0;
+	std::atomic<size_t> m_high_water_bytes = 0;
+	std::atomic<size_t> m_capacity_bytes = 0;
+	std::atomic<size_t> m_allocation_count = 0;
+	std::atomic<size_t> m_chunk_allocation_count = 0;
+};
+
+// -----------------------------------------------------------------------
+// Thread Arenas;
+// Every thread has a frame and a phase arena, made the first time it asks for one, given back when it exits;
+// Each thread resets its own: the main thread's frame arena at Game::EndFrame, its phase arena at
+// Server::SwitchPhases; a Job worker's frame arena lasts one Job;
+// -----------------------------------------------------------------------
+enum eArenaLifetime : int
+{
+	ARENA_FRAME = 0,
+	ARENA_PHASE,
+
+	ARENA_LIFETIME_COUNT
+};
+
+// The calling thread's;
+ArenaAllocator& ArenaGet(eArenaLifetime lifetime_);
+void ArenaReset(eArenaLifetime lifetime_);
+
+// Summed over every thread's arena of that lifetime;
+arena_stats_t ArenaGetStats(eArenaLifetime lifetime_);
+
+void ArenaSystemInit();
@@ -1,56 +1,162 @@
 
 
 #include "Engine/Memory/BlockAllocator.hpp"
-#include "Engine/Log/Log.hpp"
 
-#include <shared_mutex>
+#include <new>
+#include <string.h>
 
 
 
-BlockAllocator* g_theBlockAllocatorOnlyForProfilerNodeT = nullptr;
-static uint numberofblocks = 0;
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+// -----------------------------------------------------------------------
+// Shared list head;
+// Both halves are swapped at once, cmpxchg16b on x64 and cmpxchg8b on Win32; a load may tear, which only makes the
+// compare fail, and the pointer half is still one that was on the list, so its memory is readable;
+// -----------------------------------------------------------------------
+static_assert(sizeof(block_batch_head_t) == 2 * sizeof(void*), "block_batch_head_t has to be swappable in one go");
+
+static inline block_batch_head_t LoadBatchHead(const block_batch_head_t* head_)
+{
+	block_batch_head_t head;
+	head.tag = ((const volatile block_batch_head_t*)head_)->tag;
+	head.batch = ((const volatile block_batch_head_t*)head_)->batch;
+	return head;
+}
+
+// On failure expected_ gets what the head was;
+static inline bool CompareExchangeBatchHead(block_batch_head_t* head_, block_batch_head_t* expected_, const block_batch_head_t& desired_)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	return _InterlockedCompareExchange128((volatile long long*)head_, (long long)desired_.tag, (long long)desired_.batch, (long long*)expected_) != 0;
+#elif defined(_MSC_VER)
+	long long expected = (long long)(uint32_t)(uintptr_t)expected_->batch | ((long long)expected_->tag << 32);
+	long long desired = (long long)(uint32_t)(uintptr_t)desired_.batch | ((long long)desired_.tag << 32);
+	long long previous = _InterlockedCompareExchange64((volatile long long*)head_, desired, expected);
+	expected_->batch = (block_batch_t*)(uintptr_t)(uint32_t)previous;
+	expected_->tag = (uintptr_t)((unsigned long long)previous >> 32);
+	return previous == expected;
+#elif defined(__x86_64__)
+	// Needs -mcx16;
+	typedef unsigned __int128 head_bits_t;
+	head_bits_t expected;
+	head_bits_t desired;
+	memcpy(&expected, expected_, sizeof(expected));
+	memcpy(&desired, &desired_, sizeof(desired));
+	head_bits_t previous = __sync_val_compare_and_swap((head_bits_t*)head_, expected, desired);
+	memcpy(expected_, &previous, sizeof(previous));
+	return previous == expected;
+#else
+	typedef uint64_t head_bits_t;
+	head_bits_t expected;
+	head_bits_t desired;
+	memcpy(&expected, expected_, sizeof(expected));
+	memcpy(&desired, &desired_, sizeof(desired));
+	head_bits_t previous = __sync_val_compare_and_swap((head_bits_t*)head_, expected, desired);
+	memcpy(expected_, &previous, sizeof(previous));
+	return previous == expected;
+#endif
+}
+
+static inline uintptr_t AlignUp(uintptr_t value_, size_t alignment_)		{ return (value_ + alignment_ - 1) & ~((uintptr_t)alignment_ - 1); }
+
+// -----------------------------------------------------------------------
+// Thread caches;
+// A BlockAllocator claims a slot at init, each thread has its own cache in every slot;
+// The serial tells a cache left over from an allocator that was deinit apart from the one in the slot now;
+// -----------------------------------------------------------------------
+struct block_cache_t
+{
+	uint64_t m_serial;
+	block_t* m_head;
+	size_t m_count;
+};
+
+static std::atomic<uint64_t> s_cacheSlotSerials[BLOCK_ALLOCATOR_CACHE_SLOTS];		// 0 when free;
+static std::atomic<BlockAllocator*> s_cacheSlotOwners[BLOCK_ALLOCATOR_CACHE_SLOTS];
+static std::atomic<uint64_t> s_nextCacheSerial = 1;
+
+struct block_thread_caches_t
+{
+	~block_thread_caches_t()
+	{
+		// An exiting thread's blocks go back to the shared lists, so nothing is lost to threads coming and going;
+		for (uint slot = 0; slot < BLOCK_ALLOCATOR_CACHE_SLOTS; ++slot)
+		{
+			BlockAllocator* owner = s_cacheSlotOwners[slot].load();
+			if (owner != nullptr && m_caches[slot].m_head != nullptr && s_cacheSlotSerials[slot].load() == m_caches[slot].m_serial)
+			{
+				owner->flush_thread_cache();
+			}
+		}
+	}
+
+	block_cache_t m_caches[BLOCK_ALLOCATOR_CACHE_SLOTS] = {};
+};
+
+static thread_local block_thread_caches_t t_blockCaches;
+
+// -----------------------------------------------------------------------
+BlockAllocator::~BlockAllocator()
+{
+	deinit();
+}
 
 // -----------------------------------------------------------------------
 bool BlockAllocator::init(Allocator* base, size_t block_size, size_t alignment, uint blocks_per_chunk)
 {
+	deinit();
+
 	m_base = base;
-	m_block_size = block_size;
-	m_alignment = alignment;
+	m_alignment = alignment > alignof(void*) ? alignment : alignof(void*);
+	m_block_size = AlignUp(block_size > sizeof(block_batch_t) ? block_size : sizeof(block_batch_t), m_alignment);
 	m_blocks_per_chunk = blocks_per_chunk;
+	m_batch_size = blocks_per_chunk < BLOCK_ALLOCATOR_BATCH_SIZE ? blocks_per_chunk : BLOCK_ALLOCATOR_BATCH_SIZE;
 
-	m_free_blocks = nullptr;
+	m_free_batches = {};
 	m_chunk_list = nullptr;
 
-	allocate_chunk();
+	claim_cache_slot();
 
-	return true;
+	// Chunks are allocated the first time a thread finds the shared list empty;
+	return m_base != nullptr && m_blocks_per_chunk > 0;
 }
 
 // -----------------------------------------------------------------------
 bool BlockAllocator::init(void* buffer, size_t buffer_size, size_t block_size, size_t alignment)
 {
-	m_blocks_per_chunk = buffer_size / block_size;
+	deinit();
+
+	m_alignment = alignment > alignof(void*) ? alignment : alignof(void*);
+	m_block_size = AlignUp(block_size > sizeof(block_batch_t) ? block_size : sizeof(block_batch_t), m_alignment);
 	m_buffer_size = buffer_size;
-	m_block_size = block_size;
-	m_alignment = alignment;
 
-	m_base = nullptr;
-	m_free_blocks = nullptr;
+	uintptr_t first = AlignUp((uintptr_t)buffer, m_alignment);
+	size_t padding = (size_t)(first - (uintptr_t)buffer);
+	m_blocks_per_chunk = padding < buffer_size ? (buffer_size - padding) / m_block_size : 0;
+	m_batch_size = m_blocks_per_chunk < BLOCK_ALLOCATOR_BATCH_SIZE ? m_blocks_per_chunk : BLOCK_ALLOCATOR_BATCH_SIZE;
 
-	break_up_chunk(buffer);
+	m_base = nullptr;
+	m_free_batches = {};
+	m_chunk_list = nullptr;
 
+	claim_cache_slot();
 
+	break_up_chunk((void*)first, m_blocks_per_chunk, nullptr);
 
-	return true;
+	return m_blocks_per_chunk > 0;
 }
 
 // -----------------------------------------------------------------------
 void BlockAllocator::deinit()
 {
-	std::scoped_lock lk(m_block_lock);
-	std::scoped_lock lk2(m_chunk_lock);
+	std::scoped_lock lk(m_chunk_lock);
 
-	if (m_base) 
+	release_cache_slot();
+
+	if (m_base)
 	{
 		while (m_chunk_list != nullptr)
 		{
@@ -61,9 +167,11 @@ void BlockAllocator::deinit()
 	}
 
 	m_base = nullptr;
-	m_free_blocks = nullptr;
+	m_free_batches = {};
+	m_chunk_list = nullptr;
 	m_block_size = 0u;
 	m_blocks_per_chunk = 0u;
+	m_batch_size = 0u;
 }
 
 // -----------------------------------------------------------------------
@@ -86,110 +194,359 @@ void BlockAllocator::free(void* ptr)
 // -----------------------------------------------------------------------
 void* BlockAllocator::alloc_block()
 {
-	block_t* block = pop_free_block();
-	while (block == nullptr) 
+	block_cache_t* cache = get_thread_cache();
+	if (cache != nullptr && cache->m_head != nullptr)
 	{
-		if (!allocate_chunk())
+		block_t* block = cache->m_head;
+		cache->m_head = block->next;
+		--cache->m_count;
+
+		return block;
+	}
+
+	block_batch_t* batch = pop_batch();
+	if (batch == nullptr)
+	{
+		batch = allocate_chunk();
+		if (batch == nullptr)
 		{
 			return nullptr;
 		}
+	}
 
-		block = pop_free_block();
+	// The first block is handed out, the rest of the batch fills the cache;
+	block_t* rest = batch->next;
+	size_t rest_count = batch->count - 1;
+	if (cache != nullptr)
+	{
+		cache->m_head = rest;
+		cache->m_count = rest_count;
+	}
+	else if (rest != nullptr)
+	{
+		block_batch_t* rest_batch = (block_batch_t*)rest;
+		rest_batch->count = rest_count;
+		push_batch(rest_batch);
 	}
 
-	return block;
+	return batch;
 }
 
 // -----------------------------------------------------------------------
 void BlockAllocator::free_block(void* ptr)
 {
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
 	block_t* block = (block_t*)ptr;
-	push_free_block(block);
+	block_cache_t* cache = get_thread_cache();
+	if (cache == nullptr)
+	{
+		block_batch_t* batch = (block_batch_t*)block;
+		batch->next = nullptr;
+		batch->count = 1;
+		push_batch(batch);
+		return;
+	}
+
+	block->next = cache->m_head;
+	cache->m_head = block;
+	++cache->m_count;
+
+	// Keep the batch freed last, it is the likeliest to still be in this core's cache, and share the older one;
+	if (cache->m_count >= 2 * m_batch_size)
+	{
+		block_t* last_kept = cache->m_head;
+		for (size_t index = 1; index < m_batch_size; ++index)
+		{
+			last_kept = last_kept->next;
+		}
+
+		block_batch_t* batch = (block_batch_t*)last_kept->next;
+		last_kept->next = nullptr;
+		batch->count = cache->m_count - m_batch_size;
+		cache->m_count = m_batch_size;
+
+		push_batch(batch);
+	}
 }
 
 // -----------------------------------------------------------------------
-block_t* BlockAllocator::pop_free_block()
+void BlockAllocator::flush_thread_cache()
 {
-	std::scoped_lock lk(m_block_lock);
+	block_cache_t* cache = get_thread_cache();
+	if (cache == nullptr || cache->m_head == nullptr)
+	{
+		return;
+	}
 
-	numberofblocks--;
+	block_batch_t* batch = (block_batch_t*)cache->m_head;
+	batch->count = cache->m_count;
+	cache->m_head = nullptr;
+	cache->m_count = 0;
+
+	push_batch(batch);
+}
 
-	block_t* head = m_free_blocks;
-	if (head != nullptr) 
+// -----------------------------------------------------------------------
+block_cache_t* BlockAllocator::get_thread_cache()
+{
+	if (m_cache_slot >= BLOCK_ALLOCATOR_CACHE_SLOTS)
 	{
-		m_free_blocks = head->next;
+		return nullptr;
 	}
 
-	return head;
+	block_cache_t* cache = &t_blockCaches.m_caches[m_cache_slot];
+	if (cache->m_serial != m_cache_serial)
+	{
+		// Left over from whoever had the slot before, its blocks went with its chunks;
+		cache->m_serial = m_cache_serial;
+		cache->m_head = nullptr;
+		cache->m_count = 0;
+	}
+
+	return cache;
+}
+
+// -----------------------------------------------------------------------
+void BlockAllocator::push_batch(block_batch_t* batch)
+{
+	block_batch_head_t head = LoadBatchHead(&m_free_batches);
+	block_batch_head_t new_head;
+	do
+	{
+		batch->next_batch.store(head.batch, std::memory_order_relaxed);
+		new_head = { batch, head.tag + 1 };
+	} while (!CompareExchangeBatchHead(&m_free_batches, &head, new_head));
+}
+
+// -----------------------------------------------------------------------
+block_batch_t* BlockAllocator::pop_batch()
+{
+	block_batch_head_t head = LoadBatchHead(&m_free_batches);
+	while (true)
+	{
+		if (head.batch == nullptr)
+		{
+			return nullptr;
+		}
+
+		// batch may be popped and reused by now, its memory is still ours, and the tag fails the compare;
+		block_batch_t* next = head.batch->next_batch.load(std::memory_order_relaxed);
+		if (CompareExchangeBatchHead(&m_free_batches, &head, { next, head.tag + 1 }))
+		{
+			return head.batch;
+		}
+	}
 }
 
 // -----------------------------------------------------------------------
-void BlockAllocator::push_free_block(block_t* block)
+block_batch_t* BlockAllocator::allocate_chunk()
 {
-	std::scoped_lock lk(m_block_lock);
+	if (m_base == nullptr)
+	{
+		return nullptr;
+	}
+
+	std::scoped_lock lk(m_chunk_lock);
+
+	// Another thread may have grown it while this one waited;
+	block_batch_t* batch = pop_batch();
+	if (batch != nullptr)
+	{
+		return batch;
+	}
 
-	if (numberofblocks == 0)
+	size_t chunk_size = sizeof(chunk_t) + m_alignment + m_blocks_per_chunk * m_block_size;
+
+	chunk_t* chunk = (chunk_t*)m_base->alloc(chunk_size);
+	if (chunk == nullptr)
 	{
-		LogCallstackf("filter", "asd");
+		return nullptr;
 	}
 
-	numberofblocks++;
+	// track this chunk so we can free it later
+	chunk->next = m_chunk_list;
+	m_chunk_list = chunk;
+
+	// break chunk, keeping a batch for the caller
+	break_up_chunk((void*)AlignUp((uintptr_t)(chunk + 1), m_alignment), m_blocks_per_chunk, &batch);
+
+	return batch;
+}
+
+// -----------------------------------------------------------------------
+void BlockAllocator::break_up_chunk(void* chunk, size_t block_count, block_batch_t** out_kept)
+{
+	uint8_t* buff = (uint8_t*)chunk;
+
+	for (size_t first = 0; first < block_count; first += m_batch_size)
+	{
+		size_t count = (block_count - first) < m_batch_size ? (block_count - first) : m_batch_size;
+
+		// Blocks in address order, so a fresh batch is walked front to back;
+		for (size_t index = 0; index < count; ++index)
+		{
+			block_t* node = (block_t*)(buff + (first + index) * m_block_size);
+			node->next = (index + 1 < count) ? (block_t*)(buff + (first + index + 1) * m_block_size) : nullptr;
+		}
+
+		block_batch_t* batch = (block_batch_t*)(buff + first * m_block_size);
+		batch->count = count;
 
-	block->next = m_free_blocks;
-	m_free_blocks = block;
+		if (out_kept != nullptr && *out_kept == nullptr)
+		{
+			*out_kept = batch;
+		}
+		else
+		{
+			push_batch(batch);
+		}
+	}
 }
 
 // -----------------------------------------------------------------------
-bool BlockAllocator::allocate_chunk()
+bool BlockAllocator::claim_cache_slot()
 {
-	if (m_base == nullptr) 
+	m_cache_serial = s_nextCacheSerial.fetch_add(1);
+
+	for (uint slot = 0; slot < BLOCK_ALLOCATOR_CACHE_SLOTS; ++slot)
 	{
-		return false;
+		uint64_t expected = 0;
+		if (s_cacheSlotSerials[slot].compare_exchange_strong(expected, m_cache_serial))
+		{
+			s_cacheSlotOwners[slot].store(this);
+			m_cache_slot = slot;
+			return true;
+		}
 	}
 
-	if (m_chunk_lock.try_lock()) 
+	// Still works, every call goes to the shared list;
+	m_cache_slot = BLOCK_ALLOCATOR_CACHE_SLOTS;
+	return false;
+}
+
+// -----------------------------------------------------------------------
+void BlockAllocator::release_cache_slot()
+{
+	if (m_cache_slot < BLOCK_ALLOCATOR_CACHE_SLOTS)
 	{
-		size_t chunk_size = m_blocks_per_chunk * m_block_size + sizeof(chunk_t);
+		s_cacheSlotOwners[m_cache_slot].store(nullptr);
+		s_cacheSlotSerials[m_cache_slot].store(0);
+	}
+
+	m_cache_slot = BLOCK_ALLOCATOR_CACHE_SLOTS;
+	m_cache_serial = 0;
+}
 
-		chunk_t* chunk = (chunk_t*)m_base->alloc(chunk_size);
-		if (chunk == nullptr) 
+// -----------------------------------------------------------------------
+// Size Classes
+// -----------------------------------------------------------------------
+static constexpr size_t s_sizeClassSizes[SIZE_CLASS_COUNT] = { 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512, 640, 768, 896, 1024 };
+
+// Class index for every multiple of SIZE_CLASS_ALIGNMENT up to SIZE_CLASS_MAX_SIZE;
+struct size_class_table_t
+{
+	constexpr size_class_table_t()
+		: m_indices()
+	{
+		uint classIndex = 0;
+		for (size_t step = 0; step <= SIZE_CLASS_MAX_SIZE / SIZE_CLASS_ALIGNMENT; ++step)
 		{
-			m_chunk_lock.unlock();
-			return false;
+			while (s_sizeClassSizes[classIndex] < step * SIZE_CLASS_ALIGNMENT)
+			{
+				++classIndex;
+			}
+			m_indices[step] = (uint8_t)classIndex;
 		}
+	}
+
+	uint8_t m_indices[SIZE_CLASS_MAX_SIZE / SIZE_CLASS_ALIGNMENT + 1];
+};
+
+static constexpr size_class_table_t s_sizeClassTable;
+
+static inline uint GetSizeClassIndex(size_t size_)
+{
+	return s_sizeClassTable.m_indices[(size_ + SIZE_CLASS_ALIGNMENT - 1) / SIZE_CLASS_ALIGNMENT];
+}
+
+// -----------------------------------------------------------------------
+bool SizeClassAllocator::init(Allocator* base)
+{
+	m_base = base;
 
-		// track this chunk so we can free it later
-		chunk->next = m_chunk_list;
-		m_chunk_list = chunk;
+	bool isGood = m_base != nullptr;
+	for (uint classIndex = 0; classIndex < SIZE_CLASS_COUNT; ++classIndex)
+	{
+		// About 64KB a chunk, and never fewer than two batches;
+		size_t classSize = s_sizeClassSizes[classIndex];
+		uint blocksPerChunk = (uint)((64 * 1024) / classSize);
+		blocksPerChunk = blocksPerChunk > 2 * BLOCK_ALLOCATOR_BATCH_SIZE ? blocksPerChunk : 2 * BLOCK_ALLOCATOR_BATCH_SIZE;
 
-		// break chunk 
-		break_up_chunk(chunk + 1);
-		m_chunk_lock.unlock();
+		isGood = m_classes[classIndex].init(base, classSize, SIZE_CLASS_ALIGNMENT, blocksPerChunk) && isGood;
 	}
-	
-	return true;
+
+	return isGood;
 }
 
 // -----------------------------------------------------------------------
-void BlockAllocator::break_up_chunk(void* chunk)
+void SizeClassAllocator::deinit()
 {
-	byte* buff = (byte*)chunk;
-	block_t* first = (block_t*)buff;
-	block_t* head = nullptr;
+	for (uint classIndex = 0; classIndex < SIZE_CLASS_COUNT; ++classIndex)
+	{
+		m_classes[classIndex].deinit();
+	}
+
+	m_base = nullptr;
+}
 
-	for (uint i = 0; i < m_blocks_per_chunk; ++i) 
+// -----------------------------------------------------------------------
+void* SizeClassAllocator::alloc(size_t size)
+{
+	if (size > SIZE_CLASS_MAX_SIZE)
 	{
-		block_t* node = (block_t*)buff;
-		buff += m_block_size;
-		numberofblocks++;
+		return m_base->alloc(size);
+	}
+
+	return m_classes[GetSizeClassIndex(size)].alloc_block();
+}
 
-		node->next = head;
-		head = node;
+// -----------------------------------------------------------------------
+void SizeClassAllocator::free(void* ptr, size_t size)
+{
+	if (ptr == nullptr)
+	{
+		return;
 	}
 
+	if (size > SIZE_CLASS_MAX_SIZE)
 	{
-		std::scoped_lock lk(m_block_lock);
-		first->next = m_free_blocks;
-		m_free_blocks = head;
+		m_base->free(ptr);
+		return;
 	}
+
+	m_classes[GetSizeClassIndex(size)].free_block(ptr);
+}
+
+// -----------------------------------------------------------------------
+size_t SizeClassAllocator::get_class_size(size_t size)
+{
+	return size > SIZE_CLASS_MAX_SIZE ? 0 : s_sizeClassSizes[GetSizeClassIndex(size)];
+}
+
+// -----------------------------------------------------------------------
+SizeClassAllocator& GetSizeClassAllocator()
+{
+	static SizeClassAllocator* s_sizeClassAllocator = []()
+	{
+		alignas(SizeClassAllocator) static unsigned char s_storage[sizeof(SizeClassAllocator)];
+		SizeClassAllocator* sizeClassAllocator = new (s_storage) SizeClassAllocator();
+		sizeClassAllocator->init(&TrackedAllocator::s_instance);
+		return sizeClassAllocator;
+	}();
+
+	return *s_sizeClassAllocator;
 }
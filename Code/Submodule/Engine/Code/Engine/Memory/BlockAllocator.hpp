@@ -2,7 +2,9 @@
 #include "Engine/Memory/Allocator.hpp"
 
 
+#include <atomic>
 #include <mutex>
+#include <stdint.h>
 
 typedef unsigned int uint;
 
@@ -11,16 +13,52 @@ struct block_t
 	block_t* next;
 };
 
+// The first block of a batch on the shared free list;
+struct block_batch_t
+{
+	block_t* next;								// The rest of the batch;
+	std::atomic<block_batch_t*> next_batch;
+	size_t count;
+};
+
+// The shared list's head; swapped as one with a tag bumped by every push and pop, 64 bits of it on x64 and 32 on
+// Win32, so it can't wrap back around while a thread sits between its load and its compare;
+struct alignas(2 * sizeof(void*)) block_batch_head_t
+{
+	block_batch_t* batch;
+	uintptr_t tag;
+};
+
 struct chunk_t
 {
 	chunk_t* next;
 };
 
+struct block_cache_t;
+
+// How many blocks move between a thread's cache and the shared list at once;
+constexpr uint BLOCK_ALLOCATOR_BATCH_SIZE = 32;
+
+// BlockAllocators that can be alive at once with thread caches, any past that go to the shared list every time;
+constexpr uint BLOCK_ALLOCATOR_CACHE_SLOTS = 64;
+
+// -----------------------------------------------------------------------
+// Block Allocator;
+// Every thread keeps a cache of free blocks, so most alloc_block and free_block calls touch nothing shared;
+// Caches trade full batches with a lock-free shared list, a Treiber stack whose head carries a tag so a batch
+// popped and pushed back between a load and a compare can't be mistaken for the one that was there (ABA);
+// Only growing takes a lock; chunks are kept until deinit, so a stale head still points at readable memory;
+// A block freed on another thread goes to that thread's cache and finds its way back through the shared list;
+// deinit only once no thread will touch it again, blocks in other threads' caches are dropped with the chunks;
+// -----------------------------------------------------------------------
 class BlockAllocator : public Allocator
 {
 
 public:
 
+	BlockAllocator() = default;
+	~BlockAllocator();
+
 	// Takes a base allocator to sub-allocate out of,
 	//  which means it can grow as long as the base can allocate
 	bool init(Allocator* base, size_t block_size, size_t alignment, uint blocks_per_chunk);
@@ -39,32 +77,83 @@ public:
 	// allocates and frees a single block
 	void* alloc_block();
 	void free_block(void* ptr);
-	block_t* pop_free_block();
-	void push_free_block(block_t* block);
+
+	size_t get_block_size() const { return m_block_size; }
+
+	// Gives the calling thread's cached blocks back to the shared list;
+	void flush_thread_cache();
 
 private:
 
+	block_cache_t* get_thread_cache();
+
+	// The shared list;
+	void push_batch(block_batch_t* batch);
+	block_batch_t* pop_batch();
+
 	// allocates a single chunk of memory
 	// that is divided into blocks - will fail
 	// if no base allocator is provided
-	bool allocate_chunk();
-	void break_up_chunk(void* chunk);
+	block_batch_t* allocate_chunk();
+	void break_up_chunk(void* chunk, size_t block_count, block_batch_t** out_kept);
+
+	bool claim_cache_slot();
+	void release_cache_slot();
 
 private:
 
 	Allocator* m_base = nullptr;
 
-	block_t* m_free_blocks = nullptr;
-	chunk_t* m_chunk_list = nullptr;
+	alignas(64) block_batch_head_t m_free_batches = {};	// Only touched through LoadBatchHead and CompareExchangeBatchHead;
+	alignas(64) chunk_t* m_chunk_list = nullptr;
+
+	size_t m_buffer_size = 0;
+	size_t m_alignment = 0;
+	size_t m_block_size = 0;
+	size_t m_blocks_per_chunk = 0;
+	size_t m_batch_size = 0;
 
-	size_t m_buffer_size;
-	size_t m_alignment;
-	size_t m_block_size;
-	size_t m_blocks_per_chunk;
+	uint m_cache_slot = BLOCK_ALLOCATOR_CACHE_SLOTS;
+	uint64_t m_cache_serial = 0;
 
-	// AsyncBlockAllocator
 	std::mutex m_chunk_lock; // when allocating chunks;
-	std::mutex m_block_lock; // when allocating a single block;
 };
 
-extern BlockAllocator* g_theBlockAllocatorOnlyForProfilerNodeT;
\ No newline at end of file
+// -----------------------------------------------------------------------
+// Size Classes;
+// A BlockAllocator per size class, 32 to 1024 bytes, 16 byte aligned; bigger sizes go to the base allocator;
+// free has to be told the size alloc was, which class operator delete is, see BLOCK_ALLOCATED_CLASS;
+// -----------------------------------------------------------------------
+constexpr size_t SIZE_CLASS_MAX_SIZE = 1024;
+constexpr size_t SIZE_CLASS_ALIGNMENT = 16;
+constexpr uint SIZE_CLASS_COUNT = 19;
+
+class SizeClassAllocator
+{
+
+public:
+
+	bool init(Allocator* base);
+	void deinit();
+
+	void* alloc(size_t size);
+	void free(void* ptr, size_t size);
+
+	// Which block size a size is rounded up to, 0 past SIZE_CLASS_MAX_SIZE;
+	static size_t get_class_size(size_t size);
+
+private:
+
+	Allocator* m_base = nullptr;
+	BlockAllocator m_classes[SIZE_CLASS_COUNT];
+};
+
+// Shared by everything using BLOCK_ALLOCATED_CLASS, chunks come from TrackedAllocator; never torn down,
+// objects may still be deleted during static destruction;
+SizeClassAllocator& GetSizeClassAllocator();
+
+// Inside a class, routes new and delete of it, and of everything derived from it, through GetSizeClassAllocator;
+// A virtual destructor makes delete through a base pointer give the right size; 16 byte alignment at most;
+#define BLOCK_ALLOCATED_CLASS() \
+	static void* operator new(size_t size_)					{ return GetSizeClassAllocator().alloc(size_); } \
+	static void operator delete(void* ptr_, size_t size_)	{ GetSizeClassAllocator().free(ptr_, size_); }
@@ -0,0 +1,333 @@
+#include "Engine/Memory/BlockAllocatorBenchmark.hpp"
+#include "Engine/Memory/BlockAllocator.hpp"
+#include "Engine/Async/MPMCQueue.hpp"
+#include "Engine/Core/BenchmarkUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+constexpr size_t BENCHMARK_BLOCK_SIZE = 64;
+constexpr uint BENCHMARK_WINDOW_SIZE = 256;
+constexpr uint BENCHMARK_HANDOFF_CAPACITY = 1024;
+
+// ------------------------------------------------------------------------------------------------
+// The BlockAllocator this replaced, kept here as the baseline;
+// ------------------------------------------------------------------------------------------------
+class LockedBlockAllocator
+{
+
+public:
+
+	~LockedBlockAllocator()
+	{
+		while (m_chunk_list != nullptr)
+		{
+			chunk_t* list = m_chunk_list;
+			m_chunk_list = m_chunk_list->next;
+			::free(list);
+		}
+	}
+
+	void* alloc_block()
+	{
+		block_t* block = pop_free_block();
+		while (block == nullptr)
+		{
+			allocate_chunk();
+			block = pop_free_block();
+		}
+
+		return block;
+	}
+
+	void free_block(void* ptr)
+	{
+		std::scoped_lock lk(m_block_lock);
+
+		block_t* block = (block_t*)ptr;
+		block->next = m_free_blocks;
+		m_free_blocks = block;
+	}
+
+private:
+
+	block_t* pop_free_block()
+	{
+		std::scoped_lock lk(m_block_lock);
+
+		block_t* head = m_free_blocks;
+		if (head != nullptr)
+		{
+			m_free_blocks = head->next;
+		}
+
+		return head;
+	}
+
+	void allocate_chunk()
+	{
+		if (m_chunk_lock.try_lock())
+		{
+			chunk_t* chunk = (chunk_t*)::malloc(BLOCKS_PER_CHUNK * BENCHMARK_BLOCK_SIZE + sizeof(chunk_t));
+			chunk->next = m_chunk_list;
+			m_chunk_list = chunk;
+
+			uint8_t* buff = (uint8_t*)(chunk + 1);
+			block_t* first = (block_t*)buff;
+			block_t* head = nullptr;
+			for (uint i = 0; i < BLOCKS_PER_CHUNK; ++i)
+			{
+				block_t* node = (block_t*)buff;
+				buff += BENCHMARK_BLOCK_SIZE;
+
+				node->next = head;
+				head = node;
+			}
+
+			{
+				std::scoped_lock lk(m_block_lock);
+				first->next = m_free_blocks;
+				m_free_blocks = head;
+			}
+
+			m_chunk_lock.unlock();
+		}
+	}
+
+private:
+
+	static constexpr uint BLOCKS_PER_CHUNK = 1024;
+
+	block_t* m_free_blocks = nullptr;
+	chunk_t* m_chunk_list = nullptr;
+
+	std::mutex m_chunk_lock;
+	std::mutex m_block_lock;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct MallocBlocks
+{
+	void* Alloc()				{ return ::malloc(BENCHMARK_BLOCK_SIZE); }
+	void Free(void* ptr_)		{ ::free(ptr_); }
+};
+
+struct LockedBlocks
+{
+	void* Alloc()				{ return m_allocator.alloc_block(); }
+	void Free(void* ptr_)		{ m_allocator.free_block(ptr_); }
+
+	LockedBlockAllocator m_allocator;
+};
+
+struct LockFreeBlocks
+{
+	LockFreeBlocks()			{ m_allocator.init(&UntrackedAllocator::s_instance, BENCHMARK_BLOCK_SIZE, 16, 1024); }
+	void* Alloc()				{ return m_allocator.alloc_block(); }
+	void Free(void* ptr_)		{ m_allocator.free_block(ptr_); }
+
+	BlockAllocator m_allocator;
+};
+
+struct SizeClassBlocks
+{
+	SizeClassBlocks()			{ m_allocator.init(&UntrackedAllocator::s_instance); }
+	~SizeClassBlocks()			{ m_allocator.deinit(); }
+	void* Alloc()				{ return m_allocator.alloc(BENCHMARK_BLOCK_SIZE); }
+	void Free(void* ptr_)		{ m_allocator.free(ptr_, BENCHMARK_BLOCK_SIZE); }
+
+	SizeClassAllocator m_allocator;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Every block carries who allocated it, checked again when it's freed, so one handed out twice shows up;
+static inline void* TakeBlock(void* block_, uint64_t stamp_)
+{
+	GUARANTEE_OR_DIE(block_ != nullptr, "Block allocator benchmark ran out of memory.");
+	*(uint64_t*)block_ = stamp_;
+	((uint64_t*)block_)[BENCHMARK_BLOCK_SIZE / sizeof(uint64_t) - 1] = stamp_;
+	return block_;
+}
+
+static inline void CheckBlock(void* block_)
+{
+	uint64_t* words = (uint64_t*)block_;
+	GUARANTEE_OR_DIE(words[0] == words[BENCHMARK_BLOCK_SIZE / sizeof(uint64_t) - 1], "Block allocator benchmark found a block handed out twice.");
+}
+
+static inline uint NextRandom(uint& state_)
+{
+	state_ ^= state_ << 13;
+	state_ ^= state_ >> 17;
+	state_ ^= state_ << 5;
+	return state_;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Each thread frees and allocates its own blocks;
+template <typename BLOCKS>
+static double TimeWindow(BLOCKS& blocks_, int threadCount_, int operationsPerThread_)
+{
+	std::atomic<bool> go = false;
+	std::vector<std::thread> threads;
+
+	for (int threadIndex = 0; threadIndex < threadCount_; ++threadIndex)
+	{
+		threads.emplace_back([&blocks_, &go, threadIndex, operationsPerThread_]()
+		{
+			void* window[BENCHMARK_WINDOW_SIZE] = {};
+			uint random = 0x9E3779B9u * (uint)(threadIndex + 1);
+
+			while (!go.load());
+
+			for (int operation = 0; operation < operationsPerThread_; ++operation)
+			{
+				void*& slot = window[NextRandom(random) % BENCHMARK_WINDOW_SIZE];
+				if (slot != nullptr)
+				{
+					CheckBlock(slot);
+					blocks_.Free(slot);
+				}
+				slot = TakeBlock(blocks_.Alloc(), ((uint64_t)threadIndex << 32) | (uint64_t)operation);
+			}
+
+			for (void* block : window)
+			{
+				if (block != nullptr)
+				{
+					CheckBlock(block);
+					blocks_.Free(block);
+				}
+			}
+		});
+	}
+
+	double startTime = GetCurrentTimeSeconds();
+	go.store(true);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	return GetCurrentTimeSeconds() - startTime;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Each thread allocates for the next one over and frees what the one before sent it, the Job pattern;
+template <typename BLOCKS>
+static double TimeHandoff(BLOCKS& blocks_, int threadCount_, int operationsPerThread_)
+{
+	std::atomic<bool> go = false;
+	std::atomic<int> doneCount = 0;
+	std::vector<std::unique_ptr<BoundedMPMCQueue<void*>>> inboxes;
+	std::vector<std::thread> threads;
+
+	for (int threadIndex = 0; threadIndex < threadCount_; ++threadIndex)
+	{
+		inboxes.emplace_back(std::make_unique<BoundedMPMCQueue<void*>>(BENCHMARK_HANDOFF_CAPACITY));
+	}
+
+	for (int threadIndex = 0; threadIndex < threadCount_; ++threadIndex)
+	{
+		threads.emplace_back([&blocks_, &go, &doneCount, &inboxes, threadIndex, threadCount_, operationsPerThread_]()
+		{
+			BoundedMPMCQueue<void*>& inbox = *inboxes[threadIndex];
+			BoundedMPMCQueue<void*>& outbox = *inboxes[(threadIndex + 1) % threadCount_];
+			void* block = nullptr;
+
+			while (!go.load());
+
+			for (int operation = 0; operation < operationsPerThread_; ++operation)
+			{
+				void* sent = TakeBlock(blocks_.Alloc(), ((uint64_t)threadIndex << 32) | (uint64_t)operation);
+				while (!outbox.TryEnqueue(sent))
+				{
+					// The next thread is behind, do our own freeing while it catches up;
+					while (inbox.TryDequeue(&block))
+					{
+						CheckBlock(block);
+						blocks_.Free(block);
+					}
+					std::this_thread::yield();
+				}
+
+				if (inbox.TryDequeue(&block))
+				{
+					CheckBlock(block);
+					blocks_.Free(block);
+				}
+			}
+
+			doneCount.fetch_add(1);
+			while (true)
+			{
+				bool wasEveryoneDone = doneCount.load() == threadCount_;
+				while (inbox.TryDequeue(&block))
+				{
+					CheckBlock(block);
+					blocks_.Free(block);
+				}
+				if (wasEveryoneDone)
+				{
+					break;
+				}
+				std::this_thread::yield();
+			}
+		});
+	}
+
+	double startTime = GetCurrentTimeSeconds();
+	go.store(true);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	return GetCurrentTimeSeconds() - startTime;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void PrintResult(const char* allocatorName_, const char* workloadName_, int threadCount_, int operationsPerThread_, double seconds_)
+{
+	double totalOperations = (double)threadCount_ * (double)operationsPerThread_;
+	PrintLine(Stringf("%-10s %-8s %2i threads %8.3fs %8.2f Mops/s", allocatorName_, workloadName_, threadCount_, seconds_, MillionsPerSecond(totalOperations, seconds_)));
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename BLOCKS>
+static void RunBoth(const char* allocatorName_, int threadCount_, int operationsPerThread_)
+{
+	{
+		BLOCKS blocks;
+		PrintResult(allocatorName_, "window", threadCount_, operationsPerThread_, TimeWindow(blocks, threadCount_, operationsPerThread_));
+	}
+
+	{
+		BLOCKS blocks;
+		PrintResult(allocatorName_, "handoff", threadCount_, operationsPerThread_, TimeHandoff(blocks, threadCount_, operationsPerThread_));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunBlockAllocatorBenchmark(int maxThreads_, int operationsPerThread_)
+{
+	if (maxThreads_ < 1 || operationsPerThread_ < 1)
+	{
+		return;
+	}
+
+	for (int threadCount = 1; threadCount <= maxThreads_; threadCount *= 2)
+	{
+		RunBoth<MallocBlocks>("malloc", threadCount, operationsPerThread_);
+		RunBoth<LockedBlocks>("mutex", threadCount, operationsPerThread_);
+		RunBoth<LockFreeBlocks>("block", threadCount, operationsPerThread_);
+		RunBoth<SizeClassBlocks>("sizeclass", threadCount, operationsPerThread_);
+	}
+}
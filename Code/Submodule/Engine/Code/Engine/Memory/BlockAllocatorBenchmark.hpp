@@ -0,0 +1,10 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+// Contention benchmark for the block allocators;
+// Runs N threads for N = 1, 2, 4... up to maxThreads_, each keeping a window of live blocks and swapping a random
+// one out per operation, on malloc, the old mutex BlockAllocator, BlockAllocator and SizeClassAllocator, then
+// again with every block freed by the next thread over; prints millions of alloc/free pairs per second to the
+// DevConsole; Blocks the caller until every run has finished;
+// ------------------------------------------------------------------------------------------------
+void RunBlockAllocatorBenchmark(int maxThreads_, int operationsPerThread_);
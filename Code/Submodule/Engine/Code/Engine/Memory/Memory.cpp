@@ -1,12 +1,18 @@
 #include "Engine/Memory/Memory.hpp"
+#include "Engine/Core/BenchmarkUtils.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Memory/Allocator.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
 
+#include <algorithm>
+#include <new>
+#include <string.h>
+#include <unordered_map>
 
-//-----------------------------------------------------------------------------------------------
-std::atomic<size_t> memtrack_allocationCount = 0;
-std::atomic<size_t> memtrack_byteCount = 0;
 
+//-----------------------------------------------------------------------------------------------
 thread_local size_t t_allocCount = 0;
 thread_local size_t t_allocBytes = 0;
 thread_local size_t t_freeCount = 0;
@@ -14,32 +20,169 @@ thread_local size_t t_freeBytes = 0;
 
 size_t GetMemAllocCount()
 {
-	return memtrack_allocationCount;
+	return MemTrackGetLiveAllocationCount();
 }
 
-// std::mutex gTrackerLock;
-// 
-// std::map<void*,      // key
-// 	mem_track_info_t, // value
-// 	std::less<void*>, // less to use for map
-// 	UntrackedAllocator<std::pair<void* const, mem_track_info_t>> // allocator  
-// > gMemTrackers;
+#if defined(MEM_TRACKING) && MEM_TRACKING == MEM_TRACK_ALLOC_COUNT
+// -----------------------------------------------------------------------
+// Count Records, MEM_TRACK_ALLOC_COUNT
+// Each thread counts the allocations it makes less the ones it frees in its own record, so counting is a
+// plain store to a line no other thread writes; a record can go negative, only the sum over all of them means anything;
+// Records are never freed and keep their count, an exiting thread's is taken over by the next one to start;
+// -----------------------------------------------------------------------
+struct alignas(64) mem_count_record_t
+{
+	std::atomic<int64_t> m_allocationCount = 0;			// Only written by the thread holding the record;
+	std::atomic<bool> m_isInUse = false;
+	mem_count_record_t* m_next = nullptr;
+};
 
+// Constant initialized, so it is good before this file's globals are constructed;
+static std::atomic<mem_count_record_t*> s_memCountRecords = nullptr;
 
 // ------------------------------------------------------------------------------------------------------------------------------
-std::mutex& GetMemTrackerLock()
+static mem_count_record_t* AcquireMemCountRecord()
 {
-    static std::mutex trackerLock;
-    return trackerLock;
+	for (mem_count_record_t* record = s_memCountRecords.load(); record != nullptr; record = record->m_next)
+	{
+		bool isInUse = false;
+		if (!record->m_isInUse.load() && record->m_isInUse.compare_exchange_strong(isInUse, true))
+		{
+			return record;
+		}
+	}
+
+	// Untracked, this runs inside operator new;
+	mem_count_record_t* record = new (UntrackedAlloc(sizeof(mem_count_record_t))) mem_count_record_t();
+	record->m_isInUse.store(true);
+
+	mem_count_record_t* head = s_memCountRecords.load();
+	do
+	{
+		record->m_next = head;
+	} while (!s_memCountRecords.compare_exchange_weak(head, record));
+
+	return record;
 }
 
+static thread_local mem_count_record_t* t_memCountRecord = nullptr;
+
 // ------------------------------------------------------------------------------------------------------------------------------
-std::map<void*, mem_track_info_t, std::less<void*>, STLUntrackedAllocator<std::pair<void* const, mem_track_info_t>>>& GetMemTrakingMap()
+// Hands the record back when its thread exits; an allocation after that takes a record again and keeps it;
+struct mem_count_record_owner_t
 {
-    static std::map<void*, mem_track_info_t, std::less<void*>, STLUntrackedAllocator<std::pair<void* const, mem_track_info_t>>> memTrackerMap;
-    return memTrackerMap;
+	~mem_count_record_owner_t()
+	{
+		if (t_memCountRecord != nullptr)
+		{
+			t_memCountRecord->m_isInUse.store(false);
+			t_memCountRecord = nullptr;
+		}
+	}
+};
+
+static thread_local mem_count_record_owner_t t_memCountRecordOwner;
+
+// ------------------------------------------------------------------------------------------------------------------------------
+static inline void AddToMemCountRecord(int64_t allocations_)
+{
+	mem_count_record_t* record = t_memCountRecord;
+	if (record == nullptr)
+	{
+		// Touching the owner is what registers its destructor for this thread;
+		(void)&t_memCountRecordOwner;
+		record = AcquireMemCountRecord();
+		t_memCountRecord = record;
+	}
+
+	record->m_allocationCount.store(record->m_allocationCount.load(std::memory_order_relaxed) + allocations_, std::memory_order_relaxed);
 }
 
+// ------------------------------------------------------------------------------------------------------------------------------
+static int64_t SumMemCountRecords()
+{
+	int64_t allocationCount = 0;
+	for (mem_count_record_t* record = s_memCountRecords.load(); record != nullptr; record = record->m_next)
+	{
+		allocationCount += record->m_allocationCount.load(std::memory_order_relaxed);
+	}
+
+	return allocationCount;
+}
+#endif
+
+// -----------------------------------------------------------------------
+// Tracker Shards
+// Live allocations are split over shards by address, so threads freeing and allocating different memory
+// rarely share a lock; each shard also counts its allocations per tag, under its own lock;
+// -----------------------------------------------------------------------
+constexpr uint MEM_TRACKER_SHARD_BITS = 6;
+constexpr uint MEM_TRACKER_SHARD_COUNT = 1 << MEM_TRACKER_SHARD_BITS;
+constexpr uint MEM_CALLSTACK_SHARD_COUNT = 16;
+constexpr uint MEM_SEEN_CALLSTACK_COUNT = 64;
+
+struct alignas(64) mem_tracker_shard_t
+{
+	std::mutex m_lock;
+	std::unordered_map<void*, mem_track_info_t, std::hash<void*>, std::equal_to<void*>, STLUntrackedAllocator<std::pair<void* const, mem_track_info_t>>> m_allocations;
+
+	// Only written under m_lock, read without it;
+	std::atomic<size_t> m_tagByteCounts[MEM_TAG_MAX] = {};
+	std::atomic<size_t> m_tagAllocationCounts[MEM_TAG_MAX] = {};
+};
+
+// Every distinct callstack once, never removed; there are only so many places that allocate;
+struct alignas(64) mem_callstack_shard_t
+{
+	std::mutex m_lock;
+	std::unordered_map<DWORD, Callstack, std::hash<DWORD>, std::equal_to<DWORD>, STLUntrackedAllocator<std::pair<const DWORD, Callstack>>> m_callstacks;
+};
+
+// Function statics, operator new can run before this file's globals are constructed;
+// ------------------------------------------------------------------------------------------------------------------------------
+static mem_tracker_shard_t* GetMemTrackerShards()
+{
+	static mem_tracker_shard_t s_shards[MEM_TRACKER_SHARD_COUNT];
+	return s_shards;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------
+static mem_callstack_shard_t* GetMemCallstackShards()
+{
+	static mem_callstack_shard_t s_shards[MEM_CALLSTACK_SHARD_COUNT];
+	return s_shards;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------
+static inline mem_tracker_shard_t& GetMemTrackerShard(void* allocation_)
+{
+	// Fibonacci hash, allocations are 16 byte aligned so the low bits say nothing;
+	uint64_t key = (uint64_t)(uintptr_t)allocation_ >> 4;
+	return GetMemTrackerShards()[(key * 0x9E3779B97F4A7C15ull) >> (64 - MEM_TRACKER_SHARD_BITS)];
+}
+
+static std::atomic<bool> s_isCallstackCaptureEnabled = true;
+
+// Callstacks this thread already put in the table, so a repeat allocation site skips its lock;
+static thread_local DWORD t_seenCallstackHashes[MEM_SEEN_CALLSTACK_COUNT] = {};
+
+// -----------------------------------------------------------------------
+// Tags
+// -----------------------------------------------------------------------
+struct mem_tag_registry_t
+{
+	std::mutex m_lock;
+	const char* m_names[MEM_TAG_MAX] = { "Untagged", "Renderer", "Audio", "Log", "Profiler", "Assets", "Arena" };
+	std::atomic<uint> m_count = MEM_TAG_ENGINE_COUNT;
+};
+
+static mem_tag_registry_t& GetMemTagRegistry()
+{
+	static mem_tag_registry_t s_registry;
+	return s_registry;
+}
+
+static thread_local uint8_t t_memTag = MEM_TAG_UNTAGGED;
 
 //-----------------------------------------------------------------------------------------------
 std::string GetSizeString(size_t byte_count)
@@ -83,20 +226,42 @@ void UntrackedFree(void* ptr)
 //-----------------------------------------------------------------------------------------------
 #if defined(MEM_TRACKING) 
 	#if MEM_TRACKING == MEM_TRACK_VERBOSE
-		static void TrackAllocation(void* allocation, size_t byte_count)
+		static DWORD CaptureCallstack()
 		{
-			memtrack_byteCount += byte_count;
-
 			Callstack callstack = GetCallstack();
+			DWORD hash = callstack.BackTraceHash;
+			if (hash == 0)
+			{
+				return 0;
+			}
 
+			DWORD& seen = t_seenCallstackHashes[hash % MEM_SEEN_CALLSTACK_COUNT];
+			if (seen != hash)
+			{
+				mem_callstack_shard_t& shard = GetMemCallstackShards()[hash % MEM_CALLSTACK_SHARD_COUNT];
+				std::scoped_lock<std::mutex> lock(shard.m_lock);
+				shard.m_callstacks.try_emplace(hash, callstack);
+				seen = hash;
+			}
+
+			return hash;
+		}
+
+		static void TrackAllocation(void* allocation, size_t byte_count)
+		{
 			mem_track_info_t memtrack_info;
-			memtrack_info.original_pointer = allocation;
 			memtrack_info.byte_size = byte_count;
-			memtrack_info.callstack = callstack;
+			memtrack_info.callstack_hash = s_isCallstackCaptureEnabled.load(std::memory_order_relaxed) ? CaptureCallstack() : 0;
+			memtrack_info.tag = t_memTag;
+
+			mem_tracker_shard_t& shard = GetMemTrackerShard(allocation);
+			std::scoped_lock<std::mutex> lock(shard.m_lock);
+			shard.m_allocations[allocation] = memtrack_info;
 
-			GetMemTrackerLock().lock();
-			GetMemTrakingMap()[allocation] = memtrack_info;
-			GetMemTrackerLock().unlock();
+			std::atomic<size_t>& tagBytes = shard.m_tagByteCounts[memtrack_info.tag];
+			std::atomic<size_t>& tagCount = shard.m_tagAllocationCounts[memtrack_info.tag];
+			tagBytes.store(tagBytes.load(std::memory_order_relaxed) + byte_count, std::memory_order_relaxed);
+			tagCount.store(tagCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 		}
 	#endif
 #endif
@@ -106,23 +271,25 @@ void UntrackedFree(void* ptr)
 	#if MEM_TRACKING == MEM_TRACK_VERBOSE
 		static void UntrackAllocation(void* allocation)
 		{
-			// This can be nullptr because we may delete a nullptr, its not a real problem...
-			// ... except when we try to find a nullptr in our memorymap
-			if (allocation)
+			mem_tracker_shard_t& shard = GetMemTrackerShard(allocation);
+			std::scoped_lock<std::mutex> lock(shard.m_lock);
+
+			auto it = shard.m_allocations.find(allocation);
+			if (it == shard.m_allocations.end())
 			{
-				GetMemTrackerLock().lock();
-				auto it = GetMemTrakingMap().find(allocation);
-				if (it == GetMemTrakingMap().end())
-				{
-					__debugbreak();
-				}
-
-				memtrack_byteCount -= it->second.byte_size;
-				t_freeBytes += it->second.byte_size;
-
-				GetMemTrakingMap().erase(it);
-				GetMemTrackerLock().unlock();
+				__debugbreak();
+				return;
 			}
+
+			const mem_track_info_t& memtrack_info = it->second;
+			t_freeBytes += memtrack_info.byte_size;
+
+			std::atomic<size_t>& tagBytes = shard.m_tagByteCounts[memtrack_info.tag];
+			std::atomic<size_t>& tagCount = shard.m_tagAllocationCounts[memtrack_info.tag];
+			tagBytes.store(tagBytes.load(std::memory_order_relaxed) - memtrack_info.byte_size, std::memory_order_relaxed);
+			tagCount.store(tagCount.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+			shard.m_allocations.erase(it);
 		}
 	#endif
 #endif
@@ -135,13 +302,13 @@ void* TrackedAlloc(size_t byte_count)
 #else
 	#if MEM_TRACKING == MEM_TRACK_ALLOC_COUNT
 
-		memtrack_allocationCount++;
+		AddToMemCountRecord(1);
 		t_allocCount++;
 		t_allocBytes += byte_count;
 		return UntrackedAlloc(byte_count);
 
 	#elif MEM_TRACKING == MEM_TRACK_VERBOSE
-		memtrack_allocationCount++;
+		// Counted by the shard it lands in, under the lock TrackAllocation takes anyway;
 		t_allocCount++;
 		t_allocBytes += byte_count;
 		void* allocation = UntrackedAlloc(byte_count);
@@ -156,13 +323,17 @@ void TrackedFree(void* ptr)
 #if !defined(MEM_TRACKING)
 	return UntrackedFree(ptr);
 #else
-		
+	// delete of a nullptr, nothing was counted for it;
+	if (!ptr)
+	{
+		return;
+	}
+
 	#if MEM_TRACKING == MEM_TRACK_ALLOC_COUNT
-		memtrack_allocationCount--;
+		AddToMemCountRecord(-1);
 		t_freeCount++;
 		UntrackedFree(ptr);
 	#elif MEM_TRACKING == MEM_TRACK_VERBOSE
-		memtrack_allocationCount--;
 		t_freeCount++;
 		UntrackAllocation(ptr);
 		UntrackedFree(ptr);
@@ -171,14 +342,44 @@ void TrackedFree(void* ptr)
 #endif
 }
 
+// The writers only keep their own counts, these add them up;
+//-----------------------------------------------------------------------------------------------
 size_t MemTrackGetLiveAllocationCount()
 {
-	return memtrack_allocationCount;
+#if defined(MEM_TRACKING) && MEM_TRACKING == MEM_TRACK_VERBOSE
+	size_t allocationCount = 0;
+	for (uint shardIndex = 0; shardIndex < MEM_TRACKER_SHARD_COUNT; ++shardIndex)
+	{
+		mem_tracker_shard_t& shard = GetMemTrackerShards()[shardIndex];
+		for (uint tag = 0; tag < MEM_TAG_MAX; ++tag)
+		{
+			allocationCount += shard.m_tagAllocationCounts[tag].load(std::memory_order_relaxed);
+		}
+	}
+	return allocationCount;
+#elif defined(MEM_TRACKING) && MEM_TRACKING == MEM_TRACK_ALLOC_COUNT
+	// Records are read one at a time while others keep counting, so clamp a momentary negative sum;
+	int64_t allocationCount = SumMemCountRecords();
+	return allocationCount > 0 ? (size_t)allocationCount : 0;
+#else
+	return 0;
+#endif
 }
 
+//-----------------------------------------------------------------------------------------------
 size_t MemTrackGetLiveByteCount()
 {
-	return memtrack_byteCount;
+	// Only MEM_TRACK_VERBOSE knows the size of what is freed;
+	size_t byteCount = 0;
+	for (uint shardIndex = 0; shardIndex < MEM_TRACKER_SHARD_COUNT; ++shardIndex)
+	{
+		mem_tracker_shard_t& shard = GetMemTrackerShards()[shardIndex];
+		for (uint tag = 0; tag < MEM_TAG_MAX; ++tag)
+		{
+			byteCount += shard.m_tagByteCounts[tag].load(std::memory_order_relaxed);
+		}
+	}
+	return byteCount;
 }
 
 struct 
@@ -191,61 +392,41 @@ struct
 
 void MemTrackLogLiveAllocations()
 {
-	std::map<void*, mem_track_info_t, std::less<void*>, STLUntrackedAllocator<std::pair<void* const, mem_track_info_t>>> secretMemTrackerMap;
-	
-	// Deep copy the mem tracker map
-	GetMemTrackerLock().lock();
-	auto copyIter = GetMemTrakingMap().begin();
-	while(copyIter != GetMemTrakingMap().end())
-	{
-		secretMemTrackerMap[copyIter->first] = copyIter->second;
-		copyIter++;
-	}
-	GetMemTrackerLock().unlock();
-
-	// Group things by callstack
+	// Group things by callstack, a shard at a time so allocating threads only wait on one;
+	// Untracked containers, a tracked allocation here would want a shard lock;
 	size_t totalByte = 0;
 	size_t totalAllocCount = 0;
 
-	std::map<DWORD, output_mem_track_info_t> condensedSecretMap;
-	auto backTraceHashIter = secretMemTrackerMap.begin();
-	while(backTraceHashIter != secretMemTrackerMap.end())
+	std::unordered_map<DWORD, output_mem_track_info_t, std::hash<DWORD>, std::equal_to<DWORD>, STLUntrackedAllocator<std::pair<const DWORD, output_mem_track_info_t>>> condensedSecretMap;
+	for (uint shardIndex = 0; shardIndex < MEM_TRACKER_SHARD_COUNT; ++shardIndex)
 	{
-		DWORD backtracehash = backTraceHashIter->second.callstack.BackTraceHash;
-
-		auto it = condensedSecretMap.find(backtracehash);
-		if(it == condensedSecretMap.end())
-		{
-			output_mem_track_info_t output_memtrack;
-			output_memtrack.allocation = 1;
-			output_memtrack.byte_size = backTraceHashIter->second.byte_size;
-			output_memtrack.callstack = backTraceHashIter->second.callstack;
-
-			condensedSecretMap[backtracehash] = output_memtrack;
+		mem_tracker_shard_t& shard = GetMemTrackerShards()[shardIndex];
+		std::scoped_lock<std::mutex> lock(shard.m_lock);
 
-			totalByte += output_memtrack.byte_size;
-			totalAllocCount++;
-		}
-		else
+		for (auto& allocation : shard.m_allocations)
 		{
-			it->second.allocation++;
-			it->second.byte_size += backTraceHashIter->second.byte_size;
+			output_mem_track_info_t& output_memtrack = condensedSecretMap[allocation.second.callstack_hash];
+			output_memtrack.allocation++;
+			output_memtrack.byte_size += allocation.second.byte_size;
 
-			totalByte += it->second.byte_size;
+			totalByte += allocation.second.byte_size;
 			totalAllocCount++;
 		}
-
-		backTraceHashIter++;
 	}
 
 	// Sort by byte size
-	std::vector<output_mem_track_info_t> logVector;
-	auto logIter = condensedSecretMap.begin();
-	while (logIter != condensedSecretMap.end())
+	std::vector<output_mem_track_info_t, STLUntrackedAllocator<output_mem_track_info_t>> logVector;
+	for (auto& condensed : condensedSecretMap)
 	{
-		logVector.emplace_back(logIter->second);
+		mem_callstack_shard_t& callstackShard = GetMemCallstackShards()[condensed.first % MEM_CALLSTACK_SHARD_COUNT];
+		std::scoped_lock<std::mutex> lock(callstackShard.m_lock);
 
-		logIter++;
+		auto found = callstackShard.m_callstacks.find(condensed.first);
+		if (found != callstackShard.m_callstacks.end())
+		{
+			condensed.second.callstack = found->second;
+		}
+		logVector.emplace_back(condensed.second);
 	}
 
 	std::sort(logVector.begin(), logVector.end(), VecCompareFunction);
@@ -256,22 +437,183 @@ void MemTrackLogLiveAllocations()
 	std::string formattedBytes = GetSizeString(totalByte);
 	DebuggerPrintf("===========\n");
 	DebuggerPrintf("%s", formattedBytes.c_str());
-	DebuggerPrintf(" from %d allocations\n", totalAllocCount);
+	DebuggerPrintf(" from %zu allocations\n", totalAllocCount);
 	DebuggerPrintf("===========\n\n");
 
+	mem_tag_stats_t tagStats[MEM_TAG_MAX];
+	MemTrackGetAllTagStats(tagStats);
+	for (uint tag = 0; tag < MemTagGetCount(); ++tag)
+	{
+		formattedBytes = GetSizeString(tagStats[tag].m_liveByteCount);
+		DebuggerPrintf("%-12s %s from %zu allocations\n", MemTagGetName(tag), formattedBytes.c_str(), tagStats[tag].m_liveAllocationCount);
+	}
+
 	for(int i = 0; i < logVector.size(); i++)
 	{
 		formattedBytes = GetSizeString(logVector[i].byte_size);
 		DebuggerPrintf("\n\n======================\n");
 		DebuggerPrintf("%s", formattedBytes.c_str());
-		DebuggerPrintf(" from %d allocations\n", logVector[i].allocation);
+		DebuggerPrintf(" from %zu allocations\n", logVector[i].allocation);
 		DebuggerPrintf("======================\n");
-		CallstackToString(logVector[i].callstack);
+		if (logVector[i].callstack.frames > 0)
+		{
+			CallstackToString(logVector[i].callstack);
+		}
+		else
+		{
+			DebuggerPrintf("No callstack captured\n");
+		}
 	}
 	
 	DebuggerPrintf("\n=== END OF LOG ===\n\n\n");
 }
 
+//-----------------------------------------------------------------------------------------------
+void MemTrackSetCallstackCapture(bool isEnabled_)
+{
+	s_isCallstackCaptureEnabled = isEnabled_;
+}
+
+//-----------------------------------------------------------------------------------------------
+uint MemTagRegister(const char* name_)
+{
+	mem_tag_registry_t& registry = GetMemTagRegistry();
+	std::scoped_lock<std::mutex> lock(registry.m_lock);
+
+	uint count = registry.m_count;
+	for (uint tag = 0; tag < count; ++tag)
+	{
+		if (strcmp(registry.m_names[tag], name_) == 0)
+		{
+			return tag;
+		}
+	}
+
+	if (count == MEM_TAG_MAX)
+	{
+		return MEM_TAG_UNTAGGED;
+	}
+
+	registry.m_names[count] = name_;
+	registry.m_count = count + 1;
+	return count;
+}
+
+//-----------------------------------------------------------------------------------------------
+uint MemTagGetCount()
+{
+	return GetMemTagRegistry().m_count;
+}
+
+//-----------------------------------------------------------------------------------------------
+const char* MemTagGetName(uint tag_)
+{
+	return tag_ < MemTagGetCount() ? GetMemTagRegistry().m_names[tag_] : "";
+}
+
+//-----------------------------------------------------------------------------------------------
+mem_tag_stats_t MemTrackGetTagStats(uint tag_)
+{
+	mem_tag_stats_t stats;
+	if (tag_ >= MEM_TAG_MAX)
+	{
+		return stats;
+	}
+
+	for (uint shardIndex = 0; shardIndex < MEM_TRACKER_SHARD_COUNT; ++shardIndex)
+	{
+		mem_tracker_shard_t& shard = GetMemTrackerShards()[shardIndex];
+		stats.m_liveByteCount += shard.m_tagByteCounts[tag_].load(std::memory_order_relaxed);
+		stats.m_liveAllocationCount += shard.m_tagAllocationCounts[tag_].load(std::memory_order_relaxed);
+	}
+
+	return stats;
+}
+
+//-----------------------------------------------------------------------------------------------
+void MemTrackGetAllTagStats(mem_tag_stats_t* outStats_)
+{
+	uint tagCount = MemTagGetCount();
+	for (uint tag = 0; tag < tagCount; ++tag)
+	{
+		outStats_[tag] = mem_tag_stats_t();
+	}
+
+	// Shard by shard, each one's counters share its cache lines;
+	for (uint shardIndex = 0; shardIndex < MEM_TRACKER_SHARD_COUNT; ++shardIndex)
+	{
+		mem_tracker_shard_t& shard = GetMemTrackerShards()[shardIndex];
+		for (uint tag = 0; tag < tagCount; ++tag)
+		{
+			outStats_[tag].m_liveByteCount += shard.m_tagByteCounts[tag].load(std::memory_order_relaxed);
+			outStats_[tag].m_liveAllocationCount += shard.m_tagAllocationCounts[tag].load(std::memory_order_relaxed);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+MemTagScope::MemTagScope(uint tag_)
+	: m_previousTag(t_memTag)
+{
+	t_memTag = (uint8_t)(tag_ < MEM_TAG_MAX ? tag_ : MEM_TAG_UNTAGGED);
+}
+
+//-----------------------------------------------------------------------------------------------
+MemTagScope::~MemTagScope()
+{
+	t_memTag = m_previousTag;
+}
+
+// -----------------------------------------------------------------------
+// Commands
+// mem_tags;
+static bool MemTagsCommand(EventArgs& args)
+{
+	args;
+
+#if !defined(MEM_TRACKING) || MEM_TRACKING != MEM_TRACK_VERBOSE
+	PrintLine("Memory tags are only counted with MEM_TRACKING MEM_TRACK_VERBOSE");
+#endif
+
+	mem_tag_stats_t tagStats[MEM_TAG_MAX];
+	MemTrackGetAllTagStats(tagStats);
+
+	PrintLine(Stringf("Memory: %s live in %zu allocations", GetSizeString(MemTrackGetLiveByteCount()).c_str(), MemTrackGetLiveAllocationCount()));
+	for (uint tag = 0; tag < MemTagGetCount(); ++tag)
+	{
+		PrintLine(Stringf("  %-12s %14s  %10zu allocations", MemTagGetName(tag), GetSizeString(tagStats[tag].m_liveByteCount).c_str(), tagStats[tag].m_liveAllocationCount));
+	}
+
+	return true;
+}
+
+// mem_log_live;
+static bool MemLogLiveCommand(EventArgs& args)
+{
+	args;
+
+	MemTrackLogLiveAllocations();
+	return true;
+}
+
+// mem_callstacks enabled=true;
+static bool MemCallstacksCommand(EventArgs& args)
+{
+	bool isEnabled = args.GetValue("enabled", true);
+	MemTrackSetCallstackCapture(isEnabled);
+	PrintLine(Stringf("Memory tracking callstacks %s", isEnabled ? "on" : "off"));
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+void MemTrackSystemInit()
+{
+	g_theEventSystem->SubscriptionEventCallbackFunction("mem_tags", MemTagsCommand);
+	g_theEventSystem->SubscriptionEventCallbackFunction("mem_log_live", MemLogLiveCommand);
+	g_theEventSystem->SubscriptionEventCallbackFunction("mem_callstacks", MemCallstacksCommand);
+}
+
 // Overload new and delete to use tracked allocations
 void* operator new(size_t size)
 {
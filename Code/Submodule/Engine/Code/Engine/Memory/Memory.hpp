@@ -10,15 +10,18 @@
 #include <string>
 #include <atomic>
 #include <thread>
+#include <mutex>
 #include <chrono>
+#include <stdint.h>
 
 typedef unsigned int uint;
 
+// A live allocation, MEM_TRACK_VERBOSE; the callstack is kept once per BackTraceHash in a shared table;
 struct mem_track_info_t
 {
-	void* original_pointer;
 	size_t byte_size;
-	Callstack callstack;
+	DWORD callstack_hash;		// 0 without a callstack;
+	uint8_t tag;
 };
 
 struct output_mem_track_info_t
@@ -56,6 +59,65 @@ size_t MemTrackGetLiveAllocationCount();
 size_t MemTrackGetLiveByteCount();
 void MemTrackLogLiveAllocations();
 
+// Registers mem_tags, mem_log_live and mem_callstacks;
+void MemTrackSystemInit();
+
+// Capturing the callstack is most of what a verbose allocation costs; without it allocations are still
+// tracked and tagged, they just group under no callstack in MemTrackLogLiveAllocations;
+void MemTrackSetCallstackCapture(bool isEnabled_);
+
+// -----------------------------------------------------------------------
+// Tags
+// Every allocation counts against the tag of the MEM_TAG_SCOPE it was made in, MEM_TAG_UNTAGGED outside of one;
+// Live bytes and counts per tag are kept with MEM_TRACK_VERBOSE only, a free needs to know the size and tag;
+// Reading them takes no lock, cheap enough for every frame;
+// -----------------------------------------------------------------------
+constexpr uint MEM_TAG_MAX = 32;
+
+enum eMemTag : uint8_t
+{
+	MEM_TAG_UNTAGGED = 0,
+	MEM_TAG_RENDERER,
+	MEM_TAG_AUDIO,
+	MEM_TAG_LOG,
+	MEM_TAG_PROFILER,
+	MEM_TAG_ASSETS,
+	MEM_TAG_ARENA,
+
+	MEM_TAG_ENGINE_COUNT		// The game's tags come from MemTagRegister;
+};
+
+// The name is kept by pointer; registering a name again gives back the same tag;
+// MEM_TAG_UNTAGGED once all MEM_TAG_MAX are taken;
+uint MemTagRegister(const char* name_);
+uint MemTagGetCount();
+const char* MemTagGetName(uint tag_);
+
+struct mem_tag_stats_t
+{
+	size_t m_liveByteCount = 0;
+	size_t m_liveAllocationCount = 0;
+};
+mem_tag_stats_t MemTrackGetTagStats(uint tag_);
+void MemTrackGetAllTagStats(mem_tag_stats_t* outStats_);		// MemTagGetCount of them;
+
+class MemTagScope
+{
+
+public:
+
+	explicit MemTagScope(uint tag_);
+	~MemTagScope();
+
+private:
+
+	uint8_t m_previousTag;
+};
+
+#define MEM_TAG_COMBINE1(X,Y) X##Y
+#define MEM_TAG_COMBINE(X,Y) MEM_TAG_COMBINE1(X,Y)
+#define MEM_TAG_SCOPE( tag ) MemTagScope MEM_TAG_COMBINE(__memTag, __LINE__)(tag)
+
 
 
 
@@ -0,0 +1,274 @@
+#pragma once
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <stdint.h>
+#include <new>
+#include <utility>
+#include <vector>
+
+// ------------------------------------------------------------------------------------------------
+// Handle into an ObjectPool; the generation goes stale once the object it was taken from is destroyed;
+// ------------------------------------------------------------------------------------------------
+struct PoolHandle
+{
+	static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+	uint32_t m_index = INVALID_INDEX;
+	uint32_t m_generation = 0;
+
+	inline bool IsValid() const										{ return m_index != INVALID_INDEX; }
+	inline bool operator==(const PoolHandle& compare_) const		{ return m_index == compare_.m_index && m_generation == compare_.m_generation; }
+	inline bool operator!=(const PoolHandle& compare_) const		{ return !(*this == compare_); }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Owns objects of a single type in fixed-size chunks of slots;
+// Chunks are never moved or freed until the pool is, so pointers stay valid for as long as the object lives;
+// Destroyed slots go on a free list and are reused first, so churn doesn't touch the heap once warmed up;
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK = 64>
+class ObjectPool
+{
+
+public:
+
+	ObjectPool() = default;
+	~ObjectPool();
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	template <typename ...ARGS>
+	T* Create(ARGS&&... args_);
+	void Destroy(T* object_);
+	void Destroy(PoolHandle handle_);
+	void DestroyAll();
+
+	T* Get(PoolHandle handle_) const;
+	PoolHandle GetHandle(const T* object_) const;
+	bool IsAlive(PoolHandle handle_) const;
+	bool Owns(const T* object_) const;
+	uint32_t GetAliveCount() const									{ return m_aliveCount; }
+	uint32_t GetCapacity() const									{ return (uint32_t)m_chunks.size() * SLOTS_PER_CHUNK; }
+
+	// Visits alive objects in slot order, chunk by chunk, so the walk goes through memory front to back;
+	// func_ must not create or destroy objects in this pool;
+	template <typename FUNC>
+	void ForEach(FUNC func_) const;
+
+	// The first alive object, in slot order, func_ returns true for; nullptr if none;
+	template <typename FUNC>
+	T* FindIf(FUNC func_) const;
+
+private:
+
+	// m_storage has to stay first so a T* can be turned back into its Slot*;
+	struct Slot
+	{
+		alignas(T) unsigned char m_storage[sizeof(T)];
+		uint32_t m_index = PoolHandle::INVALID_INDEX;
+		uint32_t m_generation = 0;
+		uint32_t m_nextFree = PoolHandle::INVALID_INDEX;
+		bool m_isAlive = false;
+
+		inline T* GetPointer()										{ return reinterpret_cast<T*>(m_storage); }
+	};
+
+	Slot* GetSlot(uint32_t index_) const							{ return &m_chunks[index_ / SLOTS_PER_CHUNK][index_ % SLOTS_PER_CHUNK]; }
+	Slot* GetSlot(const T* object_) const							{ return reinterpret_cast<Slot*>(const_cast<T*>(object_)); }
+	void AddChunk();
+
+private:
+
+	std::vector<Slot*> m_chunks;
+	uint32_t m_firstFree = PoolHandle::INVALID_INDEX;
+	uint32_t m_aliveCount = 0;
+};
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+ObjectPool<T, SLOTS_PER_CHUNK>::~ObjectPool()
+{
+	DestroyAll();
+
+	for (Slot* chunk : m_chunks)
+	{
+		delete[] chunk;
+	}
+	m_chunks.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+template <typename ...ARGS>
+T* ObjectPool<T, SLOTS_PER_CHUNK>::Create(ARGS&&... args_)
+{
+	if (m_firstFree == PoolHandle::INVALID_INDEX)
+	{
+		AddChunk();
+	}
+
+	Slot* slot = GetSlot(m_firstFree);
+	m_firstFree = slot->m_nextFree;
+
+	slot->m_nextFree = PoolHandle::INVALID_INDEX;
+	slot->m_isAlive = true;
+	m_aliveCount++;
+
+	return new (slot->m_storage) T(std::forward<ARGS>(args_)...);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+void ObjectPool<T, SLOTS_PER_CHUNK>::Destroy(T* object_)
+{
+	if (object_ == nullptr)
+	{
+		return;
+	}
+
+	Slot* slot = GetSlot(object_);
+	GUARANTEE_OR_DIE(slot->m_isAlive, "ObjectPool tried to destroy an object that is not alive.");
+
+	object_->~T();
+
+	// Bumping the generation makes every handle to this slot stale;
+	slot->m_generation++;
+	slot->m_isAlive = false;
+	slot->m_nextFree = m_firstFree;
+	m_firstFree = slot->m_index;
+	m_aliveCount--;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+void ObjectPool<T, SLOTS_PER_CHUNK>::Destroy(PoolHandle handle_)
+{
+	Destroy(Get(handle_));
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+void ObjectPool<T, SLOTS_PER_CHUNK>::DestroyAll()
+{
+	uint32_t capacity = GetCapacity();
+	for (uint32_t index = 0; index < capacity; ++index)
+	{
+		Slot* slot = GetSlot(index);
+		if (slot->m_isAlive)
+		{
+			Destroy(slot->GetPointer());
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+T* ObjectPool<T, SLOTS_PER_CHUNK>::Get(PoolHandle handle_) const
+{
+	if (!IsAlive(handle_))
+	{
+		return nullptr;
+	}
+
+	return GetSlot(handle_.m_index)->GetPointer();
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+PoolHandle ObjectPool<T, SLOTS_PER_CHUNK>::GetHandle(const T* object_) const
+{
+	PoolHandle handle;
+	if (object_ == nullptr)
+	{
+		return handle;
+	}
+
+	const Slot* slot = GetSlot(object_);
+	handle.m_index = slot->m_index;
+	handle.m_generation = slot->m_generation;
+	return handle;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+bool ObjectPool<T, SLOTS_PER_CHUNK>::IsAlive(PoolHandle handle_) const
+{
+	if (!handle_.IsValid() || handle_.m_index >= GetCapacity())
+	{
+		return false;
+	}
+
+	const Slot* slot = GetSlot(handle_.m_index);
+	return slot->m_isAlive && slot->m_generation == handle_.m_generation;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+bool ObjectPool<T, SLOTS_PER_CHUNK>::Owns(const T* object_) const
+{
+	const Slot* slot = reinterpret_cast<const Slot*>(object_);
+	for (const Slot* chunk : m_chunks)
+	{
+		if (slot >= chunk && slot < chunk + SLOTS_PER_CHUNK)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+template <typename FUNC>
+void ObjectPool<T, SLOTS_PER_CHUNK>::ForEach(FUNC func_) const
+{
+	for (Slot* chunk : m_chunks)
+	{
+		for (uint32_t slotIndex = 0; slotIndex < SLOTS_PER_CHUNK; ++slotIndex)
+		{
+			if (chunk[slotIndex].m_isAlive)
+			{
+				func_(chunk[slotIndex].GetPointer());
+			}
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+template <typename FUNC>
+T* ObjectPool<T, SLOTS_PER_CHUNK>::FindIf(FUNC func_) const
+{
+	for (Slot* chunk : m_chunks)
+	{
+		for (uint32_t slotIndex = 0; slotIndex < SLOTS_PER_CHUNK; ++slotIndex)
+		{
+			if (chunk[slotIndex].m_isAlive && func_(chunk[slotIndex].GetPointer()))
+			{
+				return chunk[slotIndex].GetPointer();
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T, uint32_t SLOTS_PER_CHUNK>
+void ObjectPool<T, SLOTS_PER_CHUNK>::AddChunk()
+{
+	uint32_t firstIndex = GetCapacity();
+	Slot* chunk = new Slot[SLOTS_PER_CHUNK];
+	m_chunks.push_back(chunk);
+
+	// Thread the new slots onto the free list in order so they are handed out front to back;
+	for (uint32_t slotIndex = 0; slotIndex < SLOTS_PER_CHUNK; ++slotIndex)
+	{
+		chunk[slotIndex].m_index = firstIndex + slotIndex;
+		chunk[slotIndex].m_nextFree = (slotIndex + 1 < SLOTS_PER_CHUNK) ? firstIndex + slotIndex + 1 : m_firstFree;
+	}
+
+	m_firstFree = firstIndex;
+}
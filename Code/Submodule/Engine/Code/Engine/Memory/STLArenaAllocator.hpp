@@ -0,0 +1,66 @@
+#pragma once
+#include "Engine/Memory/ArenaAllocator.hpp"
+
+#include <limits>
+#include <new>
+#include <vector>
+#undef max
+
+// Containers made on a thread take that thread's arena of LIFETIME, and must be gone, or emptied with a swap,
+// before it resets; clear keeps the memory; Their deallocate does nothing;
+template <typename T, eArenaLifetime LIFETIME = ARENA_FRAME>
+struct STLArenaAllocator
+{
+	using value_type = T;
+
+	template <class U>
+	struct rebind
+	{
+		using other = STLArenaAllocator<U, LIFETIME>;
+	};
+
+	STLArenaAllocator()
+		: m_arena(&ArenaGet(LIFETIME)) {}
+	explicit STLArenaAllocator(ArenaAllocator& arena_)
+		: m_arena(&arena_) {}
+	template <class U>
+	STLArenaAllocator(const STLArenaAllocator<U, LIFETIME>& other_)
+		: m_arena(other_.m_arena) {}
+
+	T* allocate(std::size_t n)
+	{
+		if (n <= std::numeric_limits<std::size_t>::max() / sizeof(T))
+		{
+			if (void* ptr = m_arena->alloc_aligned(n * sizeof(T), alignof(T) > ARENA_DEFAULT_ALIGNMENT ? alignof(T) : ARENA_DEFAULT_ALIGNMENT))
+			{
+				return static_cast<T*>(ptr);
+			}
+		}
+		throw std::bad_alloc();
+	}
+	void deallocate(T* ptr, std::size_t n)
+	{
+		n;
+		m_arena->free(ptr);
+	}
+
+	ArenaAllocator* m_arena;
+};
+
+template <typename T, typename U, eArenaLifetime LIFETIME>
+inline bool operator == (const STLArenaAllocator<T, LIFETIME>& a, const STLArenaAllocator<U, LIFETIME>& b)
+{
+	return a.m_arena == b.m_arena;
+}
+
+template <typename T, typename U, eArenaLifetime LIFETIME>
+inline bool operator != (const STLArenaAllocator<T, LIFETIME>& a, const STLArenaAllocator<U, LIFETIME>& b)
+{
+	return !(a == b);
+}
+
+template <typename T>
+using FrameVector = std::vector<T, STLArenaAllocator<T, ARENA_FRAME>>;
+
+template <typename T>
+using PhaseVector = std::vector<T, STLArenaAllocator<T, ARENA_PHASE>>;
@@ -1,195 +1,635 @@
 #include "Engine/Profile/Profile.hpp"
 #include "Engine/Core/Time.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
-#include "Engine/Memory/BlockAllocator.hpp"
 #include "Engine/Memory/Memory.hpp"
 #include "Engine/Log/Log.hpp"
+#include "Engine/Profile/ProfileExport.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 
 #define WIN32_LEAN_AND_MEAN
 #include "windows.h"
 
+#if defined(_M_X64) || defined(__x86_64__)
+	#define PROFILER_USE_TSC
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+#endif
+
+// -----------------------------------------------------------------------
+// One begin or end event in a thread's ring, written by that thread only; 32 bytes, two to a cache line;
+// The counters are the thread's totals at the event, the Tree holds the difference; 32 bits wrap harmlessly,
+// as long as a single scope allocates less than 4 GB;
+// -----------------------------------------------------------------------
+struct profiler_event_t
+{
+	const char* label;		// nullptr for an end event;
+	uint64_t ticksAndDepth;	// Ticks in the low 56 bits; depth of the scope begun or ended in the top 8, lets a reader that lost the start of a Tree find the next root;
+	uint32_t allocBytes;
+	uint32_t freeBytes;
+	uint32_t allocCount;
+	uint32_t freeCount;
+};
+
+constexpr uint PROFILER_EVENT_TICK_BITS = 56;
+constexpr uint64_t PROFILER_EVENT_TICK_MASK = (1ull << PROFILER_EVENT_TICK_BITS) - 1;
+
+static inline uint64_t GetEventTicks(const profiler_event_t& event_)			{ return event_.ticksAndDepth & PROFILER_EVENT_TICK_MASK; }
+static inline uint8_t GetEventDepth(const profiler_event_t& event_)			{ return (uint8_t)(event_.ticksAndDepth >> PROFILER_EVENT_TICK_BITS); }
+
+// -----------------------------------------------------------------------
+// A thread's ring; m_writeIndex only grows, an event lives at index & m_mask until it is lapped;
+// Rings outlive their thread, the next thread to start takes over a finished one;
+// -----------------------------------------------------------------------
+struct profiler_thread_buffer_t
+{
+	profiler_event_t* m_events = nullptr;
+	uint64_t m_mask = 0;
+	std::atomic<uint64_t> m_writeIndex = 0;
+
+	// Guarded by g_ThreadBuffersLock;
+	uint64_t m_firstIndex = 0;			// Events before this are from the thread that had the ring before;
+	std::thread::id m_threadID;
+	bool m_isInUse = false;
+};
+
+// -----------------------------------------------------------------------
+// Hands the ring back when its thread exits;
+// -----------------------------------------------------------------------
+struct profiler_thread_buffer_owner_t
+{
+	profiler_thread_buffer_t* m_buffer = nullptr;
+	uint m_generation = 0;
+
+	~profiler_thread_buffer_owner_t();
+};
+
 // -----------------------------------------------------------------------
 ProfilerReport* g_theProfilerReport = nullptr;
 
-static thread_local profiler_node_t* t_ActiveNode = nullptr;
+static thread_local profiler_thread_buffer_t* t_buffer = nullptr;
+static thread_local uint t_bufferGeneration = 0;
+static thread_local profiler_thread_buffer_owner_t t_bufferOwner;
 static thread_local int t_ProfilerDepth = 0;
+static thread_local bool t_isRecording = false;		// Decided when the root is pushed, so a pause lets current Trees finish;
 
+// Bumped by init and deinit, a thread's cached ring pointer is only good for the generation it was handed out in;
+static std::atomic<uint> g_profilerGeneration = 0;
+static std::vector<profiler_thread_buffer_t*> g_ThreadBuffers;
+static std::mutex g_ThreadBuffersLock;
+static uint64_t g_eventsPerThread = PROFILER_DEFAULT_EVENTS_PER_THREAD;
+
+// Built from the rings on the first request after ProfilerUpdate, owned until the next one;
 static std::vector<profiler_node_t*> g_History;
+static bool g_isHistoryBuilt = false;
 static std::shared_mutex g_HistoryLock;
 static double g_maxHistoryTime = 10.0;
 
-static bool g_isProfilerPaused = false;
+static std::atomic<bool> g_isProfilerPaused = false;
+
+static std::vector<profiler_thread_name_t> g_ThreadNames;
+static std::mutex g_ThreadNamesLock;
+
+// A ring, g_MemorySampleCount of them are valid;
+static profiler_memory_sample_t* g_MemorySamples = nullptr;
+static uint g_nextMemorySample = 0;
+static uint g_MemorySampleCount = 0;
+static std::mutex g_MemorySamplesLock;
+
+// Ticks to GetCurrentTimeSeconds; calibrated at init and refined each time the history is built;
+static uint64_t g_ticksAtInit = 0;
+static double g_secondsAtInit = 0.0;
+static double g_ticksPerSecond = 1.0;
 
 // -----------------------------------------------------------------------
-static profiler_node_t* AllocNode()
+// Statics Used for Callbacks
+// -----------------------------------------------------------------------
+static bool ProfileExportCommand(EventArgs& args)
 {
-	profiler_node_t* node = (profiler_node_t*)g_theBlockAllocatorOnlyForProfilerNodeT->alloc(sizeof(profiler_node_t));
-	if(node)
-	{
-		node->refCount = 1;
-	}
+	std::string format = args.GetValue("format", "json");
+	bool binary = (format == "binary" || format == "bin");
+	std::string defaultPath = binary ? "Data/Log/profile.prof" : "Data/Log/profile.json";
+	std::string path = args.GetValue("file", defaultPath);
 
-	GUARANTEE_OR_DIE(node, "Returned nullptr when requested a block.");
+	ProfilerExportAsync(path.c_str(), binary ? PROFILE_EXPORT_BINARY : PROFILE_EXPORT_CHROME_JSON);
 
-	return node;
+	return true;
 }
 
 // -----------------------------------------------------------------------
-bool ProfilerSystemInit()
+// Timing;
+// -----------------------------------------------------------------------
+static inline uint64_t ReadProfilerTicks()
 {
-	g_theBlockAllocatorOnlyForProfilerNodeT = new BlockAllocator();
-
-	size_t size = 1'000'000'000;
-	void* buffer = UntrackedAlloc(size);
-	g_theBlockAllocatorOnlyForProfilerNodeT->init(buffer, size, sizeof(profiler_node_t), alignof(profiler_node_t));
+#if defined(PROFILER_USE_TSC)
+	return __rdtsc();
+#else
+	return (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
 
-	return true;
+// -----------------------------------------------------------------------
+static void CalibrateProfilerTicks()
+{
+#if defined(PROFILER_USE_TSC)
+	// Long enough that the timer's resolution doesn't matter, short enough not to be noticed at startup;
+	uint64_t startTicks = ReadProfilerTicks();
+	double startSeconds = GetCurrentTimeSeconds();
+	double endSeconds = startSeconds;
+	while(endSeconds - startSeconds < 0.01)
+	{
+		endSeconds = GetCurrentTimeSeconds();
+	}
+	uint64_t endTicks = ReadProfilerTicks();
+
+	g_ticksPerSecond = (double)(endTicks - startTicks) / (endSeconds - startSeconds);
+	g_ticksAtInit = endTicks;
+	g_secondsAtInit = endSeconds;
+#else
+	g_ticksPerSecond = (double)std::chrono::steady_clock::period::den / (double)std::chrono::steady_clock::period::num;
+	g_ticksAtInit = ReadProfilerTicks();
+	g_secondsAtInit = GetCurrentTimeSeconds();
+#endif
 }
 
 // -----------------------------------------------------------------------
-void ProfilerSystemDeinit()
+static void RefineProfilerTicks()
 {
-	g_theBlockAllocatorOnlyForProfilerNodeT->deinit();
+#if defined(PROFILER_USE_TSC)
+	uint64_t ticks = ReadProfilerTicks();
+	double seconds = GetCurrentTimeSeconds();
+	if(seconds - g_secondsAtInit > 1.0)
+	{
+		g_ticksPerSecond = (double)(ticks - g_ticksAtInit) / (seconds - g_secondsAtInit);
+	}
+#endif
+}
 
-	delete g_theBlockAllocatorOnlyForProfilerNodeT;
-	g_theBlockAllocatorOnlyForProfilerNodeT = nullptr;
+// -----------------------------------------------------------------------
+// Only the low PROFILER_EVENT_TICK_BITS count, events don't keep the rest;
+static inline double ProfilerTicksToSeconds(uint64_t ticks_)
+{
+	uint64_t shift = 64 - PROFILER_EVENT_TICK_BITS;
+	int64_t deltaTicks = (int64_t)((ticks_ - g_ticksAtInit) << shift) >> shift;
+	return g_secondsAtInit + (double)deltaTicks / g_ticksPerSecond;
 }
 
 // -----------------------------------------------------------------------
-void ProfilerSetMaxHistoryTime(double seconds_)
+// Thread Rings;
+// -----------------------------------------------------------------------
+profiler_thread_buffer_owner_t::~profiler_thread_buffer_owner_t()
 {
-	g_maxHistoryTime = seconds_;
+	std::scoped_lock<std::mutex> lock(g_ThreadBuffersLock);
+	if(m_buffer && m_generation == g_profilerGeneration)
+	{
+		m_buffer->m_isInUse = false;
+	}
 }
 
 // -----------------------------------------------------------------------
-void ProfilerUpdate()
+static profiler_thread_buffer_t* AcquireThreadBuffer()
 {
-	double time = GetCurrentTimeSeconds();
+	std::scoped_lock<std::mutex> lock(g_ThreadBuffersLock);
+
+	uint generation = g_profilerGeneration;
+	if(generation % 2 == 0)
+	{
+		// Not running;
+		return nullptr;
+	}
 
-	for(auto it = g_History.begin(); it != g_History.end();)
+	profiler_thread_buffer_t* buffer = nullptr;
+	for(profiler_thread_buffer_t* threadBuffer : g_ThreadBuffers)
 	{
-		if ((time - (*it)->startTime) > g_maxHistoryTime)
+		if(!threadBuffer->m_isInUse)
 		{
-			ProfileReleaseTree((*it));
-			it = g_History.erase(it);
+			buffer = threadBuffer;
+			break;
 		}
-		else
+	}
+
+	if(!buffer)
+	{
+		buffer = new profiler_thread_buffer_t();
+		buffer->m_events = (profiler_event_t*)UntrackedAlloc(sizeof(profiler_event_t) * g_eventsPerThread);
+		buffer->m_mask = g_eventsPerThread - 1;
+		g_ThreadBuffers.push_back(buffer);
+	}
+
+	buffer->m_firstIndex = buffer->m_writeIndex.load(std::memory_order_relaxed);
+	buffer->m_threadID = std::this_thread::get_id();
+	buffer->m_isInUse = true;
+
+	t_buffer = buffer;
+	t_bufferGeneration = generation;
+	t_bufferOwner.m_buffer = buffer;
+	t_bufferOwner.m_generation = generation;
+
+	return buffer;
+}
+
+// -----------------------------------------------------------------------
+static inline void AppendEvent(const char* label_, uint32_t depth_)
+{
+	profiler_thread_buffer_t* buffer = t_buffer;
+	uint generation = g_profilerGeneration.load(std::memory_order_relaxed);
+	if(!buffer || t_bufferGeneration != generation)
+	{
+		// An even generation is not running; AcquireThreadBuffer would only find that out under the lock;
+		if(generation % 2 == 0)
+		{
+			return;
+		}
+
+		buffer = AcquireThreadBuffer();
+		if(!buffer)
 		{
-			++it;
+			return;
 		}
 	}
+
+	uint64_t writeIndex = buffer->m_writeIndex.load(std::memory_order_relaxed);
+	profiler_event_t& event = buffer->m_events[writeIndex & buffer->m_mask];
+	event.label = label_;
+	event.ticksAndDepth = (ReadProfilerTicks() & PROFILER_EVENT_TICK_MASK) | ((uint64_t)(uint8_t)depth_ << PROFILER_EVENT_TICK_BITS);
+	event.allocBytes = (uint32_t)t_allocBytes;
+	event.freeBytes = (uint32_t)t_freeBytes;
+	event.allocCount = (uint32_t)t_allocCount;
+	event.freeCount = (uint32_t)t_freeCount;
+
+	buffer->m_writeIndex.store(writeIndex + 1, std::memory_order_release);
 }
 
 // -----------------------------------------------------------------------
-void ProfilerPause()
+// Tree Building;
+// -----------------------------------------------------------------------
+static void FreeTree(profiler_node_t* node)
 {
-	g_isProfilerPaused = true;
+	std::vector<profiler_node_t*> stack;
+	if(node)
+	{
+		stack.push_back(node);
+	}
+
+	while(!stack.empty())
+	{
+		profiler_node_t* top = stack.back();
+		stack.pop_back();
+
+		for(profiler_node_t* child = top->lastChild; child != nullptr; child = child->previousSibling)
+		{
+			stack.push_back(child);
+		}
+
+		delete top;
+	}
 }
 
 // -----------------------------------------------------------------------
-void ProfilerResume()
+// Whatever the ring still holds, copied out; events the writer laps while we copy are dropped after;
+// -----------------------------------------------------------------------
+static void CopyThreadEvents(profiler_thread_buffer_t* buffer_, std::vector<profiler_event_t>* outEvents_)
 {
-	g_isProfilerPaused = false;
+	uint64_t capacity = buffer_->m_mask + 1;
+	uint64_t writeIndex = buffer_->m_writeIndex.load(std::memory_order_acquire);
+	// The slot of the event being written right now still holds the oldest one, half overwritten;
+	uint64_t readIndex = writeIndex + 1 > capacity ? writeIndex + 1 - capacity : 0;
+	readIndex = readIndex > buffer_->m_firstIndex ? readIndex : buffer_->m_firstIndex;
+
+	outEvents_->clear();
+	outEvents_->reserve((size_t)(writeIndex - readIndex));
+	for(uint64_t eventIndex = readIndex; eventIndex < writeIndex; ++eventIndex)
+	{
+		outEvents_->push_back(buffer_->m_events[eventIndex & buffer_->m_mask]);
+	}
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	uint64_t newWriteIndex = buffer_->m_writeIndex.load(std::memory_order_relaxed);
+	uint64_t firstSafeIndex = newWriteIndex + 1 > capacity ? newWriteIndex + 1 - capacity : 0;
+	if(firstSafeIndex > readIndex)
+	{
+		size_t lappedCount = (size_t)std::min(firstSafeIndex - readIndex, (uint64_t)outEvents_->size());
+		outEvents_->erase(outEvents_->begin(), outEvents_->begin() + lappedCount);
+	}
 }
 
 // -----------------------------------------------------------------------
-void ProfilePush(const char* label_)
+// Complete Trees only; a root whose begin was lapped, or that is still open, is skipped;
+// -----------------------------------------------------------------------
+static void BuildThreadTrees(const std::vector<profiler_event_t>& events_, std::thread::id threadID_, double oldestTime_, std::vector<profiler_node_t*>* outTrees_)
+{
+	std::vector<profiler_node_t*> openNodes;
+	std::vector<const profiler_event_t*> openEvents;
+
+	for(const profiler_event_t& event : events_)
+	{
+		if(event.label != nullptr)
+		{
+			if(GetEventDepth(event) != (uint8_t)openNodes.size())
+			{
+				// Lost the start of this Tree, wait for the next root;
+				if(!openNodes.empty())
+				{
+					FreeTree(openNodes.front());
+					openNodes.clear();
+					openEvents.clear();
+				}
+				continue;
+			}
+
+			profiler_node_t* node = new profiler_node_t();
+			node->m_label = event.label;
+			node->threadID = threadID_;
+			node->startTime = ProfilerTicksToSeconds(GetEventTicks(event));
+			node->callCount = 1;
+			if(!openNodes.empty())
+			{
+				openNodes.back()->AddChild(node);
+			}
+
+			openNodes.push_back(node);
+			openEvents.push_back(&event);
+			continue;
+		}
+
+		if(openNodes.empty() || GetEventDepth(event) != (uint8_t)(openNodes.size() - 1))
+		{
+			if(!openNodes.empty())
+			{
+				FreeTree(openNodes.front());
+				openNodes.clear();
+				openEvents.clear();
+			}
+			continue;
+		}
+
+		profiler_node_t* node = openNodes.back();
+		const profiler_event_t& beginEvent = *openEvents.back();
+		openNodes.pop_back();
+		openEvents.pop_back();
+
+		node->endTime = ProfilerTicksToSeconds(GetEventTicks(event));
+		node->totalTime = node->endTime - node->startTime;
+		node->m_allocCount = (uint32_t)(event.allocCount - beginEvent.allocCount);
+		node->m_allocBytes = (uint32_t)(event.allocBytes - beginEvent.allocBytes);
+		node->m_freeCount = (uint32_t)(event.freeCount - beginEvent.freeCount);
+		node->m_freeBytes = (uint32_t)(event.freeBytes - beginEvent.freeBytes);
+
+		double childrenTime = 0.0;
+		for(profiler_node_t* child = node->lastChild; child != nullptr; child = child->previousSibling)
+		{
+			childrenTime += child->totalTime;
+		}
+		node->selfTime = node->totalTime - childrenTime;
+
+		if(openNodes.empty())
+		{
+			if(node->startTime >= oldestTime_)
+			{
+				node->refCount = 1;
+				outTrees_->push_back(node);
+			}
+			else
+			{
+				FreeTree(node);
+			}
+		}
+	}
+
+	if(!openNodes.empty())
+	{
+		FreeTree(openNodes.front());
+	}
+}
+
+// -----------------------------------------------------------------------
+// Builds without the history lock, so an export building on a worker never holds up ProfilerUpdate;
+// -----------------------------------------------------------------------
+static void BuildHistory()
 {
-	profiler_node_t* newNode = AllocNode();
+	{
+		std::shared_lock<std::shared_mutex> lock(g_HistoryLock);
+		if(g_isHistoryBuilt)
+		{
+			return;
+		}
+	}
+
+	std::vector<profiler_node_t*> trees;
+	std::vector<profiler_event_t> events;
+	{
+		std::scoped_lock<std::mutex> lock(g_ThreadBuffersLock);
+
+		RefineProfilerTicks();
+		double oldestTime = GetCurrentTimeSeconds() - g_maxHistoryTime;
+
+		for(profiler_thread_buffer_t* buffer : g_ThreadBuffers)
+		{
+			CopyThreadEvents(buffer, &events);
+			BuildThreadTrees(events, buffer->m_threadID, oldestTime, &trees);
+		}
+	}
+
+	std::stable_sort(trees.begin(), trees.end(), [](const profiler_node_t* lhs, const profiler_node_t* rhs)
+	{
+		return lhs->startTime < rhs->startTime;
+	});
+
+	{
+		std::scoped_lock<std::shared_mutex> lock(g_HistoryLock);
+		if(!g_isHistoryBuilt)
+		{
+			g_History.swap(trees);
+			g_isHistoryBuilt = true;
+		}
+	}
+
+	// Someone else got there first;
+	for(profiler_node_t* tree : trees)
+	{
+		FreeTree(tree);
+	}
+}
+
+// -----------------------------------------------------------------------
+bool ProfilerSystemInit(uint eventsPerThread_ /*= PROFILER_DEFAULT_EVENTS_PER_THREAD*/)
+{
+	uint64_t eventsPerThread = 2;
+	while(eventsPerThread < eventsPerThread_)
+	{
+		eventsPerThread *= 2;
+	}
 
-	newNode->parent = t_ActiveNode;
-	newNode->lastChild = nullptr;
-	newNode->previousSibling = nullptr;
-	newNode->threadID = std::this_thread::get_id();
+	{
+		std::scoped_lock<std::mutex> lock(g_ThreadBuffersLock);
+		GUARANTEE_OR_DIE(g_profilerGeneration % 2 == 0, "ProfilerSystemInit called twice.");
 
-	newNode->m_allocCount = t_allocCount;
-	newNode->m_allocBytes = t_allocBytes;
-	newNode->m_freeCount = t_freeCount;
-	newNode->m_freeBytes = t_freeBytes;
+		g_eventsPerThread = eventsPerThread;
+		CalibrateProfilerTicks();
+		++g_profilerGeneration;
+	}
 
-	// Setup now
-	newNode->startTime = GetCurrentTimeSeconds();
-	strcpy_s(newNode->m_label, label_);
+	ProfilerSetThreadName("Main");
 
-	if (t_ActiveNode != nullptr)
 	{
-		t_ActiveNode->AddChild(newNode);
+		MEM_TAG_SCOPE(MEM_TAG_PROFILER);
+		std::scoped_lock<std::mutex> lock(g_MemorySamplesLock);
+		g_MemorySamples = new profiler_memory_sample_t[PROFILER_MEMORY_SAMPLE_COUNT];
+		g_nextMemorySample = 0;
+		g_MemorySampleCount = 0;
 	}
 
-	// This is now my active node;
-	t_ActiveNode = newNode;
+	g_theEventSystem->SubscriptionEventCallbackFunction("profile_export", ProfileExportCommand);
 
-	++t_ProfilerDepth;
+	return true;
 }
 
 // -----------------------------------------------------------------------
-void ProfilePop()
+void ProfilerSystemDeinit()
 {
-	GUARANTEE_OR_DIE(t_ProfilerDepth > 0, "ProfilerDepth is less than 0 and we tried to pop.");
-	--t_ProfilerDepth;
+	// An export still walking the Trees would be reading freed nodes;
+	ProfilerWaitForExport();
+	ProfilerUpdate();
+
+	std::scoped_lock<std::mutex> lock(g_ThreadBuffersLock);
+	++g_profilerGeneration;
 
-	if (t_ActiveNode == nullptr) 
+	for(profiler_thread_buffer_t* buffer : g_ThreadBuffers)
 	{
-		return;
+		UntrackedFree(buffer->m_events);
+		delete buffer;
 	}
+	g_ThreadBuffers.clear();
 
-	t_ActiveNode->endTime = GetCurrentTimeSeconds();
+	std::scoped_lock<std::mutex> samplesLock(g_MemorySamplesLock);
+	delete[] g_MemorySamples;
+	g_MemorySamples = nullptr;
+	g_MemorySampleCount = 0;
+}
 
-	t_ActiveNode->m_allocCount = t_allocCount - t_ActiveNode->m_allocCount;
-	t_ActiveNode->m_allocBytes = t_allocBytes - t_ActiveNode->m_allocBytes;
-	t_ActiveNode->m_freeCount = t_freeCount - t_ActiveNode->m_freeCount;
-	t_ActiveNode->m_freeBytes = t_freeBytes - t_ActiveNode->m_freeBytes;
+// -----------------------------------------------------------------------
+void ProfilerSetMaxHistoryTime(double seconds_)
+{
+	g_maxHistoryTime = seconds_;
+}
 
-	profiler_node_t* oldActive = t_ActiveNode;
-	t_ActiveNode = t_ActiveNode->parent;
-	if (t_ActiveNode == nullptr)
+// -----------------------------------------------------------------------
+void ProfilerUpdate()
+{
+	// Exports and reports hold their own reference, the release decides who frees;
+	std::vector<profiler_node_t*> builtTrees;
+	{
+		std::scoped_lock<std::shared_mutex> lock(g_HistoryLock);
+		builtTrees.swap(g_History);
+		g_isHistoryBuilt = false;
+	}
+
+	for(profiler_node_t* tree : builtTrees)
 	{
-		std::scoped_lock<std::shared_mutex> look(g_HistoryLock);
-		g_History.push_back(oldActive);
+		ProfileReleaseTree(tree);
 	}
 }
 
 // -----------------------------------------------------------------------
-void ProfileBeginFrame(const char* label_ /*= "frame"*/)
+void ProfilerPause()
 {
-	GUARANTEE_OR_DIE(t_ActiveNode == nullptr, "ActiveNode is not null at the top of the frame.");
+	g_isProfilerPaused = true;
+}
 
-	ProfilePush(label_);
+// -----------------------------------------------------------------------
+void ProfilerResume()
+{
+	g_isProfilerPaused = false;
 }
 
 // -----------------------------------------------------------------------
-void ProfileEndFrame()
+void ProfilePush(const char* label_)
 {
-	ProfilePop();
+	int depth = t_ProfilerDepth++;
+	if(depth == 0)
+	{
+		t_isRecording = !g_isProfilerPaused.load(std::memory_order_relaxed);
+	}
 
-	GUARANTEE_OR_DIE(t_ActiveNode == nullptr, "Profile::ActiveNode is not null at the top of the frame.");
+	if(t_isRecording)
+	{
+		AppendEvent(label_, (uint32_t)depth);
+	}
 }
 
 // -----------------------------------------------------------------------
-static void FreeNode(profiler_node_t* node)
+void ProfilePop()
 {
-	g_theBlockAllocatorOnlyForProfilerNodeT->free(node);
+	GUARANTEE_OR_DIE(t_ProfilerDepth > 0, "ProfilerDepth is less than 0 and we tried to pop.");
+	int depth = --t_ProfilerDepth;
+
+	if(t_isRecording)
+	{
+		AppendEvent(nullptr, (uint32_t)depth);
+	}
 }
 
 // -----------------------------------------------------------------------
-static void FreeTree(profiler_node_t* node)
+void ProfileBeginFrame(const char* label_ /*= "frame"*/)
 {
-	if(!node)
+	GUARANTEE_OR_DIE(t_ProfilerDepth == 0, "A scope is still open at the top of the frame.");
+
+	ProfilePush(label_);
+}
+
+// -----------------------------------------------------------------------
+void ProfileEndFrame()
+{
+	ProfilePop();
+
+	GUARANTEE_OR_DIE(t_ProfilerDepth == 0, "Profile: a scope is still open at the end of the frame.");
+
+#if defined(MEM_TRACKING) && MEM_TRACKING == MEM_TRACK_VERBOSE
+	if(g_isProfilerPaused)
 	{
 		return;
 	}
 
-	if(node->lastChild)
+	// No tracker locks, a few atomic reads per tag;
+	mem_tag_stats_t tagStats[MEM_TAG_MAX];
+	MemTrackGetAllTagStats(tagStats);
+
+	std::scoped_lock<std::mutex> lock(g_MemorySamplesLock);
+	if(!g_MemorySamples)
 	{
-		FreeTree(node->lastChild);
+		return;
 	}
 
-	if(node->previousSibling)
+	profiler_memory_sample_t& sample = g_MemorySamples[g_nextMemorySample];
+	sample.time = ProfilerTicksToSeconds(ReadProfilerTicks());
+	sample.tagCount = MemTagGetCount();
+	for(uint tag = 0; tag < sample.tagCount; ++tag)
 	{
-		FreeTree(node->lastChild);
+		sample.tagBytes[tag] = tagStats[tag].m_liveByteCount;
 	}
 
-	FreeNode(node);
+	g_nextMemorySample = (g_nextMemorySample + 1) % PROFILER_MEMORY_SAMPLE_COUNT;
+	g_MemorySampleCount = g_MemorySampleCount < PROFILER_MEMORY_SAMPLE_COUNT ? g_MemorySampleCount + 1 : PROFILER_MEMORY_SAMPLE_COUNT;
+#endif
+}
+
+// -----------------------------------------------------------------------
+void ProfilerGetMemorySamples(std::vector<profiler_memory_sample_t>* outSamples_)
+{
+	std::scoped_lock<std::mutex> lock(g_MemorySamplesLock);
+
+	uint firstSample = (g_nextMemorySample + PROFILER_MEMORY_SAMPLE_COUNT - g_MemorySampleCount) % PROFILER_MEMORY_SAMPLE_COUNT;
+	for(uint sampleIndex = 0; sampleIndex < g_MemorySampleCount; ++sampleIndex)
+	{
+		outSamples_->push_back(g_MemorySamples[(firstSample + sampleIndex) % PROFILER_MEMORY_SAMPLE_COUNT]);
+	}
 }
 
 // -----------------------------------------------------------------------
@@ -202,16 +642,66 @@ void ProfileReleaseTree(profiler_node_t* node_)
 	}
 }
 
+// -----------------------------------------------------------------------
+void ProfilerAcquireHistory(std::vector<profiler_node_t*>* outTrees_)
+{
+	// A ProfilerUpdate between the build and the copy means building again;
+	while(true)
+	{
+		BuildHistory();
+
+		std::shared_lock<std::shared_mutex> lock(g_HistoryLock);
+		if(!g_isHistoryBuilt)
+		{
+			continue;
+		}
+
+		outTrees_->reserve(outTrees_->size() + g_History.size());
+		for(profiler_node_t* tree : g_History)
+		{
+			::InterlockedIncrement(&tree->refCount);
+			outTrees_->push_back(tree);
+		}
+		return;
+	}
+}
+
+// -----------------------------------------------------------------------
+void ProfilerSetThreadName(const char* name_)
+{
+	std::thread::id threadID = std::this_thread::get_id();
+
+	std::scoped_lock<std::mutex> lock(g_ThreadNamesLock);
+	for(profiler_thread_name_t& threadName : g_ThreadNames)
+	{
+		if(threadName.threadID == threadID)
+		{
+			threadName.name = name_;
+			return;
+		}
+	}
+
+	g_ThreadNames.push_back({ threadID, name_ });
+}
+
+// -----------------------------------------------------------------------
+void ProfilerGetThreadNames(std::vector<profiler_thread_name_t>* outNames_)
+{
+	std::scoped_lock<std::mutex> lock(g_ThreadNamesLock);
+	*outNames_ = g_ThreadNames;
+}
+
 // -----------------------------------------------------------------------
 profiler_node_t* GetTreeFromHistory(uint historyBack /*= 0*/)
 {
-	std::scoped_lock lock(g_HistoryLock);
+	BuildHistory();
+	std::shared_lock<std::shared_mutex> lock(g_HistoryLock);
 
 	profiler_node_t* node = nullptr;
 
 	size_t index = g_History.size() - 1;
 	size_t historypull = index - historyBack;
-	if(historypull > 0)
+	if(!g_History.empty() && historyBack <= index)
 	{
 		node = g_History[historypull];
 	}
@@ -226,22 +716,20 @@ profiler_node_t* GetTreeFromHistory(uint historyBack /*= 0*/)
 // -----------------------------------------------------------------------
 profiler_node_t* GetTreeFromHistoryForThread(std::thread::id threadID, uint historyBack /*= 0*/)
 {
-	std::scoped_lock lock(g_HistoryLock);
+	BuildHistory();
+	std::shared_lock<std::shared_mutex> lock(g_HistoryLock);
 	
 	uint threadChecks = 0;
-	auto it = g_History.end();
-	while(it != g_History.begin())
+	for(auto it = g_History.rbegin(); it != g_History.rend(); ++it)
 	{
 		if((*it)->threadID == threadID)
 		{
-			++threadChecks;
 			if(threadChecks == historyBack)
 			{
 				return (*it);
 			}
+			++threadChecks;
 		}
-
-		--it;
 	}
 
 	ERROR_AND_DIE("Asked for too many frames back for a thread that did not have enough frames in history.");
@@ -250,7 +738,7 @@ profiler_node_t* GetTreeFromHistoryForThread(std::thread::id threadID, uint hist
 // -----------------------------------------------------------------------
 reporter_node_t::reporter_node_t(profiler_node_t* profiler_node, reporter_node_t* reporter_node_parent)
 {
-	strcpy_s(m_label, profiler_node->m_label);
+	m_label = profiler_node->m_label;
 	m_callCount = 1;
 	m_parent = reporter_node_parent;
 	m_totalTime = profiler_node->endTime - profiler_node->startTime;
@@ -352,7 +840,7 @@ void ProfilerReport::GetFlatTree(reporter_node_t* reporter)
 	profiler_node_t* pn = new profiler_node_t();
 
 	pn->callCount = 1;
-	strcpy_s(pn->m_label, reporter->m_label);
+	pn->m_label = reporter->m_label;
 	pn->totalTime = reporter->m_totalTime;
 	pn->selfTime = reporter->m_selfTime;
 
@@ -1,23 +1,30 @@
 #pragma once
+#include "Engine/Memory/Memory.hpp"
 
+#include <stdint.h>
 #include <thread>
 #include <shared_mutex>
+#include <string>
+#include <vector>
 
+// Only the label's pointer is recorded, so it has to outlive the profiler; a literal or __FUNCTION__;
 #define COMBINE1(X,Y) X##Y  // helper macro
 #define COMBINE(X,Y) COMBINE1(X,Y)
-#define PROFILE_SCOPE( tag ) ProfileScope COMBINE(__scopeLog, __LINE__) ## (tag)
+#define PROFILE_SCOPE( tag ) ProfileScope COMBINE(__scopeLog, __LINE__)(tag)
 #define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__);
 
 typedef unsigned int uint;
 
-bool ProfilerSystemInit();
-void ProfilerSystemDeinit();
+// Begin and end events per thread ring; at 60 fps and a few hundred scopes a frame the main thread keeps ~2 seconds;
+constexpr uint PROFILER_DEFAULT_EVENTS_PER_THREAD = 64 * 1024;
 
-//PrilferGetHistory();
+bool ProfilerSystemInit(uint eventsPerThread_ = PROFILER_DEFAULT_EVENTS_PER_THREAD);		// Rounded up to a power of two;
+void ProfilerSystemDeinit();																// After the threads that record are joined;
 
-// Cleanup Trees that are older than X seconds;
+// Trees older than X seconds are left out when the history is built;
 void ProfilerSetMaxHistoryTime(double seconds_);
 
+// Once a frame; drops the Trees built from the rings last frame, the next request rebuilds them;
 void ProfilerUpdate();
 
 // Stop recording of Trees, disables creation of new Trees, current Trees can finish;
@@ -27,10 +34,11 @@ void ProfilerPause();
 void ProfilerResume();
 
 // RECORDING
-// Pushes a new child node, and marks it as the active one;
+// Each thread appends a begin event (label pointer, tick count, alloc counters) to its own ring, nothing is shared or locked;
+// The Trees are only built from the rings when the history is asked for;
 void ProfilePush(const char* label_);
 
-// Pops the active node in the Tree, errors if there is none;
+// Appends the end event of the innermost scope, errors if there is none;
 void ProfilePop();
 
 
@@ -52,7 +60,7 @@ struct profiler_node_t
 	profiler_node_t* lastChild = nullptr;
 	profiler_node_t* previousSibling = nullptr;
 
-	char m_label[64];
+	const char* m_label = "";
 
 	// Memory;
 	size_t m_allocCount = 0;
@@ -84,6 +92,31 @@ void ProfileReleaseTree(profiler_node_t* node_);
 profiler_node_t* GetTreeFromHistory(uint historyBack = 0);
 profiler_node_t* GetTreeFromHistoryForThread(std::thread::id threadID, uint historyBack = 0);
 
+// Every Tree in the history, oldest first, each with a reference taken; builds them from the rings if this frame hasn't yet;
+// ProfilerUpdate can drop them from the history meanwhile, call ProfileReleaseTree on each when done;
+void ProfilerAcquireHistory(std::vector<profiler_node_t*>* outTrees_);
+
+// Name shown for the calling thread in exports, "Main", "Job Worker 3", "Log";
+void ProfilerSetThreadName(const char* name_);
+
+struct profiler_thread_name_t
+{
+	std::thread::id threadID;
+	std::string name;
+};
+void ProfilerGetThreadNames(std::vector<profiler_thread_name_t>* outNames_);
+
+// Live bytes per memory tag, taken at every ProfileEndFrame with MEM_TRACK_VERBOSE; exports show them as counters;
+constexpr uint PROFILER_MEMORY_SAMPLE_COUNT = 1024;
+
+struct profiler_memory_sample_t
+{
+	double time = 0;
+	uint tagCount = 0;
+	size_t tagBytes[MEM_TAG_MAX] = {};
+};
+void ProfilerGetMemorySamples(std::vector<profiler_memory_sample_t>* outSamples_);		// Oldest first;
+
 // -----------------------------------------------------------------------
 class reporter_node_t;
 
@@ -136,7 +169,7 @@ public:
 	reporter_node_t* m_parent = nullptr; // parent in tree view, root node in flat view
 	std::vector<reporter_node_t> m_children;
 
-	char m_label[64];
+	const char* m_label = "";
 	uint m_callCount;
 
 	double m_totalTime = 0; 			// total time spent at this node
@@ -0,0 +1,111 @@
+#include "Engine/Profile/ProfileBenchmark.hpp"
+#include "Engine/Core/BenchmarkUtils.hpp"
+#include "Engine/Profile/Profile.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+constexpr int PROFILE_BENCH_WARM_UP_SCOPES = 64;
+constexpr double PROFILE_SCOPE_TARGET_NS = 50.0;
+
+// -----------------------------------------------------------------------
+// Every scope is its own root, like a Job's; no frame, so the memory sample at the end of one isn't timed;
+// -----------------------------------------------------------------------
+static void RecordScopes(int scopeCount_)
+{
+	for (int scopeIndex = 0; scopeIndex < scopeCount_; ++scopeIndex)
+	{
+		PROFILE_SCOPE("profile_bench scope");
+	}
+}
+
+// -----------------------------------------------------------------------
+// Worst thread's ns per scope;
+// -----------------------------------------------------------------------
+static double TimeScopesOnThreads(int scopesPerThread_, int threadCount_)
+{
+	std::vector<double> threadSeconds(threadCount_, 0.0);
+	std::atomic<int> readyCount = 0;
+	std::atomic<bool> go = false;
+
+	std::vector<std::thread> threads;
+	for (int threadIndex = 0; threadIndex < threadCount_; ++threadIndex)
+	{
+		threads.emplace_back([&, threadIndex]()
+		{
+			// Warm up, the first scope on a thread takes its ring;
+			RecordScopes(PROFILE_BENCH_WARM_UP_SCOPES);
+
+			++readyCount;
+			while (!go)
+			{
+				std::this_thread::yield();
+			}
+
+			double startTime = GetCurrentTimeSeconds();
+			RecordScopes(scopesPerThread_);
+			threadSeconds[threadIndex] = GetCurrentTimeSeconds() - startTime;
+		});
+	}
+
+	while (readyCount < threadCount_)
+	{
+		std::this_thread::yield();
+	}
+	go = true;
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	double worstSeconds = 0.0;
+	for (double seconds : threadSeconds)
+	{
+		worstSeconds = seconds > worstSeconds ? seconds : worstSeconds;
+	}
+	return worstSeconds * 1'000'000'000.0 / (double)scopesPerThread_;
+}
+
+// -----------------------------------------------------------------------
+void RunProfileScopeBenchmark(int scopesPerThread_, int threadCount_)
+{
+	if (scopesPerThread_ < PROFILE_BENCH_WARM_UP_SCOPES || threadCount_ < 1)
+	{
+		return;
+	}
+
+	// More threads than cores measures the scheduler, not the rings;
+	int coreCount = (int)std::thread::hardware_concurrency();
+	threadCount_ = (coreCount > 0 && threadCount_ > coreCount) ? coreCount : threadCount_;
+
+	PrintLine(Stringf("PROFILE_SCOPE, %d scopes per thread, target %.0f ns", scopesPerThread_, PROFILE_SCOPE_TARGET_NS));
+
+	double singleNS = TimeScopesOnThreads(scopesPerThread_, 1);
+	PrintLine(Stringf("  1 thread     %7.1f ns/scope  %s", singleNS, singleNS < PROFILE_SCOPE_TARGET_NS ? "ok" : "OVER"));
+
+	double threadedNS = TimeScopesOnThreads(scopesPerThread_, threadCount_);
+	PrintLine(Stringf("  %2d threads   %7.1f ns/scope  %s  (slowest thread)", threadCount_, threadedNS, threadedNS < PROFILE_SCOPE_TARGET_NS ? "ok" : "OVER"));
+
+	ProfilerPause();
+	double pausedNS = TimeScopesOnThreads(scopesPerThread_, 1);
+	ProfilerResume();
+	PrintLine(Stringf("  paused       %7.1f ns/scope", pausedNS));
+
+	// What a report or an export pays, once per frame at most;
+	ProfilerUpdate();
+	std::vector<profiler_node_t*> trees;
+	double buildStart = GetCurrentTimeSeconds();
+	ProfilerAcquireHistory(&trees);
+	double buildMS = (GetCurrentTimeSeconds() - buildStart) * 1000.0;
+	PrintLine(Stringf("  tree build   %7.2f ms for %u trees", buildMS, (uint)trees.size()));
+
+	for (profiler_node_t* tree : trees)
+	{
+		ProfileReleaseTree(tree);
+	}
+}
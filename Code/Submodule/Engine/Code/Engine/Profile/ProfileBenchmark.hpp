@@ -0,0 +1,9 @@
+#pragma once
+
+// -----------------------------------------------------------------------
+// PROFILE_SCOPE cost, begin and end together, on fresh threads so each starts at depth 0;
+// Once on one thread, then on threadCount_ at once (at most one per core) to show the threads don't contend, then paused,
+// then how long building the Trees from the rings takes; scopes go 64 to a frame like a real frame would;
+// Prints to the DevConsole and blocks the caller;
+// -----------------------------------------------------------------------
+void RunProfileScopeBenchmark(int scopesPerThread_, int threadCount_);
@@ -0,0 +1,470 @@
+#include "Engine/Profile/ProfileExport.hpp"
+#include "Engine/Profile/Profile.hpp"
+#include "Engine/Job/Jobs.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unordered_map>
+
+// -----------------------------------------------------------------------
+static std::atomic<bool> s_isExporting = false;
+
+constexpr size_t PROFILE_EXPORT_BUFFER_SIZE = 64 * 1024;
+
+// -----------------------------------------------------------------------
+// Buffered file writes, the Job never holds more than one buffer of output;
+// -----------------------------------------------------------------------
+class ProfileExportWriter
+{
+
+public:
+
+	~ProfileExportWriter() { Close(); }
+
+	bool Open(const char* path_)
+	{
+		std::error_code errorCode;
+		std::filesystem::path parentPath = std::filesystem::path(path_).parent_path();
+		if(!parentPath.empty())
+		{
+			std::filesystem::create_directories(parentPath, errorCode);
+		}
+
+		m_file = fopen(path_, "wb");
+		m_buffer.reserve(PROFILE_EXPORT_BUFFER_SIZE);
+		return m_file != nullptr;
+	}
+
+	bool Close()
+	{
+		if(!m_file)
+		{
+			return m_isGood;
+		}
+
+		Flush();
+		m_isGood = (fclose(m_file) == 0) && m_isGood;
+		m_file = nullptr;
+		return m_isGood;
+	}
+
+	void Write(const void* data_, size_t size_)
+	{
+		if(m_buffer.size() + size_ > PROFILE_EXPORT_BUFFER_SIZE)
+		{
+			Flush();
+		}
+
+		const char* bytes = (const char*)data_;
+		m_buffer.insert(m_buffer.end(), bytes, bytes + size_);
+	}
+
+	void WriteByte(uint8_t byte_)
+	{
+		Write(&byte_, 1);
+	}
+
+	void WriteVarint(uint64_t value_)
+	{
+		uint8_t bytes[10];
+		size_t byteCount = 0;
+		do
+		{
+			uint8_t byte = (uint8_t)(value_ & 0x7F);
+			value_ >>= 7;
+			bytes[byteCount++] = value_ ? (byte | 0x80) : byte;
+		} while(value_);
+
+		Write(bytes, byteCount);
+	}
+
+	void WriteString(const char* text_, size_t length_)
+	{
+		WriteVarint(length_);
+		Write(text_, length_);
+	}
+
+	void Printf(const char* format_, ...)
+	{
+		char text[512];
+
+		va_list args;
+		va_start(args, format_);
+		int length = vsnprintf(text, sizeof(text), format_, args);
+		va_end(args);
+
+		if(length > 0)
+		{
+			Write(text, (size_t)length < sizeof(text) ? (size_t)length : sizeof(text) - 1);
+		}
+	}
+
+	// JSON string contents, without the quotes;
+	void WriteEscaped(const char* text_, size_t length_)
+	{
+		for(size_t charIndex = 0; charIndex < length_; ++charIndex)
+		{
+			unsigned char character = (unsigned char)text_[charIndex];
+			if(character == '"' || character == '\\')
+			{
+				char escaped[2] = { '\\', (char)character };
+				Write(escaped, 2);
+			}
+			else if(character < 0x20)
+			{
+				Printf("\\u%04x", character);
+			}
+			else
+			{
+				Write(&character, 1);
+			}
+		}
+	}
+
+private:
+
+	void Flush()
+	{
+		if(m_file && !m_buffer.empty())
+		{
+			m_isGood = (fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) == m_buffer.size()) && m_isGood;
+		}
+		m_buffer.clear();
+	}
+
+private:
+
+	FILE* m_file = nullptr;
+	std::vector<char> m_buffer;
+	bool m_isGood = true;
+};
+
+// -----------------------------------------------------------------------
+// Small thread indices for the viewer, named threads first in the order they named themselves;
+// -----------------------------------------------------------------------
+struct ProfileExportThread
+{
+	std::thread::id m_threadID;
+	std::string m_name;
+	bool m_isUsed = false;
+};
+
+// -----------------------------------------------------------------------
+class ProfileExportJob : public Job
+{
+
+public:
+
+	ProfileExportJob(const char* path_, eProfileExportFormat format_);
+	virtual ~ProfileExportJob();
+
+	virtual void Execute() override;
+
+private:
+
+	uint32_t GetThreadIndex(std::thread::id threadID_);
+	uint32_t GetLabelIndex(const char* label_, size_t length_, bool* isNew_);
+
+	void WriteChromeJson(ProfileExportWriter& writer_);
+	void WriteBinary(ProfileExportWriter& writer_);
+
+	// Depth first over every Tree; children come newest first, the viewers sort by time anyway;
+	void ForEachNode(const std::function<void(const profiler_node_t* node_, uint32_t depth_)>& visit_) const;
+
+private:
+
+	std::string m_path;
+	eProfileExportFormat m_format = PROFILE_EXPORT_CHROME_JSON;
+	std::vector<profiler_node_t*> m_trees;
+
+	std::vector<ProfileExportThread> m_threads;
+	std::unordered_map<std::string, uint32_t> m_labelIndices;
+	double m_baseTime = 0.0;
+	size_t m_nodeCount = 0;
+};
+
+// -----------------------------------------------------------------------
+ProfileExportJob::ProfileExportJob(const char* path_, eProfileExportFormat format_)
+	: m_path(path_)
+	, m_format(format_)
+{
+}
+
+// -----------------------------------------------------------------------
+ProfileExportJob::~ProfileExportJob()
+{
+	for(profiler_node_t* tree : m_trees)
+	{
+		ProfileReleaseTree(tree);
+	}
+	m_trees.clear();
+
+	s_isExporting = false;
+}
+
+// -----------------------------------------------------------------------
+void ProfileExportJob::Execute()
+{
+	double exportStart = GetCurrentTimeSeconds();
+
+	// Building the Trees from the thread rings happens here too, not on the thread that asked;
+	ProfilerAcquireHistory(&m_trees);
+	if(m_trees.empty())
+	{
+		DebuggerPrintf("Profile export: the history is empty.\n");
+		return;
+	}
+
+	std::vector<profiler_thread_name_t> threadNames;
+	ProfilerGetThreadNames(&threadNames);
+	for(profiler_thread_name_t& threadName : threadNames)
+	{
+		m_threads.push_back({ threadName.threadID, threadName.name });
+	}
+
+	m_baseTime = m_trees.front()->startTime;
+	for(profiler_node_t* tree : m_trees)
+	{
+		m_baseTime = tree->startTime < m_baseTime ? tree->startTime : m_baseTime;
+	}
+
+	ProfileExportWriter writer;
+	if(!writer.Open(m_path.c_str()))
+	{
+		DebuggerPrintf("Profile export: could not open %s.\n", m_path.c_str());
+		return;
+	}
+
+	if(m_format == PROFILE_EXPORT_BINARY)
+	{
+		WriteBinary(writer);
+	}
+	else
+	{
+		WriteChromeJson(writer);
+	}
+
+	if(!writer.Close())
+	{
+		DebuggerPrintf("Profile export: writing %s failed.\n", m_path.c_str());
+		return;
+	}
+
+	DebuggerPrintf("Profile export: %zu scopes from %zu trees to %s in %.1f ms.\n",
+		m_nodeCount, m_trees.size(), m_path.c_str(), (GetCurrentTimeSeconds() - exportStart) * 1000.0);
+}
+
+// -----------------------------------------------------------------------
+uint32_t ProfileExportJob::GetThreadIndex(std::thread::id threadID_)
+{
+	for(uint32_t threadIndex = 0; threadIndex < (uint32_t)m_threads.size(); ++threadIndex)
+	{
+		if(m_threads[threadIndex].m_threadID == threadID_)
+		{
+			return threadIndex;
+		}
+	}
+
+	char name[64];
+	snprintf(name, sizeof(name), "Thread %zu", std::hash<std::thread::id>{}(threadID_));
+	m_threads.push_back({ threadID_, name });
+	return (uint32_t)m_threads.size() - 1;
+}
+
+// -----------------------------------------------------------------------
+uint32_t ProfileExportJob::GetLabelIndex(const char* label_, size_t length_, bool* isNew_)
+{
+	auto result = m_labelIndices.try_emplace(std::string(label_, length_), (uint32_t)m_labelIndices.size());
+	*isNew_ = result.second;
+	return result.first->second;
+}
+
+// -----------------------------------------------------------------------
+void ProfileExportJob::ForEachNode(const std::function<void(const profiler_node_t* node_, uint32_t depth_)>& visit_) const
+{
+	struct StackEntry
+	{
+		const profiler_node_t* m_node;
+		uint32_t m_depth;
+	};
+	std::vector<StackEntry> stack;
+
+	for(const profiler_node_t* tree : m_trees)
+	{
+		stack.push_back({ tree, 0 });
+		while(!stack.empty())
+		{
+			StackEntry entry = stack.back();
+			stack.pop_back();
+
+			visit_(entry.m_node, entry.m_depth);
+
+			for(const profiler_node_t* child = entry.m_node->lastChild; child != nullptr; child = child->previousSibling)
+			{
+				stack.push_back({ child, entry.m_depth + 1 });
+			}
+		}
+	}
+}
+
+// -----------------------------------------------------------------------
+void ProfileExportJob::WriteChromeJson(ProfileExportWriter& writer_)
+{
+	writer_.Printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	writer_.Printf("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Game\"}}");
+
+	ForEachNode([&](const profiler_node_t* node_, uint32_t /*depth_*/)
+	{
+		uint32_t threadIndex = GetThreadIndex(node_->threadID);
+		m_threads[threadIndex].m_isUsed = true;
+
+		writer_.Printf(",\n{\"name\":\"");
+		writer_.WriteEscaped(node_->m_label, strlen(node_->m_label));
+		writer_.Printf("\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+			"\"args\":{\"allocs\":%zu,\"allocBytes\":%zu,\"frees\":%zu,\"freeBytes\":%zu}}",
+			threadIndex,
+			(node_->startTime - m_baseTime) * 1'000'000.0,
+			(node_->endTime - node_->startTime) * 1'000'000.0,
+			node_->m_allocCount, node_->m_allocBytes, node_->m_freeCount, node_->m_freeBytes);
+
+		++m_nodeCount;
+	});
+
+	// Memory by tag, a counter track per tag; only samples inside the exported Trees;
+	std::vector<profiler_memory_sample_t> memorySamples;
+	ProfilerGetMemorySamples(&memorySamples);
+	for(const profiler_memory_sample_t& sample : memorySamples)
+	{
+		if(sample.time < m_baseTime)
+		{
+			continue;
+		}
+
+		writer_.Printf(",\n{\"name\":\"Memory\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"args\":{", (sample.time - m_baseTime) * 1'000'000.0);
+		for(uint tag = 0; tag < sample.tagCount; ++tag)
+		{
+			const char* tagName = MemTagGetName(tag);
+			writer_.Printf(tag == 0 ? "\"" : ",\"");
+			writer_.WriteEscaped(tagName, strlen(tagName));
+			writer_.Printf("\":%zu", sample.tagBytes[tag]);
+		}
+		writer_.Printf("}}");
+	}
+
+	// Only threads that show up, otherwise the viewer lists empty rows;
+	for(uint32_t threadIndex = 0; threadIndex < (uint32_t)m_threads.size(); ++threadIndex)
+	{
+		if(!m_threads[threadIndex].m_isUsed)
+		{
+			continue;
+		}
+
+		writer_.Printf(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", threadIndex);
+		writer_.WriteEscaped(m_threads[threadIndex].m_name.c_str(), m_threads[threadIndex].m_name.size());
+		writer_.Printf("\"}}");
+		writer_.Printf(",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"sort_index\":%u}}", threadIndex, threadIndex);
+	}
+
+	writer_.Printf("\n]}\n");
+}
+
+// -----------------------------------------------------------------------
+void ProfileExportJob::WriteBinary(ProfileExportWriter& writer_)
+{
+	ProfileStreamHeader header;
+	header.m_treeCount = m_trees.size();
+	writer_.Write(&header, sizeof(header));
+
+	ForEachNode([&](const profiler_node_t* node_, uint32_t depth_)
+	{
+		uint32_t threadIndex = GetThreadIndex(node_->threadID);
+		ProfileExportThread& thread = m_threads[threadIndex];
+		if(!thread.m_isUsed)
+		{
+			thread.m_isUsed = true;
+			writer_.WriteByte(PROFILE_RECORD_THREAD);
+			writer_.WriteVarint(threadIndex);
+			writer_.WriteString(thread.m_name.c_str(), thread.m_name.size());
+		}
+
+		bool isNewLabel = false;
+		size_t labelLength = strlen(node_->m_label);
+		uint32_t labelIndex = GetLabelIndex(node_->m_label, labelLength, &isNewLabel);
+		if(isNewLabel)
+		{
+			writer_.WriteByte(PROFILE_RECORD_LABEL);
+			writer_.WriteVarint(labelIndex);
+			writer_.WriteString(node_->m_label, labelLength);
+		}
+
+		double startNS = (node_->startTime - m_baseTime) * 1'000'000'000.0;
+		double durationNS = (node_->endTime - node_->startTime) * 1'000'000'000.0;
+
+		writer_.WriteByte(PROFILE_RECORD_SCOPE);
+		writer_.WriteVarint(threadIndex);
+		writer_.WriteVarint(depth_);
+		writer_.WriteVarint(labelIndex);
+		writer_.WriteVarint(startNS > 0.0 ? (uint64_t)(startNS + 0.5) : 0);
+		writer_.WriteVarint(durationNS > 0.0 ? (uint64_t)(durationNS + 0.5) : 0);
+		writer_.WriteVarint(node_->m_allocCount);
+		writer_.WriteVarint(node_->m_allocBytes);
+		writer_.WriteVarint(node_->m_freeCount);
+		writer_.WriteVarint(node_->m_freeBytes);
+
+		++m_nodeCount;
+	});
+
+	writer_.WriteByte(PROFILE_RECORD_END);
+}
+
+// -----------------------------------------------------------------------
+bool ProfilerExportAsync(const char* path_, eProfileExportFormat format_)
+{
+	bool expected = false;
+	if(!s_isExporting.compare_exchange_strong(expected, true))
+	{
+		g_theDevConsole->Print("Profile export: one is already running.");
+		return false;
+	}
+
+	g_theDevConsole->Print(Stringf("Profile export: writing the history to %s.", path_));
+
+	ProfileExportJob* exportJob = new ProfileExportJob(path_, format_);
+	if(g_theJobSystem && g_theJobSystem->IsRunning())
+	{
+		g_theJobSystem->Run(exportJob);
+	}
+	else
+	{
+		std::thread([exportJob]()
+		{
+			exportJob->Execute();
+			delete exportJob;
+		}).detach();
+	}
+
+	return true;
+}
+
+// -----------------------------------------------------------------------
+bool ProfilerIsExporting()
+{
+	return s_isExporting;
+}
+
+// -----------------------------------------------------------------------
+void ProfilerWaitForExport()
+{
+	while(s_isExporting)
+	{
+		std::this_thread::yield();
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------
+// Profile Export;
+// Writes the whole profiler history, every thread, to a file on a generic Job;
+// The Job builds the Trees from the thread rings and takes a reference on each, the history lock is only
+// held to copy the root pointers, so ProfilerUpdate keeps going while the Job walks the Trees;
+// -----------------------------------------------------------------------
+enum eProfileExportFormat : int
+{
+	PROFILE_EXPORT_CHROME_JSON = 0,		// Trace event JSON, opens in chrome://tracing and ui.perfetto.dev;
+	PROFILE_EXPORT_BINARY,				// Compact stream, see below;
+
+	PROFILE_EXPORT_FORMAT_COUNT
+};
+
+// False if an export is already running;
+bool ProfilerExportAsync(const char* path_, eProfileExportFormat format_);
+bool ProfilerIsExporting();
+void ProfilerWaitForExport();
+
+// -----------------------------------------------------------------------
+// Binary stream;
+// A header, then records one after the other, each a type byte and its fields, ended by PROFILE_RECORD_END;
+// Integers are LEB128 varints, strings are a varint length and the bytes, no terminator;
+// Threads and labels are declared by the record that first uses them, so it can be read in one pass;
+// Times are nanoseconds from the earliest start in the export;
+//
+//   PROFILE_RECORD_THREAD	threadIndex, name
+//   PROFILE_RECORD_LABEL	labelIndex, label
+//   PROFILE_RECORD_SCOPE	threadIndex, depth, labelIndex, startNS, durationNS,
+//							allocCount, allocBytes, freeCount, freeBytes
+// -----------------------------------------------------------------------
+constexpr uint32_t PROFILE_STREAM_MAGIC = 0x53465250;		// "PRFS";
+constexpr uint16_t PROFILE_STREAM_VERSION = 1;
+
+struct ProfileStreamHeader
+{
+	uint32_t m_magic = PROFILE_STREAM_MAGIC;
+	uint16_t m_version = PROFILE_STREAM_VERSION;
+	uint16_t m_headerSize = sizeof(ProfileStreamHeader);
+	uint64_t m_treeCount = 0;
+};
+
+enum eProfileRecordType : uint8_t
+{
+	PROFILE_RECORD_END = 0,
+	PROFILE_RECORD_THREAD,
+	PROFILE_RECORD_LABEL,
+	PROFILE_RECORD_SCOPE,
+};
@@ -84,8 +84,8 @@ BitMapFont::BitMapFont(std::string fontName_)
 		{
 			for(int tIndexY = pushedTexelY - 1; tIndexY > texelY; --tIndexY)
 			{
-				Rgba texelColor = image.GetTexelColor(tIndexX, tIndexY);
-				if(texelColor.a > 0.0f)
+				uint32_t texelColor = image.GetTexelRgba8(tIndexX, tIndexY);
+				if((texelColor >> 24) > 0)
 				{
 					// We found a colored texel, mark the xTexel;
 					if(tIndexX > largestXTexelPosition)
@@ -156,7 +156,7 @@ BitMapFont::BitMapFont(std::string fontName_, std::string fntFilePath_)
 	m_glyphData.resize(256);
 
 	tinyxml2::XMLDocument fontXMLDoc;
-	fontXMLDoc.LoadFile(fntFilePath_.c_str());
+	LoadXmlDocument(fontXMLDoc, fntFilePath_);
 
 	if (fontXMLDoc.ErrorID() != tinyxml2::XML_SUCCESS)
 	{
@@ -228,6 +228,135 @@ TextureView* BitMapFont::GetTextureView()
 	return m_fontTextureView;
 }
 
+// ------------------------------------------------------------------
+// Same A, B, C spacing the old per frame layout used, relative to 0,0;
+// ------------------------------------------------------------------
+void BitMapFont::LayoutGlyphRun( GlyphRun& run, float displayHeight, std::string_view text ) const
+{
+	// Calculating apparent font height;
+	displayHeight /= m_fontHeight;
+
+	run.m_quads.reserve(text.size());
+
+	float cursorX = 0.0f;
+	for(char character : text)
+	{
+		// Index as unsigned, chars past 127 are negative;
+		size_t index = (size_t)(unsigned char)character;
+		if(index >= m_glyphData.size())
+		{
+			continue;
+		}
+
+		const GlyphData& glyph = m_glyphData[index];
+
+		// Get the A, B, C values of the glyph;
+		float before = displayHeight * glyph.m_cellHeightFractionBeforeGlyph;
+		float during = displayHeight * glyph.m_cellHeightFractionDuringGlyph;
+		float after = displayHeight * glyph.m_cellHeightFractionAfterGlyph;
+
+		cursorX += before;
+
+		GlyphQuad quad;
+		quad.m_mins = Vec2(cursorX, 0.0f);
+		quad.m_maxs = Vec2(cursorX + during, displayHeight);
+		quad.m_uvMins = glyph.m_texCoordsMins;
+		quad.m_uvMaxs = glyph.m_texCoordsMaxs;
+		run.m_quads.push_back(quad);
+
+		cursorX += during + after;
+	}
+
+	run.m_width = cursorX;
+}
+
+// ------------------------------------------------------------------
+const GlyphRun& BitMapFont::GetGlyphRun( float displayHeight, std::string_view text )
+{
+	return g_theRenderer->GetGlyphRunCache().FindOrLayout(this, displayHeight, text, [this, displayHeight, text](GlyphRun& run)
+	{
+		LayoutGlyphRun(run, displayHeight, text);
+	});
+}
+
+// ------------------------------------------------------------------
+float BitMapFont::GetTextWidth( float displayHeight, std::string_view text )
+{
+	return GetGlyphRun(displayHeight, text).m_width;
+}
+
+// ------------------------------------------------------------------
+uint BitMapFont::WriteVertsForText2D( Vertex_PCU2D* outVerts, uint maxVerts, const Vec2& textPosition, float displayHeight, std::string_view text, const Rgba& tint )
+{
+	const GlyphRun& run = GetGlyphRun(displayHeight, text);
+	uint32_t packedTint = PackRgba8(tint);
+
+	uint quadCount = (uint)run.m_quads.size();
+	if(quadCount * 6 > maxVerts)
+	{
+		quadCount = maxVerts / 6;
+	}
+
+	// Same corners and winding as AddVertsForAABB2D;
+	Vertex_PCU2D* vert = outVerts;
+	for(uint quadIndex = 0; quadIndex < quadCount; ++quadIndex)
+	{
+		const GlyphQuad& quad = run.m_quads[quadIndex];
+		Vec2 mins = textPosition + quad.m_mins;
+		Vec2 maxs = textPosition + quad.m_maxs;
+
+		Vertex_PCU2D bottomLeft(mins, packedTint, quad.m_uvMins);
+		Vertex_PCU2D bottomRight(Vec2(maxs.x, mins.y), packedTint, Vec2(quad.m_uvMaxs.x, quad.m_uvMins.y));
+		Vertex_PCU2D topLeft(Vec2(mins.x, maxs.y), packedTint, Vec2(quad.m_uvMins.x, quad.m_uvMaxs.y));
+		Vertex_PCU2D topRight(maxs, packedTint, quad.m_uvMaxs);
+
+		vert[0] = bottomLeft;
+		vert[1] = bottomRight;
+		vert[2] = topRight;
+		vert[3] = bottomLeft;
+		vert[4] = topRight;
+		vert[5] = topLeft;
+		vert += 6;
+	}
+
+	return quadCount * 6;
+}
+
+// ------------------------------------------------------------------
+uint BitMapFont::WriteVertsForText2D( Vertex_PCU* outVerts, uint maxVerts, const Vec2& textPosition, float displayHeight, std::string_view text, const Rgba& tint )
+{
+	const GlyphRun& run = GetGlyphRun(displayHeight, text);
+
+	uint quadCount = (uint)run.m_quads.size();
+	if(quadCount * 6 > maxVerts)
+	{
+		quadCount = maxVerts / 6;
+	}
+
+	Vertex_PCU* vert = outVerts;
+	for(uint quadIndex = 0; quadIndex < quadCount; ++quadIndex)
+	{
+		const GlyphQuad& quad = run.m_quads[quadIndex];
+		Vec2 mins = textPosition + quad.m_mins;
+		Vec2 maxs = textPosition + quad.m_maxs;
+
+		Vertex_PCU bottomLeft(Vec3(mins.x, mins.y, 0.0f), tint, quad.m_uvMins);
+		Vertex_PCU bottomRight(Vec3(maxs.x, mins.y, 0.0f), tint, Vec2(quad.m_uvMaxs.x, quad.m_uvMins.y));
+		Vertex_PCU topLeft(Vec3(mins.x, maxs.y, 0.0f), tint, Vec2(quad.m_uvMins.x, quad.m_uvMaxs.y));
+		Vertex_PCU topRight(Vec3(maxs.x, maxs.y, 0.0f), tint, quad.m_uvMaxs);
+
+		vert[0] = bottomLeft;
+		vert[1] = bottomRight;
+		vert[2] = topRight;
+		vert[3] = bottomLeft;
+		vert[4] = topRight;
+		vert[5] = topLeft;
+		vert += 6;
+	}
+
+	return quadCount * 6;
+}
+
 // ------------------------------------------------------------------
 void BitMapFont::AddVertsForText3D( std::vector<Vertex_PCU>& textVerts, const Vec3& textPosition, float cellHeight, const std::string& text, const Rgba& tint )
 {
@@ -3,12 +3,16 @@
 #include "Engine/Renderer/SpriteSheet.hpp"
 #include "Engine/Core/Rgba.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCU2D.hpp"
+#include "Engine/Renderer/GlyphRunCache.hpp"
 
-
+#include <string_view>
 #include <vector>
 
 class TextureView;
-struct Vertex_PCU;
+
+typedef unsigned int uint;
 
 struct GlyphData
 {
@@ -34,53 +38,48 @@ private:
 public:
 	TextureView* GetTextureView();
 	
-	template<typename ...Types>
-	void AddVertsForText2D(std::vector<Vertex_PCU>& textVerts, 
+	// VERTEX is Vertex_PCU or Vertex_PCU2D;
+	// With no args the text is used as is, it only goes through Stringf when there is something to format;
+	template<typename VERTEX, typename ...Types>
+	void AddVertsForText2D(std::vector<VERTEX>& textVerts, 
 						   const Vec2& textPosition, 
 						   float displayHeight,
 						   const std::string& text, 
 						   const Rgba& tint = Rgba::WHITE, 
 						   Types... args)
 	{
-		// Calculating apparent font height;
-		displayHeight /= m_fontHeight;
-
-		std::string newText = "";
-		newText = Stringf(text.c_str(), args...);
-		
-		int numChars = static_cast<int>(newText.length());
-		Vec2 minBounds = textPosition;
-		for(int charIndex = 0; charIndex < numChars; charIndex++)
+		if constexpr (sizeof...(Types) == 0)
 		{
-			// Get the Glyph information;
-			int index = newText[charIndex];
-			GlyphData glyph = m_glyphData[index];
-
-			// Get the UVs of the glyph;
-			Vec2 mins = glyph.m_texCoordsMins;
-			Vec2 maxs = glyph.m_texCoordsMaxs;
-
-			// Get the A, B, C values of the glyph;
-			float before = displayHeight * glyph.m_cellHeightFractionBeforeGlyph;
-			float during = displayHeight * glyph.m_cellHeightFractionDuringGlyph;
-			float after = displayHeight * glyph.m_cellHeightFractionAfterGlyph;
+			AddVertsForTextRun(textVerts, textPosition, displayHeight, std::string_view(text), tint);
+		}
+		else
+		{
+			std::string formattedText = Stringf(text.c_str(), args...);
+			AddVertsForTextRun(textVerts, textPosition, displayHeight, std::string_view(formattedText), tint);
+		}
+	}
 
-			// Move the minBounds on X by A;
-			minBounds.x += before;
+	// Lays the text out through the RenderContext's GlyphRunCache and appends 6 verts per character;
+	template<typename VERTEX>
+	void AddVertsForTextRun(std::vector<VERTEX>& textVerts, const Vec2& textPosition, float displayHeight, std::string_view text, const Rgba& tint = Rgba::WHITE)
+	{
+		size_t firstVert = textVerts.size();
+		textVerts.resize(firstVert + GetVertCountForText(text));
 
-			// Create the bounding box for this Glyph;			
-			AABB2 glyphBoundingBox = AABB2::MakeFromMinsMaxs(minBounds, (minBounds + Vec2(during, displayHeight)));
+		uint writtenVerts = WriteVertsForText2D(textVerts.data() + firstVert, (uint)(textVerts.size() - firstVert), textPosition, displayHeight, text, tint);
+		textVerts.resize(firstVert + writtenVerts);
+	}
 
-			// Move the minBounds on X by B;
-			minBounds.x += during;
+	// Writes into a caller owned span, at most maxVerts, and returns how many were written;
+	// Stops at the last whole glyph that fits;
+	uint WriteVertsForText2D(Vertex_PCU2D* outVerts, uint maxVerts, const Vec2& textPosition, float displayHeight, std::string_view text, const Rgba& tint = Rgba::WHITE);
+	uint WriteVertsForText2D(Vertex_PCU* outVerts, uint maxVerts, const Vec2& textPosition, float displayHeight, std::string_view text, const Rgba& tint = Rgba::WHITE);
 
-			// Add the verts of glyph bounding box to the textVerts;
-			AddVertsForAABB2D(textVerts, glyphBoundingBox, tint, mins, maxs);
+	static inline uint GetVertCountForText(std::string_view text)	{ return (uint)text.size() * 6; }
 
-			// Move the minBounds on X by C;
-			minBounds.x += after;
-		}
-	}
+	// Cached layout, relative to the start position; the reference is good until the next layout;
+	const GlyphRun& GetGlyphRun(float displayHeight, std::string_view text);
+	float GetTextWidth(float displayHeight, std::string_view text);
 	
 	void AddVertsForText3D(std::vector<Vertex_PCU>& textVerts, const Vec3& textPosition, float cellHeight,
 		const std::string& text, const Rgba& tint = Rgba::WHITE/*, float cellAspect = 1.0f*/);
@@ -89,6 +88,7 @@ public:
 public:
 
 	float GetGlyphsAspect(int glyphCode) const;
+	void LayoutGlyphRun(GlyphRun& run, float displayHeight, std::string_view text) const;
 
 	std::string m_fontName;
 	TextureView* m_fontTextureView = nullptr;
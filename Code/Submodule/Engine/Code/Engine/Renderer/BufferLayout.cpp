@@ -1,4 +1,5 @@
 #include "Engine/Renderer/BufferLayout.hpp"
+#include "Engine/Core/StringUtils.hpp"
 
 std::map<std::string, BufferLayout*> BufferLayout::s_bufferLayouts;
 
@@ -31,12 +32,12 @@ BufferLayout::~BufferLayout()
 
 STATIC const BufferLayout* BufferLayout::For( const BufferAttribute_t* attributeList, size_t stride, CopyFromMasterCallback copyCallback )
 {
-	// Make the key;
-	std::string keyName = "";
+	// Make the key; names alone aren't unique, Vertex_PCU and Vertex_PCU2D share semantics but not formats;
+	std::string keyName = Stringf("%u", (unsigned int)stride);
 	int counter = 0;
 	while(!attributeList[counter].IsNull())
 	{
-		keyName += attributeList[counter].name;
+		keyName += Stringf("|%s:%d:%u", attributeList[counter].name.c_str(), (int)attributeList[counter].dataType, (unsigned int)attributeList[counter].memberOffset);
 		counter++;
 	}
 
@@ -5,10 +5,12 @@
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/Core/VertexLit.hpp"
+#include "Engine/Core/CRC32.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Renderer/ObjLoader.hpp"
+#include "Engine/Renderer/MeshCache.hpp"
 
-#include <fstream>
-#include <sstream>
-#include <iostream>
+#include <vector>
 
 CPUMesh::CPUMesh()
 {
@@ -17,7 +19,8 @@ CPUMesh::CPUMesh()
 
 CPUMesh::~CPUMesh()
 {
-
+	delete m_mappedFile;
+	m_mappedFile = nullptr;
 }
 
 void CPUMesh::SetColor( const Rgba& color )
@@ -47,6 +50,8 @@ void CPUMesh::SetBiTangent( const Vec3& biTangent )
 
 uint CPUMesh::AddVertex( const VertexMaster& vertexMaster )
 {
+	CopyOutMappedData();
+
 	m_stamp = vertexMaster;
 	m_vertices.push_back(m_stamp);
 
@@ -55,6 +60,8 @@ uint CPUMesh::AddVertex( const VertexMaster& vertexMaster )
 
 uint CPUMesh::AddVertex( const Vec3& position )
 {
+	CopyOutMappedData();
+
 	m_stamp.position = position;
 	m_vertices.push_back(m_stamp);
 
@@ -63,6 +70,8 @@ uint CPUMesh::AddVertex( const Vec3& position )
 
 void CPUMesh::AddIndexedTriangle( uint index0, uint index1, uint index2 )
 {
+	CopyOutMappedData();
+
 	ASSERT_OR_DIE( index0 < m_vertices.size(), "Index0 is more than the size of the vertices." );
 	ASSERT_OR_DIE( index1 < m_vertices.size(), "Index1 is more than the size of the vertices." );
 	ASSERT_OR_DIE( index2 < m_vertices.size(), "Index2 is more than the size of the vertices." );
@@ -74,6 +83,8 @@ void CPUMesh::AddIndexedTriangle( uint index0, uint index1, uint index2 )
 
 void CPUMesh::AddIndexedQuad( uint topLeft, uint topRight, uint bottomLeft, uint bottomRight )
 {
+	CopyOutMappedData();
+
 	m_indices.push_back(topLeft);
 	m_indices.push_back(bottomLeft);
 	m_indices.push_back(topRight);
@@ -85,12 +96,12 @@ void CPUMesh::AddIndexedQuad( uint topLeft, uint topRight, uint bottomLeft, uint
 
 uint CPUMesh::GetVertexCount() const
 {
-	return (uint)m_vertices.size();
+	return IsMapped() ? m_mappedVertexCount : (uint)m_vertices.size();
 }
 
 uint CPUMesh::GetIndexCount() const
 {
-	return (uint)m_indices.size();
+	return IsMapped() ? m_mappedIndexCount : (uint)m_indices.size();
 }
 
 const BufferLayout* CPUMesh::GetLayout() const
@@ -100,7 +111,12 @@ const BufferLayout* CPUMesh::GetLayout() const
 
 const VertexMaster* CPUMesh::GetVertices() const
 {
-	return m_vertices.data();
+	return IsMapped() ? m_mappedVertices : m_vertices.data();
+}
+
+const uint* CPUMesh::GetIndices() const
+{
+	return IsMapped() ? m_mappedIndices : m_indices.data();
 }
 
 void CPUMesh::SetLayout( const BufferLayout* bufferLayout )
@@ -112,6 +128,39 @@ void CPUMesh::Clear()
 {
 	m_vertices.clear();
 	m_indices.clear();
+
+	delete m_mappedFile;
+	m_mappedFile = nullptr;
+	m_mappedVertices = nullptr;
+	m_mappedIndices = nullptr;
+	m_mappedVertexCount = 0;
+	m_mappedIndexCount = 0;
+}
+
+void CPUMesh::SetMappedData( MemoryMappedFile* mappedFile, const VertexMaster* vertices, uint vertexCount, const uint* indices, uint indexCount )
+{
+	Clear();
+
+	m_mappedFile = mappedFile;
+	m_mappedVertices = vertices;
+	m_mappedIndices = indices;
+	m_mappedVertexCount = vertexCount;
+	m_mappedIndexCount = indexCount;
+}
+
+void CPUMesh::CopyOutMappedData()
+{
+	if(!IsMapped())
+	{
+		return;
+	}
+
+	std::vector<VertexMaster> vertices(m_mappedVertices, m_mappedVertices + m_mappedVertexCount);
+	std::vector<uint> indices(m_mappedIndices, m_mappedIndices + m_mappedIndexCount);
+	Clear();
+
+	m_vertices.swap(vertices);
+	m_indices.swap(indices);
 }
 
 void CPUMeshAddQuad( CPUMesh* out, AABB2 quad )
@@ -403,8 +452,16 @@ void CPUMeshAddUVCapsule( CPUMesh* out, Vec3 start, Vec3 end, float radius, uint
 
 void CreateMeshFromFile( const char* filename, CPUMesh* cpuMesh )
 {
+	// The descriptor is read in place too, its bytes are part of the cache key;
+	DataFile descriptorFile;
+	if(!descriptorFile.Open(filename))
+	{
+		DebuggerPrintf("Could not open mesh: %s\n", filename);
+		return;
+	}
+
 	tinyxml2::XMLDocument meshesXMLDoc;
-	meshesXMLDoc.LoadFile(filename);
+	meshesXMLDoc.Parse((const char*)descriptorFile.GetData(), descriptorFile.GetSize());
 
 	if(meshesXMLDoc.ErrorID() != tinyxml2::XML_SUCCESS)
 	{
@@ -412,228 +469,70 @@ void CreateMeshFromFile( const char* filename, CPUMesh* cpuMesh )
 		printf("ErrorID:      %i\n", meshesXMLDoc.ErrorID());
 		printf("ErrorLineNum: %i\n", meshesXMLDoc.ErrorLineNum());
 		printf("ErrorLineNum: \"%s\"\n", meshesXMLDoc.ErrorName());
+		return;
 	}
-	else
-	{
-		printf("Success with XML Doc: %s\n", filename);
 
-		// Object Values;
-		XmlElement* meshesElement = meshesXMLDoc.RootElement();
+	// Object Values;
+	XmlElement* meshesElement = meshesXMLDoc.RootElement();
 
-		std::string invertBool = ParseXmlAttribute(*meshesElement, "invert", "");
-		std::string tangentsBool = ParseXmlAttribute(*meshesElement, "tangents", "");
-		std::string scale = ParseXmlAttribute(*meshesElement, "scale", "");
-		std::string transform = ParseXmlAttribute(*meshesElement, "transform", "");
-		bool invertFaces = invertBool == "true" ? true : false;
-		float scalef = (float)atof(scale.c_str());
-		std::vector<std::string> objectSourceFilenames;
+	ObjImportOptions importOptions;
+	importOptions.m_invertFaces = ParseXmlAttribute(*meshesElement, "invert", false);
+	float scale = ParseXmlAttribute(*meshesElement, "scale", 1.0f);
+	std::string transform = ParseXmlAttribute(*meshesElement, "transform", "x y z");
+	importOptions.m_transform = MakeObjImportTransform(transform, scale);
 
-		XmlElement* meshElement = meshesElement->FirstChildElement("mesh");
-		while(meshElement)
-		{
-			std::string objectSourceFilename = ParseXmlAttribute(*meshElement, "src", "");
-			objectSourceFilenames.push_back(objectSourceFilename);
+	std::vector<std::string> objectSourceFilenames;
+	XmlElement* meshElement = meshesElement->FirstChildElement("mesh");
+	while(meshElement)
+	{
+		objectSourceFilenames.push_back(ParseXmlAttribute(*meshElement, "src", ""));
 
-			XmlElement* materialElement = meshElement->FirstChildElement("material");
+		XmlElement* materialElement = meshElement->FirstChildElement("material");
+		if(materialElement != nullptr)
+		{
 			cpuMesh->m_defaultMaterialName = ParseXmlAttribute(*materialElement, "src", "");
-
-			meshElement = meshElement->NextSiblingElement();
 		}
 
-		CreateObjMeshFromFile(cpuMesh, objectSourceFilenames, invertFaces, scalef, transform);
+		meshElement = meshElement->NextSiblingElement();
 	}
-}
 
-void CreateObjMeshFromFile( CPUMesh* cpuMesh, std::vector<std::string>& objectFilenames, bool invertFaces, float scalef, std::string transform )
-{
-	std::vector<Vec3> verts;
-	std::vector<Vec3> uvcoords;
-	std::vector<Vec3> normals;
-	std::vector<std::string> faces;	
-
-	//std::string& filename = objectFilenames.front();
-
-	for(auto& filename: objectFilenames)
+	// Open every source up front, the CRC of all of them decides whether the cache is still good;
+	uint sourceCRC = CRC32((const void*)descriptorFile.GetData(), (int)descriptorFile.GetSize());
+	std::vector<DataFile> objectFiles(objectSourceFilenames.size());
+	for(size_t sourceIndex = 0; sourceIndex < objectSourceFilenames.size(); ++sourceIndex)
 	{
-		// The four vectors going in will come out with data;
-		ReadContentsOfObjFile(verts, uvcoords, normals, faces, filename.c_str());
-
-		for(auto& face: faces)
+		DataFile& objectFile = objectFiles[sourceIndex];
+		if(!objectFile.Open(objectSourceFilenames[sourceIndex]))
 		{
-			std::stringstream faceStream(face);
-
-			std::string faceChunks[5];
-			int chunkIndex = 0;
-
-			while (faceStream.good() && chunkIndex < 5)
-			{
-				faceStream >> faceChunks[chunkIndex];
-				chunkIndex++;
-			}
-
-			bool fourVerts = faceChunks[4] != "" ? true : false;
-			bool assBackedUp = false;
-			for(int x = 1; x < 5; x++)
-			{
-				if(x == 4 && !fourVerts)
-				{
-					continue;
-				}
-
-				if(!assBackedUp && x == 4 && fourVerts)
-				{
-					x = 3;
-					assBackedUp = true;
-				}
-				std::string chunk = faceChunks[x];
-
-				std::string delimiter = "/";
-				size_t pos = 0;
-
-				std::string splitString[3];
-				int splitIndex = 0;
-				while ((pos = chunk.find("/")) != std::string::npos) 
-				{
-					splitString[splitIndex] = chunk.substr(0, pos);
-					chunk.erase(0, pos + 1);
-					splitIndex++;
-				}
-				splitString[splitIndex] = chunk;
-
-				int a = atoi(splitString[0].c_str()) - 1;
-				int b = atoi(splitString[1].c_str()) - 1;
-				int c = atoi(splitString[2].c_str()) - 1;
-
-				VertexMaster vertex;
-				vertex.position = verts[a];
-				vertex.color = Rgba::WHITE;
-				vertex.uv = Vec2(uvcoords[b].x, 1.0f - uvcoords[b].y);
-				vertex.normal = normals[c];			
-				vertex.tangent = Vec3(1.0f, 1.0f, 1.0f);
-				vertex.bitangent = Vec3(1.0f, 1.0f, 1.0f);
-
-				cpuMesh->m_vertices.push_back(vertex);
-
-				if(x == 4 && fourVerts)
-				{
-					int position = (int)cpuMesh->m_vertices.size() - 5;
-					VertexMaster v = cpuMesh->m_vertices[position];
-					cpuMesh->m_vertices.push_back(v);
-				}
-			}
+			DebuggerPrintf("Could not open obj: %s\n", objectSourceFilenames[sourceIndex].c_str());
+			continue;
 		}
+		sourceCRC = CRC32((const void*)objectFile.GetData(), (int)objectFile.GetSize(), sourceCRC);
+	}
 
-		if(invertFaces)
-		{
-			for(int i = 0; i < cpuMesh->m_vertices.size() - 3; i += 3)
-			{
-				VertexMaster vertex1 = cpuMesh->m_vertices[i+1];
-				VertexMaster vertex2 = cpuMesh->m_vertices[i+2];
-
-				cpuMesh->m_vertices[i+1] = vertex2;
-				cpuMesh->m_vertices[i+2] = vertex1;
-			}
-		}
-
-
-
-		Matrix4x4 transformMatrix;
-
-		// Check transform
-		std::stringstream stringStream(transform);
-		std::string lineChunks[3];
-		int chunkIndex = 0;
+	std::string cachePath = GetMeshCachePath(filename);
+	if(LoadMeshCache(cachePath, sourceCRC, cpuMesh))
+	{
+		return;
+	}
 
-		while (stringStream.good() && chunkIndex < 3)
+	cpuMesh->Clear();
+	bool isClean = true;
+	for(DataFile& objectFile : objectFiles)
+	{
+		if(objectFile.IsOpen())
 		{
-			stringStream >> lineChunks[chunkIndex];
-			chunkIndex++;
+			isClean = ParseObjFromMemory((const char*)objectFile.GetData(), objectFile.GetSize(), importOptions, cpuMesh) && isClean;
 		}
-
-		Vec3 vectors[3];
-		for(int i = 0; i < 3; i++)
+		else
 		{
-			bool negative = false;
-			Vec3 vec = Vec3(0.0f, 0.0f, 0.0f);
-			if(lineChunks[i].find("-") != std::string::npos)
-			{
-				negative = true; 
-			}
-
-			if(lineChunks[i].find("x") != std::string::npos)
-			{
-				vec = negative ? Vec3(-1.0f, 0.0f, 0.0f) : Vec3(1.0f, 0.0f, 0.0f);
-			}
-			else if(lineChunks[i].find("y") != std::string::npos)
-			{
-				vec = negative ? Vec3(0.0f, -1.0f, 0.0f) : Vec3(0.0f, 1.0f, 0.0f);
-			}
-			else if(lineChunks[i].find("z") != std::string::npos)
-			{
-				vec = negative ? Vec3(0.0f, 0.0f, -1.0f) : Vec3(0.0f, 0.0f, 1.0f);
-			}
-			vec *= scalef;
-			vectors[i] = vec;
+			isClean = false;
 		}
-
-		transformMatrix.SetI(vectors[0]);
-		transformMatrix.SetJ(vectors[1]);
-		transformMatrix.SetK(vectors[2]);
-
-		for(auto& vertex: cpuMesh->m_vertices)
-		{
-			vertex.position = transformMatrix.TransformPosition3D(vertex.position);
-			vertex.normal = transformMatrix.TransformPosition3D(vertex.normal);
-			vertex.normal.Normalize();
-		}
-
-		// do mct here
 	}
-}
 
-void ReadContentsOfObjFile( std::vector<Vec3>& verts, std::vector<Vec3>& uvcoords, std::vector<Vec3>& normals, std::vector<std::string>& faces, const char* filename )
-{
-	std::ifstream myfile (filename);
-	std::string line;	
-
-
-	while(!myfile.eof())
+	// A broken source isn't cached, so it's reported again next run;
+	if(isClean)
 	{
-		std::string lineChunks[5];
-		int chunkIndex = 0;
-
-		getline(myfile, line);
-		std::stringstream stringStream(line);
-
-		if(line[0] == 'f' && line[1] == ' ')
-		{
-			faces.push_back(line);
-		}
-		else if(line[0] == 'v')
-		{
-			while (stringStream.good() && chunkIndex < 5)
-			{
-				stringStream >> lineChunks[chunkIndex];
-				chunkIndex++;
-			}
-
-			float x = (float)atof(lineChunks[1].c_str());
-			float y = (float)atof(lineChunks[2].c_str());
-			float z = (float)atof(lineChunks[3].c_str());
-			Vec3 value = Vec3(x, y, z);
-
-			if(line[0] == 'v' && line[1] == ' ')
-			{
-				verts.push_back(value);
-			}
-			if(line[0] == 'v' && line[1] == 't' && line[2] == ' ')
-			{
-				uvcoords.push_back(value);
-			}
-			if(line[0] == 'v' && line[1] == 'n' && line[2] == ' ')
-			{
-				normals.push_back(value);
-			}
-		}		
+		SaveMeshCache(cachePath, sourceCRC, *cpuMesh);
 	}
 }
@@ -8,6 +8,7 @@
 
 struct AABB2;
 struct AABB3;
+class MemoryMappedFile;
 
 
 class CPUMesh
@@ -18,6 +19,9 @@ public:
 	CPUMesh();
 	~CPUMesh();
 
+	CPUMesh(const CPUMesh&) = delete;
+	CPUMesh& operator=(const CPUMesh&) = delete;
+
 	// Modify the stamp
 	void SetColor( const Rgba& color );
 	void SetUV( const Vec2& uv );
@@ -44,6 +48,7 @@ public:
 	// Buffer Layout;	
 	const BufferLayout* GetLayout() const;
 	const VertexMaster* GetVertices() const;
+	const uint* GetIndices() const;
 	void SetLayout( const BufferLayout* bufferLayout );
 
 	template <typename T>
@@ -58,6 +63,12 @@ public:
 
 	void Clear();
 
+	// Mesh cache hits read straight out of the mapped cache file, which the mesh then owns;
+	// anything that adds to the mesh copies the data into m_vertices and m_indices first;
+	void SetMappedData( MemoryMappedFile* mappedFile, const VertexMaster* vertices, uint vertexCount, const uint* indices, uint indexCount );
+	void CopyOutMappedData();
+	inline bool IsMapped() const { return m_mappedFile != nullptr; }
+
 public:
 
 	std::vector<VertexMaster> m_vertices;
@@ -68,6 +79,12 @@ public:
 
 	std::string m_defaultMaterialName = "";
 
+	MemoryMappedFile* m_mappedFile = nullptr;
+	const VertexMaster* m_mappedVertices = nullptr;
+	const uint* m_mappedIndices = nullptr;
+	uint m_mappedVertexCount = 0;
+	uint m_mappedIndexCount = 0;
+
 };
 
 void CPUMeshAddQuad( CPUMesh* out, AABB2 quad );
@@ -77,6 +94,5 @@ void CPUMeshAddUVCapsule1( CPUMesh* out, Vec3 center, float radius, uint wedges
 void CPUMeshAddUVCapsule2( CPUMesh* out, Vec3 center, float radius, uint wedges = 32, uint slices = 16 );
 void CPUMeshAddUVCapsule( CPUMesh* out, Vec3 start, Vec3 end, float radius, uint wedges = 32, uint slices = 16 );
 
+// Reads a .mesh descriptor and its obj sources, through the mesh cache (see MeshCache.hpp);
 void CreateMeshFromFile( const char* filename, CPUMesh* cpuMesh );
-void CreateObjMeshFromFile( CPUMesh* cpuMesh, std::vector<std::string>& objectFilenames, bool invertFaces, float scalef, std::string transform );
-void ReadContentsOfObjFile(std::vector<Vec3>& verts, std::vector<Vec3>& uvcoords, std::vector<Vec3>& normals, std::vector<std::string>& faces, const char* filename);
@@ -24,8 +24,6 @@ public:
 
 	void CreateFromCPUMesh( const CPUMesh* cpuMesh, GPUMemoryUsage gpuMemoryUsage = GPU_MEMORY_USAGE_STATIC );
 	void CreateMeshFromFile(const char* filename);
-	void CreateObjMeshFromFile(std::vector<std::string>& objectFilenames, bool invertFaces, float scale, std::string transform);
-	void ReadContentsOfObjFile(std::vector<Vec3>& verts, std::vector<Vec3>& uvcoords, std::vector<Vec3>& normals, std::vector<std::string>& faces, const char* filename);
 
 	template <typename T>
 	void CreateFromVertices( std::vector<T> vertices, std::vector<uint> indices )
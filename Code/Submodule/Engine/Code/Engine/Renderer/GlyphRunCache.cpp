@@ -0,0 +1,98 @@
+#include "Engine/Renderer/GlyphRunCache.hpp"
+
+#include <iterator>
+#include <string.h>
+
+// ------------------------------------------------------------------------------------------------
+GlyphRunCache::GlyphRunCache(uint32_t capacity_)
+	: m_capacity(capacity_ > 0 ? capacity_ : 1)
+{
+	m_entryByHash.reserve(m_capacity);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GlyphRunCache::Clear()
+{
+	m_entries.clear();
+	m_entryByHash.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+// FNV-1a over the font pointer, the height bits and the text;
+// ------------------------------------------------------------------------------------------------
+uint64_t GlyphRunCache::HashKey(const BitMapFont* font_, float displayHeight_, std::string_view text_)
+{
+	const uint64_t prime = 1099511628211ull;
+	uint64_t hash = 14695981039346656037ull;
+
+	uint64_t fontBits = (uint64_t)(uintptr_t)font_;
+	uint32_t heightBits = 0;
+	memcpy(&heightBits, &displayHeight_, sizeof(heightBits));
+
+	for (int byteIndex = 0; byteIndex < 8; ++byteIndex)
+	{
+		hash = (hash ^ ((fontBits >> (byteIndex * 8)) & 0xFF)) * prime;
+	}
+	for (int byteIndex = 0; byteIndex < 4; ++byteIndex)
+	{
+		hash = (hash ^ ((heightBits >> (byteIndex * 8)) & 0xFF)) * prime;
+	}
+	for (char character : text_)
+	{
+		hash = (hash ^ (uint8_t)character) * prime;
+	}
+
+	return hash;
+}
+
+// ------------------------------------------------------------------------------------------------
+GlyphRunCache::Entry& GlyphRunCache::FindOrClaimEntry(const BitMapFont* font_, float displayHeight_, std::string_view text_, bool* found_)
+{
+	uint64_t hash = HashKey(font_, displayHeight_, text_);
+
+	std::unordered_map<uint64_t, EntryIterator>::iterator mapIter = m_entryByHash.find(hash);
+	if (mapIter != m_entryByHash.end())
+	{
+		EntryIterator entryIter = mapIter->second;
+		m_entries.splice(m_entries.begin(), m_entries, entryIter);
+
+		Entry& entry = *entryIter;
+		if (entry.m_font == font_ && entry.m_displayHeight == displayHeight_ && text_ == entry.m_text)
+		{
+			++m_stats.m_hits;
+			*found_ = true;
+			return entry;
+		}
+
+		// Hash collision; the newer key takes the entry over;
+		++m_stats.m_misses;
+		entry.m_font = font_;
+		entry.m_displayHeight = displayHeight_;
+		entry.m_text.assign(text_.data(), text_.size());
+		*found_ = false;
+		return entry;
+	}
+
+	++m_stats.m_misses;
+	if ((uint32_t)m_entries.size() >= m_capacity)
+	{
+		// Recycle the least recently used entry, its string and vector keep their capacity;
+		++m_stats.m_evictions;
+		m_entryByHash.erase(m_entries.back().m_hash);
+		m_entries.splice(m_entries.begin(), m_entries, std::prev(m_entries.end()));
+	}
+	else
+	{
+		m_entries.emplace_front();
+	}
+
+	Entry& entry = m_entries.front();
+	entry.m_hash = hash;
+	entry.m_font = font_;
+	entry.m_displayHeight = displayHeight_;
+	entry.m_text.assign(text_.data(), text_.size());
+	m_entryByHash[hash] = m_entries.begin();
+
+	*found_ = false;
+	return entry;
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+
+#include <stdint.h>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class BitMapFont;
+
+// ------------------------------------------------------------------------------------------------
+// One laid out glyph, relative to the text's start position;
+// ------------------------------------------------------------------------------------------------
+struct GlyphQuad
+{
+	Vec2 m_mins;
+	Vec2 m_maxs;
+	Vec2 m_uvMins;
+	Vec2 m_uvMaxs;
+};
+
+// ------------------------------------------------------------------------------------------------
+// A laid out string; only depends on font, text and height, so position and tint are applied when it is emitted;
+// ------------------------------------------------------------------------------------------------
+struct GlyphRun
+{
+	std::vector<GlyphQuad> m_quads;
+	float m_width = 0.0f;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct GlyphRunCacheStats
+{
+	uint32_t m_hits = 0;
+	uint32_t m_misses = 0;
+	uint32_t m_evictions = 0;
+};
+
+// ------------------------------------------------------------------------------------------------
+// GlyphRunCache;
+// LRU cache of glyph runs keyed by (font, text, height), so text that doesn't change from frame to
+// frame (console history, chat, labels) is laid out once;
+// Lookups hash the string_view in place and don't allocate; evicted entries are reused with their
+// vectors, so once the cache is full a miss doesn't allocate either unless the text is longer;
+// Main thread only, like the rest of the RenderContext;
+// ------------------------------------------------------------------------------------------------
+class GlyphRunCache
+{
+
+public:
+
+	explicit GlyphRunCache(uint32_t capacity_ = 1024);
+
+	// LAYOUT is void(GlyphRun& run_), only called on a miss, with a cleared run to fill;
+	// The reference is good until the next FindOrLayout;
+	template <typename LAYOUT>
+	const GlyphRun& FindOrLayout(const BitMapFont* font_, float displayHeight_, std::string_view text_, LAYOUT layout_);
+
+	void Clear();
+
+	inline uint32_t GetEntryCount() const							{ return (uint32_t)m_entries.size(); }
+	inline uint32_t GetCapacity() const								{ return m_capacity; }
+	inline const GlyphRunCacheStats& GetStats() const				{ return m_stats; }
+	inline void ResetStats()										{ m_stats = GlyphRunCacheStats(); }
+
+private:
+
+	struct Entry
+	{
+		uint64_t m_hash = 0;
+		const BitMapFont* m_font = nullptr;
+		float m_displayHeight = 0.0f;
+		std::string m_text;
+		GlyphRun m_run;
+	};
+
+	typedef std::list<Entry>::iterator EntryIterator;
+
+	static uint64_t HashKey(const BitMapFont* font_, float displayHeight_, std::string_view text_);
+	Entry& FindOrClaimEntry(const BitMapFont* font_, float displayHeight_, std::string_view text_, bool* found_);
+
+private:
+
+	uint32_t m_capacity;
+	std::list<Entry> m_entries;										// Most recently used first;
+	std::unordered_map<uint64_t, EntryIterator> m_entryByHash;
+	GlyphRunCacheStats m_stats;
+};
+
+// ------------------------------------------------------------------------------------------------
+template <typename LAYOUT>
+const GlyphRun& GlyphRunCache::FindOrLayout(const BitMapFont* font_, float displayHeight_, std::string_view text_, LAYOUT layout_)
+{
+	bool found = false;
+	Entry& entry = FindOrClaimEntry(font_, displayHeight_, text_, &found);
+	if (!found)
+	{
+		entry.m_run.m_quads.clear();
+		entry.m_run.m_width = 0.0f;
+		layout_(entry.m_run);
+	}
+
+	return entry.m_run;
+}
@@ -90,7 +90,7 @@ void Material::CreateMaterialFromFile( const char* filename )
 {
 
 	tinyxml2::XMLDocument materialXMLDoc;
-	materialXMLDoc.LoadFile(filename);
+	LoadXmlDocument(materialXMLDoc, filename);
 
 	if(materialXMLDoc.ErrorID() != tinyxml2::XML_SUCCESS)
 	{
@@ -0,0 +1,105 @@
+#include "Engine/Renderer/MeshCache.hpp"
+#include "Engine/Core/CRC32.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/MemoryMappedFile.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string.h>
+#include <thread>
+
+static const char* MESH_CACHE_FOLDER = "Data/Cache/Meshes/";
+
+// ------------------------------------------------------------------------------------------------
+std::string GetMeshCachePath( const std::string& meshPath_ )
+{
+	// Keep the file name readable, the CRC keeps same named meshes in different folders apart;
+	std::string meshName = std::filesystem::path(meshPath_).stem().string();
+	return Stringf("%s%s_%08x.meshcache", MESH_CACHE_FOLDER, meshName.c_str(), CRC32((const void*)meshPath_.data(), (int)meshPath_.size()));
+}
+
+// ------------------------------------------------------------------------------------------------
+bool LoadMeshCache( const std::string& cachePath_, uint sourceCRC_, CPUMesh* cpuMesh_ )
+{
+	MemoryMappedFile* cacheFile = new MemoryMappedFile();
+	if(!cacheFile->Open(cachePath_) || cacheFile->GetSize() < sizeof(MeshCacheHeader))
+	{
+		delete cacheFile;
+		return false;
+	}
+
+	MeshCacheHeader header;
+	memcpy(&header, cacheFile->GetData(), sizeof(header));
+
+	size_t fileSize = cacheFile->GetSize();
+	size_t vertexBytes = (size_t)header.m_vertexCount * sizeof(VertexMaster);
+	size_t indexBytes = (size_t)header.m_indexCount * sizeof(uint);
+	bool isValid = header.m_magic == MESH_CACHE_MAGIC
+		&& header.m_version == MESH_CACHE_VERSION
+		&& header.m_sourceCRC == sourceCRC_
+		&& header.m_vertexStride == sizeof(VertexMaster)
+		&& header.m_vertexOffset % alignof(VertexMaster) == 0
+		&& header.m_indexOffset % alignof(uint) == 0
+		&& header.m_vertexOffset >= sizeof(MeshCacheHeader)
+		&& (size_t)header.m_vertexOffset + vertexBytes <= fileSize
+		&& (size_t)header.m_indexOffset + indexBytes <= fileSize;
+
+	if(!isValid)
+	{
+		delete cacheFile;
+		return false;
+	}
+
+	const VertexMaster* vertices = (const VertexMaster*)(cacheFile->GetData() + header.m_vertexOffset);
+	const uint* indices = (const uint*)(cacheFile->GetData() + header.m_indexOffset);
+	cpuMesh_->SetMappedData(cacheFile, vertices, header.m_vertexCount, indices, header.m_indexCount);
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool SaveMeshCache( const std::string& cachePath_, uint sourceCRC_, const CPUMesh& cpuMesh_ )
+{
+	std::error_code errorCode;
+	std::filesystem::create_directories(std::filesystem::path(cachePath_).parent_path(), errorCode);
+
+	MeshCacheHeader header;
+	header.m_sourceCRC = sourceCRC_;
+	header.m_vertexStride = sizeof(VertexMaster);
+	header.m_vertexCount = cpuMesh_.GetVertexCount();
+	header.m_indexCount = cpuMesh_.GetIndexCount();
+	header.m_vertexOffset = sizeof(MeshCacheHeader);
+	header.m_indexOffset = header.m_vertexOffset + header.m_vertexCount * (uint)sizeof(VertexMaster);
+
+	// Two threads can build the same mesh (GetOrCreateMesh and the AssetLoader), each gets its own temporary;
+	std::string tempPath = Stringf("%s.%zx.tmp", cachePath_.c_str(), std::hash<std::thread::id>()(std::this_thread::get_id()));
+	{
+		std::ofstream cacheStream(tempPath, std::ios::binary | std::ios::trunc);
+		if(!cacheStream.is_open())
+		{
+			DebuggerPrintf("SaveMeshCache: could not write \"%s\".\n", tempPath.c_str());
+			return false;
+		}
+
+		cacheStream.write((const char*)&header, sizeof(header));
+		cacheStream.write((const char*)cpuMesh_.GetVertices(), (std::streamsize)header.m_vertexCount * sizeof(VertexMaster));
+		cacheStream.write((const char*)cpuMesh_.GetIndices(), (std::streamsize)header.m_indexCount * sizeof(uint));
+		if(!cacheStream.good())
+		{
+			cacheStream.close();
+			std::filesystem::remove(tempPath, errorCode);
+			return false;
+		}
+	}
+
+	// Fails if another thread has the old file mapped right now, which is fine, theirs is as good;
+	std::filesystem::rename(tempPath, cachePath_, errorCode);
+	if(errorCode)
+	{
+		std::filesystem::remove(tempPath, errorCode);
+		return false;
+	}
+	return true;
+}
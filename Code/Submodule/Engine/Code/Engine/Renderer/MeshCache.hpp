@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+
+typedef unsigned int uint;
+
+class CPUMesh;
+
+// ----------------------------------------------------------------------------
+// Mesh cache;
+// A CPUMesh as it comes out of the obj parser, written to disk so the next run maps it instead of parsing;
+// Files are named after the CRC32 of the descriptor path and remember the CRC32 of what they were built from
+// (descriptor and obj bytes), a mismatch or an older version is treated as a miss and rebuilt;
+// The layout is the in memory one, header then VertexMaster array then uint indices, so a hit is used in place;
+// ----------------------------------------------------------------------------
+constexpr uint MESH_CACHE_MAGIC		= 0x4348534D;		// "MSHC";
+constexpr uint MESH_CACHE_VERSION	= 1;				// Bump whenever the parser output or VertexMaster changes;
+
+struct MeshCacheHeader
+{
+	uint m_magic = MESH_CACHE_MAGIC;
+	uint m_version = MESH_CACHE_VERSION;
+	uint m_sourceCRC = 0;
+	uint m_vertexStride = 0;
+	uint m_vertexCount = 0;
+	uint m_indexCount = 0;
+	uint m_vertexOffset = 0;
+	uint m_indexOffset = 0;
+};
+
+std::string GetMeshCachePath( const std::string& meshPath_ );
+
+// Replaces what cpuMesh_ had with a view of the cache file; false on a miss, cpuMesh_ is untouched then;
+bool LoadMeshCache( const std::string& cachePath_, uint sourceCRC_, CPUMesh* cpuMesh_ );
+
+// Written to a temporary file and renamed over the old one, so a reader never sees half a file;
+bool SaveMeshCache( const std::string& cachePath_, uint sourceCRC_, const CPUMesh& cpuMesh_ );
@@ -0,0 +1,130 @@
+#include "Engine/Renderer/MeshImportBenchmark.hpp"
+#include "Engine/Core/BenchmarkUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/MemoryMappedFile.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+#include "Engine/Renderer/MeshCache.hpp"
+#include "Engine/Renderer/ObjLoader.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+// ------------------------------------------------------------------------------------------------
+// The reader CreateObjMeshFromFile had before, kept as the baseline; triangles only, no transform;
+// ------------------------------------------------------------------------------------------------
+static size_t OldReadObj(const std::string& objPath_)
+{
+	std::vector<Vec3> verts;
+	std::vector<Vec3> uvcoords;
+	std::vector<Vec3> normals;
+	std::vector<std::string> faces;
+	std::vector<VertexMaster> vertices;
+
+	std::ifstream objStream(objPath_);
+	std::string line;
+	while (getline(objStream, line))
+	{
+		if (line.size() < 2)
+		{
+			continue;
+		}
+
+		if (line[0] == 'f' && line[1] == ' ')
+		{
+			faces.push_back(line);
+		}
+		else if (line[0] == 'v')
+		{
+			std::stringstream lineStream(line);
+			std::string lineChunks[4];
+			for (int chunkIndex = 0; chunkIndex < 4 && lineStream.good(); ++chunkIndex)
+			{
+				lineStream >> lineChunks[chunkIndex];
+			}
+
+			Vec3 value((float)atof(lineChunks[1].c_str()), (float)atof(lineChunks[2].c_str()), (float)atof(lineChunks[3].c_str()));
+			if (line[1] == ' ')			{ verts.push_back(value); }
+			else if (line[1] == 't')	{ uvcoords.push_back(value); }
+			else if (line[1] == 'n')	{ normals.push_back(value); }
+		}
+	}
+
+	for (const std::string& face : faces)
+	{
+		std::stringstream faceStream(face);
+		std::string corner;
+		faceStream >> corner;
+		while (faceStream >> corner)
+		{
+			std::string splitString[3];
+			int splitIndex = 0;
+			size_t slash = 0;
+			while ((slash = corner.find('/')) != std::string::npos && splitIndex < 2)
+			{
+				splitString[splitIndex++] = corner.substr(0, slash);
+				corner.erase(0, slash + 1);
+			}
+			splitString[splitIndex] = corner;
+
+			int positionIndex = atoi(splitString[0].c_str()) - 1;
+			int uvIndex = atoi(splitString[1].c_str()) - 1;
+			int normalIndex = atoi(splitString[2].c_str()) - 1;
+
+			VertexMaster vertex;
+			vertex.position = (positionIndex >= 0 && positionIndex < (int)verts.size()) ? verts[positionIndex] : Vec3(0.0f, 0.0f, 0.0f);
+			vertex.uv = (uvIndex >= 0 && uvIndex < (int)uvcoords.size()) ? Vec2(uvcoords[uvIndex].x, 1.0f - uvcoords[uvIndex].y) : Vec2(0.0f, 0.0f);
+			vertex.normal = (normalIndex >= 0 && normalIndex < (int)normals.size()) ? normals[normalIndex] : Vec3(0.0f, 0.0f, 0.0f);
+			vertices.push_back(vertex);
+		}
+	}
+
+	return vertices.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunMeshImportBenchmark(const std::vector<std::string>& objPaths_, int iterations_)
+{
+	if (iterations_ < 1)
+	{
+		return;
+	}
+
+	ObjImportOptions importOptions;
+
+	for (const std::string& objPath : objPaths_)
+	{
+		MemoryMappedFile objFile;
+		if (!objFile.Open(objPath) || objFile.GetSize() == 0)
+		{
+			PrintLine(Stringf("%s: could not open, skipped", objPath.c_str()));
+			continue;
+		}
+		double megabytes = (double)objFile.GetSize() / (1024.0 * 1024.0);
+		objFile.Close();
+
+		size_t oldVertexCount = 0;
+		double oldSeconds = TimeIterations(iterations_, [&]() { oldVertexCount = OldReadObj(objPath); });
+
+		CPUMesh parsedMesh;
+		double newSeconds = TimeIterations(iterations_, [&]() { parsedMesh.Clear(); ParseObjFile(objPath, importOptions, &parsedMesh); });
+
+		// The cache is keyed on something that can't be a real descriptor, so the game's own caches are left alone;
+		std::string cachePath = GetMeshCachePath(objPath + ".bench");
+		SaveMeshCache(cachePath, 0, parsedMesh);
+
+		CPUMesh cachedMesh;
+		bool isCacheHit = true;
+		double cacheSeconds = TimeIterations(iterations_, [&]() { isCacheHit = LoadMeshCache(cachePath, 0, &cachedMesh) && isCacheHit; });
+
+		std::error_code errorCode;
+		std::filesystem::remove(cachePath, errorCode);
+
+		double perRun = 1000.0 / (double)iterations_;
+		PrintLine(Stringf("%s %.2f MB; vertices old %u, new %u (%u indices)", objPath.c_str(), megabytes, (uint)oldVertexCount, parsedMesh.GetVertexCount(), parsedMesh.GetIndexCount()));
+		PrintLine(Stringf("  old parse   %8.2f ms  %7.1f MB/s", oldSeconds * perRun, oldSeconds > 0.0 ? megabytes * iterations_ / oldSeconds : 0.0));
+		PrintLine(Stringf("  new parse   %8.2f ms  %7.1f MB/s  x%.1f", newSeconds * perRun, newSeconds > 0.0 ? megabytes * iterations_ / newSeconds : 0.0, newSeconds > 0.0 ? oldSeconds / newSeconds : 0.0));
+		PrintLine(Stringf("  cache hit   %8.3f ms%s", cacheSeconds * perRun, isCacheHit ? "" : "  (miss, cache not writable?)"));
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// ------------------------------------------------------------------------------------------------
+// Obj import benchmark on the given files;
+// Times the getline/stringstream reader CPUMesh used to have, the mapped single pass parser, and a
+// mesh cache hit (written once to Data/Cache/Meshes first), iterations_ times each; prints MB/s of obj
+// text and the vertex counts before and after corners are shared;
+// Prints to the DevConsole and blocks the caller;
+// ------------------------------------------------------------------------------------------------
+void RunMeshImportBenchmark(const std::vector<std::string>& objPaths_, int iterations_);
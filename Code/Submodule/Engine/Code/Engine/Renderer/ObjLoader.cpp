@@ -0,0 +1,452 @@
+#include "Engine/Renderer/ObjLoader.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+
+// ------------------------------------------------------------------------------------------------
+Matrix4x4 MakeObjImportTransform( const std::string& transform_, float scale_ )
+{
+	Vec3 axes[3] = { Vec3(1.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f), Vec3(0.0f, 0.0f, 1.0f) };
+
+	int axisIndex = 0;
+	bool negative = false;
+	for(char character : transform_)
+	{
+		if(axisIndex >= 3)
+		{
+			break;
+		}
+
+		if(character == '-')
+		{
+			negative = true;
+		}
+		else if(character == 'x' || character == 'y' || character == 'z')
+		{
+			float sign = negative ? -1.0f : 1.0f;
+			axes[axisIndex] = Vec3(0.0f, 0.0f, 0.0f);
+			if(character == 'x')		{ axes[axisIndex].x = sign; }
+			else if(character == 'y')	{ axes[axisIndex].y = sign; }
+			else						{ axes[axisIndex].z = sign; }
+
+			negative = false;
+			++axisIndex;
+		}
+	}
+
+	Matrix4x4 transform;
+	transform.SetI(axes[0] * scale_);
+	transform.SetJ(axes[1] * scale_);
+	transform.SetK(axes[2] * scale_);
+	return transform;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Text scanning; every helper stops at end_ and never reads past it;
+// ------------------------------------------------------------------------------------------------
+static inline bool IsDigit( char character )
+{
+	return (unsigned char)(character - '0') < 10;
+}
+
+static inline const char* SkipSpaces( const char* cursor, const char* end )
+{
+	while(cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r'))
+	{
+		++cursor;
+	}
+	return cursor;
+}
+
+static inline const char* SkipLine( const char* cursor, const char* end )
+{
+	while(cursor < end && *cursor != '\n')
+	{
+		++cursor;
+	}
+	return cursor < end ? cursor + 1 : end;
+}
+
+// Exact powers of ten a double can hold;
+static const double s_powersOfTen[] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+	1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// ------------------------------------------------------------------------------------------------
+// Decimal or scientific notation; digits go into one integer and the decimal point into a power of ten,
+// so a float costs one multiply or divide instead of an atof per number;
+// ------------------------------------------------------------------------------------------------
+static const char* ParseObjFloat( const char* cursor, const char* end, float* out )
+{
+	bool negative = false;
+	if(cursor < end && (*cursor == '-' || *cursor == '+'))
+	{
+		negative = *cursor == '-';
+		++cursor;
+	}
+
+	uint64_t mantissa = 0;
+	int significantDigits = 0;
+	int exponent = 0;
+
+	for(; cursor < end && IsDigit(*cursor); ++cursor)
+	{
+		if(significantDigits < 19)
+		{
+			mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+			significantDigits += mantissa != 0 ? 1 : 0;
+		}
+		else
+		{
+			++exponent;
+		}
+	}
+
+	if(cursor < end && *cursor == '.')
+	{
+		++cursor;
+		for(; cursor < end && IsDigit(*cursor); ++cursor)
+		{
+			if(significantDigits < 19)
+			{
+				mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+				significantDigits += mantissa != 0 ? 1 : 0;
+				--exponent;
+			}
+		}
+	}
+
+	if(cursor < end && (*cursor == 'e' || *cursor == 'E'))
+	{
+		++cursor;
+		bool negativeExponent = false;
+		if(cursor < end && (*cursor == '-' || *cursor == '+'))
+		{
+			negativeExponent = *cursor == '-';
+			++cursor;
+		}
+
+		int writtenExponent = 0;
+		for(; cursor < end && IsDigit(*cursor); ++cursor)
+		{
+			if(writtenExponent < 10000)
+			{
+				writtenExponent = writtenExponent * 10 + (*cursor - '0');
+			}
+		}
+		exponent += negativeExponent ? -writtenExponent : writtenExponent;
+	}
+
+	double value = (double)mantissa;
+	if(mantissa != 0 && exponent != 0)
+	{
+		if(exponent > 0 && exponent <= 22)
+		{
+			value *= s_powersOfTen[exponent];
+		}
+		else if(exponent < 0 && exponent >= -22)
+		{
+			value /= s_powersOfTen[-exponent];
+		}
+		else
+		{
+			value *= pow(10.0, (double)exponent);
+		}
+	}
+
+	*out = (float)(negative ? -value : value);
+	return cursor;
+}
+
+// ------------------------------------------------------------------------------------------------
+static const char* ParseObjInt( const char* cursor, const char* end, int* out )
+{
+	bool negative = false;
+	if(cursor < end && (*cursor == '-' || *cursor == '+'))
+	{
+		negative = *cursor == '-';
+		++cursor;
+	}
+
+	int value = 0;
+	for(; cursor < end && IsDigit(*cursor); ++cursor)
+	{
+		value = value * 10 + (*cursor - '0');
+	}
+
+	*out = negative ? -value : value;
+	return cursor;
+}
+
+// ------------------------------------------------------------------------------------------------
+static const char* ParseObjVec3( const char* cursor, const char* end, Vec3* out )
+{
+	cursor = ParseObjFloat(SkipSpaces(cursor, end), end, &out->x);
+	cursor = ParseObjFloat(SkipSpaces(cursor, end), end, &out->y);
+	cursor = ParseObjFloat(SkipSpaces(cursor, end), end, &out->z);
+	return cursor;
+}
+
+// ------------------------------------------------------------------------------------------------
+// 1 based, or negative from the end of what's been read so far; 0 is "not given" and comes back -1;
+// anything else out of range comes back -2;
+// ------------------------------------------------------------------------------------------------
+static inline int ResolveObjIndex( int index, size_t count )
+{
+	if(index == 0)
+	{
+		return -1;
+	}
+
+	int resolved = index > 0 ? index - 1 : (int)count + index;
+	return (resolved >= 0 && resolved < (int)count) ? resolved : -2;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Open addressing map from a face corner (position, uv, normal) to the vertex made for it;
+// Slots hold vertex index + 1, 0 is empty; the keys live next to the vertices, indexed the same;
+// ------------------------------------------------------------------------------------------------
+struct ObjCornerKey
+{
+	int m_position;
+	int m_uv;
+	int m_normal;
+};
+
+class ObjCornerMap
+{
+
+public:
+
+	ObjCornerMap()
+	{
+		m_slots.assign(1024, 0);
+		m_mask = 1023;
+	}
+
+	// Returns the vertex for key_ and true, or adds key_ as vertex newIndex_ and returns false;
+	bool FindOrAdd( const ObjCornerKey& key_, uint newIndex_, uint* outIndex_ )
+	{
+		if((m_keys.size() + 1) * 2 > m_slots.size())
+		{
+			Grow();
+		}
+
+		uint slot = Hash(key_) & m_mask;
+		while(m_slots[slot] != 0)
+		{
+			const ObjCornerKey& existing = m_keys[m_slots[slot] - 1];
+			if(existing.m_position == key_.m_position && existing.m_uv == key_.m_uv && existing.m_normal == key_.m_normal)
+			{
+				*outIndex_ = m_vertexIndices[m_slots[slot] - 1];
+				return true;
+			}
+			slot = (slot + 1) & m_mask;
+		}
+
+		m_keys.push_back(key_);
+		m_vertexIndices.push_back(newIndex_);
+		m_slots[slot] = (uint)m_keys.size();
+		*outIndex_ = newIndex_;
+		return false;
+	}
+
+private:
+
+	static inline uint Hash( const ObjCornerKey& key_ )
+	{
+		uint32_t hash = (uint32_t)key_.m_position * 0x9E3779B1u;
+		hash ^= (uint32_t)key_.m_uv * 0x85EBCA77u;
+		hash ^= (uint32_t)key_.m_normal * 0xC2B2AE3Du;
+		return hash ^ (hash >> 15);
+	}
+
+	void Grow()
+	{
+		m_slots.assign(m_slots.size() * 2, 0);
+		m_mask = (uint)m_slots.size() - 1;
+
+		for(uint keyIndex = 0; keyIndex < (uint)m_keys.size(); ++keyIndex)
+		{
+			uint slot = Hash(m_keys[keyIndex]) & m_mask;
+			while(m_slots[slot] != 0)
+			{
+				slot = (slot + 1) & m_mask;
+			}
+			m_slots[slot] = keyIndex + 1;
+		}
+	}
+
+private:
+
+	std::vector<uint> m_slots;
+	std::vector<ObjCornerKey> m_keys;
+	std::vector<uint> m_vertexIndices;
+	uint m_mask = 0;
+};
+
+// ------------------------------------------------------------------------------------------------
+bool ParseObjFromMemory( const char* data_, size_t size_, const ObjImportOptions& options_, CPUMesh* cpuMesh_ )
+{
+	cpuMesh_->CopyOutMappedData();
+
+	const char* cursor = data_;
+	const char* end = data_ + size_;
+
+	// Rough guess from typical line lengths, saves most of the regrowth;
+	std::vector<Vec3> positions;
+	std::vector<Vec2> uvs;
+	std::vector<Vec3> normals;
+	positions.reserve(size_ / 128);
+	uvs.reserve(size_ / 128);
+	normals.reserve(size_ / 128);
+	cpuMesh_->m_vertices.reserve(cpuMesh_->m_vertices.size() + size_ / 96);
+	cpuMesh_->m_indices.reserve(cpuMesh_->m_indices.size() + size_ / 16);
+
+	ObjCornerMap cornerMap;
+	int droppedFaceCount = 0;
+
+	while(cursor < end)
+	{
+		cursor = SkipSpaces(cursor, end);
+		if(cursor >= end)
+		{
+			break;
+		}
+
+		const char* next = cursor + 1;
+		bool hasNext = next < end;
+
+		if(cursor[0] == 'v' && hasNext && (*next == ' ' || *next == '\t'))
+		{
+			Vec3 position;
+			cursor = ParseObjVec3(next, end, &position);
+			positions.push_back(options_.m_transform.TransformPosition3D(position));
+		}
+		else if(cursor[0] == 'v' && hasNext && *next == 't')
+		{
+			Vec2 uv;
+			cursor = ParseObjFloat(SkipSpaces(next + 1, end), end, &uv.x);
+			cursor = ParseObjFloat(SkipSpaces(cursor, end), end, &uv.y);
+			uvs.push_back(Vec2(uv.x, 1.0f - uv.y));
+		}
+		else if(cursor[0] == 'v' && hasNext && *next == 'n')
+		{
+			Vec3 normal;
+			cursor = ParseObjVec3(next + 1, end, &normal);
+			normal = options_.m_transform.TransformVector3D(normal);
+			if(normal.GetLength() > 0.0f)
+			{
+				normal.Normalize();
+			}
+			normals.push_back(normal);
+		}
+		else if(cursor[0] == 'f' && hasNext && (*next == ' ' || *next == '\t'))
+		{
+			cursor = next;
+
+			uint firstVertex = 0;
+			uint previousVertex = 0;
+			int cornerCount = 0;
+			bool isValid = true;
+
+			size_t faceIndexStart = cpuMesh_->m_indices.size();
+			for(;;)
+			{
+				cursor = SkipSpaces(cursor, end);
+				if(cursor >= end || !(IsDigit(*cursor) || *cursor == '-' || *cursor == '+'))
+				{
+					break;
+				}
+
+				int positionIndex = 0;
+				int uvIndex = 0;
+				int normalIndex = 0;
+				cursor = ParseObjInt(cursor, end, &positionIndex);
+				if(cursor < end && *cursor == '/')
+				{
+					++cursor;
+					if(cursor < end && *cursor != '/')
+					{
+						cursor = ParseObjInt(cursor, end, &uvIndex);
+					}
+					if(cursor < end && *cursor == '/')
+					{
+						cursor = ParseObjInt(cursor + 1, end, &normalIndex);
+					}
+				}
+
+				ObjCornerKey key;
+				key.m_position = ResolveObjIndex(positionIndex, positions.size());
+				key.m_uv = ResolveObjIndex(uvIndex, uvs.size());
+				key.m_normal = ResolveObjIndex(normalIndex, normals.size());
+				if(key.m_position < 0 || key.m_uv == -2 || key.m_normal == -2)
+				{
+					isValid = false;
+					continue;
+				}
+
+				uint vertexIndex = 0;
+				if(!cornerMap.FindOrAdd(key, (uint)cpuMesh_->m_vertices.size(), &vertexIndex))
+				{
+					VertexMaster vertex;
+					vertex.position = positions[key.m_position];
+					vertex.color = Rgba::WHITE;
+					vertex.uv = key.m_uv >= 0 ? uvs[key.m_uv] : Vec2(0.0f, 0.0f);
+					vertex.normal = key.m_normal >= 0 ? normals[key.m_normal] : Vec3(0.0f, 0.0f, 0.0f);
+					vertex.tangent = Vec3(1.0f, 1.0f, 1.0f);
+					vertex.bitangent = Vec3(1.0f, 1.0f, 1.0f);
+					cpuMesh_->m_vertices.push_back(vertex);
+				}
+
+				// Fan from the first corner; for a quad that's (1 2 3) (1 3 4), the same two triangles as before;
+				if(cornerCount == 0)
+				{
+					firstVertex = vertexIndex;
+				}
+				else if(cornerCount >= 2)
+				{
+					cpuMesh_->m_indices.push_back(firstVertex);
+					cpuMesh_->m_indices.push_back(options_.m_invertFaces ? vertexIndex : previousVertex);
+					cpuMesh_->m_indices.push_back(options_.m_invertFaces ? previousVertex : vertexIndex);
+				}
+				previousVertex = vertexIndex;
+				++cornerCount;
+			}
+
+			if(!isValid)
+			{
+				cpuMesh_->m_indices.resize(faceIndexStart);
+				++droppedFaceCount;
+			}
+		}
+
+		cursor = SkipLine(cursor, end);
+	}
+
+	if(droppedFaceCount > 0)
+	{
+		DebuggerPrintf("ParseObjFromMemory: dropped %i faces with missing vertices.\n", droppedFaceCount);
+		return false;
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ParseObjFile( const std::string& filepath_, const ObjImportOptions& options_, CPUMesh* cpuMesh_ )
+{
+	DataFile objFile;
+	if(!objFile.Open(filepath_))
+	{
+		DebuggerPrintf("ParseObjFile: could not open \"%s\".\n", filepath_.c_str());
+		return false;
+	}
+
+	return ParseObjFromMemory((const char*)objFile.GetData(), objFile.GetSize(), options_, cpuMesh_);
+}
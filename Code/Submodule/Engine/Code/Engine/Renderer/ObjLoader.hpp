@@ -0,0 +1,27 @@
+#pragma once
+#include "Engine/Math/Matrix44.hpp"
+
+#include <stddef.h>
+#include <string>
+
+class CPUMesh;
+
+// How a .mesh descriptor wants its sources brought in;
+struct ObjImportOptions
+{
+	bool m_invertFaces = false;
+	Matrix4x4 m_transform;				// Positions and normals; normals are renormalized after;
+};
+
+// The descriptor's transform attribute, e.g. "-y -z -x": where each of the file's axes goes, scaled by scale_;
+// An empty or unreadable transform keeps the axes as they are;
+Matrix4x4 MakeObjImportTransform( const std::string& transform_, float scale_ );
+
+// ----------------------------------------------------------------------------
+// Single pass obj parser working straight on the file bytes;
+// Reads v, vt, vn and f (any polygon, fanned into triangles, negative indices allowed), skips everything else;
+// Corners that repeat the same position/uv/normal share one vertex, so the result is an indexed triangle list;
+// Appends to cpuMesh_; returns false if a face referenced something that doesn't exist, those faces are dropped;
+// ----------------------------------------------------------------------------
+bool ParseObjFromMemory( const char* data_, size_t size_, const ObjImportOptions& options_, CPUMesh* cpuMesh_ );
+bool ParseObjFile( const std::string& filepath_, const ObjImportOptions& options_, CPUMesh* cpuMesh_ );
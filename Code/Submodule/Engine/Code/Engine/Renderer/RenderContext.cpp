@@ -24,10 +24,12 @@
 #include "Engine/Core/NamedStrings.hpp"
 //#include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/DevConsole.hpp"
 #include "Engine/Renderer/Material.hpp"
 #include "Engine/Renderer/Model.hpp"
 #include "Engine/Core/Utils.hpp"
 #include "Engine/Profile/Profile.hpp"
+#include "Engine/Memory/Memory.hpp"
 #include "Engine/Job/MakeImageFromTextureJob.hpp"
 #include "Engine/Job/SaveImageJob.hpp"
 
@@ -145,6 +147,35 @@ static bool DirectionalLightDirectionEvent(EventArgs& args)
 	return true;
 }
 
+static bool SpriteBatchStatsEvent(EventArgs& args)
+{
+	UNUSED(args);
+
+	const SpriteBatchStats& stats = g_theRenderer->m_lastFrameSpriteBatchStats;
+	g_theDevConsole->Print(Stringf("Sprite batch last frame: %u sprites, %u quads, %u draws", stats.m_spritesSubmitted, stats.m_quadsSubmitted, stats.m_drawsSubmitted));
+
+	return true;
+}
+
+static bool GlyphCacheStatsEvent(EventArgs& args)
+{
+	UNUSED(args);
+
+	const GlyphRunCacheStats& stats = g_theRenderer->m_lastFrameGlyphRunStats;
+	GlyphRunCache& cache = g_theRenderer->GetGlyphRunCache();
+	g_theDevConsole->Print(Stringf("Glyph runs last frame: %u hits, %u misses, %u evictions; %u/%u cached", stats.m_hits, stats.m_misses, stats.m_evictions, cache.GetEntryCount(), cache.GetCapacity()));
+
+	return true;
+}
+
+static bool ResourceStatsEvent(EventArgs& args)
+{
+	bool listEntries = args.GetValue("list", false);
+	g_theRenderer->PrintResourceStats(listEntries);
+
+	return true;
+}
+
 
 
 // ------------------------------------------------------------------------------------------------
@@ -181,6 +212,7 @@ RenderContext::~RenderContext()
 void RenderContext::Init()
 {
 	ProfileTimer profileTimer("RenderContext Init: ", 0.0);
+	MEM_TAG_SCOPE(MEM_TAG_RENDERER);
 
 	CreateDefaultModelBuffer();
 
@@ -196,6 +228,9 @@ void RenderContext::Startup()
 	g_theEventSystem->SubscriptionEventCallbackFunction( "dl_color", DirectionalLightColorEvent );
 	g_theEventSystem->SubscriptionEventCallbackFunction( "al_color", AmbientLightColorEvent );
 	g_theEventSystem->SubscriptionEventCallbackFunction( "dl_dir", DirectionalLightDirectionEvent );
+	g_theEventSystem->SubscriptionEventCallbackFunction( "sprite_batch_stats", SpriteBatchStatsEvent );
+	g_theEventSystem->SubscriptionEventCallbackFunction( "resource_stats", ResourceStatsEvent );
+	g_theEventSystem->SubscriptionEventCallbackFunction( "glyph_cache_stats", GlyphCacheStatsEvent );
 
 	// Creating the RenderContext light buffer
 	m_cpuLightBuffer = light_buffer_t();
@@ -367,6 +402,7 @@ void RenderContext::BindTextureViewWithSampler( uint slot, TextureView* textureV
 // -----------------------------------------------------------------------
 TextureView* RenderContext::CreateTextureViewFromImage(Image& image)
 {
+	MEM_TAG_SCOPE(MEM_TAG_RENDERER);
 	TextureView* textureView = nullptr;
 	Texture2D* texture = new Texture2D(this);
 	bool isSuccessfulTextureLoad = texture->LoadTextureFromImage(image);
@@ -385,41 +421,28 @@ TextureView* RenderContext::CreateTextureViewFromImage(Image& image)
 // -----------------------------------------------------------------------
 TextureView* RenderContext::CreateOrGetTextureViewFromFile( const char* filename )
 {
-	TextureView* textureView = nullptr;
-
-	// If it already exists then return it
-	std::map<std::string, TextureView*>::const_iterator textureViewMapPair = m_cachedTextureViews.find(filename);
-	if(textureViewMapPair != m_cachedTextureViews.end())
-	{
-		return textureViewMapPair->second;
-	}
-
-	Texture2D* texture = new Texture2D(this);
-
-	bool isSuccessfulTextureLoad = texture->LoadTextureFromFile(filename);
+	m_textureViewRegistry.CountPathLookup();
+	return FindOrLoadTextureView(filename);
+}
 
-	// Try to load the texture. Return nullptr if cannot load.
-	if(!isSuccessfulTextureLoad)
-	{
-		delete texture;
-		texture = nullptr;
-		m_cachedTextureViews[filename] = nullptr;
-		return nullptr;
-	}
-	else
-	{
-		textureView = texture->CreateTextureView();
+// -----------------------------------------------------------------------
+TextureView* RenderContext::CreateOrGetTextureViewFromFile(std::string& filename)
+{
+	m_textureViewRegistry.CountPathLookup();
+	return FindOrLoadTextureView(filename);
+}
 
-		delete texture;
-		texture = nullptr;
-		m_cachedTextureViews[filename] = textureView;
-		return textureView;
-	}	
+// -----------------------------------------------------------------------
+TextureView* RenderContext::CreateOrGetTextureViewFromFile(const std::string& filename)
+{
+	m_textureViewRegistry.CountPathLookup();
+	return FindOrLoadTextureView(filename);
 }
 
 // -----------------------------------------------------------------------
-TextureView* RenderContext::CreateOrGetTextureViewFromFile(std::string& filename)
+TextureView* RenderContext::FindOrLoadTextureView( const std::string& filename )
 {
+	MEM_TAG_SCOPE(MEM_TAG_RENDERER);
 	TextureView* textureView = nullptr;
 
 	// If it already exists then return it
@@ -452,14 +475,6 @@ TextureView* RenderContext::CreateOrGetTextureViewFromFile(std::string& filename
 	}
 }
 
-// -----------------------------------------------------------------------
-TextureView* RenderContext::CreateOrGetTextureViewFromFile(const std::string& filename)
-{
-	std::string f = filename;
-
-	return CreateOrGetTextureViewFromFile(f);
-}
-
 // -----------------------------------------------------------------------
 // Shader
 // -----------------------------------------------------------------------
@@ -503,11 +518,18 @@ void RenderContext::BindShader( Shader* shader )
 
 // -----------------------------------------------------------------------
 Shader* RenderContext::GetOrCreateShader( const char* shaderFileName )
+{
+	m_shaderRegistry.CountPathLookup();
+	return FindOrLoadShader(shaderFileName);
+}
+
+// -----------------------------------------------------------------------
+Shader* RenderContext::FindOrLoadShader( const std::string& shaderFileName )
 {
 	std::map<std::string, Shader*>::const_iterator mapPair = m_loadedShaders.find(shaderFileName);
 	if(mapPair == m_loadedShaders.end())
 	{
-		Shader* newShader = CreateShaderFromFile(shaderFileName);
+		Shader* newShader = CreateShaderFromFile(shaderFileName.c_str());
 		m_loadedShaders[shaderFileName] = newShader;
 		return newShader;
 	}
@@ -556,6 +578,7 @@ GPUMesh* RenderContext::GetOrCreateMesh( const std::string& filename )
 // -----------------------------------------------------------------------
 void RenderContext::CreateAndRegisterGPUMesh( CPUMesh* cpuMesh, const std::string& filename )
 {
+	MEM_TAG_SCOPE(MEM_TAG_RENDERER);
 	std::map<std::string, GPUMesh*>::const_iterator meshMapPair = m_meshDatabase.find(filename);
 	if(meshMapPair == m_meshDatabase.end())
 	{
@@ -875,6 +898,7 @@ void RenderContext::CreateDefaultModelBuffer()
 
 Shader* RenderContext::CreateShaderFromFile( const char* shaderFileName )
 {
+	MEM_TAG_SCOPE(MEM_TAG_RENDERER);
 	std::string shaderFileNameString = shaderFileName;
 	
 	Shader* shader = new Shader();
@@ -885,13 +909,10 @@ Shader* RenderContext::CreateShaderFromFile( const char* shaderFileName )
 	}
 	else
 	{
-		char* outData = nullptr;
-		unsigned long bufferSize = CreateFileBuffer(shaderFileName, &outData);
+		DataFile shaderDataFile(shaderFileName);
 		
-		shader->m_vertexStage.LoadShaderFromSource(this, shaderFileName, outData, bufferSize, SHADER_STAGE_VERTEX);
-		shader->m_fragmentStage.LoadShaderFromSource(this, shaderFileName, outData, bufferSize, SHADER_STAGE_FRAGMENT);
-
-		delete[] outData;		
+		shader->m_vertexStage.LoadShaderFromSource(this, shaderFileName, shaderDataFile.GetData(), shaderDataFile.GetSize(), SHADER_STAGE_VERTEX);
+		shader->m_fragmentStage.LoadShaderFromSource(this, shaderFileName, shaderDataFile.GetData(), shaderDataFile.GetSize(), SHADER_STAGE_FRAGMENT);
 	}
 
 	m_loadedShaders[shaderFileName] = shader;
@@ -901,6 +922,13 @@ Shader* RenderContext::CreateShaderFromFile( const char* shaderFileName )
 }
 
 BitMapFont* RenderContext::CreateOrGetBitmapFontFixedWidth16x16( const char* bitmapFontName )
+{
+	m_fontRegistry.CountPathLookup();
+	return FindOrLoadBitmapFontFixedWidth16x16(bitmapFontName);
+}
+
+// ------------------------------------------------------------------------------------------------
+BitMapFont* RenderContext::FindOrLoadBitmapFontFixedWidth16x16( const std::string& bitmapFontName )
 {
 	std::map<std::string, BitMapFont*>::const_iterator mapPair = m_loadedFonts.find(bitmapFontName);
 	if(mapPair == m_loadedFonts.end())
@@ -916,6 +944,8 @@ BitMapFont* RenderContext::CreateOrGetBitmapFontFixedWidth16x16( const char* bit
 // ------------------------------------------------------------------------------------------------
 BitMapFont* RenderContext::CreateOrGetBitmapFontProportionalWidth(const char* bitmapFontName)
 {
+	m_fontRegistry.CountPathLookup();
+
 	std::map<std::string, BitMapFont*>::const_iterator mapPair = m_loadedFonts.find(bitmapFontName);
 	if (mapPair == m_loadedFonts.end())
 	{
@@ -930,6 +960,8 @@ BitMapFont* RenderContext::CreateOrGetBitmapFontProportionalWidth(const char* bi
 // ------------------------------------------------------------------------------------------------
 BitMapFont* RenderContext::CreateOrGetBitmapFontLoadFromFNTFile(const char* bitmapFontName)
 {
+	m_fontRegistry.CountPathLookup();
+
 	std::map<std::string, BitMapFont*>::const_iterator mapPair = m_loadedFonts.find(bitmapFontName);
 	if (mapPair == m_loadedFonts.end())
 	{
@@ -941,9 +973,120 @@ BitMapFont* RenderContext::CreateOrGetBitmapFontLoadFromFNTFile(const char* bitm
 	return mapPair->second;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Resource Handles;
+// ------------------------------------------------------------------------------------------------
+TextureHandle RenderContext::AcquireTextureView( const std::string& filename )
+{
+	if(filename.empty())
+	{
+		return TextureHandle();
+	}
+
+	return m_textureViewRegistry.Acquire(filename);
+}
+
+// ------------------------------------------------------------------------------------------------
+ShaderHandle RenderContext::AcquireShader( const std::string& filename )
+{
+	if(filename.empty())
+	{
+		return ShaderHandle();
+	}
+
+	return m_shaderRegistry.Acquire(filename);
+}
+
+// ------------------------------------------------------------------------------------------------
+FontHandle RenderContext::AcquireBitmapFontFixedWidth16x16( const std::string& bitmapFontName )
+{
+	if(bitmapFontName.empty())
+	{
+		return FontHandle();
+	}
+
+	return m_fontRegistry.Acquire(bitmapFontName);
+}
+
+// ------------------------------------------------------------------------------------------------
+void RenderContext::ReleaseResource( TextureHandle handle )
+{
+	m_textureViewRegistry.Release(handle);
+}
+
+// ------------------------------------------------------------------------------------------------
+void RenderContext::ReleaseResource( ShaderHandle handle )
+{
+	m_shaderRegistry.Release(handle);
+}
+
+// ------------------------------------------------------------------------------------------------
+void RenderContext::ReleaseResource( FontHandle handle )
+{
+	m_fontRegistry.Release(handle);
+}
+
+// ------------------------------------------------------------------------------------------------
+TextureView* RenderContext::GetTextureView( TextureHandle handle )
+{
+	return m_textureViewRegistry.Resolve(handle, [this](const std::string& filename_) { return FindOrLoadTextureView(filename_); });
+}
+
+// ------------------------------------------------------------------------------------------------
+Shader* RenderContext::GetShader( ShaderHandle handle )
+{
+	return m_shaderRegistry.Resolve(handle, [this](const std::string& filename_) { return FindOrLoadShader(filename_); });
+}
+
+// ------------------------------------------------------------------------------------------------
+BitMapFont* RenderContext::GetBitmapFont( FontHandle handle )
+{
+	return m_fontRegistry.Resolve(handle, [this](const std::string& fontName_) { return FindOrLoadBitmapFontFixedWidth16x16(fontName_); });
+}
+
+// ------------------------------------------------------------------------------------------------
+void RenderContext::BindShader( ShaderHandle handle )
+{
+	BindShader(GetShader(handle));
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+static void PrintResourceRegistry( const char* typeName, const ResourceRegistry<T>& registry, const ResourceLookupStats& lastFrameStats, bool listEntries )
+{
+	uint referencedCount = 0;
+	for(uint entryIndex = 0; entryIndex < registry.GetEntryCount(); ++entryIndex)
+	{
+		referencedCount += registry.GetEntry(entryIndex).m_refCount > 0 ? 1 : 0;
+	}
+
+	g_theDevConsole->Print(Stringf("%s: %u path lookups, %u handle gets, %u loads last frame; %u handles, %u referenced", 
+		typeName, lastFrameStats.m_pathLookups, lastFrameStats.m_handleGets, lastFrameStats.m_loads, registry.GetEntryCount(), referencedCount));
+
+	if(!listEntries)
+	{
+		return;
+	}
+
+	for(uint entryIndex = 0; entryIndex < registry.GetEntryCount(); ++entryIndex)
+	{
+		const typename ResourceRegistry<T>::Entry& entry = registry.GetEntry(entryIndex);
+		g_theDevConsole->Print(Stringf("  [%u] %s refs=%d%s", entryIndex, entry.m_path.c_str(), entry.m_refCount, entry.m_isLoaded ? "" : " (not loaded)"));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void RenderContext::PrintResourceStats( bool listEntries ) const
+{
+	PrintResourceRegistry("Textures", m_textureViewRegistry, m_lastFrameTextureViewStats, listEntries);
+	PrintResourceRegistry("Shaders", m_shaderRegistry, m_lastFrameShaderStats, listEntries);
+	PrintResourceRegistry("Fonts", m_fontRegistry, m_lastFrameFontStats, listEntries);
+}
+
 // ------------------------------------------------------------------------------------------------
 void RenderContext::CreateTextureViewFromImage( Image* image, std::string& imageName )
 {
+	MEM_TAG_SCOPE(MEM_TAG_RENDERER);
 	
 	// If it already exists then return it
 	std::map<std::string, TextureView*>::const_iterator textureViewMapPair = m_cachedTextureViews.find(imageName);
@@ -1096,6 +1239,18 @@ void RenderContext::BeginFrame()
 
 	DX_SAFE_RELEASE( back_buffer ); // I'm done using this - so release my hold on it (does not destroy it!)
 
+	m_lastFrameSpriteBatchStats = m_spriteBatch.GetStats();
+	m_spriteBatch.ResetStats();
+
+	m_lastFrameGlyphRunStats = m_glyphRunCache.GetStats();
+	m_glyphRunCache.ResetStats();
+
+	m_lastFrameTextureViewStats = m_textureViewRegistry.GetStats();
+	m_lastFrameShaderStats = m_shaderRegistry.GetStats();
+	m_lastFrameFontStats = m_fontRegistry.GetStats();
+	m_textureViewRegistry.ResetStats();
+	m_shaderRegistry.ResetStats();
+	m_fontRegistry.ResetStats();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1201,6 +1356,11 @@ void RenderContext::Shutdown()
 		m_cachedSamplers[i] = nullptr;
 	}
 
+	for(int i = 0; i < NUM_BLEND_MODES; i++)
+	{
+		DX_SAFE_RELEASE(m_blendStates[i]);
+	}
+
 	ClearAndDeleteContentsOfMap(m_loadedShaders);
 	ClearAndDeleteContentsOfMap(m_loadedFonts);
 	ClearAndDeleteContentsOfMap(m_cachedTextureViews);
@@ -1288,6 +1448,11 @@ void RenderContext::BeginCamera( Camera* camera )
 // ------------------------------------------------------------------------------------------------
 void RenderContext::EndCamera()
 {
+	if(!m_spriteBatch.IsEmpty())
+	{
+		DrawSpriteBatch(m_spriteBatch);
+	}
+
 	m_context->OMSetRenderTargets(0, nullptr, nullptr);
 	m_currentCamera = nullptr;
 }
@@ -1354,20 +1519,43 @@ void RenderContext::Draw( uint vertexCount, uint byteOffset /*= 0u*/ )
 // ------------------------------------------------------------------------------------------------
 void RenderContext::DrawVertexArray( int count, const Vertex_PCU* vertices )
 {
-	BufferLayout buff = BufferLayout(Vertex_PCU::LAYOUT, sizeof(Vertex_PCU), Vertex_PCU::CopyFromMaster);
+	DrawVertexArrayWithLayout( vertices, (uint)count, BufferLayout::For<Vertex_PCU>() );
+ }
+
+
+ void RenderContext::DrawVertexArray( const std::vector<Vertex_PCU>& vertexs )
+ {
+	DrawVertexArray((int)vertexs.size(), &vertexs[0]);
+ }
+
+ // ------------------------------------------------------------------------------------------------
+ void RenderContext::DrawVertexArray( int count, const Vertex_PCU2D* vertices )
+ {
+	DrawVertexArrayWithLayout( vertices, (uint)count, BufferLayout::For<Vertex_PCU2D>() );
+ }
+
+ // ------------------------------------------------------------------------------------------------
+ void RenderContext::DrawVertexArray( const std::vector<Vertex_PCU2D>& vertexs )
+ {
+	DrawVertexArray((int)vertexs.size(), &vertexs[0]);
+ }
 
-	bool result = m_currentShader->CreateOrUpdateInputLayout(&buff); 
+ // ------------------------------------------------------------------------------------------------
+ // The layout has to come from BufferLayout::For, the shader only rebuilds its input layout when the pointer changes;
+ void RenderContext::DrawVertexArrayWithLayout( const void* vertices, uint count, const BufferLayout* layout )
+ {
+	bool result = m_currentShader->CreateOrUpdateInputLayout(layout); 
 	if (result) 
 	{
 		m_context->IASetInputLayout( m_currentShader->m_inputLayout );
 	} 
 	else 
 	{
-		GUARANTEE_RECOVERABLE(true, "Shader could not create input layer for vertex pcu.")
+		GUARANTEE_RECOVERABLE(true, "Shader could not create input layer for vertex array.")
 	}
 
 	// copy to a vertex buffer
-	m_immediateVBO->CopyCPUToGPU( vertices, sizeof(Vertex_PCU), count );
+	m_immediateVBO->CopyCPUToGPU( vertices, layout->GetStride(), count );
 
 	// bind that vertex buffer
 	BindVertexStream( m_immediateVBO ); 
@@ -1375,11 +1563,79 @@ void RenderContext::DrawVertexArray( int count, const Vertex_PCU* vertices )
 	Draw( count );
  }
 
+ // ------------------------------------------------------------------------------------------------
+void RenderContext::DrawSpriteBatch( SpriteBatch& spriteBatch )
+{
+	spriteBatch.Build();
 
- void RenderContext::DrawVertexArray( const std::vector<Vertex_PCU>& vertexs )
- {
-	DrawVertexArray((int)vertexs.size(), &vertexs[0]);
- }
+	const std::vector<Vertex_PCU2D>& verts = spriteBatch.GetBatchedVerts();
+	if(verts.empty())
+	{
+		spriteBatch.Clear();
+		return;
+	}
+
+	// One upload for the whole batch, each draw is a range of it;
+	m_immediateVBO->CopyCPUToGPU( &verts[0], sizeof(Vertex_PCU2D), (uint)verts.size() );
+	BindVertexStream( m_immediateVBO );
+
+	const BufferLayout* layout = BufferLayout::For<Vertex_PCU2D>();
+	const float blendFactor[] = {0.0f, 0.0f, 0.0f, 1.0f};
+	Shader* boundShader = nullptr;
+	BlendMode boundBlendMode = BLEND_MODE_UNKNOWN;
+	TextureView* boundTextureView = nullptr;
+	bool isTextureBound = false;
+
+	for(const SpriteBatchDraw& draw : spriteBatch.GetDraws())
+	{
+		const SpriteBatchKey& key = draw.m_key;
+		if(key.m_shader != boundShader || key.m_blendMode != boundBlendMode)
+		{
+			BindShader(key.m_shader);
+			if(m_currentShader->CreateOrUpdateInputLayout(layout))
+			{
+				m_context->IASetInputLayout( m_currentShader->m_inputLayout );
+			}
+
+			// The Shader is shared with everything else that draws with it, so its own mode is left alone;
+			if(key.m_shader->GetBlendMode() != key.m_blendMode)
+			{
+				m_context->OMSetBlendState( GetOrCreateBlendState(key.m_blendMode), blendFactor, 0xffffffff );
+			}
+
+			boundShader = key.m_shader;
+			boundBlendMode = key.m_blendMode;
+		}
+
+		if(!isTextureBound || key.m_textureView != boundTextureView)
+		{
+			BindTextureViewWithSampler(0, key.m_textureView);
+			boundTextureView = key.m_textureView;
+			isTextureBound = true;
+		}
+
+		Draw(draw.m_vertCount, draw.m_firstVert);
+	}
+
+	// Whatever draws next with the last Shader gets its own blend state back;
+	if(boundShader != nullptr && boundBlendMode != boundShader->GetBlendMode())
+	{
+		m_context->OMSetBlendState( boundShader->m_blendState, blendFactor, 0xffffffff );
+	}
+
+	spriteBatch.Clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+ID3D11BlendState* RenderContext::GetOrCreateBlendState( BlendMode blendMode )
+{
+	if(m_blendStates[blendMode] == nullptr)
+	{
+		m_blendStates[blendMode] = Shader::CreateBlendState(m_device, blendMode);
+	}
+
+	return m_blendStates[blendMode];
+}
 
  void RenderContext::DrawVertexArray( Vertex_PCU const* vertices, uint count )
  {
@@ -2,7 +2,11 @@
 #include "Engine/Renderer/RendererTypes.hpp"
 #include "Engine/Core/Rgba.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCU2D.hpp"
 #include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/SpriteBatch.hpp"
+#include "Engine/Renderer/GlyphRunCache.hpp"
+#include "Engine/Renderer/ResourceRegistry.hpp"
 #include "Engine/Math/Matrix44.hpp"
 
 #include <string>
@@ -24,6 +28,7 @@ class GPUMesh;
 class CPUMesh;
 class Material;
 class Model;
+class BufferLayout;
 
 typedef unsigned int uint;
 
@@ -87,6 +92,25 @@ public:
 	BitMapFont* CreateOrGetBitmapFontLoadFromFNTFile( const char* bitmapFontName);
 	
 	void CreateTextureViewFromImage(Image* image, std::string& imageName);
+
+	// Resource Handles; resolve the path once when a definition loads, then Get by handle when drawing;
+	// Nothing is loaded until the first Get, empty paths give back an invalid handle;
+	TextureHandle AcquireTextureView( const std::string& filename );
+	ShaderHandle AcquireShader( const std::string& filename );
+	FontHandle AcquireBitmapFontFixedWidth16x16( const std::string& bitmapFontName );
+	void ReleaseResource( TextureHandle handle );
+	void ReleaseResource( ShaderHandle handle );
+	void ReleaseResource( FontHandle handle );
+	TextureView* GetTextureView( TextureHandle handle );
+	Shader* GetShader( ShaderHandle handle );
+	BitMapFont* GetBitmapFont( FontHandle handle );
+	void BindShader( ShaderHandle handle );
+
+	// Lookup counts from the last frame, and every registered path with its reference count if listEntries;
+	void PrintResourceStats( bool listEntries ) const;
+	ResourceLookupStats m_lastFrameTextureViewStats;
+	ResourceLookupStats m_lastFrameShaderStats;
+	ResourceLookupStats m_lastFrameFontStats;
 	
 	// Draw
 	void Draw(uint vertexCount, uint byteOffset = 0u);
@@ -97,6 +121,21 @@ public:
 	void DrawVertexArray( Vertex_PCU const* vertices, uint count ); 
 	void DrawVertexArray( int count, const Vertex_PCU* vertices );
 	void DrawVertexArray( const std::vector<Vertex_PCU>& vertexs );
+	void DrawVertexArray( int count, const Vertex_PCU2D* vertices );
+	void DrawVertexArray( const std::vector<Vertex_PCU2D>& vertexs );
+
+	// Sprite Batch; flushed by EndCamera, one draw per key;
+	inline SpriteBatch& GetSpriteBatch()								{ return m_spriteBatch; }
+	void DrawSpriteBatch( SpriteBatch& spriteBatch );
+	SpriteBatchStats m_lastFrameSpriteBatchStats;
+
+	// One per mode, shared by every Shader; lets a draw blend differently without touching the Shader's own mode;
+	ID3D11BlendState* GetOrCreateBlendState( BlendMode blendMode );
+	ID3D11BlendState* m_blendStates[NUM_BLEND_MODES] = {};
+
+	// Text layout; BitMapFont lays text out through this so unchanged strings aren't laid out every frame;
+	inline GlyphRunCache& GetGlyphRunCache()							{ return m_glyphRunCache; }
+	GlyphRunCacheStats m_lastFrameGlyphRunStats;
 
 	// Mesh;
 	GPUMesh* GetOrCreateMesh(const std::string& filename);
@@ -204,6 +243,14 @@ private:
 	Texture2D* CreateOrGetBitMapFontTextureFromFile(const std::string& fontName_);
 	Texture2D* CreateOrGetBitMapFontTextureFromImage(const Image& image_);
 
+	// The uncounted cache lookups behind the CreateOrGet calls and the handle loaders;
+	TextureView* FindOrLoadTextureView( const std::string& filename );
+	Shader* FindOrLoadShader( const std::string& filename );
+	BitMapFont* FindOrLoadBitmapFontFixedWidth16x16( const std::string& bitmapFontName );
+
+	// Uploads to the immediate buffer and draws; layout comes from BufferLayout::For;
+	void DrawVertexArrayWithLayout( const void* vertices, uint count, const BufferLayout* layout );
+
 	Sampler* m_cachedSamplers[SAMPLE_MODE_COUNT];
 	
 	std::map< std::string, TextureView* > m_cachedTextureViews;
@@ -213,6 +260,13 @@ private:
 	std::map< std::string, Texture* > m_loadedTextures;
 	std::map< std::string, BitMapFont* > m_loadedFonts;
 	std::map< std::string, GPUMesh* > m_meshDatabase;
+
+	SpriteBatch m_spriteBatch;
+	GlyphRunCache m_glyphRunCache;
+
+	ResourceRegistry<TextureView> m_textureViewRegistry;
+	ResourceRegistry<Shader> m_shaderRegistry;
+	ResourceRegistry<BitMapFont> m_fontRegistry;
 	
 };
 
@@ -114,6 +114,8 @@ enum DataType
 	DATA_TYPE_VEC2,
 	DATA_TYPE_VEC3,
 	DATA_TYPE_RGBA32,
+	DATA_TYPE_RGBA8,			// 4 unsigned bytes, read as normalized floats;
+	DATA_TYPE_VEC2_UNORM16,		// 2 unsigned shorts, read as normalized floats;
 
 	DATA_TYPE_COUNT
 };
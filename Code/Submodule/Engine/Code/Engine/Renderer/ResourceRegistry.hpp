@@ -0,0 +1,157 @@
+#pragma once
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TextureView;
+class Shader;
+class BitMapFont;
+
+// ------------------------------------------------------------------------------------------------
+// Handle into a ResourceRegistry; the type parameter keeps a TextureHandle from being passed as a ShaderHandle;
+// Entries are never removed, so a valid handle stays valid for the life of the registry;
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+struct ResourceHandle
+{
+	static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+	uint32_t m_index = INVALID_INDEX;
+
+	inline bool IsValid() const										{ return m_index != INVALID_INDEX; }
+	inline bool operator==(const ResourceHandle& compare_) const	{ return m_index == compare_.m_index; }
+	inline bool operator!=(const ResourceHandle& compare_) const	{ return m_index != compare_.m_index; }
+};
+
+typedef ResourceHandle<TextureView> TextureHandle;
+typedef ResourceHandle<Shader> ShaderHandle;
+typedef ResourceHandle<BitMapFont> FontHandle;
+
+// ------------------------------------------------------------------------------------------------
+struct ResourceLookupStats
+{
+	uint32_t m_pathLookups = 0;		// Anything keyed by a path string; Acquire and the old CreateOrGet calls;
+	uint32_t m_handleGets = 0;		// Resolve by handle, just an index;
+	uint32_t m_loads = 0;			// Handles that had to go to the RenderContext caches on first use;
+};
+
+// ------------------------------------------------------------------------------------------------
+// ResourceRegistry;
+// Turns a path into a small index once, then every lookup after that is an array access;
+// Acquire only records the path, the resource is loaded on the first Resolve, so definitions can
+// take handles before the async loader has finished making their textures;
+// The RenderContext caches still own the resources, the reference counts say who is still using them;
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+class ResourceRegistry
+{
+
+public:
+
+	struct Entry
+	{
+		std::string m_path;
+		T* m_resource = nullptr;
+		int m_refCount = 0;
+		bool m_isLoaded = false;
+	};
+
+public:
+
+	ResourceHandle<T> Acquire(const std::string& path_);
+	void AddReference(ResourceHandle<T> handle_);
+	void Release(ResourceHandle<T> handle_);
+
+	// LOADER is T*(const std::string& path_), only called the first time a handle is resolved;
+	template <typename LOADER>
+	T* Resolve(ResourceHandle<T> handle_, LOADER loader_);
+
+	inline void CountPathLookup()									{ ++m_stats.m_pathLookups; }
+	inline const ResourceLookupStats& GetStats() const				{ return m_stats; }
+	inline void ResetStats()										{ m_stats = ResourceLookupStats(); }
+
+	inline uint32_t GetEntryCount() const							{ return (uint32_t)m_entries.size(); }
+	inline const Entry& GetEntry(uint32_t index_) const				{ return m_entries[index_]; }
+
+private:
+
+	std::vector<Entry> m_entries;
+	std::unordered_map<std::string, uint32_t> m_indexByPath;
+	ResourceLookupStats m_stats;
+};
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+ResourceHandle<T> ResourceRegistry<T>::Acquire(const std::string& path_)
+{
+	CountPathLookup();
+
+	ResourceHandle<T> handle;
+
+	std::unordered_map<std::string, uint32_t>::const_iterator found = m_indexByPath.find(path_);
+	if (found != m_indexByPath.end())
+	{
+		handle.m_index = found->second;
+	}
+	else
+	{
+		handle.m_index = (uint32_t)m_entries.size();
+		m_entries.emplace_back();
+		m_entries.back().m_path = path_;
+		m_indexByPath[path_] = handle.m_index;
+	}
+
+	++m_entries[handle.m_index].m_refCount;
+	return handle;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void ResourceRegistry<T>::AddReference(ResourceHandle<T> handle_)
+{
+	GUARANTEE_OR_DIE(handle_.m_index < m_entries.size(), "ResourceRegistry: AddReference on an invalid handle.");
+	++m_entries[handle_.m_index].m_refCount;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void ResourceRegistry<T>::Release(ResourceHandle<T> handle_)
+{
+	if (!handle_.IsValid())
+	{
+		return;
+	}
+
+	GUARANTEE_OR_DIE(handle_.m_index < m_entries.size(), "ResourceRegistry: Release on an invalid handle.");
+
+	Entry& entry = m_entries[handle_.m_index];
+	GUARANTEE_OR_DIE(entry.m_refCount > 0, Stringf("ResourceRegistry: \"%s\" released more times than it was acquired.", entry.m_path.c_str()));
+	--entry.m_refCount;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+template <typename LOADER>
+T* ResourceRegistry<T>::Resolve(ResourceHandle<T> handle_, LOADER loader_)
+{
+	++m_stats.m_handleGets;
+
+	if (!handle_.IsValid())
+	{
+		return nullptr;
+	}
+
+	Entry& entry = m_entries[handle_.m_index];
+	if (!entry.m_isLoaded)
+	{
+		++m_stats.m_loads;
+		entry.m_resource = loader_(entry.m_path);
+		entry.m_isLoaded = true;
+	}
+
+	return entry.m_resource;
+}
@@ -67,6 +67,8 @@ DXGI_FORMAT Shader::DXGetBufferFormat( const DataType dataType )
 		case DATA_TYPE_VEC2:		return DXGI_FORMAT_R32G32_FLOAT;
 		case DATA_TYPE_VEC3:		return DXGI_FORMAT_R32G32B32_FLOAT;
 		case DATA_TYPE_RGBA32:		return DXGI_FORMAT_R32G32B32A32_FLOAT;
+		case DATA_TYPE_RGBA8:		return DXGI_FORMAT_R8G8B8A8_UNORM;
+		case DATA_TYPE_VEC2_UNORM16:	return DXGI_FORMAT_R16G16_UNORM;
 		default:
 		{
 			ERROR_AND_DIE("DXGetBufferFormat: Unknown DataType");
@@ -254,62 +256,68 @@ BlendMode Shader::GetBlendMode()
 	return m_blendMode;
 }
 
-bool Shader::UpdateBlendStateIfDirty(RenderContext* renderContext)
+// A new blend state for blendMode, the caller releases it;
+STATIC ID3D11BlendState* Shader::CreateBlendState( ID3D11Device* device, BlendMode blendMode )
 {
-	// Blend State Dirty?
-	if(m_blendStateDirty || (m_blendState == nullptr))
-	{
-		// Free old state
-		DX_SAFE_RELEASE(m_blendState);
+	D3D11_BLEND_DESC blendDescription;
+	memset( &blendDescription, 0, sizeof(blendDescription) );
 
-		// Make one
-		D3D11_BLEND_DESC blendDescription;
-		memset( &blendDescription, 0, sizeof(blendDescription) );
+	blendDescription.AlphaToCoverageEnable = false;
+	blendDescription.IndependentBlendEnable = false;
+	blendDescription.RenderTarget[0].BlendEnable = true;
 
-		blendDescription.AlphaToCoverageEnable = false;
-		blendDescription.IndependentBlendEnable = false;
-		blendDescription.RenderTarget[0].BlendEnable = true;
+	if(blendMode == BLEND_MODE_ALPHA)
+	{
+		blendDescription.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
+		blendDescription.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
+		blendDescription.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
 
-		if(m_blendMode == BLEND_MODE_ALPHA)
-		{
-			blendDescription.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
-			blendDescription.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
-			blendDescription.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+		blendDescription.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
+		blendDescription.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ONE;
+		blendDescription.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_MAX;
+	}
+	else if(blendMode == BLEND_MODE_OPAQUE)
+	{
+		blendDescription.RenderTarget[0].SrcBlend = D3D11_BLEND_ONE;
+		blendDescription.RenderTarget[0].DestBlend = D3D11_BLEND_ZERO;
+		blendDescription.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
 
-			blendDescription.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
-			blendDescription.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ONE;
-			blendDescription.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_MAX;
-		}
-		else if(m_blendMode == BLEND_MODE_OPAQUE)
-		{
-			blendDescription.RenderTarget[0].SrcBlend = D3D11_BLEND_ONE;
-			blendDescription.RenderTarget[0].DestBlend = D3D11_BLEND_ZERO;
-			blendDescription.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+		blendDescription.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
+		blendDescription.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ONE;
+		blendDescription.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_MAX;
+	}
+	else if(blendMode == BLEND_MODE_ADDITIVE)
+	{
+		blendDescription.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
+		blendDescription.RenderTarget[0].DestBlend = D3D11_BLEND_ONE;
+		blendDescription.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
 
-			blendDescription.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
-			blendDescription.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ONE;
-			blendDescription.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_MAX;
-		}
-		else if(m_blendMode == BLEND_MODE_ADDITIVE)
-		{
-			blendDescription.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
-			blendDescription.RenderTarget[0].DestBlend = D3D11_BLEND_ONE;
-			blendDescription.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+		blendDescription.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
+		blendDescription.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ONE;
+		blendDescription.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_MAX;
+	}
+	else
+	{
+		GUARANTEE_RECOVERABLE(true, "Unimplemented blend mode.");
+	}
 
-			blendDescription.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
-			blendDescription.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ONE;
-			blendDescription.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_MAX;
-		}
-		else
-		{
-			GUARANTEE_RECOVERABLE(true, "Unimplemented blend mode.");
-		}
+	blendDescription.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
 
-		blendDescription.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+	ID3D11BlendState* blendState = nullptr;
+	device->CreateBlendState( &blendDescription, &blendState );
+	return blendState;
+}
 
-		// Create the blend state.
-		ID3D11Device *device = renderContext->m_device;
-		device->CreateBlendState( &blendDescription, &m_blendState );
+bool Shader::UpdateBlendStateIfDirty(RenderContext* renderContext)
+{
+	// Blend State Dirty?
+	if(m_blendStateDirty || (m_blendState == nullptr))
+	{
+		// Free old state
+		DX_SAFE_RELEASE(m_blendState);
+
+		// Make one
+		m_blendState = CreateBlendState(renderContext->m_device, m_blendMode);
 
 		m_blendStateDirty = false;
 		return (m_blendState != nullptr);	
@@ -415,7 +423,7 @@ void Shader::CreateFromFile( const std::string& fileName, RenderContext* renderC
 	// Step 1 fuckme
 	// Load XML
 	tinyxml2::XMLDocument shaderXMLDoc;
-	shaderXMLDoc.LoadFile(fileName.c_str());
+	LoadXmlDocument(shaderXMLDoc, fileName);
 
 	if(shaderXMLDoc.ErrorID() != tinyxml2::XML_SUCCESS)
 	{
@@ -439,13 +447,10 @@ void Shader::CreateFromFile( const std::string& fileName, RenderContext* renderC
 		XmlElement* fragElement = passElement->FirstChildElement("frag");
 		std::string fragEntry = ParseXmlAttribute(*fragElement, "entry", GetEntryForStage(SHADER_STAGE_FRAGMENT));
 
-		char* outData = nullptr;
-		unsigned long bufferSize = CreateFileBuffer(sourceFile, &outData);
-
-		m_vertexStage.LoadShaderFromSource(renderContext, sourceFile, outData, bufferSize, SHADER_STAGE_VERTEX, vertEntry.c_str());
-		m_fragmentStage.LoadShaderFromSource(renderContext, sourceFile, outData, bufferSize, SHADER_STAGE_FRAGMENT, fragEntry.c_str());
+		DataFile sourceDataFile(sourceFile);
 
-		delete[] outData;
+		m_vertexStage.LoadShaderFromSource(renderContext, sourceFile, sourceDataFile.GetData(), sourceDataFile.GetSize(), SHADER_STAGE_VERTEX, vertEntry.c_str());
+		m_fragmentStage.LoadShaderFromSource(renderContext, sourceFile, sourceDataFile.GetData(), sourceDataFile.GetSize(), SHADER_STAGE_FRAGMENT, fragEntry.c_str());
 
 
 		XmlElement* depthElement = passElement->FirstChildElement("depth");
@@ -600,7 +605,7 @@ Shader::~Shader()
 
 bool ShaderStage::LoadShaderFromSource( RenderContext *renderContext, 
 	std::string const &filename, 
-	void *source,
+	void const *source,
 	size_t source_len,
 	eShaderStage stage,
 	const char* entryPoint)
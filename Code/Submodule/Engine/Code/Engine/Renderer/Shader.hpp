@@ -23,7 +23,7 @@ public:
 
 	bool LoadShaderFromSource( RenderContext *colorTargetView, 
 		std::string const &filename, 
-		void *source, 
+		void const *source, 
 		size_t source_len, 
 		eShaderStage stage,
 		const char* entryPoint=nullptr);
@@ -52,6 +52,7 @@ public:
 	static DXGI_FORMAT DXGetBufferFormat( const DataType dataType);
 	static D3D11_FILL_MODE DXGetRasterFill( const RasterFill fill);
 	static D3D11_CULL_MODE DXGetRasterCull( const RasterCull cull);
+	static ID3D11BlendState* CreateBlendState( ID3D11Device* device, BlendMode blendMode );
 	static char const* GetEntryForStage( eShaderStage stage );
 	static char const* GetShaderModelForStage( eShaderStage stage );
 	bool CreateInputLayoutForVertexPCU();
@@ -0,0 +1,205 @@
+#include "Engine/Renderer/SpriteBatch.hpp"
+#include "Engine/UnitTests/UnitTests.hpp"
+
+#include <algorithm>
+
+// ------------------------------------------------------------------------------------------------
+bool SpriteBatchKey::operator==(const SpriteBatchKey& compare_) const
+{
+	return m_layer == compare_.m_layer
+		&& m_shader == compare_.m_shader
+		&& m_textureView == compare_.m_textureView
+		&& m_blendMode == compare_.m_blendMode;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool SpriteBatchKey::operator<(const SpriteBatchKey& compare_) const
+{
+	// Layer first, it is the only part of the order that is visible;
+	// Shader next since it is the most expensive to switch;
+	if(m_layer != compare_.m_layer)					{ return m_layer < compare_.m_layer; }
+	if(m_shader != compare_.m_shader)				{ return m_shader < compare_.m_shader; }
+	if(m_blendMode != compare_.m_blendMode)			{ return m_blendMode < compare_.m_blendMode; }
+	return m_textureView < compare_.m_textureView;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpriteBatch::AddQuad(const SpriteBatchKey& key_, const AABB2& box_, const Rgba& color_, const Vec2& uvAtMins_, const Vec2& uvAtMaxs_)
+{
+	std::vector<Vertex_PCU2D>& verts = AppendVerts(key_);
+	uint32_t packedColor = PackRgba8(color_);
+
+	// Same corners and winding as AddVertsForAABB2D;
+	Vec2 positionBL(box_.mins.x, box_.mins.y);
+	Vec2 positionBR(box_.maxs.x, box_.mins.y);
+	Vec2 positionTL(box_.mins.x, box_.maxs.y);
+	Vec2 positionTR(box_.maxs.x, box_.maxs.y);
+
+	Vec2 uvBL(uvAtMins_.x, uvAtMins_.y);
+	Vec2 uvBR(uvAtMaxs_.x, uvAtMins_.y);
+	Vec2 uvTL(uvAtMins_.x, uvAtMaxs_.y);
+	Vec2 uvTR(uvAtMaxs_.x, uvAtMaxs_.y);
+
+	verts.emplace_back(positionBL, packedColor, uvBL);
+	verts.emplace_back(positionBR, packedColor, uvBR);
+	verts.emplace_back(positionTR, packedColor, uvTR);
+
+	verts.emplace_back(positionBL, packedColor, uvBL);
+	verts.emplace_back(positionTR, packedColor, uvTR);
+	verts.emplace_back(positionTL, packedColor, uvTL);
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<Vertex_PCU2D>& SpriteBatch::AppendVerts(const SpriteBatchKey& key_)
+{
+	Sprite sprite;
+	sprite.m_key = key_;
+	sprite.m_firstVert = (uint)m_pendingVerts.size();
+	m_sprites.push_back(sprite);
+
+	return m_pendingVerts;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpriteBatch::Build()
+{
+	m_draws.clear();
+	m_batchedVerts.clear();
+
+	// Sort indices, not sprites, so equal keys end up next to each other; ties keep submission order so sprites
+	// with the same key still draw in order; the pointers in the key only group, they never decide what draws first;
+	m_sortedSpriteIndices.resize(m_sprites.size());
+	for(uint spriteIndex = 0; spriteIndex < (uint)m_sprites.size(); ++spriteIndex)
+	{
+		m_sortedSpriteIndices[spriteIndex] = spriteIndex;
+	}
+
+	std::sort(m_sortedSpriteIndices.begin(), m_sortedSpriteIndices.end(), [this](uint a, uint b)
+	{
+		const SpriteBatchKey& keyA = m_sprites[a].m_key;
+		const SpriteBatchKey& keyB = m_sprites[b].m_key;
+		if(keyA == keyB)
+		{
+			return a < b;
+		}
+		return keyA < keyB;
+	});
+
+	// One group per key, its first sprite is the lowest index in the run;
+	m_groups.clear();
+	for(uint sortedIndex = 0; sortedIndex < (uint)m_sortedSpriteIndices.size(); ++sortedIndex)
+	{
+		const Sprite& sprite = m_sprites[m_sortedSpriteIndices[sortedIndex]];
+		if(m_groups.empty() || !(m_sprites[m_sortedSpriteIndices[m_groups.back().m_firstSorted]].m_key == sprite.m_key))
+		{
+			SpriteGroup group;
+			group.m_layer = sprite.m_key.m_layer;
+			group.m_firstSubmitted = m_sortedSpriteIndices[sortedIndex];
+			group.m_firstSorted = sortedIndex;
+			m_groups.push_back(group);
+		}
+		m_groups.back().m_spriteCount++;
+	}
+
+	// Layer, then first submission; no two groups share a first sprite, so the order is total;
+	std::sort(m_groups.begin(), m_groups.end(), [](const SpriteGroup& a, const SpriteGroup& b)
+	{
+		if(a.m_layer != b.m_layer)
+		{
+			return a.m_layer < b.m_layer;
+		}
+		return a.m_firstSubmitted < b.m_firstSubmitted;
+	});
+
+	m_batchedVerts.reserve(m_pendingVerts.size());
+	for(const SpriteGroup& group : m_groups)
+	{
+		for(uint sortedIndex = group.m_firstSorted; sortedIndex < group.m_firstSorted + group.m_spriteCount; ++sortedIndex)
+		{
+			uint spriteIndex = m_sortedSpriteIndices[sortedIndex];
+			const Sprite& sprite = m_sprites[spriteIndex];
+			uint vertCount = GetSpriteVertCount(spriteIndex);
+			if(vertCount == 0)
+			{
+				continue;
+			}
+
+			// Neighbouring groups never share a key, so a group is at most one draw;
+			if(m_draws.empty() || !(m_draws.back().m_key == sprite.m_key))
+			{
+				SpriteBatchDraw draw;
+				draw.m_key = sprite.m_key;
+				draw.m_firstVert = (uint)m_batchedVerts.size();
+				m_draws.push_back(draw);
+			}
+
+			m_batchedVerts.insert(m_batchedVerts.end(), m_pendingVerts.begin() + sprite.m_firstVert, m_pendingVerts.begin() + sprite.m_firstVert + vertCount);
+			m_draws.back().m_vertCount += vertCount;
+		}
+	}
+
+	m_stats.m_spritesSubmitted += (uint)m_sprites.size();
+	m_stats.m_quadsSubmitted += (uint)m_pendingVerts.size() / 6;
+	m_stats.m_drawsSubmitted += (uint)m_draws.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpriteBatch::Clear()
+{
+	m_sprites.clear();
+	m_pendingVerts.clear();
+	m_sortedSpriteIndices.clear();
+	m_groups.clear();
+	m_draws.clear();
+	m_batchedVerts.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+uint SpriteBatch::GetSpriteVertCount(uint spriteIndex_) const
+{
+	uint endVert = (spriteIndex_ + 1 < (uint)m_sprites.size()) ? m_sprites[spriteIndex_ + 1].m_firstVert : (uint)m_pendingVerts.size();
+	return endVert - m_sprites[spriteIndex_].m_firstVert;
+}
+
+// ------------------------------------------------------------------------------------------------
+UNITTEST("SpriteBatch Merge", "Renderer", 0)
+{
+	// Fake handles, Build never looks through them;
+	Shader* shader = reinterpret_cast<Shader*>(0x10);
+	TextureView* textureA = reinterpret_cast<TextureView*>(0x20);
+	TextureView* textureB = reinterpret_cast<TextureView*>(0x30);
+
+	SpriteBatch batch;
+	AABB2 box = AABB2::MakeFromMinsMaxs(Vec2(0.0f, 0.0f), Vec2(1.0f, 1.0f));
+
+	// Interleaved textures on one layer, and a layer 0 sprite submitted last;
+	batch.AddQuad(SpriteBatchKey(1, shader, textureA), box, Rgba::WHITE);
+	batch.AddQuad(SpriteBatchKey(1, shader, textureB), box, Rgba::WHITE);
+	batch.AddQuad(SpriteBatchKey(1, shader, textureA), box, Rgba::RED);
+	batch.AddQuad(SpriteBatchKey(1, shader, textureB), box, Rgba::WHITE);
+	batch.AddQuad(SpriteBatchKey(0, shader, textureB), box, Rgba::WHITE);
+	batch.Build();
+
+	const std::vector<SpriteBatchDraw>& draws = batch.GetDraws();
+	if(draws.size() != 3)																{ return false; }
+	if(draws[0].m_key.m_layer != 0 || draws[0].m_vertCount != 6)						{ return false; }
+	if(draws[1].m_vertCount != 12 || draws[2].m_vertCount != 12)						{ return false; }
+	if(draws[1].m_firstVert + draws[1].m_vertCount != draws[2].m_firstVert)				{ return false; }
+
+	// textureA was submitted first on layer 1, so it draws first whatever the pointers are;
+	if(draws[1].m_key.m_textureView != textureA || draws[2].m_key.m_textureView != textureB)	{ return false; }
+
+	// Same key keeps submission order, the red quad comes second in textureA's draw;
+	if(batch.GetBatchedVerts()[draws[1].m_firstVert + 6].color != PackRgba8(Rgba::RED))	{ return false; }
+
+	const SpriteBatchStats& stats = batch.GetStats();
+	if(stats.m_spritesSubmitted != 5 || stats.m_quadsSubmitted != 5 || stats.m_drawsSubmitted != 3)	{ return false; }
+
+	// The higher pointer submitted first still draws first;
+	batch.Clear();
+	batch.AddQuad(SpriteBatchKey(1, shader, textureB), box, Rgba::WHITE);
+	batch.AddQuad(SpriteBatchKey(1, shader, textureA), box, Rgba::WHITE);
+	batch.Build();
+
+	return draws.size() == 2 && draws[0].m_key.m_textureView == textureB && draws[1].m_key.m_textureView == textureA;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "Engine/Renderer/RendererTypes.hpp"
+#include "Engine/Core/Vertex_PCU2D.hpp"
+#include "Engine/Math/AABB2.hpp"
+
+#include <vector>
+
+class Shader;
+class TextureView;
+
+// ------------------------------------------------------------------------------------------------
+// Everything that forces a new draw call; sprites with equal keys are merged into one draw;
+// Layers draw in ascending order; inside a layer, sprites are grouped by key and the groups draw in the order
+// their first sprite was submitted, never by pointer; a sprite submitted after one with a different key
+// can still end up under it, so only sprites that never overlap with a different key should share a layer;
+// ------------------------------------------------------------------------------------------------
+struct SpriteBatchKey
+{
+	SpriteBatchKey() {}
+	SpriteBatchKey(int layer_, Shader* shader_, TextureView* textureView_, BlendMode blendMode_ = BLEND_MODE_ALPHA)
+		: m_layer(layer_), m_shader(shader_), m_textureView(textureView_), m_blendMode(blendMode_) {}
+
+	bool operator==(const SpriteBatchKey& compare_) const;
+	bool operator<(const SpriteBatchKey& compare_) const;
+
+	int m_layer = 0;
+	Shader* m_shader = nullptr;
+	TextureView* m_textureView = nullptr;		// nullptr binds the blank white texture;
+	BlendMode m_blendMode = BLEND_MODE_ALPHA;
+};
+
+// ------------------------------------------------------------------------------------------------
+// One merged draw, a range of SpriteBatch::GetBatchedVerts();
+// ------------------------------------------------------------------------------------------------
+struct SpriteBatchDraw
+{
+	SpriteBatchKey m_key;
+	uint m_firstVert = 0;
+	uint m_vertCount = 0;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct SpriteBatchStats
+{
+	uint m_spritesSubmitted = 0;	// Calls to AddQuad/AppendVerts, what would have been a draw each;
+	uint m_quadsSubmitted = 0;
+	uint m_drawsSubmitted = 0;
+};
+
+// ------------------------------------------------------------------------------------------------
+// SpriteBatch;
+// Collects 2D sprites for a camera, then sorts and merges them into one vertex array with one draw per key;
+// Build() is CPU only so the batching can run without a device; RenderContext::DrawSpriteBatch() submits it;
+// The vertex arrays are kept between frames, so a steady frame doesn't allocate;
+// Verts are Vertex_PCU2D, sprite UVs have to stay inside 0..1;
+// ------------------------------------------------------------------------------------------------
+class SpriteBatch
+{
+
+public:
+
+	void AddQuad(const SpriteBatchKey& key_, const AABB2& box_, const Rgba& color_, const Vec2& uvAtMins_ = Vec2(0.0f, 1.0f), const Vec2& uvAtMaxs_ = Vec2(1.0f, 0.0f));
+
+	// Starts a sprite and returns the array to add its verts to, for the builders that take a std::vector (AddVertsForText2D...);
+	// The reference is only good until the next call into the batch;
+	std::vector<Vertex_PCU2D>& AppendVerts(const SpriteBatchKey& key_);
+
+	// Sorts and merges everything added since the last Clear();
+	void Build();
+	void Clear();
+
+	inline bool IsEmpty() const												{ return m_sprites.empty(); }
+	inline const std::vector<SpriteBatchDraw>& GetDraws() const				{ return m_draws; }
+	inline const std::vector<Vertex_PCU2D>& GetBatchedVerts() const			{ return m_batchedVerts; }
+
+	// Counted from Build(), until ResetStats();
+	inline const SpriteBatchStats& GetStats() const							{ return m_stats; }
+	inline void ResetStats()												{ m_stats = SpriteBatchStats(); }
+
+private:
+
+	struct Sprite
+	{
+		SpriteBatchKey m_key;
+		uint m_firstVert = 0;
+	};
+
+	// A run of m_sortedSpriteIndices with one key, becomes one draw;
+	struct SpriteGroup
+	{
+		int m_layer = 0;
+		uint m_firstSubmitted = 0;		// Sprite index of the group's first sprite, what orders groups in a layer;
+		uint m_firstSorted = 0;
+		uint m_spriteCount = 0;
+	};
+
+	uint GetSpriteVertCount(uint spriteIndex_) const;
+
+private:
+
+	std::vector<Sprite> m_sprites;
+	std::vector<Vertex_PCU2D> m_pendingVerts;		// In submission order;
+	std::vector<uint> m_sortedSpriteIndices;
+	std::vector<SpriteGroup> m_groups;
+	std::vector<SpriteBatchDraw> m_draws;
+	std::vector<Vertex_PCU2D> m_batchedVerts;		// In draw order;
+
+	SpriteBatchStats m_stats;
+};
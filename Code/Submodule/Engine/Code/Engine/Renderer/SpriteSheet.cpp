@@ -62,4 +62,10 @@ const TextureView& SpriteSheet::GetTextureView() const
 	return *m_texture;
 }
 
+// ------------------------------------------------------------------
+void SpriteSheet::SetTextureView(const TextureView* texture_)
+{
+	m_texture = texture_;
+}
+
 
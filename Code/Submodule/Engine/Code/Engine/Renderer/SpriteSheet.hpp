@@ -20,6 +20,7 @@ public:
 
 	const SpriteDefinition& GetSpriteDefinition(int spriteIndex) const;
 	const TextureView& GetTextureView() const;
+	void SetTextureView(const TextureView* texture_);			// For sheets made before their texture is loaded;
 
 
 private:
@@ -186,7 +186,7 @@ void Texture2D::MakeImage(Image& outImage_)
 	hResult = m_owner->m_context->Map(m_handle, 0, mapType, 0, &subResource);
 
 	size_t size = (m_dimensions.x * m_dimensions.y) * 4;
-	memcpy(outImage_.m_imageRawData, subResource.pData, size);
+	memcpy(outImage_.GetImageBuffer(), subResource.pData, size);
 
 	m_owner->m_context->Unmap(m_handle, 0);
 }
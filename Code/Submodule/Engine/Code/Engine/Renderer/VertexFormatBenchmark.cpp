@@ -0,0 +1,79 @@
+#include "Engine/Renderer/VertexFormatBenchmark.hpp"
+#include "Engine/Core/BenchmarkUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/Vertex_PCU2D.hpp"
+#include "Engine/Math/AABB2.hpp"
+
+#include <vector>
+
+// ------------------------------------------------------------------------------------------------
+// Something like a UI frame, a grid of tinted sprite quads with a border line every 8 quads;
+template <typename VERTEX>
+static void BuildFrame(std::vector<VERTEX>& verts_, int quadsPerFrame_)
+{
+	verts_.clear();
+
+	const int quadsPerRow = 64;
+	for (int quadIndex = 0; quadIndex < quadsPerFrame_; ++quadIndex)
+	{
+		float x = (float)(quadIndex % quadsPerRow) * 2.0f;
+		float y = (float)(quadIndex / quadsPerRow) * 2.0f;
+		AABB2 box = AABB2::MakeFromMinsMaxs(Vec2(x, y), Vec2(x + 1.5f, y + 1.5f));
+		Rgba tint((float)(quadIndex & 0xFF) / 255.0f, 0.5f, 1.0f, 0.75f);
+
+		AddVertsForAABB2D(verts_, box, tint, Vec2(0.25f, 0.5f), Vec2(0.5f, 0.25f));
+		if ((quadIndex & 7) == 0)
+		{
+			AddVertsForLine2D(verts_, box.mins, box.maxs, 0.1f, Rgba::YELLOW);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename VERTEX>
+static void TimeBuild(const char* formatName_, int quadsPerFrame_, int frames_)
+{
+	std::vector<VERTEX> verts;
+	BuildFrame(verts, quadsPerFrame_);			// Warm up, and sizes the array so the timed frames don't allocate;
+
+	double seconds = TimeIterations(frames_, [&]()
+	{
+		BuildFrame(verts, quadsPerFrame_);
+	});
+
+	double totalQuads = (double)(verts.size() / 6) * (double)frames_;
+	double millionsPerSecond = MillionsPerSecond(totalQuads, seconds);
+	double kilobytesPerFrame = (double)(verts.size() * sizeof(VERTEX)) / 1024.0;
+
+	PrintLine(Stringf("%-12s %2iB/vert %8.3fs %8.2f Mquads/s %10.1f KB/frame", formatName_, (int)sizeof(VERTEX), seconds, millionsPerSecond, kilobytesPerFrame));
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunVertexFormatBenchmark(int quadsPerFrame_, int frames_)
+{
+	if (quadsPerFrame_ < 1 || frames_ < 1)
+	{
+		return;
+	}
+
+	TimeBuild<Vertex_PCU>("Vertex_PCU", quadsPerFrame_, frames_);
+	TimeBuild<Vertex_PCU2D>("Vertex_PCU2D", quadsPerFrame_, frames_);
+
+	// Conversion, for code that still builds Vertex_PCU and hands it to a 2D path;
+	std::vector<Vertex_PCU> source;
+	std::vector<Vertex_PCU2D> converted;
+	BuildFrame(source, quadsPerFrame_);
+	converted.reserve(source.size());
+
+	double seconds = TimeIterations(frames_, [&]()
+	{
+		converted.clear();
+		ConvertVertexArrayTo2D(source, converted);
+	});
+
+	double totalVerts = (double)source.size() * (double)frames_;
+	double millionsPerSecond = MillionsPerSecond(totalVerts, seconds);
+	PrintLine(Stringf("%-12s %8.3fs %8.2f Mverts/s", "convert", seconds, millionsPerSecond));
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+// Build benchmark for the 2D vertex formats;
+// Builds quadsPerFrame_ quads and a line per 8 quads into a reused array, frames_ times, once as
+// Vertex_PCU and once as Vertex_PCU2D, and prints millions of quads built per second and the bytes
+// each frame would upload to the DevConsole; also times converting the Vertex_PCU frame to Vertex_PCU2D;
+// CPU only, nothing is drawn;
+// ------------------------------------------------------------------------------------------------
+void RunVertexFormatBenchmark(int quadsPerFrame_, int frames_);
@@ -69,6 +69,8 @@ bool VertexBuffer::CopyCPUToGPU( const void* vertices, size_t stride, uint const
 		ASSERT( IsDynamic() ); 
 		if (RenderBuffer::CopyCPUToGPU( vertices, sizeNeeded )) 
 		{
+			// The same buffer can take a different vertex format from one draw to the next;
+			m_elementSize = stride;
 			m_vertexCount = count; 
 			return true; 
 		}
@@ -35,6 +35,17 @@ void Semaphore::Acquire()
 	);
 }
 
+// -----------------------------------------------------------------------
+bool Semaphore::AcquireFor(unsigned int milliseconds)
+{
+	DWORD result = ::WaitForSingleObject(
+		m_semaphore,	// Object to wait on;
+		milliseconds	// Time to wait in milliseconds before giving up;
+	);
+
+	return result == WAIT_OBJECT_0;
+}
+
 // -----------------------------------------------------------------------
 bool Semaphore::TryAcquire()
 {
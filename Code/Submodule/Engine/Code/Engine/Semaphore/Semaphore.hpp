@@ -9,6 +9,7 @@ public:
 	void Create(unsigned int initialCount, unsigned int maxCount);
 	void Destroy();
 	void Acquire();
+	bool AcquireFor(unsigned int milliseconds);		// False if it timed out;
 	bool TryAcquire();
 	void Release(unsigned int count = 1);
 	void ReleaseAll();
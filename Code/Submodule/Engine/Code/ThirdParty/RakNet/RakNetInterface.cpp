@@ -408,23 +408,6 @@ void RakNetInterface::UpdateUnitsBasedOnPlacingCardInUnitSlotByPlayer(RakNet::Pa
 	g_Interface->server().GetAndSendUnitsForPlayerID(playerID);
 }
 
-//-----------------------------------------------------------------------------------------------
-void RakNetInterface::ProcessMatchReport(RakNet::Packet* packet_)
-{
-	RakNet::BitStream bsIn(packet_->data, packet_->length, false);
-	bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
-	int winningPlayerID = 0;
-	int losingPlayerID = 0;
-	int damageDealtToLosingPlayer = 0;
-	int matchID = 0;
-	bsIn.Read(winningPlayerID);
-	bsIn.Read(losingPlayerID);
-	bsIn.Read(damageDealtToLosingPlayer);
-	bsIn.Read(matchID);
-
-	g_Interface->server().CreateMatchReport(winningPlayerID, losingPlayerID, damageDealtToLosingPlayer, matchID);
-}
-
 //-----------------------------------------------------------------------------------------------
 bool RakNetInterface::CheckAllClientsReadyStatus()
 {
@@ -59,7 +59,7 @@ enum GameMessageIDTypes
 	S_CLIENTPURCHASEDMARKETCARD,
 	S_CLIENTSOLDHANDCARD,
 	S_CLIENTPLACEDUNITFROMHANDCARD,
-	S_WINNEROFMATCHBEINGREPORTED,
+	S_RESERVED_WINNEROFMATCHBEINGREPORTED,	// Retired, the Server resolves battles itself; kept so later IDs don't move;
 	C_LOBBYMESSAGE,
 	C_LOBBYMESSAGEGAMESTARTING,
 	C_STARTMULTIPLAYERGAME,
@@ -78,6 +78,9 @@ enum GameMessageIDTypes
 	C_YOUWINTHEGAME,
 	C_YOULOSETHEGAME,
 
+	// New IDs go at the end, IDs already shipped never change;
+	C_RECIEVEMATCHRESULTFORBATTLE,
+
 	ID_GAMEMESSAGE_COUNT
 };
 
@@ -117,9 +120,6 @@ public:
 	void UpdateCardsBasedOnSellingByPlayer(RakNet::Packet* packet_);
 	void UpdateUnitsBasedOnPlacingCardInUnitSlotByPlayer(RakNet::Packet* packet_);
 
-	// Updating Server;
-	void ProcessMatchReport(RakNet::Packet* packet_);
-
 	// Checks;
 	bool CheckAllClientsReadyStatus();
 	bool CheckAllClientsPurchasePhaseComplete();